@@ -9,48 +9,44 @@
 #include <stdlib.h>
 #include <time.h>
 #include "c0_controller.h"
+#include "c0_master/task_sched.h"
+#include "c0_master/task_graph.h"
+#include "c0_master/task_place.h"
+#include "c0_master/task_exec.h"
+#include "c0_master/task_prio.h"
+#include "tile/tile_coro.h"
 #include "hal_tests/test_framework.h"
 #include "hal_tests/parallel_noc_tests.h"
 #include "mesh_noc/noc_packet.h"
 #include "mesh_noc/mesh_router.h"
+#include "hal_tests/hal_stats.h"
+#include "platform_init/placement.h"
 #include "generated/mem_map.h"
 #include "interrupt/plic.h"
+#include "log/log.h"
 
 // STEP 2: Global platform context for tile threads
 mesh_platform_t* g_platform_context = NULL;
 
+// Work-stealing scheduler for tiles 1..N-1; worker i runs on tile i + 1
+static task_sched_t g_tile_sched;
+
+// TILE_CORO_WORKERS=<n>: the tile processor loops run as coroutines on n
+// worker threads instead of one thread per tile
+#define TILE_CORO_STACK (1u << 20)
+static coro_pool_t g_tile_pool;
+static int g_tile_coro;
+
 // STEP 2: Task queue implementation
 int task_queue_init(task_queue_t* queue)
 {
     if (!queue) return -1;
     
-    queue->head = 0;
-    queue->tail = 0;
-    queue->count = 0;
-    
-    if (pthread_mutex_init(&queue->queue_lock, NULL) != 0) {
-        return -1;
-    }
-    
-    if (pthread_cond_init(&queue->task_available, NULL) != 0) {
-        pthread_mutex_destroy(&queue->queue_lock);
+    if (mpmc_queue_init(&queue->ring, TASK_QUEUE_CAPACITY) != 0) {
         return -1;
     }
     
-    if (pthread_cond_init(&queue->queue_not_full, NULL) != 0) {
-        pthread_mutex_destroy(&queue->queue_lock);
-        pthread_cond_destroy(&queue->task_available);
-        return -1;
-    }
-    
-    // Initialize all tasks
-    for (int i = 0; i < MAX_PENDING_TASKS; i++) {
-        memset(&queue->tasks[i], 0, sizeof(task_t));
-        pthread_mutex_init(&queue->tasks[i].task_lock, NULL);
-        pthread_cond_init(&queue->tasks[i].task_complete, NULL);
-    }
-    
-    printf("[Task Queue] Initialized with %d task slots\n", MAX_PENDING_TASKS);
+    LOG_INFO("[Task Queue] Initialized with %d task slots\n", TASK_QUEUE_CAPACITY);
     return 0;
 }
 
@@ -58,81 +54,57 @@ int task_queue_destroy(task_queue_t* queue)
 {
     if (!queue) return -1;
     
-    // Clean up all tasks
-    for (int i = 0; i < MAX_PENDING_TASKS; i++) {
-        pthread_mutex_destroy(&queue->tasks[i].task_lock);
-        pthread_cond_destroy(&queue->tasks[i].task_complete);
-    }
-    
-    pthread_mutex_destroy(&queue->queue_lock);
-    pthread_cond_destroy(&queue->task_available);
-    pthread_cond_destroy(&queue->queue_not_full);
-    
-    printf("[Task Queue] Destroyed\n");
+    mpmc_queue_destroy(&queue->ring);
+    LOG_INFO("[Task Queue] Destroyed\n");
     return 0;
 }
 
 int task_queue_push(task_queue_t* queue, task_t* task)
 {
     if (!queue || !task) return -1;
-    
-    pthread_mutex_lock(&queue->queue_lock);
-    
-    // Wait if queue is full
-    while (queue->count >= MAX_PENDING_TASKS) {
-        pthread_cond_wait(&queue->queue_not_full, &queue->queue_lock);
-    }
-    
-    // Copy task to queue
-    memcpy(&queue->tasks[queue->tail], task, sizeof(task_t));
-    queue->tail = (queue->tail + 1) % MAX_PENDING_TASKS;
-    queue->count++;
-    
-    printf("[Task Queue] Pushed task %d (type %d) for tile %d, queue size: %d\n", 
-           task->task_id, task->type, task->assigned_tile, queue->count);
-    
-    // Signal waiting threads
-    pthread_cond_signal(&queue->task_available);
-    pthread_mutex_unlock(&queue->queue_lock);
-    
-    return 0;
+    return mpmc_queue_push(&queue->ring, task);
 }
 
 task_t* task_queue_pop(task_queue_t* queue)
 {
     if (!queue) return NULL;
-    
-    pthread_mutex_lock(&queue->queue_lock);
-    
-    // Wait if queue is empty
-    while (queue->count == 0) {
-        pthread_cond_wait(&queue->task_available, &queue->queue_lock);
-    }
-    
-    // Get task from queue
-    task_t* task = &queue->tasks[queue->head];
-    queue->head = (queue->head + 1) % MAX_PENDING_TASKS;
-    queue->count--;
-    
-    printf("[Task Queue] Popped task %d (type %d) for tile %d, queue size: %d\n", 
-           task->task_id, task->type, task->assigned_tile, queue->count);
-    
-    // Signal waiting threads
-    pthread_cond_signal(&queue->queue_not_full);
-    pthread_mutex_unlock(&queue->queue_lock);
-    
-    return task;
+    return mpmc_queue_pop(&queue->ring);
 }
 
 bool task_queue_is_empty(task_queue_t* queue)
 {
     if (!queue) return true;
-    
-    pthread_mutex_lock(&queue->queue_lock);
-    bool empty = (queue->count == 0);
-    pthread_mutex_unlock(&queue->queue_lock);
-    
-    return empty;
+    return mpmc_queue_size(&queue->ring) == 0;
+}
+
+// Waiters on a task park here, picked by the task's address, so tasks need
+// no mutex or condvar of their own and completing an unwatched task takes
+// no lock at all. The waiter count lives in the slot too: the completer
+// must not touch the task once it is marked completed, since the waiter
+// may free it (or return from the frame holding it) right then.
+#define TASK_PARK_SLOTS 32
+#define TASK_CORO_POLL_US 50    // how often a waiting coroutine looks again
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int waiters;                // parked on any task of this slot
+} task_park[TASK_PARK_SLOTS];
+static pthread_once_t task_park_once = PTHREAD_ONCE_INIT;
+
+static void task_park_init(void)
+{
+    for (int i = 0; i < TASK_PARK_SLOTS; i++) {
+        pthread_mutex_init(&task_park[i].lock, NULL);
+        pthread_cond_init(&task_park[i].cond, NULL);
+    }
+}
+
+static int task_park_slot(const task_t* task)
+{
+    pthread_once(&task_park_once, task_park_init);
+    uintptr_t a = (uintptr_t)task;
+    return (int)((a >> 6) ^ (a >> 12)) & (TASK_PARK_SLOTS - 1);
 }
 
 // STEP 2: HAL Flow and Thread Verification (moved here for accessibility)
@@ -153,7 +125,9 @@ void* tile_processor_main(void* arg)
 {
     tile_core_t* tile = (tile_core_t*)arg;
     
-    printf("[Tile %d] Starting processor thread ...\n", tile->id);
+    LOG_DEBUG("[Tile %d] Starting processor thread ...\n", tile->id);
+    slab_bind_thread(tile->id);     // tasks freed here are reused here
+    placement_bind_tile(g_platform_context, tile->id);  // before anything touches its memory
     
     // Initialize tile state
     pthread_mutex_lock(&tile->state_lock);
@@ -162,12 +136,14 @@ void* tile_processor_main(void* arg)
     tile->tasks_completed = 0;
     tile->task_pending = false;
     tile->current_task = NULL;
+    tile->self = coro_self();
     tile->initialized = true;  // Signal that initialization is complete
     
     // NEW: Initialize interrupt tracking
     tile->interrupts_sent = 0;
     tile->last_interrupt_timestamp = 0;
     pthread_mutex_unlock(&tile->state_lock);
+    c0_notify_event(g_platform_context);
     
     // Update tile statistics with thread ID when thread starts
     pthread_mutex_lock(&stats_lock);
@@ -179,28 +155,37 @@ void* tile_processor_main(void* arg)
     clock_gettime(CLOCK_MONOTONIC, &tile_stats[tile->id].last_execution_time);
     pthread_mutex_unlock(&stats_lock);
     
-    printf("[Tile %d] Processor thread initialized with interrupt support\n", tile->id);
+    LOG_DEBUG("[Tile %d] Processor thread initialized with interrupt support\n", tile->id);
     
     // Tile processor main loop - can execute multiple tasks, but prevents duplicates
     while (true) {
         // Try to get a task from the platform
+        uint64_t seen = task_sched_epoch(&g_tile_sched);
         task_t* task = tile_get_next_task(g_platform_context, tile);
         
         if (task) {
-            printf("[Tile %d] Starting task %d execution\n", tile->id, task->task_id);
+            LOG_DEBUG("[Tile %d] Starting task %d execution\n", tile->id, task->task_id);
             
             // Execute the task
+            task_sched_begin(&g_tile_sched, tile->id - 1);
+            uint64_t start_ns = get_current_timestamp_ns();
             int result = tile_execute_task(tile, task);
+            uint64_t end_ns = get_current_timestamp_ns();
+            task_sched_end(&g_tile_sched, tile->id - 1, end_ns - start_ns);
+            task->start_ns = start_ns;
+            task->end_ns = end_ns;
+            task_prio_record(task);
             
             // NEW: Send task completion interrupt to C0 before completing task
             int irq_result = PLIC_trigger_interrupt(tile->id, 0);  // Send to C0 (hart 0)
             if (irq_result >= 0) {
-                printf("[Tile %d] Sent PLIC task completion interrupt for task %d\n", tile->id, task->task_id);
+                LOG_DEBUG("[Tile %d] Sent PLIC task completion interrupt for task %d\n", tile->id, task->task_id);
                 } else {
-                printf("[Tile %d] Failed to send PLIC interrupt: %d\n", tile->id, irq_result);
+                LOG_ERROR("[Tile %d] Failed to send PLIC interrupt: %d\n", tile->id, irq_result);
             }
             
-            // Complete the task
+            // Complete the task; it may be freed as soon as this returns
+            int task_id = task->task_id;
             tile_complete_task(g_platform_context, tile, task);
             
             // Update tile state after task completion
@@ -211,14 +196,17 @@ void* tile_processor_main(void* arg)
             tile->task_pending = false;
             pthread_mutex_unlock(&tile->state_lock);
             
-            printf("[Tile %d] Completed task %d (result=%d)\n", tile->id, task->task_id, result);
+            LOG_DEBUG("[Tile %d] Completed task %d (result=%d)\n", tile->id, task_id, result);
         } else {
-            // No task available, stay idle
+            // No task available, sleep until one is posted or we are stopped
             pthread_mutex_lock(&tile->state_lock);
             tile->idle = true;
+            bool keep_running = tile->running;
             pthread_mutex_unlock(&tile->state_lock);
             
-            usleep(1000); // 1ms polling interval
+            if (keep_running) {
+                task_sched_wait(&g_tile_sched, seen);
+            }
         }
         
         // Check if we should stop
@@ -234,33 +222,68 @@ void* tile_processor_main(void* arg)
         tile_send_interrupt_to_c0(g_platform_context, tile->id, IRQ_TYPE_SHUTDOWN, 0, "Tile processor shutting down");
     }
     
-    printf("[Tile %d] Processor thread stopping (sent %lu interrupts)...\n", tile->id, tile->interrupts_sent);
+    LOG_DEBUG("[Tile %d] Processor thread stopping (sent %lu interrupts)...\n", tile->id, tile->interrupts_sent);
     return NULL;
 }
 
+static void tile_coro_main(void* arg)
+{
+    tile_processor_main(arg);
+}
+
+static int tile_coro_workers(void)
+{
+    const char* env = getenv("TILE_CORO_WORKERS");
+    int n = env ? atoi(env) : 0;
+    return n > 0 ? n : 0;
+}
+
 // STEP 1: Start tile threads (main thread = C0 master)
 int platform_start_tile_threads(mesh_platform_t* p)
 {
-    printf("[C0 Master] Starting tile processor threads...\n");
+    LOG_INFO("[C0 Master] Starting tile processor threads...\n");
     
     // STEP 2: Set global platform context for tile threads
     g_platform_context = p;
     
     // Initialize platform state
     pthread_mutex_init(&p->platform_lock, NULL);
+    pthread_cond_init(&p->c0_event, NULL);
     p->platform_running = true;
     
     // STEP 2: Initialize task coordination system
-    pthread_mutex_init(&p->task_id_lock, NULL);
     p->next_task_id = 1;
     p->active_tasks = 0;
     p->completed_tasks = 0;
     
     // Initialize task queue
     if (task_queue_init(&p->task_queue) != 0) {
-        printf("[C0 Master] ERROR: Failed to initialize task queue\n");
+        LOG_ERROR("[C0 Master] ERROR: Failed to initialize task queue\n");
+        return -1;
+    }
+    if (slab_init(&p->task_slab, sizeof(task_t), TASK_SLAB_CAPACITY) != 0) {
+        LOG_ERROR("[C0 Master] ERROR: Failed to allocate task slab\n");
+        return -1;
+    }
+    
+    if (task_sched_init(&g_tile_sched, p->node_count - 1) != 0) {
+        LOG_ERROR("[C0 Master] ERROR: Failed to initialize tile scheduler\n");
         return -1;
     }
+    for (int i = 1; i < p->node_count; i++) {
+        task_sched_set_coords(&g_tile_sched, i - 1, p->nodes[i].x, p->nodes[i].y);
+    }
+    
+    int workers = tile_coro_workers();
+    g_tile_coro = 0;
+    if (workers > 0) {
+        if (coro_pool_init_wall(&g_tile_pool, workers, TILE_CORO_STACK) != 0) {
+            LOG_ERROR("[C0 Master] ERROR: Failed to start %d tile coroutine workers\n", workers);
+            return -1;
+        }
+        g_tile_coro = 1;
+        LOG_INFO("[C0 Master] Tiles run as coroutines on %d worker threads\n", workers);
+    }
     
     // Initialize tile threads - SKIP tile 0 (C0 master) but include tiles 1-7
     for (int i = 1; i < p->node_count; i++) {  // i = 1 to 7 (skip only tile 0)
@@ -271,33 +294,47 @@ int platform_start_tile_threads(mesh_platform_t* p)
         tile->running = false;
         tile->initialized = false;
         
-        printf("[C0 Master] Creating processor thread for tile %d...\n", i);
+        LOG_DEBUG("[C0 Master] Creating processor thread for tile %d...\n", i);
         
-        // Create tile thread
-        if (pthread_create(&tile->thread_id, NULL, tile_processor_main, tile) != 0) {
-            printf("[C0 Master] ERROR: Failed to create thread for tile %d\n", i);
+        // Create tile thread, or its coroutine
+        if (g_tile_coro) {
+            if (coro_spawn(&g_tile_pool, tile_coro_main, tile) != 0) {
+                LOG_ERROR("[C0 Master] ERROR: Failed to spawn coroutine for tile %d\n", i);
+                return -1;
+            }
+        } else if (pthread_create(&tile->thread_id, NULL, tile_processor_main, tile) != 0) {
+            LOG_ERROR("[C0 Master] ERROR: Failed to create thread for tile %d\n", i);
             return -1;
         }
     }
     
+    // C0's own memory is placed from the main thread
+    placement_bind_tile(p, 0);
+
     // Wait for tiles 1-7 to initialize (skip only tile 0 = C0 master)
-    printf("[C0 Master] Waiting for tile threads to initialize...\n");
+    LOG_INFO("[C0 Master] Waiting for tile threads to initialize...\n");
     
+    uint64_t start_ns = get_current_timestamp_ns();
+    pthread_mutex_lock(&p->platform_lock);
     for (int i = 1; i < p->node_count; i++) {  // i = 1 to 7
         while (!p->nodes[i].initialized) {
-            usleep(1000);
+            pthread_cond_wait(&p->c0_event, &p->platform_lock);
         }
     }
+    pthread_mutex_unlock(&p->platform_lock);
     
-    printf("[C0 Master] All tile threads initialized successfully!\n");
-    printf("[C0 Master] Task coordination system ready\n");
+    LOG_INFO("[C0 Master] All tile threads initialized successfully in %lu us!\n",
+             (unsigned long)((get_current_timestamp_ns() - start_ns) / 1000));
+    placement_place_dmems(p);
+    placement_report(p);
+    LOG_INFO("[C0 Master] Task coordination system ready\n");
     return 0;
 }
 
 // STEP 1: Stop tile threads
 int platform_stop_tile_threads(mesh_platform_t* p)
 {
-    printf("[C0 Master] Stopping tile processor threads...\n");
+    LOG_INFO("[C0 Master] Stopping tile processor threads...\n");
     
     // Signal tile processor threads (1-7) to stop
     for (int i = 1; i < p->node_count; i++) {  // i = 1 to 7
@@ -305,32 +342,43 @@ int platform_stop_tile_threads(mesh_platform_t* p)
         p->nodes[i].running = false;
         pthread_mutex_unlock(&p->nodes[i].state_lock);
     }
+    task_sched_stop(&g_tile_sched);
     
     // Wait for tile processor threads (1-7) to finish
-    for (int i = 1; i < p->node_count; i++) {  // i = 1 to 7
-        pthread_join(p->nodes[i].thread_id, NULL);
+    if (g_tile_coro) {
+        while (coro_pool_wait(&g_tile_pool, 1000) != 0) {
+            LOG_WARN("[C0 Master] Still waiting for tile coroutines to finish\n");
+        }
+        coro_pool_destroy(&g_tile_pool);
+        g_tile_coro = 0;
+    } else {
+        for (int i = 1; i < p->node_count; i++) {  // i = 1 to 7
+            pthread_join(p->nodes[i].thread_id, NULL);
+        }
     }
     
     // STEP 2: Clean up task system
     task_queue_destroy(&p->task_queue);
-    pthread_mutex_destroy(&p->task_id_lock);
+    slab_destroy(&p->task_slab);
+    task_sched_destroy(&g_tile_sched);
     
     // Clean up mutexes for tiles 1-7
     for (int i = 1; i < p->node_count; i++) {  // i = 1 to 7
         pthread_mutex_destroy(&p->nodes[i].state_lock);
     }
+    pthread_cond_destroy(&p->c0_event);
     pthread_mutex_destroy(&p->platform_lock);
     
     p->platform_running = false;
-    printf("[C0 Master] All tile threads stopped successfully!\n");
-    printf("[C0 Master] Task coordination system cleaned up\n");
+    LOG_INFO("[C0 Master] All tile threads stopped successfully!\n");
+    LOG_INFO("[C0 Master] Task coordination system cleaned up\n");
     return 0;
 }
 
 // STEP 1: C0 master supervision function (executed by main thread)
 void c0_master_supervise_tiles(mesh_platform_t* p)
 {
-    printf("[C0 Master] Supervising tile processors with interrupt handling...\n");
+    LOG_INFO("[C0 Master] Supervising tile processors with interrupt handling...\n");
     
     // Simple supervision - in later steps this will coordinate tasks
     int supervision_cycles = 0;
@@ -340,7 +388,7 @@ void c0_master_supervise_tiles(mesh_platform_t* p)
         // int interrupts_processed = c0_process_pending_interrupts(p);
         int interrupts_processed = c0_process_plic_interrupts(p);
         if (interrupts_processed > 0) {
-            printf("[C0 Master] Processed %d interrupts this cycle\n", interrupts_processed);
+            LOG_DEBUG("[C0 Master] Processed %d interrupts this cycle\n", interrupts_processed);
         }
         
         // Check tile status for processor tiles (1-7)
@@ -362,20 +410,35 @@ void c0_master_supervise_tiles(mesh_platform_t* p)
             pthread_mutex_unlock(&p->nodes[i].state_lock);
         }
         
-        printf("[C0 Master] Supervision cycle %d: %d processor tiles active, %d idle, %d tasks completed, %lu interrupts sent\n", 
+        LOG_INFO("[C0 Master] Supervision cycle %d: %d processor tiles active, %d idle, %d tasks completed, %lu interrupts sent\n", 
                supervision_cycles + 1, active_tiles, idle_tiles, total_completed_tasks, total_interrupts_sent);
         
         // NEW: Print interrupt controller statistics
         if (p->plic_enabled) {
-            printf("[C0 Master] PLIC interrupts processed: %lu\n",
+            LOG_INFO("[C0 Master] PLIC interrupts processed: %lu\n",
                    p->plic_interrupts_processed);
         }
         
-        usleep(200000); // 200ms supervision interval
         supervision_cycles++;
+        
+        // Nothing left to watch once every tile is idle with no work queued;
+        // otherwise sleep until a tile reports something or the interval ends
+        if (idle_tiles == active_tiles && task_sched_pending(&g_tile_sched) == 0) {
+            break;
+        }
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += 200 * 1000000L;   // 200ms supervision interval
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        pthread_mutex_lock(&p->platform_lock);
+        pthread_cond_timedwait(&p->c0_event, &p->platform_lock, &deadline);
+        pthread_mutex_unlock(&p->platform_lock);
     }
     
-    printf("[C0 Master] Supervision complete\n");
+    LOG_INFO("[C0 Master] Supervision complete\n");
 }
 
 // Function to print atomic banner for main validation header
@@ -396,8 +459,7 @@ static void print_validation_banner(const char *msg)
         msg, padding, "");
     
     // Single atomic write
-    fputs(complete_banner, stdout);
-    fflush(stdout);
+    LOG_INFO("%s", complete_banner);
 }
 
 // Function to print atomic banner for section headers
@@ -418,8 +480,7 @@ static void print_section_banner(const char *msg)
         msg, padding, "");
     
     // Single atomic write
-    fputs(complete_banner, stdout);
-    fflush(stdout);
+    LOG_INFO("%s", complete_banner);
 }
 
 // Function to print atomic banner for reports
@@ -439,8 +500,7 @@ static void print_report_banner(const char *msg)
         msg, padding, "");
     
     // Single atomic write
-    fputs(complete_banner, stdout);
-    fflush(stdout);
+    LOG_INFO("%s", complete_banner);
 }
 
 // Function to print atomic end banner for reports
@@ -457,8 +517,7 @@ static void print_end_banner(const char *msg)
         "\n");
     
     // Single atomic write
-    fputs(complete_banner, stdout);
-    fflush(stdout);
+    LOG_INFO("%s", complete_banner);
 }
 
 // Enhanced test runner with main thread as C0 master
@@ -468,12 +527,12 @@ void c0_run_test_suite(mesh_platform_t* platform)
     
     // STEP 1: Start tile processor threads (main thread becomes C0 master)
     if (platform_start_tile_threads(platform) == 0) {
-        printf("[C0 Master] Platform running with tile processors and task system!\n");
+        LOG_INFO("[C0 Master] Platform running with tile processors and task system!\n");
         
         // CONFIRM PLIC is enabled
         platform->plic_enabled = true;
         platform->plic_interrupts_processed = 0;
-        printf("[C0 Master] PLIC interrupt system active\n");
+        LOG_INFO("[C0 Master] PLIC interrupt system active\n");
         
             // Register default interrupt handlers
         // c0_register_interrupt_handler(platform, IRQ_TYPE_TASK_COMPLETE, default_task_complete_handler);
@@ -484,18 +543,18 @@ void c0_run_test_suite(mesh_platform_t* platform)
             
             // Enable interrupt processing for entire test suite
         platform->plic_enabled = true;
-            printf("[C0 Master] Interrupt system enabled - tiles can now send interrupts to C0\n");
+            LOG_INFO("[C0 Master] Interrupt system enabled - tiles can now send interrupts to C0\n");
         
         // C0 master supervises the platform (with interrupts enabled)
         c0_master_supervise_tiles(platform);
         
         // STEP 2: Run HAL tests distributed across tiles (with interrupts still enabled)
-        printf("[C0 Master] Executing HAL tests...\n");
+        LOG_INFO("[C0 Master] Executing HAL tests...\n");
         c0_run_hal_tests_distributed(platform);
         
         // NEW: Process any remaining interrupts after tests
         if (platform->plic_enabled) {
-            printf("[C0 Master] Processing final interrupts...\n");
+            LOG_INFO("[C0 Master] Processing final interrupts...\n");
             // int final_interrupts = c0_process_pending_interrupts(platform);
             // if (final_interrupts > 0) {
             //     printf("[C0 Master] Processed %d final interrupts\n", final_interrupts);
@@ -503,36 +562,30 @@ void c0_run_test_suite(mesh_platform_t* platform)
             
             // Print final interrupt statistics
             print_report_banner("FINAL INTERRUPT SYSTEM STATISTICS");
-            printf("C0 Interrupt Controller:\n");
-            printf("  - Total PLIC Interrupts Processed: %lu\n", platform->plic_interrupts_processed);
+            LOG_INFO("C0 Interrupt Controller:\n");
+            LOG_INFO("  - Total PLIC Interrupts Processed: %lu\n", platform->plic_interrupts_processed);
             
-            printf("\nTile Interrupt Statistics:\n");
+            LOG_INFO("\nTile Interrupt Statistics:\n");
             for (int i = 1; i < platform->node_count; i++) {
-                printf("  - Tile %d: %lu interrupts sent\n", i, platform->nodes[i].interrupts_sent);
+                LOG_INFO("  - Tile %d: %lu interrupts sent\n", i, platform->nodes[i].interrupts_sent);
             }
             print_end_banner("END INTERRUPT STATISTICS");
             
             // Disable interrupt processing and cleanup
             platform->plic_enabled = false;
             // c0_interrupt_controller_destroy(&platform->interrupt_controller);
-            printf("[C0 Master] Interrupt system shutdown complete\n");
+            LOG_INFO("[C0 Master] Interrupt system shutdown complete\n");
         }
         
         // STEP 1: Stop tile processor threads
         platform_stop_tile_threads(platform);
     } else {
-        printf("[C0 Master] ERROR: Failed to start tile threads, running in single-threaded mode\n");
+        LOG_ERROR("[C0 Master] ERROR: Failed to start tile threads, running in single-threaded mode\n");
     run_all_tests(platform);
     }
 }
 
 // STEP 2: Enhanced task storage for tile-specific assignment
-static task_t hal_task_storage[MAX_PENDING_TASKS];
-static int hal_task_storage_count = 0;
-static pthread_mutex_t hal_task_storage_lock = PTHREAD_MUTEX_INITIALIZER;
-
-// STEP 2: Atomic printing session lock for complete statement sequences
-static pthread_mutex_t print_session_lock = PTHREAD_MUTEX_INITIALIZER;
 
 // Function to log HAL call flow verification
 void verify_hal_call_flow(int tile_id, const char* test_name, const char* hal_function, const char* driver_function) {
@@ -544,9 +597,8 @@ void verify_hal_call_flow(int tile_id, const char* test_name, const char* hal_fu
     
     pthread_mutex_unlock(&stats_lock);
     
-    printf("[HAL-FLOW] Tile %d: Test '%s' → HAL '%s' → Driver '%s'\n", 
+    LOG_DEBUG("[HAL-FLOW] Tile %d: Test '%s' → HAL '%s' → Driver '%s'\n", 
            tile_id, test_name, hal_function, driver_function);
-    fflush(stdout);
 }
 
 // Function to update tile execution statistics
@@ -567,13 +619,13 @@ void print_execution_verification() {
     pthread_mutex_lock(&stats_lock);
     
     print_report_banner("EXECUTION VERIFICATION REPORT");
-    printf("+------+--------------+-----------+-------------+----------------------+\n");
-    printf("| Tile | Thread ID    | Tasks Exec| HAL Calls   | Last Test            |\n");
-    printf("+------+--------------+-----------+-------------+----------------------+\n");
+    LOG_INFO("+------+--------------+-----------+-------------+----------------------+\n");
+    LOG_INFO("| Tile | Thread ID    | Tasks Exec| HAL Calls   | Last Test            |\n");
+    LOG_INFO("+------+--------------+-----------+-------------+----------------------+\n");
     
     // Show all tiles 0-7
     for (int i = 0; i < 8; i++) {
-        printf("| %4d | %12lu | %9d | %11d | %-20s |\n",
+        LOG_INFO("| %4d | %12lu | %9d | %11d | %-20s |\n",
                tile_stats[i].tile_id,
                (unsigned long)tile_stats[i].thread_id,
                tile_stats[i].tasks_executed,
@@ -581,61 +633,98 @@ void print_execution_verification() {
                tile_stats[i].last_test_name[0] ? tile_stats[i].last_test_name : "None");
     }
     
-    printf("+------+--------------+-----------+-------------+----------------------+\n");
+    LOG_INFO("+------+--------------+-----------+-------------+----------------------+\n");
     
     // Verify each tile 1-7 has processor threads (tile 0 is C0 master)
-    printf("\nTHREAD ASSIGNMENT VERIFICATION:\n");
-    printf("Tile 0: Reserved for C0 Master (no processor thread needed)\n");
+    LOG_INFO("\nTHREAD ASSIGNMENT VERIFICATION:\n");
+    LOG_INFO("Tile 0: Reserved for C0 Master (no processor thread needed)\n");
     
     int active_tiles = 0;
     for (int i = 1; i <= 7; i++) {
         if (tile_stats[i].thread_id > 0) {
-            printf("Tile %d: ACTIVE (Thread %lu executed %d tasks)\n",
+            LOG_INFO("Tile %d: ACTIVE (Thread %lu executed %d tasks)\n",
                    i, (unsigned long)tile_stats[i].thread_id, tile_stats[i].tasks_executed);
             active_tiles++;
         } else {
-            printf("Tile %d: INACTIVE (No processor thread created)\n", i);
+            LOG_INFO("Tile %d: INACTIVE (No processor thread created)\n", i);
         }
     }
     
-    printf("\nHAL FLOW VERIFICATION:\n");
+    LOG_INFO("\nHAL FLOW VERIFICATION:\n");
     int hal_active_tiles = 0;
     for (int i = 1; i <= 7; i++) {
         if (tile_stats[i].hal_calls_made > 0) {
-            printf("Tile %d: HAL FLOW VERIFIED (%d HAL calls made)\n",
+            LOG_INFO("Tile %d: HAL FLOW VERIFIED (%d HAL calls made)\n",
                    i, tile_stats[i].hal_calls_made);
             hal_active_tiles++;
         } else if (tile_stats[i].thread_id > 0) {
-            printf("Tile %d: PROCESSOR THREAD ACTIVE (no HAL tasks assigned yet)\n", i);
+            LOG_INFO("Tile %d: PROCESSOR THREAD ACTIVE (no HAL tasks assigned yet)\n", i);
         } else {
-            printf("Tile %d: NO HAL FLOW DETECTED\n", i);
+            LOG_INFO("Tile %d: NO HAL FLOW DETECTED\n", i);
         }
     }
     
-    printf("\nSUMMARY:\n");
-    printf("- Processor Tiles (1-7): %d/7 active\n", active_tiles);
-    printf("- HAL Flow Verified: %d/7 tiles\n", hal_active_tiles);
-    printf("- Tile 0: C0 Master (main thread)\n");
-    printf("- All 7 processor threads available for task distribution\n");
+    LOG_INFO("\nSUMMARY:\n");
+    LOG_INFO("- Processor Tiles (1-7): %d/7 active\n", active_tiles);
+    LOG_INFO("- HAL Flow Verified: %d/7 tiles\n", hal_active_tiles);
+    LOG_INFO("- Tile 0: C0 Master (main thread)\n");
+    LOG_INFO("- All 7 processor threads available for task distribution\n");
     print_end_banner("END VERIFICATION REPORT");
     
     pthread_mutex_unlock(&stats_lock);
 }
 
-// Function to begin atomic print session (blocks other threads from printing)
+// HAL tests run concurrently on the tiles. Every test holds the state lock
+// shared, HAL_SHARES_ALL ones exclusively; the others also hold the lock of
+// each scratch resource they use, taken in bit order
+#define HAL_SHARED_RESOURCES 2
+static pthread_rwlock_t hal_test_state_lock = PTHREAD_RWLOCK_INITIALIZER;
+static pthread_mutex_t hal_test_resource_lock[HAL_SHARED_RESOURCES] = {
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER
+};
+
+static void hal_test_acquire(unsigned shares)
+{
+    // Coroutine wait points: a tile coroutine waiting here lets the others
+    // on its worker run, and they are plain locks on a tile thread
+    if (shares == HAL_SHARES_ALL) {
+        coro_rwlock_lock(&hal_test_state_lock, 1);
+        return;
+    }
+    coro_rwlock_lock(&hal_test_state_lock, 0);
+    for (int i = 0; i < HAL_SHARED_RESOURCES; i++) {
+        if (shares & (1u << i)) {
+            coro_mutex_lock(&hal_test_resource_lock[i]);
+        }
+    }
+}
+
+static void hal_test_release(unsigned shares)
+{
+    if (shares != HAL_SHARES_ALL) {
+        for (int i = HAL_SHARED_RESOURCES - 1; i >= 0; i--) {
+            if (shares & (1u << i)) {
+                coro_mutex_unlock(&hal_test_resource_lock[i]);
+            }
+        }
+    }
+    coro_rwlock_unlock(&hal_test_state_lock);
+}
+
+// Function to begin a print session: the task's output is captured per
+// tile and written as one block at the end, other tiles keep running
 void begin_print_session(int tile_id, const char* task_name) {
-    pthread_mutex_lock(&print_session_lock);
+    log_capture_begin();
     // Build entire banner in memory first for atomic printing
     char session_banner[1000];
     snprintf(session_banner, sizeof(session_banner),
         "===================================================================\n"
         "[Tile %d] Starting %s - Print Session BEGIN\n"
         "===================================================================\n", tile_id, task_name);
-    fputs(session_banner, stdout);
-    fflush(stdout);
+    LOG_INFO("%s", session_banner);
 }
 
-// Function to end atomic print session (allows other threads to print)
+// Function to end a print session and emit the captured output
 void end_print_session(int tile_id, const char* task_name, int result) {
     // Build entire banner in memory first for atomic printing
     char end_banner[1000];
@@ -644,22 +733,16 @@ void end_print_session(int tile_id, const char* task_name, int result) {
         "[Tile %d] %s Completed: %s - Print Session END\n"
         "===================================================================\n\n", 
         tile_id, task_name, result ? "PASS" : "FAIL");
-    fputs(end_banner, stdout);
-    fflush(stdout);
-    pthread_mutex_unlock(&print_session_lock);
+    LOG_INFO("%s", end_banner);
+    log_capture_end();
 }
 
-// Main thread safe printing - respects ongoing print sessions
+// Main thread printing - one log record per call, no print lock
 void main_thread_print(const char* format, ...) {
-    pthread_mutex_lock(&print_session_lock);
-    
     va_list args;
     va_start(args, format);
-    vprintf(format, args);
+    log_vwrite(LOG_LEVEL_INFO, format, args);
     va_end(args);
-    fflush(stdout);
-    
-    pthread_mutex_unlock(&print_session_lock);
 }
 
 task_t* create_hal_test_task(mesh_platform_t* p, 
@@ -671,42 +754,19 @@ task_t* create_hal_test_task(mesh_platform_t* p,
         return NULL;
     }
     
-    // Get unique task ID
-    pthread_mutex_lock(&p->task_id_lock);
-    int task_id = p->next_task_id++;
-    pthread_mutex_unlock(&p->task_id_lock);
-    
-    // Use static task storage (simple allocation)
-    pthread_mutex_lock(&hal_task_storage_lock);
-    if (hal_task_storage_count >= MAX_PENDING_TASKS) {
-        pthread_mutex_unlock(&hal_task_storage_lock);
+    task_t* task = c0_create_task(p, TASK_TYPE_HAL_TEST, 0);
+    if (!task) {
         return NULL;
     }
     
-    task_t* task = &hal_task_storage[hal_task_storage_count];
-    hal_task_storage_count++;
-    pthread_mutex_unlock(&hal_task_storage_lock);
-    
-    // Initialize task
-    memset(task, 0, sizeof(task_t));
-    task->task_id = task_id;
-    task->type = TASK_TYPE_HAL_TEST;
-    task->assigned_tile = -1; // Will be assigned when queued
-    task->completed = false;
-    task->taken = false;  // Initialize taken flag
-    task->result = 0;
-    
     // Set HAL test parameters
     task->params.hal_test.test_func = test_func;
     task->params.hal_test.test_name = test_name;
     task->params.hal_test.platform = p;
     task->params.hal_test.result_ptr = result_ptr;
+    task->params.hal_test.shares = 0;
     
-    // Initialize synchronization
-    pthread_mutex_init(&task->task_lock, NULL);
-    pthread_cond_init(&task->task_complete, NULL);
-    
-    printf("[C0 Master] Created HAL test task %d: '%s'\n", task_id, test_name);
+    LOG_DEBUG("[C0 Master] Created HAL test task %d: '%s'\n", task->task_id, test_name);
     return task;
 }
 
@@ -715,38 +775,42 @@ int queue_task_to_available_tile(mesh_platform_t* p, task_t* task)
     if (!p || !task) {
         return -1;
     }
-    
-    // Round-robin assignment to tiles 1-7 (excluding tile 0 = C0 master)
-    static int next_tile = 1; // Start from tile 1, not tile 0
-    int target_tile = next_tile;
-    next_tile++;
-    if (next_tile >= p->node_count) {
-        next_tile = 1; // Wrap back to tile 1, skip tile 0
+    return queue_task_to_tile(p, task, 0);
+}
+
+int queue_task_to_tile(mesh_platform_t* p, task_t* task, int tile)
+{
+    if (!p || !task) {
+        return -1;
     }
     
+    // The requested tile if valid, otherwise wherever the placement policy
+    // puts it among tiles 1-7 (tile 0 = C0 master); idle tiles steal from
+    // busy ones anyway
+    int target_tile = tile;
+    if (target_tile <= 0 || target_tile >= p->node_count) {
+        target_tile = task_place_choose(p, &g_tile_sched, task);
+    }
     task->assigned_tile = target_tile;
+    if (!task->graph) {
+        task->ready_ns = get_current_timestamp_ns();  // graphs stamp their own
+    }
     
     // Increment active task count
     pthread_mutex_lock(&p->platform_lock);
     p->active_tasks++;
     pthread_mutex_unlock(&p->platform_lock);
     
-    printf("[C0 Master] HAL test task %d '%s' assigned to tile %d (tile 0 reserved for C0 master)\n", 
-           task->task_id, task->params.hal_test.test_name, target_tile);
+    LOG_DEBUG("[C0 Master] Task %d '%s' assigned to tile %d (tile 0 reserved for C0 master)\n", 
+           task->task_id, c0_task_name(task), target_tile);
     
-    // Store task in static storage for tile-specific retrieval
-    pthread_mutex_lock(&hal_task_storage_lock);
-    if (hal_task_storage_count < MAX_PENDING_TASKS) {
-        hal_task_storage[hal_task_storage_count] = *task;
-        
-        // CRITICAL: Also mark the original task as taken to prevent duplicate execution
-        task->taken = true;
-        task->assigned_tile = -999;  // Invalidate original to prevent re-use
-        
-        hal_task_storage_count++;
+    if (task_sched_submit_class(&g_tile_sched, target_tile - 1, task, task_prio_class(task),
+                                task->deadline_ns) != 0) {
+        pthread_mutex_lock(&p->platform_lock);
+        p->active_tasks--;
+        pthread_mutex_unlock(&p->platform_lock);
+        return -1;
     }
-    pthread_mutex_unlock(&hal_task_storage_lock);
-    
     return 0;
 }
 
@@ -756,7 +820,7 @@ int wait_for_all_tasks_completion(mesh_platform_t* p, int expected_count)
         return -1;
     }
     
-    printf("[C0 Master] Waiting for %d HAL test tasks to complete (with interrupt processing)...\n", expected_count);
+    LOG_INFO("[C0 Master] Waiting for %d HAL test tasks to complete (with interrupt processing)...\n", expected_count);
     
     int completed = 0;
     int total_interrupts_processed = 0;
@@ -772,19 +836,18 @@ int wait_for_all_tasks_completion(mesh_platform_t* p, int expected_count)
             // }
         }
         
-        // Check completion status
+        // Sleep until a tile completes a task or raises an interrupt
         pthread_mutex_lock(&p->platform_lock);
+        if (p->completed_tasks == completed && completed < expected_count) {
+            pthread_cond_wait(&p->c0_event, &p->platform_lock);
+        }
         completed = p->completed_tasks;
         pthread_mutex_unlock(&p->platform_lock);
-        
-        if (completed < expected_count) {
-            usleep(10000); // 10ms check interval
-        }
     }
     
-    printf("[C0 Master] All %d HAL test tasks completed!\n", expected_count);
+    LOG_INFO("[C0 Master] All %d HAL test tasks completed!\n", expected_count);
     if (total_interrupts_processed > 0) {
-        printf("[C0 Master] Processed %d total interrupts during task execution\n", total_interrupts_processed);
+        LOG_INFO("[C0 Master] Processed %d total interrupts during task execution\n", total_interrupts_processed);
     }
     return 0;
 }
@@ -802,6 +865,51 @@ static int hal_test_dma_remote_transfer_wrapper(void* p) {
     extern int test_dma_remote_transfer(mesh_platform_t* p);
     return test_dma_remote_transfer((mesh_platform_t*)p); 
 }
+static int hal_test_dma_fill_engine_wrapper(void* p) {
+    extern int test_dma_fill_engine(mesh_platform_t* p);
+    return test_dma_fill_engine((mesh_platform_t*)p);
+}
+static int hal_test_dma_peer_transfer_wrapper(void* p) {
+    extern int test_dma_peer_transfer(mesh_platform_t* p);
+    return test_dma_peer_transfer((mesh_platform_t*)p);
+}
+static int hal_test_dma_stream_pipeline_wrapper(void* p) {
+    extern int test_dma_stream_pipeline(mesh_platform_t* p);
+    return test_dma_stream_pipeline((mesh_platform_t*)p);
+}
+static int hal_test_hal_batch_wrapper(void* p) {
+    extern int test_hal_batch(mesh_platform_t* p);
+    return test_hal_batch((mesh_platform_t*)p);
+}
+static int hal_test_memory_views_wrapper(void* p) {
+    extern int test_memory_views(mesh_platform_t* p);
+    return test_memory_views((mesh_platform_t*)p);
+}
+static int hal_test_hal_ring_wrapper(void* p) {
+    extern int test_hal_ring(mesh_platform_t* p);
+    return test_hal_ring((mesh_platform_t*)p);
+}
+static int hal_test_async_logging_wrapper(void* p) {
+    extern int test_async_logging(mesh_platform_t* p);
+    return test_async_logging((mesh_platform_t*)p);
+}
+static int hal_test_work_stealing_wrapper(void* p) {
+    extern int test_work_stealing(mesh_platform_t* p);
+    return test_work_stealing((mesh_platform_t*)p);
+}
+
+static int hal_test_task_queue_wrapper(void* p) {
+    extern int test_task_queue(mesh_platform_t* p);
+    return test_task_queue((mesh_platform_t*)p);
+}
+static int hal_test_tile_placement_wrapper(void* p) {
+    extern int test_tile_placement(mesh_platform_t* p);
+    return test_tile_placement((mesh_platform_t*)p);
+}
+static int hal_test_hal_compare_wrapper(void* p) {
+    extern int test_hal_compare(mesh_platform_t* p);
+    return test_hal_compare((mesh_platform_t*)p);
+}
 static int hal_test_c0_gather_wrapper(void* p) { 
     extern int test_c0_gather(mesh_platform_t* p);
     return test_c0_gather((mesh_platform_t*)p); 
@@ -818,6 +926,18 @@ static int hal_test_noc_latency_wrapper(void* p) {
     extern int test_noc_latency(mesh_platform_t* p);
     return test_noc_latency((mesh_platform_t*)p); 
 }
+static int hal_test_hal_scaling_wrapper(void* p) {
+    extern int test_hal_scaling(mesh_platform_t* p);
+    return test_hal_scaling((mesh_platform_t*)p);
+}
+static int hal_test_hal_dispatch_wrapper(void* p) {
+    extern int test_hal_dispatch(mesh_platform_t* p);
+    return test_hal_dispatch((mesh_platform_t*)p);
+}
+static int hal_test_hal_stats_wrapper(void* p) {
+    extern int test_hal_stats(mesh_platform_t* p);
+    return test_hal_stats((mesh_platform_t*)p);
+}
 static int hal_test_random_dma_remote_wrapper(void* p) { 
     extern int test_random_dma_remote(mesh_platform_t* p);
     return test_random_dma_remote((mesh_platform_t*)p); 
@@ -872,71 +992,129 @@ static int hal_test_dmem_alignment_testing_wrapper(void* p) {
 
 // ---------------------DMEM----TESTS------------------------------------------------
 
+static int hal_test_mem_ops_kernels_wrapper(void* p) {
+    extern int test_mem_ops_kernels(mesh_platform_t* p);
+    return test_mem_ops_kernels((mesh_platform_t*)p);
+}
+
+
+// Makespan against the ideal of the total work spread evenly over the tiles
+static void print_schedule_report(mesh_platform_t* p, uint64_t makespan_ns)
+{
+    int tiles = p->node_count - 1;
+    uint64_t work_ns = 0, steals = 0;
+    main_thread_print("[Sched] Tile  Tasks  Stolen  Busy(ms)\n");
+    for (int i = 0; i < tiles; i++) {
+        task_sched_stats_t st;
+        task_sched_get_stats(&g_tile_sched, i, &st);
+        work_ns += st.busy_ns;
+        steals += st.stolen;
+        main_thread_print("[Sched] %4d  %5lu  %6lu  %8.1f\n", i + 1, (unsigned long)st.executed,
+                          (unsigned long)st.stolen, st.busy_ns / 1e6);
+    }
+    double ideal_ms = work_ns / 1e6 / tiles;
+    main_thread_print("[Sched] Makespan %.1f ms, work %.1f ms over %d tiles (ideal %.1f ms, %.2fx), %lu steals\n",
+                      makespan_ns / 1e6, work_ns / 1e6, tiles, ideal_ms,
+                      ideal_ms > 0 ? makespan_ns / 1e6 / ideal_ms : 0.0, (unsigned long)steals);
+}
 
 void c0_run_hal_tests_distributed(mesh_platform_t* platform)
 {
     print_section_banner("Running Tests: C0 Master + Distributed HAL");
     
     // STEP 1: Run C0 Master tests on main thread (these are C0 coordination tasks)
-    printf("[C0 Master] Executing C0 Master coordination tests...\n");
+    LOG_INFO("[C0 Master] Executing C0 Master coordination tests...\n");
     extern int test_c0_gather(mesh_platform_t* p);
     extern int test_c0_distribute(mesh_platform_t* p);
     extern int test_parallel_c0_access(mesh_platform_t* p);
+    extern int test_c0_task_graph(mesh_platform_t* p);
+    extern int test_c0_task_pool(mesh_platform_t* p);
+    extern int test_c0_task_placement(mesh_platform_t* p);
+    extern int test_c0_task_exec(mesh_platform_t* p);
+    extern int test_c0_coroutine_tiles(mesh_platform_t* p);
+    extern int test_c0_sim_determinism(mesh_platform_t* p);
+    extern int test_c0_task_priority(mesh_platform_t* p);
     
     int c0_gather_result = test_c0_gather(platform);
     int c0_distribute_result = test_c0_distribute(platform);
     int parallel_c0_result = test_parallel_c0_access(platform);  // Run on C0 main thread
+    int task_graph_result = test_c0_task_graph(platform);         // needs idle tiles
+    int task_pool_result = test_c0_task_pool(platform);
+    int task_place_result = test_c0_task_placement(platform);
+    int task_exec_result = test_c0_task_exec(platform);
+    int coro_result = test_c0_coroutine_tiles(platform);
+    int sim_result = test_c0_sim_determinism(platform);
+    int prio_result = test_c0_task_priority(platform);
 
     // int c0_gather_result = 1;
     // int c0_distribute_result = 1;
     // int parallel_c0_result = 1;
     
-    printf("[C0 Master] C0 Master tests completed:\n");
-    printf("[C0 Master] - C0 Gather: %s\n", c0_gather_result ? "PASS" : "FAIL");
-    printf("[C0 Master] - C0 Distribute: %s\n", c0_distribute_result ? "PASS" : "FAIL");
-    printf("[C0 Master] - Parallel C0 Access: %s\n", parallel_c0_result ? "PASS" : "FAIL");
-    printf("\n");
+    LOG_INFO("[C0 Master] C0 Master tests completed:\n");
+    LOG_INFO("[C0 Master] - C0 Gather: %s\n", c0_gather_result ? "PASS" : "FAIL");
+    LOG_INFO("[C0 Master] - C0 Distribute: %s\n", c0_distribute_result ? "PASS" : "FAIL");
+    LOG_INFO("[C0 Master] - Parallel C0 Access: %s\n", parallel_c0_result ? "PASS" : "FAIL");
+    LOG_INFO("[C0 Master] - C0 Task Graph: %s\n", task_graph_result ? "PASS" : "FAIL");
+    LOG_INFO("[C0 Master] - C0 Task Pool: %s\n", task_pool_result ? "PASS" : "FAIL");
+    LOG_INFO("[C0 Master] - C0 Task Placement: %s\n", task_place_result ? "PASS" : "FAIL");
+    LOG_INFO("[C0 Master] - C0 Task Executors: %s\n", task_exec_result ? "PASS" : "FAIL");
+    LOG_INFO("[C0 Master] - C0 Coroutine Tiles: %s\n", coro_result ? "PASS" : "FAIL");
+    LOG_INFO("[C0 Master] - C0 Simulated Time: %s\n", sim_result ? "PASS" : "FAIL");
+    LOG_INFO("[C0 Master] - C0 Task Priority: %s\n", prio_result ? "PASS" : "FAIL");
+    LOG_INFO("\n");
     
     // STEP 2: Run HAL tests distributed across tile processors IN PARALLEL
-    printf("[C0 Master] Executing HAL tests in parallel across tile processors...\n");
+    LOG_INFO("[C0 Master] Executing HAL tests in parallel across tile processors...\n");
     
     // Test function table using wrapper functions (excluding C0 tests and Parallel C0 Access)
     struct {
         int (*func)(void*);
         const char* name;
         int result;
+        int home_tile;      // tile whose memory the test works on, 0 for none
+        unsigned shares;    // HAL_SHARES_* resources it uses
     } hal_tests[] = {
-        {hal_test_cpu_local_move_wrapper, "CPU Local Move", 0},
-        {hal_test_dma_local_transfer_wrapper, "DMA Local Transfer", 0},
-        {hal_test_dma_remote_transfer_wrapper, "DMA Remote Transfer", 0},
-        {hal_test_noc_bandwidth_wrapper, "NoC Bandwidth", 0},
-        {hal_test_noc_latency_wrapper, "NoC Latency", 0},
-        {hal_test_random_dma_remote_wrapper, "Random DMA Remote", 0},
+        {hal_test_cpu_local_move_wrapper, "CPU Local Move", 0, 0, HAL_SHARES_TILE0_DLM1},
+        {hal_test_dma_local_transfer_wrapper, "DMA Local Transfer", 0, 1, 0},
+        {hal_test_dma_remote_transfer_wrapper, "DMA Remote Transfer", 0, 0, HAL_SHARES_DMEM},
+        {hal_test_dma_fill_engine_wrapper, "DMA Fill Engine", 0, 0, 0},
+        {hal_test_dma_peer_transfer_wrapper, "DMA Peer Transfer", 0, 0, 0},
+        {hal_test_dma_stream_pipeline_wrapper, "DMA Stream Pipeline", 0, 4, 0},
+        {hal_test_hal_batch_wrapper, "HAL Batch", 0, 0, 0},
+        {hal_test_memory_views_wrapper, "Memory Views", 0, 7, 0},
+        {hal_test_hal_ring_wrapper, "HAL SQ/CQ Ring", 0, 0, 0},
+        {hal_test_noc_bandwidth_wrapper, "NoC Bandwidth", 0, 0, HAL_SHARES_TILE0_DLM1},
+        {hal_test_noc_latency_wrapper, "NoC Latency", 0, 0, HAL_SHARES_TILE0_DLM1 | HAL_SHARES_DMEM},
+        {hal_test_hal_scaling_wrapper, "HAL Scaling", 0, 0, HAL_SHARES_ALL},
+        {hal_test_hal_dispatch_wrapper, "HAL Dispatch", 0, 0, 0},
+        {hal_test_hal_stats_wrapper, "HAL Call Stats", 0, 0, HAL_SHARES_ALL},
+        {hal_test_hal_compare_wrapper, "HAL Compare", 0, 3, HAL_SHARES_ALL},
+        {hal_test_async_logging_wrapper, "Async Logging", 0, 0, HAL_SHARES_ALL},
+        {hal_test_work_stealing_wrapper, "Work Stealing", 0, 0, 0},
+        {hal_test_task_queue_wrapper, "Task Queue", 0, 0, 0},
+        {hal_test_tile_placement_wrapper, "Tile Placement", 0, 0, 0},
+        {hal_test_random_dma_remote_wrapper, "Random DMA Remote", 0, 0, HAL_SHARES_TILE0_DLM1 | HAL_SHARES_DMEM},
         // Parallel C0 Access is now run on C0 main thread, not distributed
 
         // ----------DMEM--TESTS----------------------------------
-        {hal_test_dmem_basic_functionality_wrapper, "DMEM-Basic-Functionality", 0},
-        {hal_test_dmem_large_transfers_wrapper, "DMEM-Large-Transfers", 0},
-        {hal_test_dmem_address_validation_wrapper, "DMEM-Address-Validation", 0},
-        {hal_test_dmem_data_integrity_wrapper, "DMEM-Data-Integrity", 0},
-        {hal_test_dmem_concurrent_access_wrapper, "DMEM-Concurrent-Access", 0},
-        {hal_test_dmem_boundary_conditions_wrapper, "DMEM-Boundary-Conditions", 0},
-        {hal_test_dmem_error_handling_wrapper, "DMEM-Error-Handling", 0},
-        {hal_test_dmem_performance_basic_wrapper, "DMEM-Performance-Basic", 0},
-        {hal_test_dmem_cross_module_transfers_wrapper, "DMEM-Cross-Module-Transfers", 0},
-        {hal_test_dmem_alignment_testing_wrapper, "DMEM-Alignment-Testing", 0},
+        {hal_test_dmem_basic_functionality_wrapper, "DMEM-Basic-Functionality", 0, 0, HAL_SHARES_DMEM},
+        {hal_test_dmem_large_transfers_wrapper, "DMEM-Large-Transfers", 0, 0, HAL_SHARES_DMEM},
+        {hal_test_dmem_address_validation_wrapper, "DMEM-Address-Validation", 0, 0, HAL_SHARES_DMEM},
+        {hal_test_dmem_data_integrity_wrapper, "DMEM-Data-Integrity", 0, 0, HAL_SHARES_DMEM},
+        {hal_test_dmem_concurrent_access_wrapper, "DMEM-Concurrent-Access", 0, 0, HAL_SHARES_DMEM},
+        {hal_test_dmem_boundary_conditions_wrapper, "DMEM-Boundary-Conditions", 0, 0, HAL_SHARES_DMEM},
+        {hal_test_dmem_error_handling_wrapper, "DMEM-Error-Handling", 0, 0, HAL_SHARES_DMEM},
+        {hal_test_dmem_performance_basic_wrapper, "DMEM-Performance-Basic", 0, 0, HAL_SHARES_DMEM},
+        {hal_test_dmem_cross_module_transfers_wrapper, "DMEM-Cross-Module-Transfers", 0, 0, HAL_SHARES_DMEM},
+        {hal_test_dmem_alignment_testing_wrapper, "DMEM-Alignment-Testing", 0, 0, HAL_SHARES_DMEM},
         // ----------DMEM---TESTS-------------------------------------------------
+
+        {hal_test_mem_ops_kernels_wrapper, "MemOps-Kernel-Variants", 0, 0, HAL_SHARES_ALL},
     
     };
     
     int num_hal_tests = sizeof(hal_tests) / sizeof(hal_tests[0]);
     
-    // Reset task storage for new test run
-    pthread_mutex_lock(&hal_task_storage_lock);
-    hal_task_storage_count = 0;
-    memset(hal_task_storage, 0, sizeof(hal_task_storage));
-    pthread_mutex_unlock(&hal_task_storage_lock);
-    
     // Reset completion counter for parallel execution
     pthread_mutex_lock(&platform->platform_lock);
     platform->completed_tasks = 0;
@@ -945,21 +1123,44 @@ void c0_run_hal_tests_distributed(mesh_platform_t* platform)
     
     // Create and queue ALL HAL test tasks for parallel execution
     main_thread_print("[C0 Master] Creating %d HAL test tasks for parallel execution...\n", num_hal_tests);
+    int num_queued = num_hal_tests;
+    task_t* hal_tasks[sizeof(hal_tests) / sizeof(hal_tests[0])] = {0};
+    task_sched_reset_stats(&g_tile_sched);
+    uint64_t run_start_ns = get_current_timestamp_ns();
     for (int i = 0; i < num_hal_tests; i++) {
         task_t* task = create_hal_test_task(platform, hal_tests[i].func, 
                                            hal_tests[i].name, &hal_tests[i].result);
         if (task) {
-            queue_task_to_available_tile(platform, task);
+            task->home_tile = hal_tests[i].home_tile;
+            task->params.hal_test.shares = hal_tests[i].shares;
+            if (queue_task_to_available_tile(platform, task) != 0) {
+                main_thread_print("[C0 Master] ERROR: Failed to queue task for %s\n", hal_tests[i].name);
+                hal_tests[i].result = 0;
+                num_queued--;
+                c0_free_task(platform, task);
+            } else {
+                hal_tasks[i] = task;
+            }
         } else {
             main_thread_print("[C0 Master] ERROR: Failed to create task for %s\n", hal_tests[i].name);
             hal_tests[i].result = 0;
+            num_queued--;
         }
     }
     
     // Wait for ALL HAL tests to complete in parallel
-    main_thread_print("[C0 Master] Waiting for all %d HAL test tasks to complete in parallel...\n", num_hal_tests);
-    wait_for_all_tasks_completion(platform, num_hal_tests);
+    main_thread_print("[C0 Master] Waiting for all %d HAL test tasks to complete in parallel...\n", num_queued);
+    wait_for_all_tasks_completion(platform, num_queued);
+    uint64_t makespan_ns = get_current_timestamp_ns() - run_start_ns;
+    for (int i = 0; i < num_hal_tests; i++) {
+        // The completion count moves just before each task is released
+        if (hal_tasks[i] && c0_wait_for_task(hal_tasks[i], 1000) == 0) {
+            c0_free_task(platform, hal_tasks[i]);
+        }
+    }
     main_thread_print("[C0 Master] All parallel HAL test tasks completed!\n");
+    print_schedule_report(platform, makespan_ns);
+    task_prio_print();
     
     // Print results
     main_thread_print("\n");
@@ -967,6 +1168,14 @@ void c0_run_hal_tests_distributed(mesh_platform_t* platform)
     main_thread_print("[C0 Master] C0 Master Tests (Main Thread):\n");
     main_thread_print("[C0 Master] - C0 Gather: %s\n", c0_gather_result ? "PASS" : "FAIL");
     main_thread_print("[C0 Master] - C0 Distribute: %s\n", c0_distribute_result ? "PASS" : "FAIL");
+    main_thread_print("[C0 Master] - Parallel C0 Access: %s\n", parallel_c0_result ? "PASS" : "FAIL");
+    main_thread_print("[C0 Master] - C0 Task Graph: %s\n", task_graph_result ? "PASS" : "FAIL");
+    main_thread_print("[C0 Master] - C0 Task Pool: %s\n", task_pool_result ? "PASS" : "FAIL");
+    main_thread_print("[C0 Master] - C0 Task Placement: %s\n", task_place_result ? "PASS" : "FAIL");
+    main_thread_print("[C0 Master] - C0 Task Executors: %s\n", task_exec_result ? "PASS" : "FAIL");
+    main_thread_print("[C0 Master] - C0 Coroutine Tiles: %s\n", coro_result ? "PASS" : "FAIL");
+    main_thread_print("[C0 Master] - C0 Simulated Time: %s\n", sim_result ? "PASS" : "FAIL");
+    main_thread_print("[C0 Master] - C0 Task Priority: %s\n", prio_result ? "PASS" : "FAIL");
     
     int hal_passed = 0;
     main_thread_print("[C0 Master] HAL Tests (Parallel Distribution to Tile Processors):\n");
@@ -975,9 +1184,25 @@ void c0_run_hal_tests_distributed(mesh_platform_t* platform)
         main_thread_print("[C0 Master] - %s: %s\n", hal_tests[i].name, hal_tests[i].result ? "PASS" : "FAIL");
     }
     
-    int total_passed = c0_gather_result + c0_distribute_result + parallel_c0_result + hal_passed;
-    int total_tests = 3 + num_hal_tests;
+    int total_passed = c0_gather_result + c0_distribute_result + parallel_c0_result + task_graph_result + task_pool_result +
+                       task_place_result + task_exec_result + coro_result + sim_result +
+                       prio_result + hal_passed;
+    int total_tests = 10 + num_hal_tests;
     main_thread_print("\033[1m[C0 Master] Overall Summary: %d/%d tests passed\033[0m\n", total_passed, total_tests);
+
+    noc_stats_t noc_stats;
+    noc_get_stats(&noc_stats);
+    main_thread_print("[C0 Master] NoC traffic: %lu packets (%lu tile-to-tile), %lu bytes, %lu hop-bytes\n",
+                      (unsigned long)noc_stats.packets, (unsigned long)noc_stats.peer_packets,
+                      (unsigned long)noc_stats.bytes, (unsigned long)noc_stats.hop_bytes);
+    if (placement_enabled()) {
+        main_thread_print("[C0 Master] NoC traffic across host NUMA nodes: %lu packets, %lu bytes (%.1f%%)\n",
+                          (unsigned long)noc_stats.cross_node_packets, (unsigned long)noc_stats.cross_node_bytes,
+                          noc_stats.bytes ? 100.0 * noc_stats.cross_node_bytes / noc_stats.bytes : 0.0);
+    }
+    if (hal_stats_enabled()) {
+        hal_stats_print();
+    }
     print_section_banner("Test Execution Complete");
     
     // Print comprehensive verification report
@@ -991,33 +1216,21 @@ task_t* tile_get_next_task(mesh_platform_t* p, tile_core_t* tile)
         return NULL;
     }
     
-    // Search through static task storage for tasks assigned to this tile
-    pthread_mutex_lock(&hal_task_storage_lock);
-    
-    task_t* assigned_task = NULL;
-    
-    // Look for an unstarted task assigned to this tile
-    for (int i = 0; i < hal_task_storage_count; i++) {
-        task_t* task = &hal_task_storage[i];
-        
-        // STRICT CHECK: Only allow task retrieval if ALL conditions are met
-        if (task->assigned_tile == tile->id && 
-            !task->completed && 
-            !task->taken &&  // Check taken flag
-            task->task_id > 0) {  // Ensure task is valid
-            
-            // IMMEDIATELY mark as taken AND invalidate task_id to prevent race conditions
-            task->taken = true;  // Set taken flag
-            task->assigned_tile = -999;  // Invalidate assignment to prevent re-retrieval
-            assigned_task = task;
-            break;
-        }
+    int stolen = 0;
+    task_t* task = task_sched_next(&g_tile_sched, tile->id - 1, &stolen);
+    if (!task) {
+        return NULL;
     }
     
-    pthread_mutex_unlock(&hal_task_storage_lock);
+    if (stolen) {
+        LOG_DEBUG("[Tile %d] Stole task %d '%s' from tile %d\n",
+                  tile->id, task->task_id, c0_task_name(task), task->assigned_tile);
+    }
+    task->taken = true;
+    task->assigned_tile = tile->id;
     
     // Don't print here - will be printed inside atomic session
-    return assigned_task;
+    return task;
 }
 
 int tile_execute_task(tile_core_t* tile, task_t* task)
@@ -1041,17 +1254,19 @@ int tile_execute_task(tile_core_t* tile, task_t* task)
             // Update execution statistics BEFORE starting
             update_tile_execution_stats(tile->id, pthread_self(), task->params.hal_test.test_name);
             
-            // BEGIN ATOMIC PRINT SESSION - blocks other threads from printing
+            hal_test_acquire(task->params.hal_test.shares);
+
+            // BEGIN PRINT SESSION - output is buffered until the test ends
             begin_print_session(tile->id, task->params.hal_test.test_name);
             
-            // Execute real HAL test function within atomic print session
-            printf("[Tile %d] Executing HAL test: %s\n", tile->id, task->params.hal_test.test_name);
+            // Execute real HAL test function within the print session
+            LOG_DEBUG("[Tile %d] Executing HAL test: %s\n", tile->id, task->params.hal_test.test_name);
             
             if (task->params.hal_test.test_func && task->params.hal_test.platform) {
                 // Log HAL flow verification before calling test
                 verify_hal_call_flow(tile->id, task->params.hal_test.test_name, "hal_reference", "hardware_driver");
                 
-                printf("[HAL-CALL] Tile %d: Calling HAL test function for '%s'\n", tile->id, task->params.hal_test.test_name);
+                LOG_DEBUG("[HAL-CALL] Tile %d: Calling HAL test function for '%s'\n", tile->id, task->params.hal_test.test_name);
                 
                 // Call the HAL test function with platform parameter
                 result = task->params.hal_test.test_func(task->params.hal_test.platform);
@@ -1060,61 +1275,44 @@ int tile_execute_task(tile_core_t* tile, task_t* task)
                 if (task->params.hal_test.result_ptr) {
                     *(task->params.hal_test.result_ptr) = result;
                 } else {
-                    printf("[Tile %d] ERROR - result_ptr is NULL!\n", tile->id);
+                    LOG_ERROR("[Tile %d] ERROR - result_ptr is NULL!\n", tile->id);
                 }
                 
-                printf("[HAL-RESULT] Tile %d: HAL test '%s' returned result: %d\n", 
+                LOG_DEBUG("[HAL-RESULT] Tile %d: HAL test '%s' returned result: %d\n", 
                        tile->id, task->params.hal_test.test_name, result);
-                printf("[Tile %d] HAL test '%s' completed with result: %s\n", 
+                LOG_INFO("[Tile %d] HAL test '%s' completed with result: %s\n", 
                        tile->id, task->params.hal_test.test_name, result ? "PASS" : "FAIL");
-                printf("[Tile %d] Task %d completed with result: %d\n", 
+                LOG_DEBUG("[Tile %d] Task %d completed with result: %d\n", 
                        tile->id, task->task_id, result);
             } else {
-                printf("[Tile %d] ERROR: Invalid HAL test parameters\n", tile->id);
+                LOG_ERROR("[Tile %d] ERROR: Invalid HAL test parameters\n", tile->id);
                 result = 0;
             }
             
-            // END ATOMIC PRINT SESSION - allows other threads to print
+            // END PRINT SESSION - the whole test's output goes out as one block
             end_print_session(tile->id, task->params.hal_test.test_name, result);
+            hal_test_release(task->params.hal_test.shares);
             break;
             
-        case TASK_TYPE_MEMORY_COPY:
-            // Simple memory operation simulation
-            printf("[Tile %d] [Placeholder] Executing memory copy task...\n", tile->id);
-            usleep(5000); // 5ms simulated work
-            result = 256; // Simulate 256 bytes copied
+        case TASK_TYPE_CALLBACK:
+            // Graph stages and other short C0 work items; these run outside
+            // the print session so a test body can wait on them
+            LOG_DEBUG("[Tile %d] Executing task %d '%s'\n", tile->id, task->task_id, task->params.callback.name);
+            result = task->params.callback.func(task->params.callback.arg);
             break;
             
+        case TASK_TYPE_MEMORY_COPY:
         case TASK_TYPE_DMA_TRANSFER:
-            // DMA transfer simulation
-            printf("[Tile %d][Placeholder] Executing DMA transfer task...\n", tile->id);
-            usleep(8000); // 8ms simulated work
-            result = (int)task->params.memory_op.size;
-            break;
-            
-        case TASK_TYPE_COMPUTATION:
-            // Computation simulation
-            printf("[Tile %d][Placeholder]Executing computation task...\n", tile->id);
-            usleep(15000); // 15ms simulated work
-            result = 1; // Success
-            break;
-            
         case TASK_TYPE_NOC_TRANSFER:
-            // NoC transfer simulation
-            printf("[Tile %d][Placeholder] Executing NoC transfer task...\n", tile->id);
-            usleep(10000); // 10ms simulated work
-            result = (int)task->params.memory_op.size;
-            break;
-            
-        case TASK_TYPE_TEST_EXECUTION:
-            // Test execution simulation
-            printf("[Tile %d][Placeholder] Executing test task %d...\n", tile->id, task->params.test_exec.test_id);
-            usleep(12000); // 12ms simulated work
-            result = 1; // Success
+        case TASK_TYPE_COMPUTATION:
+            // Real data movement / kernels over memory_op (task_exec.c)
+            LOG_DEBUG("[Tile %d] Executing %s task %d, %zu bytes\n", tile->id, c0_task_name(task),
+                      task->task_id, task->params.memory_op.size);
+            result = task_exec_memory_op(tile, task);
             break;
             
         default:
-            printf("[Tile %d] Unknown task type %d\n", tile->id, task->type);
+            LOG_ERROR("[Tile %d] Unknown task type %d\n", tile->id, task->type);
             result = -1;
             break;
     }
@@ -1131,11 +1329,12 @@ int tile_complete_task(mesh_platform_t* p, tile_core_t* tile, task_t* task)
         return -1;
     }
     
-    // Mark task as completed
-    pthread_mutex_lock(&task->task_lock);
-    task->completed = true;
-    pthread_cond_signal(&task->task_complete);
-    pthread_mutex_unlock(&task->task_lock);
+    // Hand ready successors to the scheduler first, the data they need was
+    // just produced on this tile
+    struct task_graph* graph = task->graph;
+    if (graph) {
+        task_graph_release_successors(p, task, tile->id);
+    }
     
     // Update tile state
     pthread_mutex_lock(&tile->state_lock);
@@ -1148,12 +1347,166 @@ int tile_complete_task(mesh_platform_t* p, tile_core_t* tile, task_t* task)
     pthread_mutex_lock(&p->platform_lock);
     p->completed_tasks++;
     p->active_tasks--;
+    pthread_cond_broadcast(&p->c0_event);
     pthread_mutex_unlock(&p->platform_lock);
     
+    // Mark task as completed last: a waiter in c0_wait_for_task may go on
+    // to reset the platform counters
+    c0_task_set_completed(task);
+    
+    if (graph) {
+        task_graph_retire(p, graph);
+    }
+    
     // Don't print here - completion message is already inside atomic session
     return 0;
 }
 
+int c0_init_callback_task(mesh_platform_t* p, task_t* task, int (*func)(void*), void* arg, const char* name)
+{
+    if (!p || !task || !func) {
+        return -1;
+    }
+    
+    memset(task, 0, sizeof(task_t));
+    task->task_id = __atomic_fetch_add(&p->next_task_id, 1, __ATOMIC_RELAXED);
+    task->type = TASK_TYPE_CALLBACK;
+    task->assigned_tile = -1;
+    task->params.callback.func = func;
+    task->params.callback.arg = arg;
+    task->params.callback.name = name ? name : "callback";
+    return 0;
+}
+
+task_t* c0_create_task(mesh_platform_t* p, task_type_t type, int target_tile)
+{
+    if (!p) {
+        return NULL;
+    }
+    task_t* task = slab_alloc(&p->task_slab);
+    if (!task) {
+        return NULL;
+    }
+    
+    memset(task, 0, sizeof(task_t));
+    task->task_id = __atomic_fetch_add(&p->next_task_id, 1, __ATOMIC_RELAXED);
+    task->type = type;
+    task->assigned_tile = -1;
+    task->home_tile = target_tile;
+    return task;
+}
+
+void c0_free_task(mesh_platform_t* p, task_t* task)
+{
+    if (p && task) {
+        slab_free(&p->task_slab, task);
+    }
+}
+
+int c0_queue_task(mesh_platform_t* p, task_t* task)
+{
+    return queue_task_to_available_tile(p, task);
+}
+
+void c0_task_set_completed(task_t* task)
+{
+    // Store then load, both seq_cst, against fetch_add then load in
+    // c0_wait_for_task: either the waiter sees completed or we see it.
+    // Waiters on other tasks of the slot at worst get a spurious wakeup.
+    int slot = task_park_slot(task);
+    __atomic_store_n(&task->completed, true, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&task_park[slot].waiters, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&task_park[slot].lock);
+        pthread_cond_broadcast(&task_park[slot].cond);
+        pthread_mutex_unlock(&task_park[slot].lock);
+    }
+}
+
+int c0_init_memory_task(mesh_platform_t* p, task_t* task, task_type_t type, uint64_t src_addr,
+                        uint64_t dst_addr, size_t size)
+{
+    if (!p || !task || (type != TASK_TYPE_MEMORY_COPY && type != TASK_TYPE_DMA_TRANSFER &&
+                        type != TASK_TYPE_NOC_TRANSFER && type != TASK_TYPE_COMPUTATION)) {
+        return -1;
+    }
+    
+    memset(task, 0, sizeof(task_t));
+    task->task_id = __atomic_fetch_add(&p->next_task_id, 1, __ATOMIC_RELAXED);
+    task->type = type;
+    task->assigned_tile = -1;
+    task->params.memory_op.src_addr = src_addr;
+    task->params.memory_op.dst_addr = dst_addr;
+    task->params.memory_op.size = size;
+    return 0;
+}
+
+const char* c0_task_name(const task_t* task)
+{
+    switch (task->type) {
+        case TASK_TYPE_HAL_TEST: return task->params.hal_test.test_name;
+        case TASK_TYPE_CALLBACK: return task->params.callback.name;
+        case TASK_TYPE_MEMORY_COPY: return "memory copy";
+        case TASK_TYPE_DMA_TRANSFER: return "dma transfer";
+        case TASK_TYPE_COMPUTATION: return "computation";
+        case TASK_TYPE_NOC_TRANSFER: return "noc transfer";
+        default: return "unknown";
+    }
+}
+
+void c0_notify_event(mesh_platform_t* p)
+{
+    if (!p) {
+        return;
+    }
+    pthread_mutex_lock(&p->platform_lock);
+    pthread_cond_broadcast(&p->c0_event);
+    pthread_mutex_unlock(&p->platform_lock);
+}
+
+int c0_wait_for_task(task_t* task, int timeout_ms)
+{
+    if (!task) {
+        return -1;
+    }
+    
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    
+    if (__atomic_load_n(&task->completed, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    
+    // Tile program coroutines poll so their worker keeps running the others
+    if (coro_active()) {
+        uint64_t until = get_current_timestamp_ns() + (uint64_t)timeout_ms * 1000000ULL;
+        while (!__atomic_load_n(&task->completed, __ATOMIC_ACQUIRE)) {
+            if (get_current_timestamp_ns() >= until) {
+                return -1;
+            }
+            coro_sleep_us(TASK_CORO_POLL_US);
+        }
+        return 0;
+    }
+    
+    int slot = task_park_slot(task);
+    int rc = 0;
+    __atomic_fetch_add(&task_park[slot].waiters, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_lock(&task_park[slot].lock);
+    while (!__atomic_load_n(&task->completed, __ATOMIC_SEQ_CST) && rc == 0) {
+        rc = pthread_cond_timedwait(&task_park[slot].cond, &task_park[slot].lock, &deadline);
+    }
+    bool completed = __atomic_load_n(&task->completed, __ATOMIC_ACQUIRE);
+    pthread_mutex_unlock(&task_park[slot].lock);
+    __atomic_fetch_sub(&task_park[slot].waiters, 1, __ATOMIC_RELAXED);
+    return completed ? 0 : -1;
+}
+
 // ============================================================================
 // NEW: INTERRUPT SYSTEM IMPLEMENTATION
 // ============================================================================
@@ -1177,7 +1530,7 @@ int c0_interrupt_controller_init(c0_interrupt_controller_t* ctrl) {
         return -1;
     }
     
-    printf("[C0-IRQ] Interrupt controller initialized\n");
+    LOG_INFO("[C0-IRQ] Interrupt controller initialized\n");
     return 0;
 }
 
@@ -1190,7 +1543,7 @@ int c0_interrupt_controller_destroy(c0_interrupt_controller_t* ctrl) {
     pthread_mutex_destroy(&ctrl->irq_lock);
     pthread_cond_destroy(&ctrl->irq_available);
     
-    printf("[C0-IRQ] Interrupt controller destroyed\n");
+    LOG_INFO("[C0-IRQ] Interrupt controller destroyed\n");
     return 0;
 }
 
@@ -1271,9 +1624,10 @@ int tile_send_interrupt_to_c0(mesh_platform_t* p, int tile_id, interrupt_type_t
     if (result == 0) {
         p->nodes[tile_id].interrupts_sent++;
         p->nodes[tile_id].last_interrupt_timestamp = irq.timestamp;
-        printf("[TILE-%d] Sent %s interrupt to C0 via NoC\n", tile_id, get_irq_type_name(type));
+        c0_notify_event(p);
+        LOG_DEBUG("[TILE-%d] Sent %s interrupt to C0 via NoC\n", tile_id, get_irq_type_name(type));
     } else {
-        printf("[TILE-%d] Failed to send interrupt to C0\n", tile_id);
+        LOG_ERROR("[TILE-%d] Failed to send interrupt to C0\n", tile_id);
     }
     
     return result;
@@ -1382,7 +1736,7 @@ int tile_signal_dma_complete(mesh_platform_t* p, int tile_id, uint32_t transfer_
 int default_task_complete_handler(interrupt_request_t* irq, void* platform_context) {
     mesh_platform_t* p = (mesh_platform_t*)platform_context;
     
-    printf("[C0-IRQ-HANDLER] Task %u completed on tile %d: %s\n",
+    LOG_DEBUG("[C0-IRQ-HANDLER] Task %u completed on tile %d: %s\n",
            irq->data, irq->source_tile, irq->message);
     
     // Update platform task counters
@@ -1397,7 +1751,7 @@ int default_task_complete_handler(interrupt_request_t* irq, void* platform_conte
 }
 
 int default_error_handler(interrupt_request_t* irq, void* platform_context) {
-    printf("[C0-IRQ-HANDLER] ERROR on tile %d (code=0x%x): %s\n",
+    LOG_ERROR("[C0-IRQ-HANDLER] ERROR on tile %d (code=0x%x): %s\n",
            irq->source_tile, irq->data, irq->message);
     
     // Could trigger error recovery or tile restart
@@ -1405,13 +1759,13 @@ int default_error_handler(interrupt_request_t* irq, void* platform_context) {
 }
 
 int default_dma_complete_handler(interrupt_request_t* irq, void* platform_context) {
-    printf("[C0-IRQ-HANDLER] DMA transfer %u completed on tile %d: %s\n",
+    LOG_DEBUG("[C0-IRQ-HANDLER] DMA transfer %u completed on tile %d: %s\n",
            irq->data, irq->source_tile, irq->message);
     return 0;
 }
 
 int default_resource_request_handler(interrupt_request_t* irq, void* platform_context) {
-    printf("[C0-IRQ-HANDLER] Resource request %u from tile %d: %s\n",
+    LOG_DEBUG("[C0-IRQ-HANDLER] Resource request %u from tile %d: %s\n",
            irq->data, irq->source_tile, irq->message);
     
     // Could implement resource allocation logic here
@@ -1421,7 +1775,7 @@ int default_resource_request_handler(interrupt_request_t* irq, void* platform_co
 int default_shutdown_handler(interrupt_request_t* irq, void* platform_context) {
     mesh_platform_t* p = (mesh_platform_t*)platform_context;
     
-    printf("[C0-IRQ-HANDLER] Shutdown request from tile %d: %s\n",
+    LOG_DEBUG("[C0-IRQ-HANDLER] Shutdown request from tile %d: %s\n",
            irq->source_tile, irq->message);
     
     // Could trigger graceful tile shutdown
@@ -1437,53 +1791,53 @@ int c0_process_plic_interrupts(mesh_platform_t* platform) {
     uint32_t target_local;
     plic_select(0, &plic, &target_local);  // C0 is hart 0
     
-    printf("[C0-PLIC] Hart 0: plic=%p, target_local=%d\n", plic, target_local);
+    LOG_DEBUG("[C0-PLIC] Hart 0: plic=%p, target_local=%d\n", plic, target_local);
     
     if (!plic) {
-        printf("[C0-PLIC] No PLIC instance for hart 0\n");
+        LOG_ERROR("[C0-PLIC] No PLIC instance for hart 0\n");
         return 0;
     }
     
     // Check for pending interrupts first
-    printf("[C0-PLIC] Checking for pending interrupts...\n");
+    LOG_DEBUG("[C0-PLIC] Checking for pending interrupts...\n");
     for (int source = 32; source <= 40; source++) {  // Check around our expected source ID
         int pending = PLIC_N_source_pending_read((PLIC_RegDef*)plic, source);
         if (pending) {
-            printf("[C0-PLIC] Source %d is pending!\n", source);
+            LOG_DEBUG("[C0-PLIC] Source %d is pending!\n", source);
         }
     }
     
     // Check if target 0 is enabled for source 33
     int target_enabled = PLIC_M_TAR_read((PLIC_RegDef*)plic, target_local, 33);
-    printf("[C0-PLIC] Target %d enabled for source 33: %s\n", target_local, target_enabled ? "YES" : "NO");
+    LOG_DEBUG("[C0-PLIC] Target %d enabled for source 33: %s\n", target_local, target_enabled ? "YES" : "NO");
     
     // Check threshold for target 0
     int threshold = PLIC_M_TAR_thre_read((PLIC_RegDef*)plic, target_local);
-    printf("[C0-PLIC] Target %d threshold: %d\n", target_local, threshold);
+    LOG_DEBUG("[C0-PLIC] Target %d threshold: %d\n", target_local, threshold);
     
     // Check priority of source 33
-    printf("[C0-PLIC] Checking source 33 priority...\n");
+    LOG_DEBUG("[C0-PLIC] Checking source 33 priority...\n");
     // Access priority register directly - the priority is in sprio_regs[source-1]
     uint32_t priority_reg_value = ((PLIC_RegDef*)plic)->sprio_regs[33-1];
-    printf("[C0-PLIC] Source 33 priority register value: %d\n", priority_reg_value);
+    LOG_DEBUG("[C0-PLIC] Source 33 priority register value: %d\n", priority_reg_value);
     
     // Claim any pending interrupts
     uint32_t claim_id = PLIC_M_TAR_claim_read(plic, target_local);
-    printf("[C0-PLIC] Claim attempt returned: %d\n", claim_id);
+    LOG_DEBUG("[C0-PLIC] Claim attempt returned: %d\n", claim_id);
     while (claim_id > 0) {
-        printf("[C0-PLIC] Claimed interrupt source ID %d\n", claim_id);
+        LOG_DEBUG("[C0-PLIC] Claimed interrupt source ID %d\n", claim_id);
         
         // Determine which tile sent this (based on PLIC source ID calculation)
         // source_id = SOURCE_BASE_ID + target_local_idx * SLOT_PER_TARGET + source_hart_id
         // For your platform: source_id = 32 + 0 * 8 + source_hart_id = 32 + source_hart_id
         if (claim_id >= SOURCE_BASE_ID && claim_id < SOURCE_BASE_ID + NR_HARTS) {
             uint32_t source_hart = claim_id - SOURCE_BASE_ID;
-            printf("[C0-PLIC] Received interrupt from hart %d\n", source_hart);
+            LOG_DEBUG("[C0-PLIC] Received interrupt from hart %d\n", source_hart);
             
             // Handle the interrupt (task complete, error, etc.)
             handle_plic_interrupt_from_tile(platform, source_hart, claim_id);
         } else {
-            printf("[C0-PLIC] Unknown interrupt source ID %d\n", claim_id);
+            LOG_ERROR("[C0-PLIC] Unknown interrupt source ID %d\n", claim_id);
         }
         
         // Complete the interrupt (required by PLIC)
@@ -1504,36 +1858,36 @@ void handle_plic_interrupt_from_tile(mesh_platform_t* platform, uint32_t source_
     platform->completed_tasks++;
     pthread_mutex_unlock(&platform->platform_lock);
     
-    printf("[C0-PLIC] Hart %d completed a task\n", source_hart);
+    LOG_DEBUG("[C0-PLIC] Hart %d completed a task\n", source_hart);
 }
 
 void test_plic_functionality(mesh_platform_t* platform) {
-    printf("[PLIC-TEST] Testing PLIC interrupt system...\n");
+    LOG_INFO("[PLIC-TEST] Testing PLIC interrupt system...\n");
     
     // Calculate the expected source ID for debugging
     uint32_t target_local_idx = 0;  // Hart 0 is target
     uint32_t source_hart_id = 1;    // Hart 1 is source
     uint32_t expected_source_id = SOURCE_BASE_ID + target_local_idx * SLOT_PER_TARGET + source_hart_id;
-    printf("[PLIC-TEST] Expected source ID: %d (BASE=%d + target_idx=%d * SLOT=%d + source=%d)\n",
+    LOG_INFO("[PLIC-TEST] Expected source ID: %d (BASE=%d + target_idx=%d * SLOT=%d + source=%d)\n",
            expected_source_id, SOURCE_BASE_ID, target_local_idx, SLOT_PER_TARGET, source_hart_id);
     
     // Enable hart 0 to receive interrupts from the calculated source ID
-    printf("[PLIC-TEST] Enabling hart 0 to receive source ID %d...\n", expected_source_id);
+    LOG_INFO("[PLIC-TEST] Enabling hart 0 to receive source ID %d...\n", expected_source_id);
     PLIC_enable_interrupt(expected_source_id, 0);
     PLIC_set_priority(expected_source_id, 0, 2);
     
     // Test hart 1 sending interrupt to hart 0
     int result = PLIC_trigger_interrupt(1, 0);
-    printf("[PLIC-TEST] Trigger result: %d\n", result);
+    LOG_INFO("[PLIC-TEST] Trigger result: %d\n", result);
     
     // Process the interrupt
     int processed = c0_process_plic_interrupts(platform);
-    printf("[PLIC-TEST] Processed %d interrupts\n", processed);
+    LOG_INFO("[PLIC-TEST] Processed %d interrupts\n", processed);
     
     if (processed > 0) {
-        printf("[PLIC-TEST] ✓ PLIC is working!\n");
+        LOG_INFO("[PLIC-TEST] ✓ PLIC is working!\n");
     } else {
-        printf("[PLIC-TEST] ✗ PLIC not receiving interrupts\n");
+        LOG_INFO("[PLIC-TEST] ✗ PLIC not receiving interrupts\n");
     }
 }
 
@@ -1547,14 +1901,14 @@ int c0_process_enhanced_plic_interrupts(mesh_platform_t* platform) {
     plic_select(0, &plic, &target_local);  // C0 is hart 0
     
     if (!plic) {
-        printf("[C0-PLIC] No PLIC instance for hart 0\n");
+        LOG_ERROR("[C0-PLIC] No PLIC instance for hart 0\n");
         return 0;
     }
     
     // Claim any pending interrupts
     uint32_t claim_id = PLIC_M_TAR_claim_read(plic, target_local);
     while (claim_id > 0) {
-        printf("[C0-PLIC] Claimed interrupt source ID %d\n", claim_id);
+        LOG_DEBUG("[C0-PLIC] Claimed interrupt source ID %d\n", claim_id);
         
         // Decode the interrupt using the enhanced source ID calculation
         uint32_t source_hart = 0;
@@ -1568,16 +1922,16 @@ int c0_process_enhanced_plic_interrupts(mesh_platform_t* platform) {
             irq_type = (irq_source_id_t)(offset % 32);
             
             if (source_hart < NR_HARTS) {
-                printf("[C0-PLIC] Enhanced decode: Hart %d sent %s interrupt\n", 
+                LOG_DEBUG("[C0-PLIC] Enhanced decode: Hart %d sent %s interrupt\n", 
                        source_hart, get_interrupt_type_name(irq_type));
                        
                 handle_enhanced_plic_interrupt(platform, source_hart, irq_type, claim_id);
             } else {
-                printf("[C0-PLIC] Invalid source hart %d decoded from source ID %d\n", 
+                LOG_ERROR("[C0-PLIC] Invalid source hart %d decoded from source ID %d\n", 
                        source_hart, claim_id);
             }
         } else {
-            printf("[C0-PLIC] Legacy or system interrupt source ID %d\n", claim_id);
+            LOG_DEBUG("[C0-PLIC] Legacy or system interrupt source ID %d\n", claim_id);
         }
         
         // Complete the interrupt (required by PLIC)
@@ -1609,7 +1963,7 @@ const char* get_interrupt_type_name(irq_source_id_t irq_type) {
 // Enhanced interrupt handler that can respond appropriately to different interrupt types
 void handle_enhanced_plic_interrupt(mesh_platform_t* platform, uint32_t source_hart, 
                                    irq_source_id_t irq_type, uint32_t source_id) {
-    printf("[C0-PLIC] Handling %s interrupt from hart %d\n", 
+    LOG_DEBUG("[C0-PLIC] Handling %s interrupt from hart %d\n", 
            get_interrupt_type_name(irq_type), source_hart);
     
     switch (irq_type) {
@@ -1621,31 +1975,31 @@ void handle_enhanced_plic_interrupt(mesh_platform_t* platform, uint32_t source_h
                 platform->active_tasks--;
             }
             pthread_mutex_unlock(&platform->platform_lock);
-            printf("[C0-PLIC] Task completed on hart %d\n", source_hart);
+            LOG_DEBUG("[C0-PLIC] Task completed on hart %d\n", source_hart);
             break;
             
         case IRQ_ERROR_REPORT:
-            printf("[C0-PLIC] ERROR reported by hart %d - investigating...\n", source_hart);
+            LOG_ERROR("[C0-PLIC] ERROR reported by hart %d - investigating...\n", source_hart);
             // Could trigger error recovery or restart procedures
             break;
             
         case IRQ_SYNC_REQUEST:
-            printf("[C0-PLIC] Sync request from hart %d - sending response...\n", source_hart);
+            LOG_DEBUG("[C0-PLIC] Sync request from hart %d - sending response...\n", source_hart);
             // Send a sync response back to the requesting hart
             PLIC_trigger_typed_interrupt(0, source_hart, IRQ_SYNC_RESPONSE);
             break;
             
         case IRQ_SHUTDOWN_REQUEST:
-            printf("[C0-PLIC] Shutdown request from hart %d - initiating graceful shutdown...\n", source_hart);
+            LOG_INFO("[C0-PLIC] Shutdown request from hart %d - initiating graceful shutdown...\n", source_hart);
             // Could trigger platform shutdown procedures
             break;
             
         case IRQ_DMA_COMPLETE:
-            printf("[C0-PLIC] DMA transfer completed on hart %d\n", source_hart);
+            LOG_DEBUG("[C0-PLIC] DMA transfer completed on hart %d\n", source_hart);
             break;
             
         default:
-            printf("[C0-PLIC] Standard interrupt from hart %d\n", source_hart);
+            LOG_DEBUG("[C0-PLIC] Standard interrupt from hart %d\n", source_hart);
             // Default handling for legacy interrupts
             pthread_mutex_lock(&platform->platform_lock);
             platform->completed_tasks++;
@@ -1656,46 +2010,46 @@ void handle_enhanced_plic_interrupt(mesh_platform_t* platform, uint32_t source_h
 
 // Demo function showing bidirectional communication capabilities
 void demo_bidirectional_plic_communication(mesh_platform_t* platform) {
-    printf("\n[PLIC-DEMO] === Bidirectional PLIC Communication Demo ===\n");
+    LOG_INFO("\n[PLIC-DEMO] === Bidirectional PLIC Communication Demo ===\n");
     
     // 1. Processing node -> C0 communication (existing pattern)
-    printf("\n[PLIC-DEMO] 1. Processing node -> C0 communication:\n");
+    LOG_INFO("\n[PLIC-DEMO] 1. Processing node -> C0 communication:\n");
     
-    printf("[PLIC-DEMO] Hart 1 sends TASK_COMPLETE to Hart 0...\n");
+    LOG_INFO("[PLIC-DEMO] Hart 1 sends TASK_COMPLETE to Hart 0...\n");
     int result1 = PLIC_trigger_typed_interrupt(1, 0, IRQ_TASK_COMPLETE);
-    printf("[PLIC-DEMO] Trigger result: %d\n", result1);
+    LOG_INFO("[PLIC-DEMO] Trigger result: %d\n", result1);
     
-    printf("[PLIC-DEMO] Hart 2 sends ERROR_REPORT to Hart 0...\n");
+    LOG_INFO("[PLIC-DEMO] Hart 2 sends ERROR_REPORT to Hart 0...\n");
     int result2 = PLIC_trigger_typed_interrupt(2, 0, IRQ_ERROR_REPORT);
-    printf("[PLIC-DEMO] Trigger result: %d\n", result2);
+    LOG_INFO("[PLIC-DEMO] Trigger result: %d\n", result2);
     
-    printf("[PLIC-DEMO] Hart 3 sends SYNC_REQUEST to Hart 0...\n");
+    LOG_INFO("[PLIC-DEMO] Hart 3 sends SYNC_REQUEST to Hart 0...\n");
     int result3 = PLIC_trigger_typed_interrupt(3, 0, IRQ_SYNC_REQUEST);
-    printf("[PLIC-DEMO] Trigger result: %d\n", result3);
+    LOG_INFO("[PLIC-DEMO] Trigger result: %d\n", result3);
     
     // Process all C0 interrupts
-    printf("\n[PLIC-DEMO] C0 processing received interrupts...\n");
+    LOG_INFO("\n[PLIC-DEMO] C0 processing received interrupts...\n");
     int processed = c0_process_enhanced_plic_interrupts(platform);
-    printf("[PLIC-DEMO] C0 processed %d interrupts\n", processed);
+    LOG_INFO("[PLIC-DEMO] C0 processed %d interrupts\n", processed);
     
     // 2. C0 -> Processing nodes communication (new capability)  
-    printf("\n[PLIC-DEMO] 2. C0 -> Processing nodes communication:\n");
+    LOG_INFO("\n[PLIC-DEMO] 2. C0 -> Processing nodes communication:\n");
     
-    printf("[PLIC-DEMO] C0 (Hart 0) sends TASK_ASSIGN to Hart 1...\n");
+    LOG_INFO("[PLIC-DEMO] C0 (Hart 0) sends TASK_ASSIGN to Hart 1...\n");
     int result4 = PLIC_trigger_typed_interrupt(0, 1, IRQ_TASK_ASSIGN);
-    printf("[PLIC-DEMO] Trigger result: %d\n", result4);
+    LOG_INFO("[PLIC-DEMO] Trigger result: %d\n", result4);
     
-    printf("[PLIC-DEMO] C0 (Hart 0) sends TASK_ASSIGN to Hart 2...\n");
+    LOG_INFO("[PLIC-DEMO] C0 (Hart 0) sends TASK_ASSIGN to Hart 2...\n");
     int result5 = PLIC_trigger_typed_interrupt(0, 2, IRQ_TASK_ASSIGN);
-    printf("[PLIC-DEMO] Trigger result: %d\n", result5);
+    LOG_INFO("[PLIC-DEMO] Trigger result: %d\n", result5);
     
-    printf("[PLIC-DEMO] C0 (Hart 0) sends SHUTDOWN_REQUEST to Hart 3...\n");
+    LOG_INFO("[PLIC-DEMO] C0 (Hart 0) sends SHUTDOWN_REQUEST to Hart 3...\n");
     int result6 = PLIC_trigger_typed_interrupt(0, 3, IRQ_SHUTDOWN_REQUEST);
-    printf("[PLIC-DEMO] Trigger result: %d\n", result6);
+    LOG_INFO("[PLIC-DEMO] Trigger result: %d\n", result6);
     
     // Note: Processing nodes would need interrupt handling code to actually receive these
-    printf("\n[PLIC-DEMO] Note: Processing nodes need interrupt handlers to receive C0 interrupts\n");
-    printf("[PLIC-DEMO] This demonstrates the PLIC infrastructure supports bidirectional communication\n");
+    LOG_INFO("\n[PLIC-DEMO] Note: Processing nodes need interrupt handlers to receive C0 interrupts\n");
+    LOG_INFO("[PLIC-DEMO] This demonstrates the PLIC infrastructure supports bidirectional communication\n");
     
-    printf("\n[PLIC-DEMO] === Demo Complete ===\n");
+    LOG_INFO("\n[PLIC-DEMO] === Demo Complete ===\n");
 }
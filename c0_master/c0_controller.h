@@ -7,6 +7,8 @@
 #include <time.h>
 #include "interrupt/plic.h"
 #include "generated/mem_map.h"
+#include "c0_master/mpmc_queue.h"
+#include "c0_master/slab.h"
 
 // Add DMAC512 support
 #include "hal/dma512/hal_dmac512.h"
@@ -131,14 +133,40 @@ typedef enum {
     TASK_TYPE_DMA_TRANSFER, 
     TASK_TYPE_COMPUTATION,
     TASK_TYPE_NOC_TRANSFER,
-    TASK_TYPE_TEST_EXECUTION,
-    TASK_TYPE_HAL_TEST      // New: For HAL test execution
+    TASK_TYPE_HAL_TEST,     // New: For HAL test execution
+    TASK_TYPE_CALLBACK      // func(arg), e.g. one stage of a task graph
 } task_type_t;
 
-typedef struct {
+#define TASK_MAX_SUCCESSORS 8
+
+// TASK_TYPE_COMPUTATION kernel: out is NULL when the task has no dst;
+// < 0 fails the task (see task_exec.h)
+typedef int (*task_kernel_fn)(const uint8_t* in, uint8_t* out, size_t size, void* arg);
+
+// HAL tests run concurrently; ones that share a resource never overlap
+#define HAL_SHARES_TILE0_DLM1   0x1u    // scratch at the base of tile 0 DLM1
+#define HAL_SHARES_DMEM         0x2u    // scratch at the DMEM bases, all of DMEM1
+#define HAL_SHARES_ALL          (~0u)   // swaps g_hal, HAL stats or the log sink: runs alone
+
+struct task_graph;
+
+// Dispatch priority (task_prio.h); zero, the memset default, is NORMAL
+typedef enum {
+    TASK_PRIO_LOW = -1,
+    TASK_PRIO_NORMAL = 0,
+    TASK_PRIO_HIGH = 1
+} task_prio_t;
+
+typedef struct task {
     int task_id;
     task_type_t type;
     int assigned_tile;
+    int home_tile;          // locality hint: tile holding the task's data, 0 for none
+    int priority;           // task_prio_t
+    uint64_t deadline_ns;   // absolute, get_current_timestamp_ns clock; 0 for none
+    // Data a non memory_op task moves, for placement (see task_place.h)
+    uint64_t data_src, data_dst;
+    size_t data_bytes;
     volatile bool completed;
     volatile bool taken;  // Flag to prevent double execution
     int result;
@@ -149,35 +177,45 @@ typedef struct {
             uint64_t src_addr;
             uint64_t dst_addr;
             size_t size;
+            task_kernel_fn kernel;  // TASK_TYPE_COMPUTATION only
+            void* kernel_arg;
+            uint32_t crc;           // out: CRC32C of src when kernel is NULL
         } memory_op;
         
-        struct {
-            int test_id;
-            void* test_data;
-        } test_exec;
-        
         struct {
             int (*test_func)(void*);  // HAL test function pointer
             const char* test_name;    // Test name for logging
             void* platform;           // Platform context
             int* result_ptr;          // Pointer to store result
+            unsigned shares;          // HAL_SHARES_* it must not run alongside
         } hal_test;
+        
+        struct {
+            int (*func)(void*);
+            void* arg;
+            const char* name;
+        } callback;
     } params;
     
-    // Synchronization
-    pthread_mutex_t task_lock;
-    pthread_cond_t task_complete;
+    // Dependency graph (see task_graph.h); all zero for standalone tasks
+    struct task_graph* graph;
+    int num_preds;
+    int preds_pending;                      // released when this drops to 0
+    int num_succs;
+    struct task* succs[TASK_MAX_SUCCESSORS];
+    uint64_t ready_ns, start_ns, end_ns;    // queued, started, finished
+    
+    // No per-task mutex/condvar: c0_wait_for_task parks on a lock shared
+    // by address hash, only while somebody actually waits
 } task_t;
 
 // STEP 2: Task queue system
-#define MAX_PENDING_TASKS 64
+#define TASK_QUEUE_CAPACITY 1024
+#define TASK_SLAB_CAPACITY  4096    // preallocated; the slab grows past it
 
+// Lock-free queue of task pointers; tasks are never copied
 typedef struct {
-    task_t tasks[MAX_PENDING_TASKS];
-    int head, tail, count;
-    pthread_mutex_t queue_lock;
-    pthread_cond_t task_available;
-    pthread_cond_t queue_not_full;
+    mpmc_queue_t ring;
 } task_queue_t;
 
 // STEP 2: Enhanced tile_core_t with task execution infrastructure
@@ -201,6 +239,7 @@ typedef struct {
     
     // STEP 1: Basic threading infrastructure
     pthread_t thread_id;
+    const void* self;           // coro_self() of its processor loop: thread or coroutine
     volatile bool running;
     volatile bool initialized;
     pthread_mutex_t state_lock;
@@ -222,6 +261,7 @@ typedef struct {
 
 typedef struct {
     int id;
+    int x, y;                   // Mesh position (row below the paired tile)
     uint64_t dmem_base_addr;    // Address space
     uint8_t* dmem_ptr;          // Simulated memory
     size_t dmem_size;
@@ -251,12 +291,13 @@ typedef struct {
     
     // STEP 2: Task coordination system
     task_queue_t task_queue;
-    int next_task_id;
-    pthread_mutex_t task_id_lock;
+    slab_t task_slab;           // c0_create_task / c0_free_task
+    int next_task_id;           // atomic
     
     // C0 master coordination
     volatile int active_tasks;
     volatile int completed_tasks;
+    pthread_cond_t c0_event;    // with platform_lock: completions, interrupts, tile startup
     
     // ADD PLIC tracking:
     volatile bool plic_enabled;
@@ -283,14 +324,32 @@ void c0_run_test_suite(mesh_platform_t* platform);
 // STEP 2: Task system function declarations
 int task_queue_init(task_queue_t* queue);
 int task_queue_destroy(task_queue_t* queue);
+// Non-blocking: push fails (-1) when full, pop returns NULL when empty
 int task_queue_push(task_queue_t* queue, task_t* task);
 task_t* task_queue_pop(task_queue_t* queue);
 bool task_queue_is_empty(task_queue_t* queue);
 
 // STEP 2: C0 master task coordination functions
+// Allocates a task from the platform slab; home_tile = target_tile
 task_t* c0_create_task(mesh_platform_t* p, task_type_t type, int target_tile);
+// Returns a completed (or never queued) c0_create_task task to the slab
+void c0_free_task(mesh_platform_t* p, task_t* task);
 int c0_queue_task(mesh_platform_t* p, task_t* task);
 int c0_wait_for_completion(mesh_platform_t* p, int expected_tasks);
+// Wakes C0 if it is waiting in one of the c0_* / wait_for_* helpers
+void c0_notify_event(mesh_platform_t* p);
+// Waits for a queued task to complete; -1 on timeout
+int c0_wait_for_task(task_t* task, int timeout_ms);
+// Marks task completed and wakes its waiters; the task is not touched
+// after the completing store, so a waiter may free it (or let the stack
+// frame holding it go) from that point on
+void c0_task_set_completed(task_t* task);
+// Initializes caller-owned storage as a TASK_TYPE_CALLBACK task
+int c0_init_callback_task(mesh_platform_t* p, task_t* task, int (*func)(void*), void* arg, const char* name);
+// Same for a copy/DMA/NoC/computation task over memory_op
+int c0_init_memory_task(mesh_platform_t* p, task_t* task, task_type_t type, uint64_t src_addr,
+                        uint64_t dst_addr, size_t size);
+const char* c0_task_name(const task_t* task);
 
 // STEP 2: Tile task execution functions
 task_t* tile_get_next_task(mesh_platform_t* p, tile_core_t* tile);
@@ -302,7 +361,10 @@ task_t* create_hal_test_task(mesh_platform_t* p,
                             int (*test_func)(void*),
                             const char* test_name,
                             int* result_ptr);
+// Queues where the placement policy puts it (task_place.h)
 int queue_task_to_available_tile(mesh_platform_t* p, task_t* task);
+// Queues on tile, or as above if tile is not a valid tile (1..N-1)
+int queue_task_to_tile(mesh_platform_t* p, task_t* task, int tile);
 int wait_for_all_tasks_completion(mesh_platform_t* p, int expected_count);
 void c0_run_hal_tests_distributed(mesh_platform_t* platform);
 
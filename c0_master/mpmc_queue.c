@@ -0,0 +1,100 @@
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include "c0_master/mpmc_queue.h"
+
+int mpmc_queue_init(mpmc_queue_t* q, size_t capacity)
+{
+    if (!q || capacity == 0) {
+        return -1;
+    }
+    size_t n = 2;
+    while (n < capacity) {
+        n <<= 1;
+    }
+
+    memset(q, 0, sizeof(*q));
+    q->cells = aligned_alloc(64, (n * sizeof(mpmc_cell_t) + 63) & ~(size_t)63);
+    if (!q->cells) {
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        q->cells[i].seq = i;
+        q->cells[i].item = NULL;
+    }
+    q->mask = n - 1;
+    return 0;
+}
+
+void mpmc_queue_destroy(mpmc_queue_t* q)
+{
+    if (!q) {
+        return;
+    }
+    free(q->cells);
+    q->cells = NULL;
+}
+
+// A cell at position pos is free for the producer when seq == pos and holds
+// an item for the consumer when seq == pos + 1; the consumer hands it back
+// for the next lap with seq = pos + capacity
+int mpmc_queue_push(mpmc_queue_t* q, void* item)
+{
+    if (!item) {
+        return -1;
+    }
+    uint64_t pos = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+    mpmc_cell_t* cell;
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        uint64_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        int64_t dif = (int64_t)(seq - pos);
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&q->head, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (dif < 0) {
+            return -1;      // a full lap behind: queue is full
+        } else {
+            pos = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+        }
+    }
+    cell->item = item;
+    __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+void* mpmc_queue_pop(mpmc_queue_t* q)
+{
+    uint64_t pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+    mpmc_cell_t* cell;
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        uint64_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        int64_t dif = (int64_t)(seq - (pos + 1));
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&q->tail, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (dif < 0) {
+            return NULL;    // not filled yet: queue is empty
+        } else {
+            pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+        }
+    }
+    void* item = cell->item;
+    __atomic_store_n(&cell->seq, pos + q->mask + 1, __ATOMIC_RELEASE);
+    return item;
+}
+
+size_t mpmc_queue_size(mpmc_queue_t* q)
+{
+    uint64_t tail = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+    uint64_t head = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+    return head > tail ? (size_t)(head - tail) : 0;
+}
+
+size_t mpmc_queue_capacity(const mpmc_queue_t* q)
+{
+    return (size_t)q->mask + 1;
+}
@@ -0,0 +1,40 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+#include <stdint.h>
+#include <stddef.h>
+
+// Bounded lock-free multi-producer multi-consumer queue of pointers
+// (Vyukov). Every cell carries a sequence number that tells producers and
+// consumers whose turn it is, so a push or pop is one CAS on the shared
+// position plus one release store on the cell - no locks and no copying.
+//
+//   mpmc_queue_init(&q, 1024);
+//   mpmc_queue_push(&q, item);         // -1 when full
+//   void* item = mpmc_queue_pop(&q);   // NULL when empty
+//
+// Items must not be NULL. Neither call blocks; callers decide whether to
+// spin, yield or park when the queue is full or empty.
+
+typedef struct {
+    uint64_t seq;
+    void* item;
+} mpmc_cell_t;
+
+typedef struct {
+    mpmc_cell_t* cells;
+    uint64_t mask;
+    _Alignas(64) uint64_t head;     // next push position
+    _Alignas(64) uint64_t tail;     // next pop position
+} mpmc_queue_t;
+
+// capacity is rounded up to a power of two (at least 2)
+int mpmc_queue_init(mpmc_queue_t* q, size_t capacity);
+void mpmc_queue_destroy(mpmc_queue_t* q);
+
+int mpmc_queue_push(mpmc_queue_t* q, void* item);
+void* mpmc_queue_pop(mpmc_queue_t* q);
+// Approximate while other threads push or pop
+size_t mpmc_queue_size(mpmc_queue_t* q);
+size_t mpmc_queue_capacity(const mpmc_queue_t* q);
+
+#endif
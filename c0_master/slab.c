@@ -0,0 +1,198 @@
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include "c0_master/slab.h"
+#include "log/log.h"
+
+#define CHUNK_HEADER 64         // chunk number, keeps the objects line aligned
+
+static __thread int t_list;
+
+// Objects are named by index (chunk * SLAB_CHUNK_OBJS + slot) so a list
+// head fits an index and an ABA tag in one 64-bit CAS. A free object keeps
+// the index + 1 of the next free object in its first word.
+static uint8_t* slab_obj(slab_t* s, uint32_t idx)
+{
+    return s->chunks[idx / SLAB_CHUNK_OBJS] + CHUNK_HEADER + (size_t)(idx % SLAB_CHUNK_OBJS) * s->stride;
+}
+
+// Chunks are aligned to their (power of two) size, so the chunk holding an
+// object and its number are one mask away
+static int slab_index(slab_t* s, const void* obj, uint32_t* idx)
+{
+    uintptr_t o = (uintptr_t)obj;
+    uint8_t* base = (uint8_t*)(o & ~(uintptr_t)(s->chunk_bytes - 1));
+    uint32_t c = *(const uint32_t*)base;
+    if (c >= (uint32_t)__atomic_load_n(&s->nchunks, __ATOMIC_ACQUIRE) || s->chunks[c] != base) {
+        return -1;
+    }
+    size_t off = (size_t)(o - (uintptr_t)base);
+    if (off < CHUNK_HEADER || (off - CHUNK_HEADER) % s->stride != 0 ||
+        (off - CHUNK_HEADER) / s->stride >= SLAB_CHUNK_OBJS) {
+        return -1;
+    }
+    *idx = c * SLAB_CHUNK_OBJS + (uint32_t)((off - CHUNK_HEADER) / s->stride);
+    return 0;
+}
+
+// Pushes the chain first..last, already linked through their first words
+static void list_push_chain(slab_t* s, slab_list_t* l, uint32_t first, uint32_t last)
+{
+    uint32_t* next = (uint32_t*)slab_obj(s, last);
+    uint64_t head = __atomic_load_n(&l->head, __ATOMIC_RELAXED);
+    uint64_t want;
+    do {
+        __atomic_store_n(next, (uint32_t)head, __ATOMIC_RELAXED);
+        want = ((head >> 32) + 1) << 32 | (first + 1);
+    } while (!__atomic_compare_exchange_n(&l->head, &head, want, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+static void list_push(slab_t* s, slab_list_t* l, uint32_t idx)
+{
+    list_push_chain(s, l, idx, idx);
+}
+
+static void* list_pop(slab_t* s, slab_list_t* l)
+{
+    uint64_t head = __atomic_load_n(&l->head, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t top = (uint32_t)head;
+        if (top == 0) {
+            return NULL;
+        }
+        // May read a word the new owner is already writing; the tag makes
+        // the CAS fail in that case
+        uint8_t* obj = slab_obj(s, top - 1);
+        uint32_t next = __atomic_load_n((uint32_t*)obj, __ATOMIC_RELAXED);
+        uint64_t want = ((head >> 32) + 1) << 32 | next;
+        if (__atomic_compare_exchange_n(&l->head, &head, want, 1, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            return obj;
+        }
+    }
+}
+
+// Adds a chunk and threads its objects onto list; -1 at SLAB_MAX_CHUNKS
+static int slab_grow(slab_t* s, slab_list_t* l, int seen_chunks)
+{
+    pthread_mutex_lock(&s->grow_lock);
+    int n = s->nchunks;
+    if (n != seen_chunks) {
+        pthread_mutex_unlock(&s->grow_lock);
+        return 0;       // somebody else grew it meanwhile
+    }
+    if (n >= SLAB_MAX_CHUNKS) {
+        pthread_mutex_unlock(&s->grow_lock);
+        return -1;
+    }
+    uint8_t* chunk = aligned_alloc(s->chunk_bytes, s->chunk_bytes);
+    if (!chunk) {
+        pthread_mutex_unlock(&s->grow_lock);
+        return -1;
+    }
+    *(uint32_t*)chunk = (uint32_t)n;
+    s->chunks[n] = chunk;
+    __atomic_store_n(&s->nchunks, n + 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&s->grow_lock);
+
+    uint32_t first = (uint32_t)n * SLAB_CHUNK_OBJS;
+    uint32_t last = first + SLAB_CHUNK_OBJS - 1;
+    for (uint32_t i = first; i < last; i++) {
+        *(uint32_t*)slab_obj(s, i) = i + 2;
+    }
+    list_push_chain(s, l, first, last);
+    return 0;
+}
+
+int slab_init(slab_t* s, size_t obj_size, size_t initial)
+{
+    if (!s || obj_size < sizeof(uint32_t)) {
+        return -1;
+    }
+    memset(s, 0, sizeof(*s));
+    s->stride = (obj_size + 63) & ~(size_t)63;
+    s->chunk_bytes = 64;
+    while (s->chunk_bytes < CHUNK_HEADER + (size_t)SLAB_CHUNK_OBJS * s->stride) {
+        s->chunk_bytes <<= 1;
+    }
+    pthread_mutex_init(&s->grow_lock, NULL);
+    while ((size_t)s->nchunks * SLAB_CHUNK_OBJS < initial) {
+        if (slab_grow(s, &s->lists[0], s->nchunks) != 0) {
+            slab_destroy(s);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void slab_destroy(slab_t* s)
+{
+    if (!s) {
+        return;
+    }
+    for (int c = 0; c < s->nchunks; c++) {
+        free(s->chunks[c]);
+        s->chunks[c] = NULL;
+    }
+    s->nchunks = 0;
+    pthread_mutex_destroy(&s->grow_lock);
+}
+
+void slab_bind_thread(int list)
+{
+    t_list = list >= 0 && list < SLAB_LISTS ? list : 0;
+}
+
+void* slab_alloc(slab_t* s)
+{
+    if (!s) {
+        return NULL;
+    }
+    slab_list_t* own = &s->lists[t_list];
+    for (;;) {
+        int seen = __atomic_load_n(&s->nchunks, __ATOMIC_ACQUIRE);
+        void* obj = list_pop(s, own);
+        for (int k = 1; !obj && k < SLAB_LISTS; k++) {
+            obj = list_pop(s, &s->lists[(t_list + k) % SLAB_LISTS]);
+        }
+        if (obj) {
+            __atomic_fetch_add(&own->allocs, 1, __ATOMIC_RELAXED);
+            return obj;
+        }
+        if (slab_grow(s, own, seen) != 0) {
+            return NULL;
+        }
+    }
+}
+
+void slab_free(slab_t* s, void* obj)
+{
+    if (!s || !obj) {
+        return;
+    }
+    uint32_t idx;
+    if (slab_index(s, obj, &idx) != 0) {
+        LOG_ERROR("[Slab] Freeing %p, which does not belong to this slab\n", obj);
+        return;
+    }
+    slab_list_t* own = &s->lists[t_list];
+    list_push(s, own, idx);
+    __atomic_fetch_add(&own->frees, 1, __ATOMIC_RELAXED);
+}
+
+size_t slab_in_use(slab_t* s)
+{
+    if (!s) {
+        return 0;
+    }
+    uint64_t allocs = 0, frees = 0;
+    for (int i = 0; i < SLAB_LISTS; i++) {
+        allocs += __atomic_load_n(&s->lists[i].allocs, __ATOMIC_RELAXED);
+        frees += __atomic_load_n(&s->lists[i].frees, __ATOMIC_RELAXED);
+    }
+    return allocs > frees ? (size_t)(allocs - frees) : 0;
+}
+
+size_t slab_capacity(slab_t* s)
+{
+    return s ? (size_t)__atomic_load_n(&s->nchunks, __ATOMIC_ACQUIRE) * SLAB_CHUNK_OBJS : 0;
+}
@@ -0,0 +1,55 @@
+#ifndef SLAB_H
+#define SLAB_H
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// Growable fixed-size object allocator with per-tile free lists.
+//
+// Objects live in cache-line aligned chunks of SLAB_CHUNK_OBJS that are
+// added on demand and never moved or released before slab_destroy(), so
+// object pointers stay valid. Every tile thread has its own free list (a
+// lock-free stack, list 0 serves C0 and any other thread): a thread frees
+// onto its own list and allocates from it first, then takes from the other
+// lists, and only then grows the slab - all O(1), and a tile that recycles
+// its own tasks never shares a cache line with another tile.
+//
+//   slab_init(&s, sizeof(task_t), 4096);
+//   slab_bind_thread(tile_id);         // once per tile thread
+//   task_t* t = slab_alloc(&s);        // NULL only when SLAB_MAX_OBJS are live
+//   slab_free(&s, t);
+
+#define SLAB_CHUNK_OBJS 1024
+#define SLAB_MAX_CHUNKS 1024            // at most 1M objects
+#define SLAB_LISTS      16
+
+typedef struct {
+    // (ABA tag << 32) | (object index + 1); 0 when empty
+    _Alignas(64) uint64_t head;
+    uint64_t allocs, frees;
+} slab_list_t;
+
+typedef struct {
+    size_t stride;              // object size rounded up to a cache line
+    size_t chunk_bytes;         // power of two, chunks are aligned to it
+    uint8_t* chunks[SLAB_MAX_CHUNKS];
+    int nchunks;
+    pthread_mutex_t grow_lock;
+    slab_list_t lists[SLAB_LISTS];
+} slab_t;
+
+// Preallocates enough chunks for initial objects
+int slab_init(slab_t* s, size_t obj_size, size_t initial);
+void slab_destroy(slab_t* s);
+
+// Free list used by the calling thread (0..SLAB_LISTS-1) in every slab
+void slab_bind_thread(int list);
+
+// Contents are left as the previous owner did; callers initialize them
+void* slab_alloc(slab_t* s);
+void slab_free(slab_t* s, void* obj);
+// Objects currently allocated / ever created (approximate under concurrency)
+size_t slab_in_use(slab_t* s);
+size_t slab_capacity(slab_t* s);
+
+#endif
@@ -0,0 +1,123 @@
+#include <stdint.h>
+#include <string.h>
+#include "c0_master/task_exec.h"
+#include "hal_tests/hal_interface.h"
+#include "platform_init/address_manager.h"
+#include "mem_ops/mem_ops.h"
+#include "log/log.h"
+
+static int exec_copy(const task_t* task)
+{
+    size_t size = task->params.memory_op.size;
+    return g_hal.cpu_local_move(task->params.memory_op.src_addr, task->params.memory_op.dst_addr, size) == 0
+               ? (int)size : -1;
+}
+
+// The DMAC512 only copies inside its own tile, so the engine of the tile
+// holding the data is programmed, wherever the task was placed
+static int exec_dma(const task_t* task)
+{
+    uint64_t src = task->params.memory_op.src_addr;
+    size_t size = task->params.memory_op.size;
+    int owner = get_tile_id_from_address(src);
+    if (owner < 0) {
+        return -1;
+    }
+    return g_hal.dma_local_transfer(owner, src, task->params.memory_op.dst_addr, size) < 0 ? -1 : (int)size;
+}
+
+static int exec_noc(const task_t* task)
+{
+    size_t size = task->params.memory_op.size;
+    return g_hal.dma_remote_transfer(task->params.memory_op.src_addr, task->params.memory_op.dst_addr, size) < 0
+               ? -1 : (int)size;
+}
+
+static int exec_compute(task_t* task)
+{
+    uint64_t src = task->params.memory_op.src_addr, dst = task->params.memory_op.dst_addr;
+    size_t size = task->params.memory_op.size;
+    task_kernel_fn kernel = task->params.memory_op.kernel;
+    hal_mem_view_t in, out;
+
+    if (!kernel) {
+        if (g_hal.memory_map_ro(src, size, &in) < 0) {
+            return -1;
+        }
+        task->params.memory_op.crc = mem_ops_crc32c(0, in.data, size);
+        g_hal.memory_unmap(&in);
+        return (int)size;
+    }
+    if (!dst) {
+        if (g_hal.memory_map_ro(src, size, &in) < 0) {
+            return -1;
+        }
+        int rc = kernel(in.data, NULL, size, task->params.memory_op.kernel_arg);
+        g_hal.memory_unmap(&in);
+        return rc < 0 ? -1 : (int)size;
+    }
+
+    // In place (or overlapping): one read-write view serves as both sides
+    int overlap = dst < src + size && src < dst + size;
+    if (overlap && dst != src) {
+        return -1;
+    }
+    // Views are mapped lower address first: a task doing the reverse copy
+    // elsewhere can then never hold one while waiting for the other
+    int src_first = !overlap && src < dst;
+    if (src_first && g_hal.memory_map_ro(src, size, &in) < 0) {
+        return -1;
+    }
+    if (g_hal.memory_map_rw(dst, size, &out) < 0) {
+        if (src_first) {
+            g_hal.memory_unmap(&in);
+        }
+        return -1;
+    }
+    if (!overlap && !src_first && g_hal.memory_map_ro(src, size, &in) < 0) {
+        g_hal.memory_commit(&out);
+        g_hal.memory_unmap(&out);
+        return -1;
+    }
+    int rc = kernel(overlap ? out.wdata : in.data, out.wdata, size, task->params.memory_op.kernel_arg);
+    // A failed kernel still commits: the view must not be dropped dirty
+    g_hal.memory_commit(&out);
+    g_hal.memory_unmap(&out);
+    if (!overlap) {
+        g_hal.memory_unmap(&in);
+    }
+    return rc < 0 ? -1 : (int)size;
+}
+
+int task_exec_memory_op(tile_core_t* tile, task_t* task)
+{
+    if (!tile || !task || task->params.memory_op.size == 0 || task->params.memory_op.size > INT32_MAX) {
+        return -1;
+    }
+    int result;
+    switch (task->type) {
+        case TASK_TYPE_MEMORY_COPY:  result = exec_copy(task); break;
+        case TASK_TYPE_DMA_TRANSFER: result = exec_dma(task); break;
+        case TASK_TYPE_NOC_TRANSFER: result = exec_noc(task); break;
+        case TASK_TYPE_COMPUTATION:  result = exec_compute(task); break;
+        default:                     return -1;
+    }
+    if (result < 0) {
+        LOG_WARN("[Tile %d] %s task %d rejected: 0x%lx -> 0x%lx, %zu bytes\n", tile->id, c0_task_name(task),
+                 task->task_id, (unsigned long)task->params.memory_op.src_addr,
+                 (unsigned long)task->params.memory_op.dst_addr, task->params.memory_op.size);
+    }
+    return result;
+}
+
+int task_kernel_xor(const uint8_t* in, uint8_t* out, size_t size, void* arg)
+{
+    if (!out) {
+        return -1;
+    }
+    uint8_t key = arg ? *(const uint8_t*)arg : 0;
+    for (size_t i = 0; i < size; i++) {
+        out[i] = in[i] ^ key;
+    }
+    return 0;
+}
@@ -0,0 +1,25 @@
+#ifndef TASK_EXEC_H
+#define TASK_EXEC_H
+#include "c0_master/c0_controller.h"
+
+// Executors for the data-moving task types. Each takes the task's
+// memory_op and drives the same data path the HAL exposes:
+//
+//   TASK_TYPE_MEMORY_COPY    CPU move (cpu_local_move), any two ranges
+//   TASK_TYPE_DMA_TRANSFER   DMAC512 of the tile holding both ranges
+//   TASK_TYPE_NOC_TRANSFER   remote DMA packet over the mesh
+//   TASK_TYPE_COMPUTATION    memory_op.kernel over zero-copy views of src
+//                            (read-only) and dst (read-write, committed
+//                            after the kernel); without a kernel the CRC32C
+//                            of src goes to memory_op.crc
+//
+// All return the bytes processed, or -1 when the HAL rejects the ranges or
+// the kernel fails; the result lands in task->result as for other tasks.
+
+int task_exec_memory_op(tile_core_t* tile, task_t* task);
+
+// Built-in kernels for TASK_TYPE_COMPUTATION
+// out[i] = in[i] ^ *(uint8_t*)arg, or a copy when arg is NULL
+int task_kernel_xor(const uint8_t* in, uint8_t* out, size_t size, void* arg);
+
+#endif
@@ -0,0 +1,253 @@
+#define _GNU_SOURCE
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include "c0_master/task_graph.h"
+#include "log/log.h"
+
+int task_depends_on(task_t* task, task_t* pred)
+{
+    if (!task || !pred || task == pred || task->graph || pred->graph ||
+        pred->num_succs >= TASK_MAX_SUCCESSORS) {
+        return -1;
+    }
+    pred->succs[pred->num_succs++] = task;
+    task->num_preds++;
+    return 0;
+}
+
+static int graph_index(const task_graph_t* g, const task_t* task)
+{
+    for (int i = 0; i < g->count; i++) {
+        if (g->tasks[i] == task) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Kahn's algorithm over the graph; fills order[] and returns how many tasks
+// it reached, which is g->count unless there is a cycle
+static int graph_topo_order(const task_graph_t* g, int* order)
+{
+    int indeg[TASK_GRAPH_MAX_TASKS];
+    int n = 0;
+    for (int i = 0; i < g->count; i++) {
+        indeg[i] = g->tasks[i]->num_preds;
+        if (indeg[i] == 0) {
+            order[n++] = i;
+        }
+    }
+    for (int k = 0; k < n; k++) {
+        const task_t* t = g->tasks[order[k]];
+        for (int s = 0; s < t->num_succs; s++) {
+            int j = graph_index(g, t->succs[s]);
+            if (--indeg[j] == 0) {
+                order[n++] = j;
+            }
+        }
+    }
+    return n;
+}
+
+// Completes a task that could not be queued so the graph still drains
+static void graph_drop(mesh_platform_t* p, task_t* task, int tile)
+{
+    LOG_ERROR("[C0 Master] Could not queue graph task %d '%s', dropping it\n", task->task_id, c0_task_name(task));
+    task_graph_t* g = task->graph;
+    task->result = -1;
+    task->start_ns = task->end_ns = get_current_timestamp_ns();
+    task_graph_release_successors(p, task, tile);
+    c0_task_set_completed(task);
+    task_graph_retire(p, g);
+}
+
+int c0_submit_graph(mesh_platform_t* p, task_graph_t* g, task_t** tasks, int n)
+{
+    if (!p || !g || !tasks || n <= 0 || n > TASK_GRAPH_MAX_TASKS) {
+        return -1;
+    }
+
+    memset(g, 0, sizeof(*g));
+    for (int i = 0; i < n; i++) {
+        if (!tasks[i] || tasks[i]->graph || graph_index(g, tasks[i]) >= 0) {
+            return -1;
+        }
+        g->tasks[g->count++] = tasks[i];
+    }
+
+    // Every edge must stay inside the graph: a predecessor outside it would
+    // never release its successor
+    int indeg[TASK_GRAPH_MAX_TASKS] = {0};
+    for (int i = 0; i < n; i++) {
+        for (int s = 0; s < tasks[i]->num_succs; s++) {
+            int j = graph_index(g, tasks[i]->succs[s]);
+            if (j < 0) {
+                LOG_ERROR("[C0 Master] Graph task %d has a successor outside the graph\n", tasks[i]->task_id);
+                return -1;
+            }
+            indeg[j]++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        if (indeg[i] != tasks[i]->num_preds) {
+            LOG_ERROR("[C0 Master] Graph task %d depends on a task outside the graph\n", tasks[i]->task_id);
+            return -1;
+        }
+    }
+    int order[TASK_GRAPH_MAX_TASKS];
+    if (graph_topo_order(g, order) != n) {
+        LOG_ERROR("[C0 Master] Task graph has a dependency cycle\n");
+        return -1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        tasks[i]->preds_pending = tasks[i]->num_preds;
+        tasks[i]->graph = g;
+    }
+    g->remaining = n;
+    g->submit_ns = get_current_timestamp_ns();
+
+    // Decide the roots before queueing any: a fast root may already have
+    // released a successor by the time the loop gets to it
+    task_t* roots[TASK_GRAPH_MAX_TASKS];
+    int num_roots = 0;
+    for (int i = 0; i < n; i++) {
+        if (tasks[i]->num_preds == 0) {
+            roots[num_roots++] = tasks[i];
+        }
+    }
+    for (int i = 0; i < num_roots; i++) {
+        roots[i]->ready_ns = g->submit_ns;
+        if (queue_task_to_available_tile(p, roots[i]) != 0) {
+            graph_drop(p, roots[i], 0);
+        }
+    }
+    LOG_DEBUG("[C0 Master] Submitted graph of %d tasks (%d ready)\n", n, num_roots);
+    return 0;
+}
+
+int c0_wait_graph(mesh_platform_t* p, task_graph_t* g, int timeout_ms)
+{
+    if (!p || !g) {
+        return -1;
+    }
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    int rc = 0;
+    pthread_mutex_lock(&p->platform_lock);
+    while (__atomic_load_n(&g->remaining, __ATOMIC_ACQUIRE) > 0 && rc == 0) {
+        rc = pthread_cond_timedwait(&p->c0_event, &p->platform_lock, &deadline);
+    }
+    int remaining = __atomic_load_n(&g->remaining, __ATOMIC_ACQUIRE);
+    pthread_mutex_unlock(&p->platform_lock);
+    return remaining == 0 ? 0 : -1;
+}
+
+void task_graph_release_successors(mesh_platform_t* p, task_t* task, int tile)
+{
+    for (int s = 0; s < task->num_succs; s++) {
+        task_t* succ = task->succs[s];
+        if (__atomic_sub_fetch(&succ->preds_pending, 1, __ATOMIC_ACQ_REL) != 0) {
+            continue;
+        }
+        succ->ready_ns = get_current_timestamp_ns();
+        if (queue_task_to_tile(p, succ, succ->home_tile > 0 ? succ->home_tile : tile) != 0) {
+            graph_drop(p, succ, tile);
+        }
+    }
+}
+
+void task_graph_retire(mesh_platform_t* p, task_graph_t* g)
+{
+    // The waiter may return and reuse g as soon as this reaches 0
+    if (__atomic_sub_fetch(&g->remaining, 1, __ATOMIC_ACQ_REL) == 0) {
+        c0_notify_event(p);
+    }
+}
+
+int task_graph_critical_path(const task_graph_t* g, task_graph_report_t* report)
+{
+    if (!g || !report || g->count <= 0) {
+        return -1;
+    }
+    memset(report, 0, sizeof(*report));
+
+    int order[TASK_GRAPH_MAX_TASKS];
+    if (graph_topo_order(g, order) != g->count) {
+        return -1;
+    }
+
+    // Longest chain by measured run time: finish[i] is the run time of the
+    // heaviest chain ending in task i, via[i] its predecessor on that chain
+    uint64_t finish[TASK_GRAPH_MAX_TASKS] = {0};
+    uint64_t before[TASK_GRAPH_MAX_TASKS] = {0};
+    int via[TASK_GRAPH_MAX_TASKS];
+    for (int i = 0; i < g->count; i++) {
+        via[i] = -1;
+    }
+    uint64_t last_end = g->submit_ns;
+    int tail = order[0];
+    for (int k = 0; k < g->count; k++) {
+        int i = order[k];
+        const task_t* t = g->tasks[i];
+        uint64_t run = t->end_ns - t->start_ns;
+        report->work_ns += run;
+        if (t->end_ns > last_end) {
+            last_end = t->end_ns;
+        }
+        finish[i] = before[i] + run;
+        if (finish[i] > finish[tail]) {
+            tail = i;
+        }
+        for (int s = 0; s < t->num_succs; s++) {
+            int j = graph_index(g, t->succs[s]);
+            if (finish[i] > before[j] || via[j] < 0) {
+                before[j] = finish[i];
+                via[j] = i;
+            }
+        }
+    }
+    report->makespan_ns = last_end - g->submit_ns;
+    report->critical_ns = finish[tail];
+
+    int rev[TASK_GRAPH_MAX_TASKS];
+    int len = 0;
+    for (int i = tail; i >= 0; i = via[i]) {
+        rev[len++] = i;
+    }
+    for (int k = 0; k < len; k++) {
+        report->path[k] = rev[len - 1 - k];
+    }
+    report->path_len = len;
+    return 0;
+}
+
+void task_graph_print_report(const task_graph_t* g, const task_graph_report_t* report, int tiles)
+{
+    double bound_ms = report->critical_ns / 1e6;
+    if (tiles > 0 && report->work_ns / 1e6 / tiles > bound_ms) {
+        bound_ms = report->work_ns / 1e6 / tiles;
+    }
+    LOG_INFO("[Graph] %d tasks: makespan %.1f ms, work %.1f ms, critical path %.1f ms over %d tasks "
+             "(bound %.1f ms, %.2fx)\n",
+             g->count, report->makespan_ns / 1e6, report->work_ns / 1e6, report->critical_ns / 1e6,
+             report->path_len, bound_ms, bound_ms > 0 ? report->makespan_ns / 1e6 / bound_ms : 0.0);
+
+    char line[256];
+    int len = 0;
+    for (int k = 0; k < report->path_len && len < (int)sizeof(line); k++) {
+        const task_t* t = g->tasks[report->path[k]];
+        len += snprintf(line + len, sizeof(line) - len, "%s%s (tile %d, %.1f ms)", k ? " -> " : "",
+                        c0_task_name(t), t->assigned_tile, (t->end_ns - t->start_ns) / 1e6);
+    }
+    LOG_INFO("[Graph] Critical path: %s\n", report->path_len ? line : "-");
+}
@@ -0,0 +1,63 @@
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+#include <stdint.h>
+#include "c0_master/c0_controller.h"
+
+// Task dependency graphs for the C0 task system.
+//
+// Tasks declare their predecessors with task_depends_on() and are handed to
+// c0_submit_graph() together. Tasks without predecessors are queued at
+// once; every other task is queued by the tile that completes its last
+// predecessor, so a multi-stage pipeline flows lane by lane instead of
+// stopping at a barrier after each stage. A released task goes to its
+// home_tile, or else stays on the tile that produced its input.
+//
+//   c0_init_callback_task(p, &dma, copy_in, &lane, "dma");
+//   c0_init_callback_task(p, &sum, checksum, &lane, "sum");
+//   task_depends_on(&sum, &dma);
+//   task_t* tasks[] = { &dma, &sum };
+//   c0_submit_graph(p, &g, tasks, 2);
+//   c0_wait_graph(p, &g, 1000);
+//   task_graph_critical_path(&g, &report);
+//
+// A failed predecessor does not cancel its successors; each task can look
+// at its inputs' result fields. Task storage belongs to the caller and must
+// outlive c0_wait_graph().
+
+#define TASK_GRAPH_MAX_TASKS 64
+
+typedef struct task_graph {
+    task_t* tasks[TASK_GRAPH_MAX_TASKS];
+    int count;
+    int remaining;              // tasks not yet completed
+    uint64_t submit_ns;
+} task_graph_t;
+
+typedef struct {
+    uint64_t makespan_ns;       // submission to last completion
+    uint64_t work_ns;           // sum of task run times
+    uint64_t critical_ns;       // run time along the longest dependency chain
+    int path[TASK_GRAPH_MAX_TASKS];     // that chain, indices into tasks[]
+    int path_len;
+} task_graph_report_t;
+
+// task may not start before pred has completed; -1 if pred already has
+// TASK_MAX_SUCCESSORS successors
+int task_depends_on(task_t* task, task_t* pred);
+
+// Queues the tasks without predecessors. -1 (nothing queued) if a task is
+// already part of a graph, depends on a task outside tasks[], or the
+// dependencies form a cycle.
+int c0_submit_graph(mesh_platform_t* p, task_graph_t* g, task_t** tasks, int n);
+// Waits until every task of the graph completed; -1 on timeout
+int c0_wait_graph(mesh_platform_t* p, task_graph_t* g, int timeout_ms);
+
+// Only valid after c0_wait_graph() succeeded
+int task_graph_critical_path(const task_graph_t* g, task_graph_report_t* report);
+void task_graph_print_report(const task_graph_t* g, const task_graph_report_t* report, int tiles);
+
+// Completion hooks, called by the tile that ran task (tile_complete_task)
+void task_graph_release_successors(mesh_platform_t* p, task_t* task, int tile);
+void task_graph_retire(mesh_platform_t* p, task_graph_t* g);
+
+#endif
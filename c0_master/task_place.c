@@ -0,0 +1,193 @@
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include "c0_master/task_place.h"
+#include "mesh_noc/mesh_router.h"
+#include "mesh_noc/mesh_routing.h"
+#include "log/log.h"
+
+static int place_round_robin(const task_t* task, const task_place_candidate_t* c, int n, uint64_t data_bytes);
+static int place_least_loaded(const task_t* task, const task_place_candidate_t* c, int n, uint64_t data_bytes);
+static int place_locality(const task_t* task, const task_place_candidate_t* c, int n, uint64_t data_bytes);
+static int place_hybrid(const task_t* task, const task_place_candidate_t* c, int n, uint64_t data_bytes);
+
+static struct {
+    const char* name;
+    task_place_fn fn;
+} g_policies[TASK_PLACE_POLICIES] = {
+    [TASK_PLACE_ROUND_ROBIN]  = { "round-robin",  place_round_robin },
+    [TASK_PLACE_LEAST_LOADED] = { "least-loaded", place_least_loaded },
+    [TASK_PLACE_LOCALITY]     = { "locality",     place_locality },
+    [TASK_PLACE_HYBRID]       = { "hybrid",       place_hybrid },
+};
+
+static int g_policy = -1;           // -1 until read from TASK_PLACEMENT
+static int g_rotor;                 // round-robin position, spreads ties
+
+static int place_round_robin(const task_t* task, const task_place_candidate_t* c, int n, uint64_t data_bytes)
+{
+    (void)task; (void)c; (void)data_bytes;
+    return (int)((unsigned)__atomic_fetch_add(&g_rotor, 1, __ATOMIC_RELAXED) % (unsigned)n);
+}
+
+// Lowest key; ties go to the first from a rotating start
+static int pick_lowest(const task_place_candidate_t* c, int n, double (*key)(const task_place_candidate_t*, uint64_t),
+                       uint64_t data_bytes)
+{
+    int start = (int)((unsigned)__atomic_fetch_add(&g_rotor, 1, __ATOMIC_RELAXED) % (unsigned)n);
+    int best = start;
+    double best_key = key(&c[start], data_bytes);
+    for (int k = 1; k < n; k++) {
+        int i = (start + k) % n;
+        double v = key(&c[i], data_bytes);
+        if (v < best_key) {
+            best = i;
+            best_key = v;
+        }
+    }
+    return best;
+}
+
+static double load_key(const task_place_candidate_t* c, uint64_t data_bytes)
+{
+    (void)data_bytes;
+    return c->load;
+}
+
+// Hop-bytes first, then load: the load term stays below one hop-byte
+static double locality_key(const task_place_candidate_t* c, uint64_t data_bytes)
+{
+    (void)data_bytes;
+    return (double)c->hop_bytes + c->load / (double)(TASK_SCHED_INBOX + 2);
+}
+
+static double hybrid_key(const task_place_candidate_t* c, uint64_t data_bytes)
+{
+    double hops = data_bytes ? (double)c->hop_bytes / (double)data_bytes : 0.0;
+    return hops + TASK_PLACE_LOAD_HOPS * c->load - (c->idle ? 0.5 : 0.0);
+}
+
+static int place_least_loaded(const task_t* task, const task_place_candidate_t* c, int n, uint64_t data_bytes)
+{
+    (void)task;
+    return pick_lowest(c, n, load_key, data_bytes);
+}
+
+static int place_locality(const task_t* task, const task_place_candidate_t* c, int n, uint64_t data_bytes)
+{
+    (void)task;
+    return pick_lowest(c, n, data_bytes ? locality_key : load_key, data_bytes);
+}
+
+static int place_hybrid(const task_t* task, const task_place_candidate_t* c, int n, uint64_t data_bytes)
+{
+    (void)task;
+    return pick_lowest(c, n, hybrid_key, data_bytes);
+}
+
+static int hops_between(uint8_t ax, uint8_t ay, uint8_t bx, uint8_t by)
+{
+    int hops = 0;
+    calc_xy_route(ax, ay, bx, by, &hops);
+    return hops;
+}
+
+uint64_t task_place_hop_bytes(mesh_platform_t* p, const task_t* task, int tile, uint64_t* data_bytes)
+{
+    uint64_t src = task->data_src, dst = task->data_dst;
+    uint64_t bytes = task->data_bytes;
+    if (task->type == TASK_TYPE_MEMORY_COPY || task->type == TASK_TYPE_DMA_TRANSFER ||
+        task->type == TASK_TYPE_NOC_TRANSFER || task->type == TASK_TYPE_COMPUTATION) {
+        src = task->params.memory_op.src_addr;
+        dst = task->params.memory_op.dst_addr;
+        bytes = task->params.memory_op.size;
+    }
+
+    uint8_t tx = (uint8_t)p->nodes[tile].x, ty = (uint8_t)p->nodes[tile].y;
+    uint8_t x, y;
+    uint64_t hop_bytes = 0;
+    int known = 0;
+    if (bytes) {
+        // The data comes in from src and goes out to dst
+        if (src && noc_addr_to_coords(src, &x, &y) == 0) {
+            hop_bytes += bytes * (uint64_t)hops_between(x, y, tx, ty);
+            known = 1;
+        }
+        if (dst && noc_addr_to_coords(dst, &x, &y) == 0) {
+            hop_bytes += bytes * (uint64_t)hops_between(tx, ty, x, y);
+            known = 1;
+        }
+    }
+    if (!known && task->home_tile > 0 && task->home_tile < p->node_count) {
+        const tile_core_t* home = &p->nodes[task->home_tile];
+        bytes = 1;
+        hop_bytes = (uint64_t)hops_between((uint8_t)home->x, (uint8_t)home->y, tx, ty);
+        known = 1;
+    }
+    if (data_bytes) {
+        *data_bytes = known ? bytes : 0;
+    }
+    return known ? hop_bytes : 0;
+}
+
+int task_place_choose(mesh_platform_t* p, task_sched_t* s, const task_t* task)
+{
+    task_place_candidate_t c[TASK_SCHED_MAX_WORKERS];
+    int n = 0;
+    uint64_t data_bytes = 0;
+    for (int t = 1; t < p->node_count && n < TASK_SCHED_MAX_WORKERS; t++, n++) {
+        c[n].tile = t;
+        c[n].hop_bytes = task_place_hop_bytes(p, task, t, &data_bytes);
+        c[n].load = task_sched_load(s, t - 1);
+        c[n].idle = __atomic_load_n(&p->nodes[t].idle, __ATOMIC_RELAXED) && c[n].load == 0;
+    }
+    if (n == 0) {
+        return -1;
+    }
+    int chosen = g_policies[task_place_get_policy()].fn(task, c, n, data_bytes);
+    return c[chosen >= 0 && chosen < n ? chosen : 0].tile;
+}
+
+void task_place_set_policy(task_place_policy_t policy)
+{
+    if (policy >= 0 && policy < TASK_PLACE_POLICIES) {
+        __atomic_store_n(&g_policy, (int)policy, __ATOMIC_RELAXED);
+    }
+}
+
+task_place_policy_t task_place_get_policy(void)
+{
+    int policy = __atomic_load_n(&g_policy, __ATOMIC_RELAXED);
+    if (policy < 0) {
+        const char* env = getenv("TASK_PLACEMENT");
+        policy = env && *env ? task_place_parse(env) : TASK_PLACE_HYBRID;
+        if (policy < 0) {
+            LOG_WARN("[Place] Unknown TASK_PLACEMENT='%s', using hybrid\n", env);
+            policy = TASK_PLACE_HYBRID;
+        }
+        __atomic_store_n(&g_policy, policy, __ATOMIC_RELAXED);
+    }
+    return (task_place_policy_t)policy;
+}
+
+void task_place_set_fn(task_place_policy_t policy, task_place_fn fn)
+{
+    if (policy >= 0 && policy < TASK_PLACE_POLICIES && fn) {
+        g_policies[policy].fn = fn;
+    }
+}
+
+const char* task_place_policy_name(task_place_policy_t policy)
+{
+    return policy >= 0 && policy < TASK_PLACE_POLICIES ? g_policies[policy].name : "unknown";
+}
+
+int task_place_parse(const char* name)
+{
+    for (int i = 0; name && i < TASK_PLACE_POLICIES; i++) {
+        if (strcmp(name, g_policies[i].name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,63 @@
+#ifndef TASK_PLACE_H
+#define TASK_PLACE_H
+#include <stdint.h>
+#include "c0_master/c0_controller.h"
+#include "c0_master/task_sched.h"
+
+// Tile selection for queue_task_to_available_tile().
+//
+// A task's data footprint is where it reads and writes: the memory_op
+// addresses of copy/DMA/NoC/computation tasks, the data_src/data_dst of
+// any other task, or failing both its home_tile. Moving the data to a
+// tile costs bytes x mesh hops (XY routing over the tile/DMEM coordinate
+// map), the same hop-bytes the NoC counts. Policies weigh that against how busy the
+// candidates are:
+//
+//   round-robin     tiles in turn, blind to data and load
+//   least-loaded    fewest queued + running tasks
+//   locality        fewest hop-bytes; load only breaks ties
+//   hybrid          hops per byte plus TASK_PLACE_LOAD_HOPS per queued
+//                   task, an idle tile slightly preferred (default)
+//
+// The policy is process wide; TASK_PLACEMENT=<name> picks it at startup.
+// Idle tiles still steal, so placement decides where work starts, not
+// necessarily where it ends up.
+
+#define TASK_PLACE_LOAD_HOPS 2.0    // one queued task weighs as much as two hops
+
+typedef enum {
+    TASK_PLACE_ROUND_ROBIN,
+    TASK_PLACE_LEAST_LOADED,
+    TASK_PLACE_LOCALITY,
+    TASK_PLACE_HYBRID,
+    TASK_PLACE_POLICIES
+} task_place_policy_t;
+
+// What a policy sees for one candidate tile
+typedef struct {
+    int tile;
+    uint64_t hop_bytes;         // to move the task's data there
+    int load;                   // queued + running
+    int idle;
+} task_place_candidate_t;
+
+// Returns the index into c[] of the chosen candidate
+typedef int (*task_place_fn)(const task_t* task, const task_place_candidate_t* c, int n,
+                             uint64_t data_bytes);
+
+// Tile (1..node_count-1) for task under the current policy
+int task_place_choose(mesh_platform_t* p, task_sched_t* s, const task_t* task);
+
+void task_place_set_policy(task_place_policy_t policy);
+task_place_policy_t task_place_get_policy(void);
+// Replaces a policy's selection function, e.g. to try a new heuristic
+void task_place_set_fn(task_place_policy_t policy, task_place_fn fn);
+const char* task_place_policy_name(task_place_policy_t policy);
+// Policy by name, -1 if unknown
+int task_place_parse(const char* name);
+
+// Hop-bytes to move the task's data to tile; *data_bytes gets the bytes
+// moved (1 when only a home tile is known, 0 when nothing is)
+uint64_t task_place_hop_bytes(mesh_platform_t* p, const task_t* task, int tile, uint64_t* data_bytes);
+
+#endif
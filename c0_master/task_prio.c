@@ -0,0 +1,117 @@
+#include <string.h>
+#include "c0_master/task_prio.h"
+#include "c0_master/task_sched.h"
+#include "log/log.h"
+#include "log/log_hist.h"
+
+typedef struct {
+    uint64_t completed, deadlines, missed, max_ns;
+    uint64_t hist[LOG_HIST_BUCKETS];
+} class_stats_t;
+
+static class_stats_t g_class[TASK_SCHED_CLASSES];
+
+int task_prio_class(const task_t* task)
+{
+    switch (task->priority) {
+        case TASK_PRIO_HIGH: return 0;
+        case TASK_PRIO_LOW:  return 2;
+        default:             return TASK_SCHED_CLASS_DEFAULT;
+    }
+}
+
+const char* task_prio_name(task_prio_t prio)
+{
+    switch (prio) {
+        case TASK_PRIO_HIGH:   return "high";
+        case TASK_PRIO_NORMAL: return "normal";
+        case TASK_PRIO_LOW:    return "low";
+        default:               return "unknown";
+    }
+}
+
+void task_prio_set(task_t* task, task_prio_t prio, uint64_t deadline_us)
+{
+    if (!task) {
+        return;
+    }
+    task->priority = prio;
+    task->deadline_ns = deadline_us ? get_current_timestamp_ns() + deadline_us * 1000ULL : 0;
+}
+
+void task_prio_record(const task_t* task)
+{
+    class_stats_t* c = &g_class[task_prio_class(task)];
+    uint64_t ns = task->end_ns > task->ready_ns ? task->end_ns - task->ready_ns : 0;
+    __atomic_fetch_add(&c->completed, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&c->hist[log_hist_bucket(ns)], 1, __ATOMIC_RELAXED);
+    if (task->deadline_ns) {
+        __atomic_fetch_add(&c->deadlines, 1, __ATOMIC_RELAXED);
+        if (task->end_ns > task->deadline_ns) {
+            __atomic_fetch_add(&c->missed, 1, __ATOMIC_RELAXED);
+        }
+    }
+    uint64_t max = __atomic_load_n(&c->max_ns, __ATOMIC_RELAXED);
+    while (ns > max && !__atomic_compare_exchange_n(&c->max_ns, &max, ns, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+void task_prio_get_stats(task_prio_t prio, task_prio_stats_t* stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    task_t probe = { .priority = prio };
+    class_stats_t* c = &g_class[task_prio_class(&probe)];
+
+    uint64_t hist[LOG_HIST_BUCKETS];
+    uint64_t counted = 0;
+    for (unsigned b = 0; b < LOG_HIST_BUCKETS; b++) {
+        hist[b] = __atomic_load_n(&c->hist[b], __ATOMIC_RELAXED);
+        counted += hist[b];
+    }
+    stats->completed = __atomic_load_n(&c->completed, __ATOMIC_RELAXED);
+    stats->deadlines = __atomic_load_n(&c->deadlines, __ATOMIC_RELAXED);
+    stats->missed = __atomic_load_n(&c->missed, __ATOMIC_RELAXED);
+    stats->max_ns = __atomic_load_n(&c->max_ns, __ATOMIC_RELAXED);
+    // Counts and buckets are read separately, so use the bucket total;
+    // a bucket's top can lie past the largest value seen
+    if (counted) {
+        uint64_t* pct[] = { &stats->p50_ns, &stats->p90_ns, &stats->p99_ns };
+        const double q[] = { 0.50, 0.90, 0.99 };
+        for (int i = 0; i < 3; i++) {
+            uint64_t v = log_hist_percentile(hist, counted, q[i]);
+            *pct[i] = v < stats->max_ns ? v : stats->max_ns;
+        }
+    }
+}
+
+void task_prio_reset_stats(void)
+{
+    for (int i = 0; i < TASK_SCHED_CLASSES; i++) {
+        class_stats_t* c = &g_class[i];
+        __atomic_store_n(&c->completed, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&c->deadlines, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&c->missed, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&c->max_ns, 0, __ATOMIC_RELAXED);
+        for (unsigned b = 0; b < LOG_HIST_BUCKETS; b++) {
+            __atomic_store_n(&c->hist[b], 0, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+void task_prio_print(void)
+{
+    static const task_prio_t order[] = { TASK_PRIO_HIGH, TASK_PRIO_NORMAL, TASK_PRIO_LOW };
+    LOG_INFO("[Prio] %-7s %9s %9s %7s %7s %10s %10s %10s %10s\n",
+             "class", "tasks", "deadline", "missed", "miss%", "p50_us", "p90_us", "p99_us", "max_us");
+    for (int i = 0; i < TASK_SCHED_CLASSES; i++) {
+        task_prio_stats_t st;
+        task_prio_get_stats(order[i], &st);
+        if (!st.completed) {
+            continue;
+        }
+        LOG_INFO("[Prio] %-7s %9lu %9lu %7lu %6.1f%% %10.1f %10.1f %10.1f %10.1f\n",
+                 task_prio_name(order[i]), (unsigned long)st.completed, (unsigned long)st.deadlines,
+                 (unsigned long)st.missed, st.deadlines ? 100.0 * st.missed / st.deadlines : 0.0,
+                 st.p50_ns / 1e3, st.p90_ns / 1e3, st.p99_ns / 1e3, st.max_ns / 1e3);
+    }
+}
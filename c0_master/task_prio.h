@@ -0,0 +1,43 @@
+#ifndef TASK_PRIO_H
+#define TASK_PRIO_H
+#include <stdint.h>
+#include "c0_master/c0_controller.h"
+
+// Priority classes and deadlines for C0 tasks.
+//
+// task->priority picks the class (HIGH, NORMAL, LOW) and a nonzero
+// task->deadline_ns makes the task earliest-deadline-first within it:
+//
+//   task_prio_set(task, TASK_PRIO_HIGH, 500);   // due 500 us from now
+//   queue_task_to_tile(p, task, 0);
+//
+// Tiles take HIGH before NORMAL before LOW (task_sched.h) but never
+// preempt a running task, so a HIGH task can still wait for one whole
+// LOW task per tile. Plain NORMAL tasks keep the lock-free FIFO path.
+//
+// Every completed task is accounted to its class: response time, from
+// queueing to completion, in a log-linear histogram (16 sub-buckets per
+// power of two, so percentiles are within about 6%), and for tasks with a
+// deadline whether they finished after it.
+
+typedef struct {
+    uint64_t completed;
+    uint64_t deadlines;         // completed with a deadline
+    uint64_t missed;            // ... finished after it
+    uint64_t p50_ns, p90_ns, p99_ns, max_ns;
+} task_prio_stats_t;
+
+// Scheduler class for task (0 is dispatched first)
+int task_prio_class(const task_t* task);
+const char* task_prio_name(task_prio_t prio);
+// Sets the priority and a deadline deadline_us from now (0: none)
+void task_prio_set(task_t* task, task_prio_t prio, uint64_t deadline_us);
+
+// Called by the tile once task has run, end_ns set
+void task_prio_record(const task_t* task);
+void task_prio_get_stats(task_prio_t prio, task_prio_stats_t* stats);
+void task_prio_reset_stats(void);
+// One line per class that completed anything
+void task_prio_print(void);
+
+#endif
@@ -0,0 +1,451 @@
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include "c0_master/task_sched.h"
+#include "tile/tile_coro.h"
+
+#define MASK (TASK_SCHED_CAPACITY - 1)
+#define CORO_WAIT_POLL_US 50    // a coroutine polls the epoch, the worker runs others
+
+// ---------------------------------------------------------------------------
+// Chase-Lev deque (Le et al., "Correct and Efficient Work-Stealing for Weak
+// Memory Models"), fixed capacity
+// ---------------------------------------------------------------------------
+
+static int deque_push(sched_worker_t* w, void* item)
+{
+    int64_t b = __atomic_load_n(&w->bottom, __ATOMIC_RELAXED);
+    int64_t t = __atomic_load_n(&w->top, __ATOMIC_ACQUIRE);
+    if (b - t >= TASK_SCHED_CAPACITY) {
+        return -1;
+    }
+    __atomic_store_n(&w->ring[b & MASK], item, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&w->bottom, b + 1, __ATOMIC_RELAXED);
+    return 0;
+}
+
+static void* deque_take(sched_worker_t* w)
+{
+    int64_t b = __atomic_load_n(&w->bottom, __ATOMIC_RELAXED) - 1;
+    __atomic_store_n(&w->bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t t = __atomic_load_n(&w->top, __ATOMIC_RELAXED);
+
+    void* item = NULL;
+    if (t <= b) {
+        item = __atomic_load_n(&w->ring[b & MASK], __ATOMIC_RELAXED);
+        if (t == b) {
+            // Last item: race the thieves for it
+            if (!__atomic_compare_exchange_n(&w->top, &t, t + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+                item = NULL;
+            }
+            __atomic_store_n(&w->bottom, b + 1, __ATOMIC_RELAXED);
+        }
+    } else {
+        __atomic_store_n(&w->bottom, b + 1, __ATOMIC_RELAXED);
+    }
+    return item;
+}
+
+static void* deque_steal(sched_worker_t* w)
+{
+    for (;;) {
+        int64_t t = __atomic_load_n(&w->top, __ATOMIC_ACQUIRE);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        int64_t b = __atomic_load_n(&w->bottom, __ATOMIC_ACQUIRE);
+        if (t >= b) {
+            return NULL;
+        }
+        void* item = __atomic_load_n(&w->ring[t & MASK], __ATOMIC_RELAXED);
+        if (__atomic_compare_exchange_n(&w->top, &t, t + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            return item;
+        }
+        // Lost to the owner or another thief; look again
+    }
+}
+
+static int deque_size(sched_worker_t* w)
+{
+    int64_t b = __atomic_load_n(&w->bottom, __ATOMIC_ACQUIRE);
+    int64_t t = __atomic_load_n(&w->top, __ATOMIC_ACQUIRE);
+    return b > t ? (int)(b - t) : 0;
+}
+
+// ---------------------------------------------------------------------------
+// Inbox
+// ---------------------------------------------------------------------------
+
+static int inbox_size(sched_worker_t* w)
+{
+    return (int)mpmc_queue_size(&w->inbox);
+}
+
+// Moves the inbox into the deque so thieves can reach it lock-free while
+// the owner runs. Pushed newest first, so the owner pops in submission
+// order and thieves take the most recent submissions.
+static void inbox_drain(sched_worker_t* w)
+{
+    void* batch[TASK_SCHED_CAPACITY];
+    int room = TASK_SCHED_CAPACITY - deque_size(w);
+    int n = 0;
+    while (n < room && (batch[n] = mpmc_queue_pop(&w->inbox)) != NULL) {
+        n++;
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        deque_push(w, batch[i]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Class heap
+// ---------------------------------------------------------------------------
+
+static int entry_before(const sched_entry_t* a, const sched_entry_t* b)
+{
+    if (a->cls != b->cls) return a->cls < b->cls;
+    if (a->deadline_ns != b->deadline_ns) return a->deadline_ns < b->deadline_ns;
+    return a->seq < b->seq;
+}
+
+static int heap_push(sched_worker_t* w, void* item, int cls, uint64_t deadline_ns)
+{
+    pthread_mutex_lock(&w->heap_lock);
+    if (w->heap_n >= TASK_SCHED_HEAP) {
+        pthread_mutex_unlock(&w->heap_lock);
+        return -1;
+    }
+    sched_entry_t e = { item, cls, deadline_ns ? deadline_ns : UINT64_MAX, w->heap_seq++ };
+    int i = w->heap_n;
+    while (i > 0 && entry_before(&e, &w->heap[(i - 1) / 2])) {
+        w->heap[i] = w->heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    w->heap[i] = e;
+    __atomic_store_n(&w->heap_n, w->heap_n + 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&w->heap_lock);
+    return 0;
+}
+
+// Top item if it belongs to class cls or a more urgent one
+static void* heap_take(sched_worker_t* w, int cls)
+{
+    if (__atomic_load_n(&w->heap_n, __ATOMIC_ACQUIRE) == 0) {
+        return NULL;
+    }
+    void* item = NULL;
+    pthread_mutex_lock(&w->heap_lock);
+    if (w->heap_n > 0 && w->heap[0].cls <= cls) {
+        item = w->heap[0].item;
+        int n = w->heap_n - 1;
+        sched_entry_t last = w->heap[n];
+        int i = 0;
+        for (;;) {
+            int c = 2 * i + 1;
+            if (c >= n) break;
+            if (c + 1 < n && entry_before(&w->heap[c + 1], &w->heap[c])) c++;
+            if (!entry_before(&w->heap[c], &last)) break;
+            w->heap[i] = w->heap[c];
+            i = c;
+        }
+        w->heap[i] = last;
+        __atomic_store_n(&w->heap_n, n, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&w->heap_lock);
+    return item;
+}
+
+static int heap_size(sched_worker_t* w)
+{
+    return __atomic_load_n(&w->heap_n, __ATOMIC_ACQUIRE);
+}
+
+// ---------------------------------------------------------------------------
+// Scheduler
+// ---------------------------------------------------------------------------
+
+// The epoch bump and the sleeper check are both sequentially consistent,
+// so either the parking worker sees the new epoch or we see it parked
+static void wake_workers(task_sched_t* s)
+{
+    __atomic_fetch_add(&s->epoch, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&s->sleepers, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&s->wake_lock);
+        pthread_cond_broadcast(&s->wake);
+        pthread_mutex_unlock(&s->wake_lock);
+    }
+}
+
+static int hops(const sched_worker_t* a, const sched_worker_t* b)
+{
+    return abs(a->x - b->x) + abs(a->y - b->y);
+}
+
+// Victims sorted by hop distance, ties by distance in worker index
+static void order_victims(task_sched_t* s)
+{
+    for (int i = 0; i < s->workers; i++) {
+        sched_worker_t* w = &s->w[i];
+        int n = 0;
+        for (int k = 1; k < s->workers; k++) {
+            int v = (i + k) % s->workers;
+            int j = n++;
+            while (j > 0 && hops(w, &s->w[w->victims[j - 1]]) > hops(w, &s->w[v])) {
+                w->victims[j] = w->victims[j - 1];
+                j--;
+            }
+            w->victims[j] = v;
+        }
+    }
+}
+
+int task_sched_init(task_sched_t* s, int workers)
+{
+    if (!s || workers <= 0 || workers > TASK_SCHED_MAX_WORKERS) {
+        return -1;
+    }
+    memset(s, 0, sizeof(*s));
+    s->workers = workers;
+    for (int i = 0; i < workers; i++) {
+        s->w[i].x = i;
+        // The heap lives outside s: schedulers sit in statics and on stacks
+        s->w[i].heap = malloc(TASK_SCHED_HEAP * sizeof(sched_entry_t));
+        if (!s->w[i].heap || mpmc_queue_init(&s->w[i].inbox, TASK_SCHED_INBOX) != 0) {
+            free(s->w[i].heap);
+            while (i-- > 0) {
+                mpmc_queue_destroy(&s->w[i].inbox);
+                free(s->w[i].heap);
+                pthread_mutex_destroy(&s->w[i].heap_lock);
+            }
+            return -1;
+        }
+        pthread_mutex_init(&s->w[i].heap_lock, NULL);
+    }
+    pthread_mutex_init(&s->wake_lock, NULL);
+    pthread_cond_init(&s->wake, NULL);
+    order_victims(s);
+    return 0;
+}
+
+void task_sched_destroy(task_sched_t* s)
+{
+    if (!s) {
+        return;
+    }
+    for (int i = 0; i < s->workers; i++) {
+        mpmc_queue_destroy(&s->w[i].inbox);
+        free(s->w[i].heap);
+        s->w[i].heap = NULL;
+        pthread_mutex_destroy(&s->w[i].heap_lock);
+    }
+    pthread_mutex_destroy(&s->wake_lock);
+    pthread_cond_destroy(&s->wake);
+}
+
+void task_sched_set_coords(task_sched_t* s, int worker, int x, int y)
+{
+    if (!s || worker < 0 || worker >= s->workers) {
+        return;
+    }
+    s->w[worker].x = x;
+    s->w[worker].y = y;
+    order_victims(s);
+}
+
+int task_sched_submit(task_sched_t* s, int worker, void* item)
+{
+    if (!s || !item || worker < 0 || worker >= s->workers) {
+        return -1;
+    }
+    // Count it first so pending never drops below what is really queued
+    __atomic_fetch_add(&s->pending, 1, __ATOMIC_RELEASE);
+    if (mpmc_queue_push(&s->w[worker].inbox, item) != 0) {
+        __atomic_fetch_sub(&s->pending, 1, __ATOMIC_RELEASE);
+        return -1;
+    }
+    wake_workers(s);
+    return 0;
+}
+
+int task_sched_submit_class(task_sched_t* s, int worker, void* item, int cls, uint64_t deadline_ns)
+{
+    if (!s || !item || worker < 0 || worker >= s->workers || cls < 0 || cls >= TASK_SCHED_CLASSES) {
+        return -1;
+    }
+    if (cls == TASK_SCHED_CLASS_DEFAULT && !deadline_ns) {
+        return task_sched_submit(s, worker, item);
+    }
+    __atomic_fetch_add(&s->pending, 1, __ATOMIC_RELEASE);
+    if (heap_push(&s->w[worker], item, cls, deadline_ns) != 0) {
+        __atomic_fetch_sub(&s->pending, 1, __ATOMIC_RELEASE);
+        return -1;
+    }
+    wake_workers(s);
+    return 0;
+}
+
+int task_sched_least_loaded(task_sched_t* s)
+{
+    if (!s || s->workers <= 0) {
+        return -1;
+    }
+    int start = __atomic_fetch_add(&s->rotor, 1, __ATOMIC_RELAXED) % s->workers;
+    int best = -1, best_load = 0;
+    for (int k = 0; k < s->workers; k++) {
+        int i = (start + k) % s->workers;
+        int load = task_sched_load(s, i);
+        if (best < 0 || load < best_load) {
+            best = i;
+            best_load = load;
+        }
+    }
+    return best;
+}
+
+int task_sched_load(task_sched_t* s, int worker)
+{
+    if (!s || worker < 0 || worker >= s->workers) {
+        return 0;
+    }
+    sched_worker_t* w = &s->w[worker];
+    return deque_size(w) + inbox_size(w) + heap_size(w) + __atomic_load_n(&w->busy, __ATOMIC_RELAXED);
+}
+
+void* task_sched_next(task_sched_t* s, int worker, int* stolen)
+{
+    if (stolen) {
+        *stolen = 0;
+    }
+    if (!s || worker < 0 || worker >= s->workers) {
+        return NULL;
+    }
+    if (__atomic_load_n(&s->pending, __ATOMIC_ACQUIRE) == 0) {
+        return NULL;
+    }
+
+    sched_worker_t* self = &s->w[worker];
+    void* item = NULL;
+    for (int cls = 0; !item && cls < TASK_SCHED_CLASSES; cls++) {
+        item = heap_take(self, cls);
+        if (!item && cls == TASK_SCHED_CLASS_DEFAULT) {
+            item = deque_take(self);
+            if (!item && inbox_size(self) > 0) {
+                inbox_drain(self);
+                item = deque_take(self);
+            }
+        }
+
+        // Rob the nearest busy worker; an idle one will get to its work itself
+        for (int k = 0; !item && k < s->workers - 1; k++) {
+            sched_worker_t* victim = &s->w[self->victims[k]];
+            if (!__atomic_load_n(&victim->busy, __ATOMIC_ACQUIRE)) {
+                continue;
+            }
+            item = heap_take(victim, cls);
+            if (!item && cls == TASK_SCHED_CLASS_DEFAULT) {
+                item = deque_steal(victim);
+                if (!item) {
+                    item = mpmc_queue_pop(&victim->inbox);
+                }
+            }
+            if (item) {
+                __atomic_store_n(&self->stolen, self->stolen + 1, __ATOMIC_RELAXED);
+                if (stolen) {
+                    *stolen = 1;
+                }
+            }
+        }
+    }
+
+    if (item) {
+        __atomic_fetch_sub(&s->pending, 1, __ATOMIC_RELEASE);
+    }
+    return item;
+}
+
+void task_sched_begin(task_sched_t* s, int worker)
+{
+    if (!s || worker < 0 || worker >= s->workers) {
+        return;
+    }
+    sched_worker_t* w = &s->w[worker];
+    __atomic_store_n(&w->busy, 1, __ATOMIC_RELEASE);
+    // Whatever is still queued here just became stealable
+    if (deque_size(w) > 0 || inbox_size(w) > 0 || heap_size(w) > 0) {
+        wake_workers(s);
+    }
+}
+
+void task_sched_end(task_sched_t* s, int worker, uint64_t elapsed_ns)
+{
+    if (!s || worker < 0 || worker >= s->workers) {
+        return;
+    }
+    sched_worker_t* w = &s->w[worker];
+    __atomic_store_n(&w->busy, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&w->executed, w->executed + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&w->busy_ns, w->busy_ns + elapsed_ns, __ATOMIC_RELAXED);
+}
+
+int task_sched_pending(task_sched_t* s)
+{
+    return s ? __atomic_load_n(&s->pending, __ATOMIC_ACQUIRE) : 0;
+}
+
+uint64_t task_sched_epoch(task_sched_t* s)
+{
+    return s ? __atomic_load_n(&s->epoch, __ATOMIC_SEQ_CST) : 0;
+}
+
+void task_sched_wait(task_sched_t* s, uint64_t seen)
+{
+    if (!s) {
+        return;
+    }
+    if (coro_active()) {
+        while (__atomic_load_n(&s->epoch, __ATOMIC_SEQ_CST) == seen &&
+               !__atomic_load_n(&s->stopped, __ATOMIC_SEQ_CST)) {
+            coro_sleep_us(CORO_WAIT_POLL_US);
+        }
+        return;
+    }
+    pthread_mutex_lock(&s->wake_lock);
+    __atomic_fetch_add(&s->sleepers, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&s->epoch, __ATOMIC_SEQ_CST) == seen && !s->stopped) {
+        pthread_cond_wait(&s->wake, &s->wake_lock);
+    }
+    __atomic_fetch_sub(&s->sleepers, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&s->wake_lock);
+}
+
+void task_sched_stop(task_sched_t* s)
+{
+    if (!s) {
+        return;
+    }
+    pthread_mutex_lock(&s->wake_lock);
+    __atomic_store_n(&s->stopped, 1, __ATOMIC_SEQ_CST);
+    pthread_cond_broadcast(&s->wake);
+    pthread_mutex_unlock(&s->wake_lock);
+}
+
+void task_sched_get_stats(task_sched_t* s, int worker, task_sched_stats_t* stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    if (!s || worker < 0 || worker >= s->workers) {
+        return;
+    }
+    sched_worker_t* w = &s->w[worker];
+    stats->executed = __atomic_load_n(&w->executed, __ATOMIC_RELAXED);
+    stats->stolen = __atomic_load_n(&w->stolen, __ATOMIC_RELAXED);
+    stats->busy_ns = __atomic_load_n(&w->busy_ns, __ATOMIC_RELAXED);
+}
+
+void task_sched_reset_stats(task_sched_t* s)
+{
+    for (int i = 0; s && i < s->workers; i++) {
+        __atomic_store_n(&s->w[i].executed, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s->w[i].stolen, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&s->w[i].busy_ns, 0, __ATOMIC_RELAXED);
+    }
+}
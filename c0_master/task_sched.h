@@ -0,0 +1,124 @@
+#ifndef TASK_SCHED_H
+#define TASK_SCHED_H
+#include <stdint.h>
+#include <pthread.h>
+#include "c0_master/mpmc_queue.h"
+
+// Work-stealing task scheduler for the tile processor threads.
+//
+// Every worker owns a Chase-Lev deque: the owner pushes and pops at the
+// bottom without locks, idle workers steal from the top. The submitter
+// (C0) is not an owner, so submissions land in a lock-free per-worker
+// inbox (MPMC queue) that the owner drains into its deque between tasks. Thieves only rob
+// workers that are busy running a task - an idle owner gets to its own
+// (home) work first - and try the nearest workers in the mesh first, so
+// stolen work stays close to its data.
+//
+//   task_sched_init(&s, workers);
+//   task_sched_submit(&s, home, item);          // any thread
+//   void* item = task_sched_next(&s, w, &stolen); // worker w only
+//   task_sched_begin(&s, w); run(item); task_sched_end(&s, w, elapsed_ns);
+//
+// Idle workers park on a condition variable instead of polling: read
+// task_sched_epoch() before looking for work and pass it to
+// task_sched_wait(), which returns as soon as anything was submitted (or
+// became stealable) since. Submitting costs no lock while nobody is parked.
+//
+// Dispatch classes (task_sched_submit_class): class 0 goes first. Items of
+// TASK_SCHED_CLASS_DEFAULT without a deadline take the lock-free path
+// above; everything else waits in a small per-worker heap ordered by
+// (class, deadline, arrival) - earliest deadline first within a class,
+// FIFO among equal deadlines, no deadline counting as the latest. A worker
+// finishes one class, its own and then stolen, before the next, so an idle
+// tile takes urgent work from a busy one ahead of its own default work.
+// Nothing is preempted: a running item always finishes first.
+
+#define TASK_SCHED_MAX_WORKERS 16
+#define TASK_SCHED_CAPACITY    64      // per deque, power of two
+#define TASK_SCHED_INBOX       8192    // per inbox; the backlog waits here
+#define TASK_SCHED_HEAP        1024    // classed items per worker
+#define TASK_SCHED_CLASSES     3
+#define TASK_SCHED_CLASS_DEFAULT 1
+
+typedef struct {
+    void* item;
+    int cls;
+    uint64_t deadline_ns;       // UINT64_MAX for none
+    uint64_t seq;
+} sched_entry_t;
+
+typedef struct {
+    // Chase-Lev deque; top and bottom only ever grow
+    int64_t top;
+    int64_t bottom;
+    void* ring[TASK_SCHED_CAPACITY];
+
+    mpmc_queue_t inbox;
+
+    // Classed and deadline items, a binary heap under heap_lock; heap_n
+    // is also read without it as a hint
+    pthread_mutex_t heap_lock;
+    sched_entry_t* heap;
+    int heap_n;
+    uint64_t heap_seq;
+
+    int busy;
+    int x, y;
+    int victims[TASK_SCHED_MAX_WORKERS - 1];  // nearest first
+
+    uint64_t executed;
+    uint64_t stolen;            // items this worker took from others
+    uint64_t busy_ns;
+} sched_worker_t;
+
+typedef struct {
+    int workers;
+    int pending;                // submitted, not yet taken (counted before the push)
+    int rotor;                  // spreads ties in task_sched_least_loaded
+    sched_worker_t w[TASK_SCHED_MAX_WORKERS];
+
+    uint64_t epoch;             // bumped whenever work may have appeared
+    int sleepers;
+    int stopped;
+    pthread_mutex_t wake_lock;
+    pthread_cond_t wake;
+} task_sched_t;
+
+typedef struct {
+    uint64_t executed;
+    uint64_t stolen;
+    uint64_t busy_ns;
+} task_sched_stats_t;
+
+int task_sched_init(task_sched_t* s, int workers);
+void task_sched_destroy(task_sched_t* s);
+// Mesh position of a worker; steals prefer victims fewer hops away
+void task_sched_set_coords(task_sched_t* s, int worker, int x, int y);
+
+// Queues item on worker's inbox; -1 if the worker is invalid or full
+int task_sched_submit(task_sched_t* s, int worker, void* item);
+// Queues item in class cls (0 first) with an absolute deadline (0: none)
+int task_sched_submit_class(task_sched_t* s, int worker, void* item, int cls, uint64_t deadline_ns);
+// Least loaded worker, counting queued items and a running task
+int task_sched_least_loaded(task_sched_t* s);
+// That load for one worker (approximate while others submit and steal)
+int task_sched_load(task_sched_t* s, int worker);
+// Next item for worker, or NULL: per class from the top, own heap, for
+// the default class own deque then inbox, then steals
+void* task_sched_next(task_sched_t* s, int worker, int* stolen);
+// Bracket the execution of an item; a busy worker may be stolen from
+void task_sched_begin(task_sched_t* s, int worker);
+void task_sched_end(task_sched_t* s, int worker, uint64_t elapsed_ns);
+int task_sched_pending(task_sched_t* s);
+
+uint64_t task_sched_epoch(task_sched_t* s);
+// Parks until the epoch moves past seen or the scheduler is stopped; a
+// coroutine polls instead so the others on its worker keep running
+void task_sched_wait(task_sched_t* s, uint64_t seen);
+// Releases every parked worker, now and in future waits
+void task_sched_stop(task_sched_t* s);
+
+void task_sched_get_stats(task_sched_t* s, int worker, task_sched_stats_t* stats);
+void task_sched_reset_stats(task_sched_t* s);
+
+#endif
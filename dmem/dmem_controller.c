@@ -1,5 +1,6 @@
 #include "dmem_controller.h"
 #include "platform_init/address_manager.h"
+#include "mem_ops/mem_ops.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -46,7 +47,7 @@ int dmem_read(int dmem_id, uint64_t offset, uint8_t* buffer, size_t size) {
     if (!src_ptr) return -1;
     
     // Simulate DMEM read operation
-    memcpy(buffer, src_ptr, size);
+    mem_ops_copy(buffer, src_ptr, size);
     return (int)size;
 }
 
@@ -69,7 +70,7 @@ int dmem_write(int dmem_id, uint64_t offset, const uint8_t* buffer, size_t size)
     if (!dst_ptr) return -1;
     
     // Simulate DMEM write operation
-    memcpy(dst_ptr, buffer, size);
+    mem_ops_copy(dst_ptr, buffer, size);
     return (int)size;
 }
 
@@ -92,7 +93,7 @@ int dmem_copy(uint64_t src_addr, uint64_t dst_addr, size_t size) {
     if (!src_ptr || !dst_ptr) return -1;
     
     // Simulate DMEM-to-DMEM copy operation
-    memcpy(dst_ptr, src_ptr, size);
+    mem_ops_copy(dst_ptr, src_ptr, size);
     return 0;  // Return 0 for success (not byte count)
 }
 
@@ -47,6 +47,7 @@
 #include "hal_dmac512.h"
 #include "../platform_init/address_manager.h"
 #include "../generated/mem_map.h"
+#include "../mem_ops/mem_ops.h"
 #include <string.h>
 
 /** @defgroup DMAC512 HAL driver module
@@ -91,6 +92,9 @@ int32_t HAL_DMAC512ConfigureChannel(DMAC512_HandleTypeDef *dmac512_handle)
 
 	// Set DMAC512 DMAC mode 
 	SET_DMAC512_CTRL_MODE(dmac512_handle->Instance->DMAC_CONTROL,dmac512_handle->Init.DmacMode); 
+
+	// Enable/disable CRC32C generation
+	SET_DMAC512_CTRL_CRC_EN(dmac512_handle->Instance->DMAC_CONTROL,dmac512_handle->Init.CrcEnable ? 1U : 0U);
 	
 	// Set DMAC512 Source address
 	SET_DMAC512_SRC_ADDR(dmac512_handle->Instance->DMAC_SRC_ADDR,dmac512_handle->Init.SrcAddr); 
@@ -100,6 +104,15 @@ int32_t HAL_DMAC512ConfigureChannel(DMAC512_HandleTypeDef *dmac512_handle)
 	
 	// Set DMAC512 Transfer count value
 	SET_DMAC512_TOTAL_XFER_CNT(dmac512_handle->Instance->DMAC_TOTAL_XFER_CNT,dmac512_handle->Init.XferCount); 
+
+	// Fill modes take their data from the fill registers instead of a source address
+	if (dmac512_handle->Init.DmacMode == DMAC512_FILL_CONST_MODE ||
+	    dmac512_handle->Init.DmacMode == DMAC512_FILL_INCR_MODE) {
+		SET_DMAC512_FILL_DATA(dmac512_handle->Instance->DMAC_FILL_DATA,dmac512_handle->Init.FillData);
+	} else if (dmac512_handle->Init.DmacMode == DMAC512_FILL_PATTERN_MODE) {
+		memcpy((void*)dmac512_handle->Instance->DMAC_FILL_PATTERN, dmac512_handle->Init.FillPattern,
+		       DMAC512_FILL_PATTERN_BYTES);
+	}
  
 	return 0;  // Success
 }
@@ -121,15 +134,39 @@ void HAL_DMAC512StartTransfers(DMAC512_HandleTypeDef *dmac512_handle)
 	uint64_t src_addr = dmac512_handle->Init.SrcAddr;
 	uint64_t dst_addr = dmac512_handle->Init.DstAddr;
 	uint32_t size = dmac512_handle->Init.XferCount;
+	uint32_t mode = GET_DMAC512_MODE(dmac512_handle->Instance->DMAC_CONTROL);
+	uint32_t crc_en = GET_DMAC512_CRC_EN(dmac512_handle->Instance->DMAC_CONTROL);
 	
 	// Translate addresses to pointers for simulation
-	uint8_t* src_ptr = addr_to_ptr(src_addr);
 	uint8_t* dst_ptr = addr_to_ptr(dst_addr);
+	bool valid = dst_ptr && validate_address(dst_addr, size);
 	
-	if (src_ptr && dst_ptr && validate_address(src_addr, size) && validate_address(dst_addr, size)) {
-		// Simulate DMA transfer
-		memcpy(dst_ptr, src_ptr, size);
-		
+	if (valid && mode == DMAC512_NORMAL_MODE) {
+		uint8_t* src_ptr = addr_to_ptr(src_addr);
+		valid = src_ptr && validate_address(src_addr, size);
+		if (valid && crc_en) {
+			// Simulate DMA transfer with the CRC unit snooping the write stream
+			dmac512_handle->Instance->DMAC_CRC_RESULT = mem_ops_copy_crc32c(dst_ptr, src_ptr, size, 0);
+		} else if (valid) {
+			// Simulate DMA transfer
+			mem_ops_copy(dst_ptr, src_ptr, size);
+		}
+	} else if (valid) {
+		// Simulate DMA fill engine
+		uint8_t fill_data = (uint8_t)GET_DMAC512_FILL_DATA(dmac512_handle->Instance->DMAC_FILL_DATA);
+		if (mode == DMAC512_FILL_CONST_MODE) {
+			mem_ops_fill(dst_ptr, fill_data, size);
+		} else if (mode == DMAC512_FILL_INCR_MODE) {
+			mem_ops_fill_ramp(dst_ptr, fill_data, size);
+		} else {
+			mem_ops_fill_pattern(dst_ptr, (const uint8_t*)dmac512_handle->Instance->DMAC_FILL_PATTERN, size);
+		}
+		if (crc_en) {
+			dmac512_handle->Instance->DMAC_CRC_RESULT = mem_ops_crc32c(0, dst_ptr, size);
+		}
+	}
+	
+	if (valid) {
 		// Mark transfer as complete by clearing busy bit
 		dmac512_handle->Instance->DMAC_STATUS &= ~DMAC512_STATUS_DMAC_BUSY_MASK;
 		
@@ -191,6 +228,7 @@ int HAL_DMAC512InitTile(DMAC512_HandleTypeDef *dmac512_handle, int tile_id)
 	dmac512_handle->Init.SrcAddr = 0;
 	dmac512_handle->Init.DstAddr = 0;
 	dmac512_handle->Init.XferCount = 0;
+	dmac512_handle->Init.CrcEnable = false;
 	
 	// Reset DMA controller
 	SET_DMAC512_CTRL_RST(dmac512_handle->Instance->DMAC_CONTROL, 1);
@@ -226,6 +264,7 @@ int HAL_DMAC512Transfer(DMAC512_HandleTypeDef *dmac512_handle,
 	}
 	
 	// Configure transfer parameters
+	dmac512_handle->Init.DmacMode = DMAC512_NORMAL_MODE;
 	dmac512_handle->Init.SrcAddr = src_addr;
 	dmac512_handle->Init.DstAddr = dst_addr;
 	dmac512_handle->Init.XferCount = (uint32_t)size;
@@ -247,4 +286,74 @@ int HAL_DMAC512Transfer(DMAC512_HandleTypeDef *dmac512_handle,
 	return (int)size;
 }
 
+/**
+ * @brief Fills a memory range using the DMAC512 fill engine
+ *
+ * @param[in] dmac512_handle handle pointer.
+ * @param[in] dst_addr Destination address to fill.
+ * @param[in] size Fill size in bytes.
+ * @param[in] mode One of the DMAC512_FILL_*_MODE values.
+ * @param[in] value Fill byte (constant mode) or first byte (incrementing mode).
+ * @param[in] pattern 64-byte pattern for pattern mode, ignored otherwise.
+ * @param[out] None.
+ * @return Fill size on success, -1 on failure
+ */
+int HAL_DMAC512Fill(DMAC512_HandleTypeDef *dmac512_handle, uint64_t dst_addr, size_t size,
+                    DMAC512_OP_MODE_t mode, uint8_t value, const uint8_t *pattern)
+{
+	if (!dmac512_handle || size == 0 || size > 0xFFFFFF) {  // 24-bit max size
+		return -1;
+	}
+	if (mode != DMAC512_FILL_CONST_MODE && mode != DMAC512_FILL_INCR_MODE &&
+	    mode != DMAC512_FILL_PATTERN_MODE) {
+		return -1;
+	}
+	if (mode == DMAC512_FILL_PATTERN_MODE && !pattern) {
+		return -1;
+	}
+	
+	// Validate destination
+	if (!validate_address(dst_addr, size)) {
+		return -1;
+	}
+	
+	// Configure fill parameters
+	dmac512_handle->Init.DmacMode = mode;
+	dmac512_handle->Init.SrcAddr = 0;
+	dmac512_handle->Init.DstAddr = dst_addr;
+	dmac512_handle->Init.XferCount = (uint32_t)size;
+	dmac512_handle->Init.FillData = value;
+	if (mode == DMAC512_FILL_PATTERN_MODE) {
+		memcpy(dmac512_handle->Init.FillPattern, pattern, DMAC512_FILL_PATTERN_BYTES);
+	}
+	
+	int32_t config_result = HAL_DMAC512ConfigureChannel(dmac512_handle);
+	
+	// Leave the channel in copy mode for subsequent transfers
+	dmac512_handle->Init.DmacMode = DMAC512_NORMAL_MODE;
+	if (config_result != 0) {
+		return -1;
+	}
+	
+	// Mark as busy before starting fill
+	dmac512_handle->Instance->DMAC_STATUS |= DMAC512_STATUS_DMAC_BUSY_MASK;
+	
+	// Start fill (performed synchronously in simulation)
+	HAL_DMAC512StartTransfers(dmac512_handle);
+	
+	return (int)size;
+}
+
+/**
+ * @brief Returns the CRC32C computed by the last transfer or fill
+ *
+ * @param[in] dmac512_handle handle pointer.
+ * @param[out] None.
+ * @return Content of the CRC result register
+ */
+uint32_t HAL_DMAC512GetCrc(DMAC512_HandleTypeDef *dmac512_handle)
+{
+	return GET_DMAC512_CRC_RESULT(dmac512_handle->Instance->DMAC_CRC_RESULT);
+}
+
 /** @} */ // End of Driver DMAC512 group
@@ -83,6 +83,9 @@ typedef enum {
 typedef enum {
 
     DMAC512_NORMAL_MODE = 0,  			      /*!< normal transfer mode(default) */
+    DMAC512_FILL_CONST_MODE,  			      /*!< fill destination with FILL_DATA */
+    DMAC512_FILL_INCR_MODE,   			      /*!< fill destination with FILL_DATA + i */
+    DMAC512_FILL_PATTERN_MODE 			      /*!< repeat the 64-byte FILL_PATTERN */
 
 } DMAC512_OP_MODE_t;
 
@@ -111,6 +114,10 @@ typedef struct{
     uint64_t	DstAddr;	          /*!< destination address */ 
     uint32_t	XferCount;	        /*!< Total transfer count in byte */ 
 
+    bool    	CrcEnable;	        /*!< compute CRC32C of the written data */
+    uint8_t 	FillData;	          /*!< fill byte for constant/incrementing fill modes */
+    uint8_t 	FillPattern[DMAC512_FILL_PATTERN_BYTES]; /*!< pattern for pattern fill mode */
+
 }DMAC512_InitTypdef;
 
 
@@ -193,6 +200,31 @@ int HAL_DMAC512InitTile(DMAC512_HandleTypeDef *dmac512_handle, int tile_id);
 int HAL_DMAC512Transfer(DMAC512_HandleTypeDef *dmac512_handle, 
                        uint64_t src_addr, uint64_t dst_addr, size_t size);
 
+/**
+ * @brief Fills a memory range using the DMAC512 fill engine
+ *
+ * @param[in] dmac512_handle handle pointer.
+ * @param[in] dst_addr Destination address to fill.
+ * @param[in] size Fill size in bytes.
+ * @param[in] mode One of the DMAC512_FILL_*_MODE values.
+ * @param[in] value Fill byte (constant mode) or first byte (incrementing mode).
+ * @param[in] pattern 64-byte pattern for pattern mode, ignored otherwise.
+ * @param[out] None.
+ * @return Fill size on success, -1 on failure
+ */
+int HAL_DMAC512Fill(DMAC512_HandleTypeDef *dmac512_handle, uint64_t dst_addr, size_t size,
+                    DMAC512_OP_MODE_t mode, uint8_t value, const uint8_t *pattern);
+
+/**
+ * @brief Returns the CRC32C computed by the last transfer or fill
+ *        (valid only when Init.CrcEnable was set for that transfer)
+ *
+ * @param[in] dmac512_handle handle pointer.
+ * @param[out] None.
+ * @return Content of the CRC result register
+ */
+uint32_t HAL_DMAC512GetCrc(DMAC512_HandleTypeDef *dmac512_handle);
+
 /** @} */ // End of HAL DMAC512 group
 
 #ifdef __cplusplus
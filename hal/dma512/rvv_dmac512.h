@@ -82,6 +82,12 @@ typedef struct {
     __IO uint32_t   DMAC_TOTAL_XFER_CNT;      /*!< Reserved (0x40) */
     __IO uint32_t   RESERVED4[3];        	 	  /*!< Reserved (Offset 0x44 - 0x4F) */
 
+    __IO uint32_t   DMAC_FILL_DATA;           /*!< DMAC512 fill data register (Offset 0x50) */
+    __IO uint32_t   DMAC_CRC_RESULT;          /*!< DMAC512 CRC32C of last transfer (Offset 0x54) */
+    __IO uint32_t   RESERVED5[2];        	 	  /*!< Reserved (Offset 0x58 - 0x5F) */
+
+    __IO uint32_t   DMAC_FILL_PATTERN[16];    /*!< DMAC512 64-byte fill pattern (Offset 0x60 - 0x9F) */
+
 } DMAC512_RegDef;
 
 /** @} */ // End of DMAC512 register offset structure definition
@@ -102,12 +108,14 @@ typedef struct {
 #define DMAC512_CTRL_DOB_B_SHIFT        (20)    // [22:20]
 #define DMAC512_CTRL_DFB_B_SHIFT        (16)    // [18:16]
 #define DMAC512_CTRL_DMAC_MODE_SHIFT     (8)   	// [9:8]
+#define DMAC512_CTRL_CRC_EN_SHIFT        (4)   	// [4]
 #define DMAC512_CTRL_DMAC_RST_SHIFT    	 (0)   	// [0]
 											
 /* bit masks */
 #define DMAC512_CTRL_DOB_B_MASK         ( 0x7 << DMAC512_CTRL_DOB_B_SHIFT )      // 3 bits
 #define DMAC512_CTRL_DFB_B_MASK         ( 0x7 << DMAC512_CTRL_DFB_B_SHIFT )      // 3 bits
 #define DMAC512_CTRL_DMAC_MODE_MASK    	( 0x3 << DMAC512_CTRL_DMAC_MODE_SHIFT )  // 2 bits
+#define DMAC512_CTRL_CRC_EN_MASK       	( 0x1 << DMAC512_CTRL_CRC_EN_SHIFT )     // 1 bit
 #define DMAC512_CTRL_DMAC_RST_MASK    	( 0x1 << DMAC512_CTRL_DMAC_RST_SHIFT )   // 1 bit
 
 /* operation */
@@ -115,11 +123,13 @@ typedef struct {
 #define SET_DMAC512_CTRL_DFB_B(REG,VAL)  ( (REG) = ( (REG) & ~DMAC512_CTRL_DFB_B_MASK )   | ( (VAL) << DMAC512_CTRL_DFB_B_SHIFT) )
 #define SET_DMAC512_CTRL_MODE(REG, VAL)  ( (REG) = ( (REG) & ~DMAC512_CTRL_DMAC_MODE_MASK)| ( (VAL) << DMAC512_CTRL_DMAC_MODE_SHIFT) )
 #define SET_DMAC512_CTRL_RST(REG, VAL)   ( (REG) = ( (REG) & ~DMAC512_CTRL_DMAC_RST_MASK) | ( (VAL) << DMAC512_CTRL_DMAC_RST_SHIFT) )
+#define SET_DMAC512_CTRL_CRC_EN(REG, VAL)( (REG) = ( (REG) & ~DMAC512_CTRL_CRC_EN_MASK)   | ( (VAL) << DMAC512_CTRL_CRC_EN_SHIFT) )
 
 #define GET_DMAC512_DOB_B(REG)      ( ((REG) & DMAC512_CTRL_DOB_B_MASK)     >> DMAC512_CTRL_DOB_B_SHIFT )
 #define GET_DMAC512_DFB_B(REG)      ( ((REG) & DMAC512_CTRL_DFB_B_MASK)     >> DMAC512_CTRL_DFB_B_SHIFT )
 #define GET_DMAC512_MODE(REG)       ( ((REG) & DMAC512_CTRL_DMAC_MODE_MASK) >> DMAC512_CTRL_DMAC_MODE_SHIFT )
 #define GET_DMAC512_RST(REG)        ( ((REG) & DMAC512_CTRL_DMAC_RST_MASK ) >> DMAC512_CTRL_DMAC_RST_SHIFT )
+#define GET_DMAC512_CRC_EN(REG)     ( ((REG) & DMAC512_CTRL_CRC_EN_MASK )   >> DMAC512_CTRL_CRC_EN_SHIFT )
 
 
 /**************************************************************************
@@ -210,6 +220,38 @@ typedef struct {
 #define GET_DMAC512_TOTAL_XFER_CNT(REG)    ( (REG) = ((REG) & DMAC512_TOTAL_XFER_CNT_MASK) >> DMAC512_TOTAL_XFER_CNT_SHIFT )
 
 
+/*************************************************************************************************
+ *  bit masks and positions of DMAC512 fill data register (Offset 0x50)
+ *  Used by the constant (start byte of the ramp for incrementing) fill modes
+ *************************************************************************************************/
+
+/* bit positions */
+#define DMAC512_FILL_DATA_SHIFT    (0)   // [7:0]
+
+/* bit masks */
+#define DMAC512_FILL_DATA_MASK     ( 0xFFU << DMAC512_FILL_DATA_SHIFT )   // 8 bits
+
+/* operation */
+#define SET_DMAC512_FILL_DATA(REG, VAL)    ( (REG) = ((REG) & ~DMAC512_FILL_DATA_MASK) | ((VAL) << DMAC512_FILL_DATA_SHIFT) )
+#define GET_DMAC512_FILL_DATA(REG)         ( ((REG) & DMAC512_FILL_DATA_MASK) >> DMAC512_FILL_DATA_SHIFT )
+
+
+/*************************************************************************************************
+ *  DMAC512 CRC result register (Offset 0x54)
+ *  CRC32C (Castagnoli) of the bytes written by the last transfer/fill when CRC_EN is set
+ *************************************************************************************************/
+
+#define GET_DMAC512_CRC_RESULT(REG)        ( (uint32_t)(REG) )
+
+
+/*************************************************************************************************
+ *  DMAC512 fill pattern registers (Offset 0x60 - 0x9F)
+ *  16 x 32-bit words holding one 512-bit beat, repeated by the pattern fill mode
+ *************************************************************************************************/
+
+#define DMAC512_FILL_PATTERN_BYTES    (64)
+
+
 /** @} */ // End of Driver DMAC512 group
 
 #ifdef __cplusplus
@@ -0,0 +1,130 @@
+// hal_example.c – example external HAL for HAL=hal_plugins/hal_example.so
+//
+// Overrides the memory access slots with a translation-caching variant:
+// each thread remembers the last DLM/DMEM region it touched, so repeated
+// accesses skip the address manager's region scans. All other slots fall
+// back to the reference HAL. Simulator symbols (address manager, mem_ops,
+// range locks) resolve against soc_top, which is linked with -rdynamic.
+
+#include <stdio.h>
+#include "hal_tests/hal_interface.h"
+#include "hal_tests/hal_range_lock.h"
+#include "platform_init/address_manager.h"
+#include "mem_ops/mem_ops.h"
+#include "generated/mem_map.h"
+
+static __thread struct {
+    uint64_t base, size;
+    uint8_t* ptr;
+} t_last;
+
+static uint8_t* translate(uint64_t addr, size_t size)
+{
+    if (size == 0) {
+        return NULL;
+    }
+    if (addr >= t_last.base && addr - t_last.base + size <= t_last.size) {
+        return t_last.ptr + (addr - t_last.base);
+    }
+    if (!validate_address(addr, size)) {
+        return NULL;
+    }
+
+    uint64_t base, region_size;
+    static const uint64_t dmem_bases[NUM_DMEMS] = {
+        DMEM0_512_BASE, DMEM1_512_BASE, DMEM2_512_BASE, DMEM3_512_BASE,
+        DMEM4_512_BASE, DMEM5_512_BASE, DMEM6_512_BASE, DMEM7_512_BASE
+    };
+    int tile = get_tile_id_from_address(addr);
+    switch (get_address_region(addr)) {
+    case ADDR_TILE_DLM64:
+        base = TILE0_DLM_64_BASE + (uint64_t)tile * TILE_STRIDE;
+        region_size = DLM_64_SIZE;
+        break;
+    case ADDR_TILE_DLM1_512:
+        base = TILE0_DLM1_512_BASE + (uint64_t)tile * TILE_STRIDE;
+        region_size = DLM1_512_SIZE;
+        break;
+    case ADDR_DMEM_512:
+        base = dmem_bases[get_dmem_id_from_address(addr)];
+        region_size = DMEM_512_SIZE;
+        break;
+    default:
+        return addr_to_ptr(addr);
+    }
+
+    uint8_t* ptr = addr_to_ptr(base);
+    if (!ptr) {
+        return NULL;
+    }
+    t_last.base = base;
+    t_last.size = region_size;
+    t_last.ptr = ptr;
+    return ptr + (addr - base);
+}
+
+static int ex_memory_read(uint64_t addr, uint8_t* buffer, size_t size)
+{
+    uint8_t* src = translate(addr, size);
+    if (!src || !buffer) return -1;
+    hal_range_lock_t lock;
+    hal_range_lock_init(&lock);
+    hal_range_lock_add(&lock, addr, size, 0);
+    hal_range_lock_acquire(&lock);
+    mem_ops_copy(buffer, src, size);
+    hal_range_lock_release(&lock);
+    return (int)size;
+}
+
+static int ex_memory_write(uint64_t addr, const uint8_t* buffer, size_t size)
+{
+    uint8_t* dst = translate(addr, size);
+    if (!dst || !buffer) return -1;
+    hal_range_lock_t lock;
+    hal_range_lock_init(&lock);
+    hal_range_lock_add(&lock, addr, size, 1);
+    hal_range_lock_acquire(&lock);
+    mem_ops_copy(dst, buffer, size);
+    hal_range_lock_release(&lock);
+    return (int)size;
+}
+
+static int ex_memory_set(uint64_t addr, uint8_t value, size_t size)
+{
+    uint8_t* dst = translate(addr, size);
+    if (!dst) return -1;
+    hal_range_lock_t lock;
+    hal_range_lock_init(&lock);
+    hal_range_lock_add(&lock, addr, size, 1);
+    hal_range_lock_acquire(&lock);
+    mem_ops_fill(dst, value, size);
+    hal_range_lock_release(&lock);
+    return (int)size;
+}
+
+static int ex_memory_checksum(uint64_t addr, size_t size, uint32_t* crc)
+{
+    uint8_t* src = translate(addr, size);
+    if (!src || !crc) return -1;
+    hal_range_lock_t lock;
+    hal_range_lock_init(&lock);
+    hal_range_lock_add(&lock, addr, size, 0);
+    hal_range_lock_acquire(&lock);
+    *crc = mem_ops_crc32c(0, src, size);
+    hal_range_lock_release(&lock);
+    return (int)size;
+}
+
+static const hal_interface_t example_table = {
+    .memory_read     = ex_memory_read,
+    .memory_write    = ex_memory_write,
+    .memory_set      = ex_memory_set,
+    .memory_checksum = ex_memory_checksum,
+};
+
+const hal_export_t hal_export = {
+    .abi_version = HAL_ABI_VERSION,
+    .table_size  = sizeof(hal_interface_t),
+    .name        = "example (translation cache)",
+    .table       = &example_table,
+};
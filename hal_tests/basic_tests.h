@@ -5,5 +5,10 @@
 int test_cpu_local_move(mesh_platform_t* p);
 int test_dma_local_transfer(mesh_platform_t* p);
 int test_dma_remote_transfer(mesh_platform_t* p);
+int test_dma_fill_engine(mesh_platform_t* p);
+int test_dma_peer_transfer(mesh_platform_t* p);
+int test_dma_stream_pipeline(mesh_platform_t* p);
+int test_hal_batch(mesh_platform_t* p);
+int test_memory_views(mesh_platform_t* p);
 
 #endif
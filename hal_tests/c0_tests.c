@@ -7,46 +7,18 @@
 #include <stdio.h>
 #include <string.h>
 #include <pthread.h>
-#include <stdarg.h>
 
 #include "c0_tests.h"
 #include "hal_tests/hal_interface.h"
+#include "log/log.h"
 
 /* ───────────────── helpers ───────────────── */
 #define CHUNK 256
 
 // Thread-safe printing for parallel test execution
-static pthread_mutex_t print_mutex = PTHREAD_MUTEX_INITIALIZER;
-
-static void thread_safe_banner(const char *msg)
-{
-    pthread_mutex_lock(&print_mutex);
-    
-    // Build entire banner in memory first
-    char complete_banner[1000];
-    int msg_len = strlen(msg);
-    int total_width = 82; // Inner width of the box
-    int padding = total_width - msg_len;
-    
-    snprintf(complete_banner, sizeof(complete_banner),
-        "\n"
-        "╔═══════════════════════════════════════════════════════════════════════════════════╗\n"
-        "║ \033[1;36m%s\033[0m%*s║\n"
-        "╚═══════════════════════════════════════════════════════════════════════════════════╝\n"
-        "\n",
-        msg, padding, "");
-    
-    // Single atomic write
-    fputs(complete_banner, stdout);
-    fflush(stdout);
-    
-    pthread_mutex_unlock(&print_mutex);
-}
 
 static void thread_safe_operation_banner(const char *msg)
 {
-    pthread_mutex_lock(&print_mutex);
-    
     // Build entire banner in memory first
     char complete_banner[1000];
     int msg_len = strlen(msg);
@@ -61,60 +33,39 @@ static void thread_safe_operation_banner(const char *msg)
         msg, padding, "");
     
     // Single atomic write
-    fputs(complete_banner, stdout);
-    fflush(stdout);
-    
-    pthread_mutex_unlock(&print_mutex);
+    LOG_INFO("%s", complete_banner);
 }
 
 static void thread_safe_dump32(const char *tag, const uint8_t *buf)
 {
-    pthread_mutex_lock(&print_mutex);
-    printf("%s 0x", tag);
-    for (int i = 0; i < 32; ++i) printf("%02X", buf[i]);
-    printf(" ...\n");
-    fflush(stdout);
-    pthread_mutex_unlock(&print_mutex);
-}
-
-static void thread_safe_printf(const char* format, ...)
-{
-    pthread_mutex_lock(&print_mutex);
-    va_list args;
-    va_start(args, format);
-    vprintf(format, args);
-    va_end(args);
-    fflush(stdout);
-    pthread_mutex_unlock(&print_mutex);
+    char hex[65];
+    for (int i = 0; i < 32; ++i) snprintf(hex + 2 * i, 3, "%02X", buf[i]);
+    LOG_INFO("%s 0x%s ...\n", tag, hex);
 }
 
 static void banner(const char *msg)
 {
-    printf("\n");
-    printf("╔═══════════════════════════════════════════════════════════════════════════════════╗\n");
-    printf("║ \033[1;36m%s\033[0m", msg);
+    LOG_INFO("\n");
+    LOG_INFO("╔═══════════════════════════════════════════════════════════════════════════════════╗\n");
     // Calculate padding to center the text
     int msg_len = strlen(msg);
     int total_width = 82; // Inner width of the box
     int padding = total_width - msg_len;
-    for (int i = 0; i < padding; i++) printf(" ");
-    printf("║\n");
-    printf("╚═══════════════════════════════════════════════════════════════════════════════════╝\n");
-    printf("\n");
+    LOG_INFO("║ \033[1;36m%s\033[0m%*s║\n", msg, padding, "");
+    LOG_INFO("╚═══════════════════════════════════════════════════════════════════════════════════╝\n");
+    LOG_INFO("\n");
 }
 
 static void operation_banner(const char *msg)
 {
-    printf("\n");
-    printf("┌─────────────────────────────────────────────────────────────────────────────────────┐\n");
-    printf("│ \033[1;33m%s\033[0m", msg);
+    LOG_INFO("\n");
+    LOG_INFO("┌─────────────────────────────────────────────────────────────────────────────────────┐\n");
     // Calculate padding 
     int msg_len = strlen(msg);
     int total_width = 84; // Inner width of the box
     int padding = total_width - msg_len;
-    for (int i = 0; i < padding; i++) printf(" ");
-    printf("│\n");
-    printf("└─────────────────────────────────────────────────────────────────────────────────────┘\n");
+    LOG_INFO("│ \033[1;33m%s\033[0m%*s│\n", msg, padding, "");
+    LOG_INFO("└─────────────────────────────────────────────────────────────────────────────────────┘\n");
 }
 
 static void fill(uint8_t *buf, uint8_t base)
@@ -127,16 +78,21 @@ static void fill(uint8_t *buf, uint8_t base)
  * ───────────────────────────────────────────*/
 int test_c0_gather(mesh_platform_t *p)
 {
-    thread_safe_banner("C0-Gather(collect 8 DMEM to a continue DLM1)");
+    log_banner("1;36", "C0-Gather(collect 8 DMEM to a continue DLM1)");
 
-    /* 1. Seed DMEMs with deterministic data using HAL functions */
+    /* 1. Seed DMEMs with deterministic data in one HAL batch */
+    hal_op_t ops[8];
+    hal_result_t results[8];
     for (int d = 0; d < 8; ++d) {
-        uint64_t dmem_addr = p->dmems[d].dmem_base_addr;
-        g_hal.memory_fill(dmem_addr, (uint8_t)(0x10 | d), CHUNK);
+        ops[d] = (hal_op_t){ .type = HAL_OP_FILL, .dst_addr = p->dmems[d].dmem_base_addr,
+                             .size = CHUNK, .value = (uint8_t)(0x10 | d) };
     }
+    hal_submit_batch(ops, 8, results);
     int pass = 0;
 
-    /* 2. C0 sequentially reads each DMEM into successive slices using HAL */
+    /* 2. C0 reads each DMEM into successive slices; the eight NoC transfers
+     *    are independent, so one batch sends them in a single wave */
+    uint8_t src_buffer[32], dst_buffer[32];
     for (int d = 0; d < 8; ++d) {
         uint64_t src_addr = p->dmems[d].dmem_base_addr;
         uint64_t dst_addr = p->nodes[0].dlm1_512_base_addr + d * CHUNK;
@@ -147,31 +103,38 @@ int test_c0_gather(mesh_platform_t *p)
         thread_safe_operation_banner(operation_msg);
         
         // Read data using HAL for display
-        uint8_t src_buffer[32], dst_buffer[32];
         g_hal.memory_read(src_addr, src_buffer, 32);
         g_hal.memory_read(dst_addr, dst_buffer, 32);
         
         thread_safe_dump32("[SRC-BEFORE]", src_buffer);
         thread_safe_dump32("[DST-BEFORE]", dst_buffer);
 
-        /* Use HAL for remote transfer (DMEM -> Tile) */
-        int result = g_hal.dma_remote_transfer(src_addr, dst_addr, CHUNK);
+        ops[d] = (hal_op_t){ .type = HAL_OP_DMA_REMOTE, .src_addr = src_addr,
+                             .dst_addr = dst_addr, .size = CHUNK };
+    }
+
+    /* Use HAL for remote transfers (DMEM -> Tile) */
+    hal_submit_batch(ops, 8, results);
+
+    for (int d = 0; d < 8; ++d) {
+        uint64_t src_addr = ops[d].src_addr;
+        uint64_t dst_addr = ops[d].dst_addr;
 
         // Read data using HAL for verification
         g_hal.memory_read(dst_addr, dst_buffer, 32);
         
         thread_safe_dump32("[DST-AFTER ]", dst_buffer);
-        thread_safe_printf("HAL result: %d\n\n", result);
+        LOG_INFO("HAL result: %d (wave %d)\n\n", results[d].status, results[d].wave);
 
-        /* Verify transfer using HAL memory read */
-        uint8_t src_verify[CHUNK], dst_verify[CHUNK];
-        g_hal.memory_read(src_addr, src_verify, CHUNK);
-        g_hal.memory_read(dst_addr, dst_verify, CHUNK);
+        /* Verify transfer by comparing CRC32C of source and destination */
+        uint32_t src_crc = 0, dst_crc = 0;
+        int c1 = g_hal.memory_checksum(src_addr, CHUNK, &src_crc);
+        int c2 = g_hal.memory_checksum(dst_addr, CHUNK, &dst_crc);
         
-        pass += (memcmp(src_verify, dst_verify, CHUNK) == 0);
+        pass += (results[d].status == CHUNK && c1 >= 0 && c2 >= 0 && src_crc == dst_crc);
     }
 
-    thread_safe_printf("\033[1m[C0-Gather] Summary: %d/8 passed\033[0m\n\n", pass);
+    LOG_INFO("\033[1m[C0-Gather] Summary: %d/8 passed\033[0m\n\n", pass);
     return pass == 8;
 }
 
@@ -180,7 +143,7 @@ int test_c0_gather(mesh_platform_t *p)
  * ───────────────────────────────────────────*/
 int test_c0_distribute(mesh_platform_t *p)
 {
-    thread_safe_banner("C0-Distribute(same SRC --> diff. Dist)");
+    log_banner("1;36", "C0-Distribute(same SRC --> diff. Dist)");
 
     /* 1. Put unique patterns into eight slices of node_0.dlm1 using HAL functions */
     for (int d = 0; d < 8; ++d) {
@@ -213,16 +176,12 @@ int test_c0_distribute(mesh_platform_t *p)
         g_hal.memory_read(dst_addr, dst_buffer, 32);
         
         thread_safe_dump32("[DST-AFTER ]", dst_buffer);
-        thread_safe_printf("HAL result: %d\n\n", result);
+        LOG_INFO("HAL result: %d\n\n", result);
 
-        /* Verify transfer using HAL memory read */
-        uint8_t src_verify[CHUNK], dst_verify[CHUNK];
-        g_hal.memory_read(src_addr, src_verify, CHUNK);
-        g_hal.memory_read(dst_addr, dst_verify, CHUNK);
-        
-        pass += (memcmp(src_verify, dst_verify, CHUNK) == 0);
+        /* Verify transfer in place through HAL memory views */
+        pass += (hal_memory_equal(src_addr, dst_addr, CHUNK) == 1);
     }
 
-    thread_safe_printf("\033[1m[C0-Distribute] Summary: %d/8 passed\033[0m\n\n", pass);
+    LOG_INFO("\033[1m[C0-Distribute] Summary: %d/8 passed\033[0m\n\n", pass);
     return pass == 8;
 }
@@ -0,0 +1,153 @@
+// coro_tests.c – a 16x16 mesh of tile programs on two host threads. Each
+// program streams packets from a DMEM to a tile over the NoC and hands a
+// task to the physical tiles, yielding its worker while the NoC delay runs
+// and while the task is pending. The programs' NoC time overlaps across
+// destinations just as it would with a thread per tile.
+
+#define _GNU_SOURCE
+#include <string.h>
+#include "coro_tests.h"
+#include "tile/tile_coro.h"
+#include "hal_tests/hal_interface.h"
+#include "generated/mem_map.h"
+#include "log/log.h"
+
+#define CORO_MESH_DIM       16
+#define CORO_PROGRAMS       (CORO_MESH_DIM * CORO_MESH_DIM)
+#define CORO_WORKERS        2
+#define CORO_ROUNDS         3
+#define CORO_BYTES          64          // 640 us each in the NoC model
+#define CORO_DMEM_OFF       0x3B000     // program sources, in DMEM n
+#define CORO_DLM_OFF        0x1C000     // program destinations, in tile n DLM1
+#define CORO_SWITCHES       100000
+#define CORO_TIMEOUT_MS     10000
+
+typedef struct {
+    mesh_platform_t* p;
+    int id;
+    uint64_t src, dst;
+    int ok;
+} coro_program_t;
+
+static const uint64_t coro_dmem[NUM_DMEMS] = {
+    DMEM0_512_BASE, DMEM1_512_BASE, DMEM2_512_BASE, DMEM3_512_BASE,
+    DMEM4_512_BASE, DMEM5_512_BASE, DMEM6_512_BASE, DMEM7_512_BASE
+};
+
+static int coro_task_runs;
+
+static int coro_bump(void* arg)
+{
+    __atomic_fetch_add((int*)arg, 1, __ATOMIC_RELAXED);
+    return 1;
+}
+
+static void coro_tile_program(void* arg)
+{
+    coro_program_t* prog = arg;
+    uint8_t want[CORO_BYTES], got[CORO_BYTES];
+    int ok = 1;
+    // Copies rather than memory views: pins belong to the worker thread
+    for (int r = 0; r < CORO_ROUNDS; r++) {
+        ok &= g_hal.memory_fill(prog->src, (uint8_t)(prog->id * 3 + r), CORO_BYTES) >= 0;
+        ok &= g_hal.dma_remote_transfer(prog->src, prog->dst, CORO_BYTES) == CORO_BYTES;
+        ok &= g_hal.memory_read(prog->src, want, CORO_BYTES) >= 0 && g_hal.memory_read(prog->dst, got, CORO_BYTES) >= 0;
+        ok &= memcmp(want, got, CORO_BYTES) == 0;
+    }
+
+    // The task lives on this coroutine's stack until the wait returns
+    task_t t;
+    ok &= c0_init_callback_task(prog->p, &t, coro_bump, &coro_task_runs, "coro") == 0;
+    ok &= queue_task_to_available_tile(prog->p, &t) == 0 && c0_wait_for_task(&t, CORO_TIMEOUT_MS) == 0;
+    prog->ok = ok;
+}
+
+static void coro_ping(void* arg)
+{
+    for (int i = 0; i < CORO_SWITCHES; i++) {
+        coro_yield();
+    }
+    __atomic_fetch_add((int*)arg, 1, __ATOMIC_RELAXED);
+}
+
+// Two coroutines on one worker yielding to each other
+static int coro_check_switch(void)
+{
+    coro_pool_t pool;
+    int done = 0;
+    if (coro_pool_init(&pool, 1, 0) != 0) {
+        return 0;
+    }
+    uint64_t t0 = get_current_timestamp_ns();
+    int ok = coro_spawn(&pool, coro_ping, &done) == 0 && coro_spawn(&pool, coro_ping, &done) == 0;
+    ok &= coro_pool_wait(&pool, CORO_TIMEOUT_MS) == 0 && done == 2;
+    uint64_t elapsed = get_current_timestamp_ns() - t0;
+    coro_stats_t st;
+    coro_pool_get_stats(&pool, &st);
+    coro_pool_destroy(&pool);
+    ok &= st.yields == 2 * CORO_SWITCHES;
+
+    LOG_INFO("[Coro] %lu switches on one worker, %.0f ns each\n",
+             (unsigned long)st.resumes, st.resumes ? (double)elapsed / st.resumes : 0.0);
+    return ok;
+}
+
+static int coro_check_mesh(mesh_platform_t* p)
+{
+    static coro_program_t progs[CORO_PROGRAMS];
+    coro_pool_t pool;
+    if (coro_pool_init(&pool, CORO_WORKERS, 0) != 0) {
+        return 0;
+    }
+    coro_task_runs = 0;
+
+    // Programs share the physical tiles' memory; each has its own slot
+    for (int i = 0; i < CORO_PROGRAMS; i++) {
+        int tile = 1 + i % (NUM_TILES - 1), slot = i / (NUM_TILES - 1);
+        progs[i] = (coro_program_t){
+            .p = p,
+            .id = i,
+            .src = coro_dmem[tile] + CORO_DMEM_OFF + (uint64_t)slot * CORO_BYTES,
+            .dst = TILE0_DLM1_512_BASE + (uint64_t)tile * TILE_STRIDE + CORO_DLM_OFF + (uint64_t)slot * CORO_BYTES,
+        };
+    }
+
+    uint64_t t0 = get_current_timestamp_ns();
+    int ok = 1;
+    for (int i = 0; i < CORO_PROGRAMS; i++) {
+        ok &= coro_spawn(&pool, coro_tile_program, &progs[i]) == 0;
+    }
+    ok &= coro_pool_wait(&pool, CORO_TIMEOUT_MS) == 0;
+    uint64_t elapsed = get_current_timestamp_ns() - t0;
+    coro_stats_t st;
+    coro_pool_get_stats(&pool, &st);
+    coro_pool_destroy(&pool);
+
+    int progs_ok = 0;
+    for (int i = 0; i < CORO_PROGRAMS; i++) {
+        progs_ok += progs[i].ok;
+    }
+    ok &= progs_ok == CORO_PROGRAMS && coro_task_runs == CORO_PROGRAMS;
+    ok &= st.finished == CORO_PROGRAMS && st.workers_used <= CORO_WORKERS;
+
+    // One program at a time would wait out every packet back to back
+    double serial_ms = CORO_PROGRAMS * CORO_ROUNDS * CORO_BYTES * 10 / 1e3;
+    ok &= elapsed / 1e6 < serial_ms / 2;
+
+    LOG_INFO("[Coro] %dx%d tile programs on %d host threads: %d/%d correct, %d tasks waited on\n",
+             CORO_MESH_DIM, CORO_MESH_DIM, st.workers_used, progs_ok, CORO_PROGRAMS,
+             coro_task_runs);
+    LOG_INFO("[Coro] %.1f ms for %.1f ms of NoC time (%.1fx overlap), %lu resumes, %lu sleeps, %lu yields\n",
+             elapsed / 1e6, serial_ms, serial_ms / (elapsed / 1e6), (unsigned long)st.resumes,
+             (unsigned long)st.sleeps, (unsigned long)st.yields);
+    return ok;
+}
+
+int test_c0_coroutine_tiles(mesh_platform_t* p)
+{
+    LOG_INFO("[Coro] Tile programs as coroutines on a small worker pool\n");
+    int ok = coro_check_switch();
+    ok &= coro_check_mesh(p);
+    LOG_INFO("[Coro] C0 coroutine tiles: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
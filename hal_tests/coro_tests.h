@@ -0,0 +1,8 @@
+#ifndef CORO_TESTS_H
+#define CORO_TESTS_H
+#include "c0_master/c0_controller.h"
+
+// Runs on the C0 main thread while the tiles are idle
+int test_c0_coroutine_tiles(mesh_platform_t* p);
+
+#endif
@@ -1,63 +1,25 @@
 // ===================== File: hal_tests/dmem_tests.c =====================
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <pthread.h>
-#include <stdarg.h>
 #include <time.h>
 #include "dmem_tests.h"
 #include "hal_tests/hal_interface.h"
 #include "generated/mem_map.h"
+#include "tile/tile_coro.h"
+#include "log/log.h"
 
 /* -------------------------------------------------------------------------- */
 /*                               Thread‑safe I/O                              */
 /* -------------------------------------------------------------------------- */
-static pthread_mutex_t print_mutex = PTHREAD_MUTEX_INITIALIZER;
-
-static void thread_safe_printf(const char* format, ...)
-{
-    pthread_mutex_lock(&print_mutex);
-    va_list args;
-    va_start(args, format);
-    vprintf(format, args);
-    va_end(args);
-    fflush(stdout);
-    pthread_mutex_unlock(&print_mutex);
-}
-
-static void thread_safe_banner(const char *msg)
-{
-    pthread_mutex_lock(&print_mutex);
-
-    char complete_banner[1000];
-    int msg_len             = (int)strlen(msg);
-    int total_width         = 82;
-    int padding             = total_width - msg_len;
-
-    snprintf(complete_banner,
-             sizeof(complete_banner),
-             "\n"
-             "╔═══════════════════════════════════════════════════════════════════════════════════╗\n"
-             "║ \033[1;32m%s\033[0m%*s║\n"
-             "╚═══════════════════════════════════════════════════════════════════════════════════╝\n"
-             "\n",
-             msg,
-             padding,
-             "");
-
-    fputs(complete_banner, stdout);
-    fflush(stdout);
-    pthread_mutex_unlock(&print_mutex);
-}
 
 static void thread_safe_dump32(const char* tag, const uint8_t* buf)
 {
-    pthread_mutex_lock(&print_mutex);
-    printf("%s 0x", tag);
-    for (int i = 0; i < 32; i++) printf("%02X", buf[i]);
-    printf(" ...\n");
-    fflush(stdout);
-    pthread_mutex_unlock(&print_mutex);
+    char hex[65];
+    for (int i = 0; i < 32; i++) snprintf(hex + 2 * i, 3, "%02X", buf[i]);
+    LOG_INFO("%s 0x%s ...\n", tag, hex);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -84,38 +46,38 @@ int test_dmem_basic_functionality(mesh_platform_t* p)
     uint64_t src_addr  = DMEM0_512_BASE;
     uint64_t dst_addr  = DMEM1_512_BASE;
 
-    thread_safe_banner("DMEM Basic Functionality");
+    log_banner("1;32", "DMEM Basic Functionality");
 
-    thread_safe_printf("[DEBUG] Starting memory_fill...\n");
+    LOG_INFO("[DEBUG] Starting memory_fill...\n");
     int fill_result = g_hal.memory_fill(src_addr, 0xAA, bytes);
-    thread_safe_printf("[DEBUG] memory_fill result: %d\n", fill_result);
+    LOG_INFO("[DEBUG] memory_fill result: %d\n", fill_result);
     
-    thread_safe_printf("[DEBUG] Starting memory_set...\n");
+    LOG_INFO("[DEBUG] Starting memory_set...\n");
     int set_result = g_hal.memory_set(dst_addr, 0, bytes);
-    thread_safe_printf("[DEBUG] memory_set result: %d\n", set_result);
+    LOG_INFO("[DEBUG] memory_set result: %d\n", set_result);
 
-    thread_safe_printf("[DEBUG] Starting dmem_to_dmem_transfer...\n");
+    LOG_INFO("[DEBUG] Starting dmem_to_dmem_transfer...\n");
     int result = g_hal.dmem_to_dmem_transfer(src_addr, dst_addr, bytes);
-    thread_safe_printf("[DEBUG] dmem_to_dmem_transfer result: %d\n", result);
+    LOG_INFO("[DEBUG] dmem_to_dmem_transfer result: %d\n", result);
 
     uint8_t src_verify[bytes];
     uint8_t dst_verify[bytes];
     
-    thread_safe_printf("[DEBUG] Starting memory_read src...\n");
+    LOG_INFO("[DEBUG] Starting memory_read src...\n");
     int read_src_result = g_hal.memory_read(src_addr, src_verify, bytes);
-    thread_safe_printf("[DEBUG] memory_read src result: %d\n", read_src_result);
+    LOG_INFO("[DEBUG] memory_read src result: %d\n", read_src_result);
     
-    thread_safe_printf("[DEBUG] Starting memory_read dst...\n");
+    LOG_INFO("[DEBUG] Starting memory_read dst...\n");
     int read_dst_result = g_hal.memory_read(dst_addr, dst_verify, bytes);
-    thread_safe_printf("[DEBUG] memory_read dst result: %d\n", read_dst_result);
+    LOG_INFO("[DEBUG] memory_read dst result: %d\n", read_dst_result);
 
     int buffers_equal = verify_buffer_equal(src_verify, dst_verify, bytes);
-    thread_safe_printf("[DEBUG] buffers_equal: %d\n", buffers_equal);
+    LOG_INFO("[DEBUG] buffers_equal: %d\n", buffers_equal);
 
     int ok = (result == 0) && buffers_equal;
-    thread_safe_printf("[DEBUG] Final ok: %d (result==0: %d, buffers_equal: %d)\n", ok, (result == 0), buffers_equal);
+    LOG_INFO("[DEBUG] Final ok: %d (result==0: %d, buffers_equal: %d)\n", ok, (result == 0), buffers_equal);
 
-    thread_safe_printf("[Test] DMEM Basic Functionality: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("[Test] DMEM Basic Functionality: %s\n", ok ? "PASS" : "FAIL");
     return ok;
 }
 
@@ -129,25 +91,23 @@ int test_dmem_large_transfers(mesh_platform_t* p)
     uint64_t src_addr  = DMEM0_512_BASE;
     uint64_t dst_addr  = DMEM1_512_BASE;
 
-    thread_safe_banner("DMEM Large Transfers");
+    log_banner("1;32", "DMEM Large Transfers");
 
-    g_hal.memory_fill(src_addr, 0x55, bytes);
-    g_hal.memory_set(dst_addr, 0, bytes);
+    /* Seed both modules with the DMA fill engine instead of CPU loops */
+    g_hal.dma_memory_fill(src_addr, 0x55, bytes);
+    g_hal.dma_memory_set(dst_addr, 0, bytes);
 
     int result = g_hal.dmem_to_dmem_transfer(src_addr, dst_addr, bytes);
 
-    uint8_t* src_verify = (uint8_t*)malloc(bytes);
-    uint8_t* dst_verify = (uint8_t*)malloc(bytes);
-
-    g_hal.memory_read(src_addr, src_verify, bytes);
-    g_hal.memory_read(dst_addr, dst_verify, bytes);
+    /* Verify with CRC32C instead of reading 2 x 256 KiB back into buffers */
+    uint32_t src_crc = 0, dst_crc = 0;
+    int c1 = g_hal.memory_checksum(src_addr, bytes, &src_crc);
+    int c2 = g_hal.memory_checksum(dst_addr, bytes, &dst_crc);
 
-    int ok = (result == 0) && verify_buffer_equal(src_verify, dst_verify, bytes);
+    int ok = (result == 0) && (c1 == (int)bytes) && (c2 == (int)bytes) && (src_crc == dst_crc);
 
-    thread_safe_printf("[Test] DMEM Large Transfers: %s\n", ok ? "PASS" : "FAIL");
-
-    free(src_verify);
-    free(dst_verify);
+    LOG_INFO("[CRC] src=0x%08X dst=0x%08X\n", src_crc, dst_crc);
+    LOG_INFO("[Test] DMEM Large Transfers: %s\n", ok ? "PASS" : "FAIL");
     return ok;
 }
 
@@ -157,7 +117,7 @@ int test_dmem_large_transfers(mesh_platform_t* p)
 int test_dmem_address_validation(mesh_platform_t* p)
 {
     (void)p;
-    thread_safe_banner("DMEM Address Validation");
+    log_banner("1;32", "DMEM Address Validation");
 
     int r1 = g_hal.dmem_to_dmem_transfer(DMEM0_512_BASE, DMEM1_512_BASE, 1024);
     int r2 = g_hal.dmem_to_dmem_transfer(DMEM0_512_BASE, DMEM7_512_BASE, 1024);
@@ -168,7 +128,7 @@ int test_dmem_address_validation(mesh_platform_t* p)
 
     int ok = (r1 == 0) && (r2 == 0) && (s0 == 0) && (s1 == 0) && (s7 == 0);
 
-    thread_safe_printf("[Test] DMEM Address Validation: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("[Test] DMEM Address Validation: %s\n", ok ? "PASS" : "FAIL");
     return ok;
 }
 
@@ -178,7 +138,7 @@ int test_dmem_address_validation(mesh_platform_t* p)
 int test_dmem_data_integrity(mesh_platform_t* p)
 {
     (void)p;
-    thread_safe_banner("DMEM Data Integrity");
+    log_banner("1;32", "DMEM Data Integrity");
 
     const size_t bytes = 1024;
     uint8_t pattern[bytes];
@@ -194,7 +154,7 @@ int test_dmem_data_integrity(mesh_platform_t* p)
 
     int ok = (result == 0) && verify_buffer_equal(pattern, dst_verify, bytes);
 
-    thread_safe_printf("[Test] DMEM Data Integrity: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("[Test] DMEM Data Integrity: %s\n", ok ? "PASS" : "FAIL");
     return ok;
 }
 
@@ -218,7 +178,7 @@ static void* transfer_thread(void* arg)
 int test_dmem_concurrent_access(mesh_platform_t* p)
 {
     (void)p;
-    thread_safe_banner("DMEM Concurrent Access");
+    log_banner("1;32", "DMEM Concurrent Access");
 
     const size_t bytes = 1024;
 
@@ -234,22 +194,14 @@ int test_dmem_concurrent_access(mesh_platform_t* p)
     pthread_create(&t1, NULL, transfer_thread, &a1);
     pthread_create(&t2, NULL, transfer_thread, &a2);
 
-    pthread_join(t1, NULL);
-    pthread_join(t2, NULL);
-
-    uint8_t v1_src[bytes], v1_dst[bytes];
-    uint8_t v2_src[bytes], v2_dst[bytes];
-
-    g_hal.memory_read(DMEM0_512_BASE, v1_src, bytes);
-    g_hal.memory_read(DMEM1_512_BASE, v1_dst, bytes);
-    g_hal.memory_read(DMEM2_512_BASE, v2_src, bytes);
-    g_hal.memory_read(DMEM3_512_BASE, v2_dst, bytes);
+    coro_join(t1, NULL);
+    coro_join(t2, NULL);
 
     int ok = (a1.result == 0) && (a2.result == 0) &&
-             verify_buffer_equal(v1_src, v1_dst, bytes) &&
-             verify_buffer_equal(v2_src, v2_dst, bytes);
+             hal_memory_equal(DMEM0_512_BASE, DMEM1_512_BASE, bytes) == 1 &&
+             hal_memory_equal(DMEM2_512_BASE, DMEM3_512_BASE, bytes) == 1;
 
-    thread_safe_printf("[Test] DMEM Concurrent Access: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("[Test] DMEM Concurrent Access: %s\n", ok ? "PASS" : "FAIL");
     return ok;
 }
 
@@ -259,7 +211,7 @@ int test_dmem_concurrent_access(mesh_platform_t* p)
 int test_dmem_boundary_conditions(mesh_platform_t* p)
 {
     (void)p;
-    thread_safe_banner("DMEM Boundary Conditions");
+    log_banner("1;32", "DMEM Boundary Conditions");
 
     int r_first_byte = g_hal.dmem_to_dmem_transfer(DMEM0_512_BASE, DMEM1_512_BASE, 1);
 
@@ -268,7 +220,7 @@ int test_dmem_boundary_conditions(mesh_platform_t* p)
 
     int ok = (r_first_byte == 0) && (r_last_chunk == 0);
 
-    thread_safe_printf("[Test] DMEM Boundary Conditions: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("[Test] DMEM Boundary Conditions: %s\n", ok ? "PASS" : "FAIL");
     return ok;
 }
 
@@ -278,7 +230,7 @@ int test_dmem_boundary_conditions(mesh_platform_t* p)
 int test_dmem_error_handling(mesh_platform_t* p)
 {
     (void)p;
-    thread_safe_banner("DMEM Error Handling");
+    log_banner("1;32", "DMEM Error Handling");
 
     int r_zero_size = g_hal.dmem_to_dmem_transfer(DMEM0_512_BASE, DMEM1_512_BASE, 0);
 
@@ -287,7 +239,7 @@ int test_dmem_error_handling(mesh_platform_t* p)
 
     int ok = (r_zero_size != 0) && (r_null_read != 0);
 
-    thread_safe_printf("[Test] DMEM Error Handling: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("[Test] DMEM Error Handling: %s\n", ok ? "PASS" : "FAIL");
     return ok;
 }
 
@@ -297,7 +249,7 @@ int test_dmem_error_handling(mesh_platform_t* p)
 int test_dmem_performance_basic(mesh_platform_t* p)
 {
     (void)p;
-    thread_safe_banner("DMEM Performance Basic");
+    log_banner("1;32", "DMEM Performance Basic");
 
     const size_t bytes = 65536; /* 64 KiB */
 
@@ -309,12 +261,12 @@ int test_dmem_performance_basic(mesh_platform_t* p)
     double elapsed = timespec_diff_sec(&start, &end);
     double bps     = (bytes / elapsed);
 
-    thread_safe_printf("    Bytes transferred: %zu\n", bytes);
-    thread_safe_printf("    Elapsed time    : %.6f s\n", elapsed);
-    thread_safe_printf("    Throughput      : %.2f B/s\n", bps);
+    LOG_INFO("    Bytes transferred: %zu\n", bytes);
+    LOG_INFO("    Elapsed time    : %.6f s\n", elapsed);
+    LOG_INFO("    Throughput      : %.2f B/s\n", bps);
 
     int ok = (result == 0);
-    thread_safe_printf("[Test] DMEM Performance Basic: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("[Test] DMEM Performance Basic: %s\n", ok ? "PASS" : "FAIL");
     return ok;
 }
 
@@ -324,7 +276,7 @@ int test_dmem_performance_basic(mesh_platform_t* p)
 int test_dmem_cross_module_transfers(mesh_platform_t* p)
 {
     (void)p;
-    thread_safe_banner("DMEM Cross‑Module Transfers");
+    log_banner("1;32", "DMEM Cross‑Module Transfers");
 
     /* Pre‑fill distinct patterns so we can sanity‑check later */
     g_hal.memory_fill(DMEM0_512_BASE, 0x11, 256);
@@ -352,7 +304,7 @@ int test_dmem_cross_module_transfers(mesh_platform_t* p)
 
     int ok = (r1 == 0) && (r2 == 0) && (r3 == 0) && ok1 && ok2 && ok3;
 
-    thread_safe_printf("[Test] DMEM Cross‑Module Transfers: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("[Test] DMEM Cross‑Module Transfers: %s\n", ok ? "PASS" : "FAIL");
     return ok;
 }
 
@@ -364,29 +316,20 @@ static int run_alignment_case(uint64_t src, uint64_t dst, size_t bytes)
     g_hal.memory_fill(src, 0x5A, bytes);
     g_hal.memory_set(dst, 0, bytes);
 
-    int r         = g_hal.dmem_to_dmem_transfer(src, dst, bytes);
-    uint8_t* sbuf = (uint8_t*)malloc(bytes);
-    uint8_t* dbuf = (uint8_t*)malloc(bytes);
-
-    g_hal.memory_read(src, sbuf, bytes);
-    g_hal.memory_read(dst, dbuf, bytes);
-    int ok = (r == 0) && verify_buffer_equal(sbuf, dbuf, bytes);
-
-    free(sbuf);
-    free(dbuf);
-    return ok;
+    int r = g_hal.dmem_to_dmem_transfer(src, dst, bytes);
+    return (r == 0) && hal_memory_equal(src, dst, bytes) == 1;
 }
 
 int test_dmem_alignment_testing(mesh_platform_t* p)
 {
     (void)p;
-    thread_safe_banner("DMEM Alignment Testing");
+    log_banner("1;32", "DMEM Alignment Testing");
 
     int ok1 = run_alignment_case(DMEM0_512_BASE + 1, DMEM1_512_BASE + 1, 255);
     int ok2 = run_alignment_case(DMEM0_512_BASE + 3, DMEM1_512_BASE + 3, 253);
     int ok3 = run_alignment_case(DMEM0_512_BASE + 7, DMEM1_512_BASE + 7, 249);
 
     int ok = ok1 && ok2 && ok3;
-    thread_safe_printf("[Test] DMEM Alignment Testing: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("[Test] DMEM Alignment Testing: %s\n", ok ? "PASS" : "FAIL");
     return ok;
 }
\ No newline at end of file
@@ -0,0 +1,249 @@
+// graph_tests.c – C0 task graphs: a DMA -> checksum -> reduce pipeline over
+// six lanes, run once as a dependency graph and once with a barrier after
+// every stage. Lane stages have uneven lengths that add up to the same
+// total, so the barrier version pays for the slowest lane of each stage
+// while the graph lets every lane flow straight through. Times are only
+// reported: in the graph run the last lane's DMA holds until every other
+// lane's checksum is done, which finishes only if each checksum is
+// released by its own DMA alone.
+
+#define _GNU_SOURCE
+#include <string.h>
+#include "graph_tests.h"
+#include "c0_master/task_graph.h"
+#include "hal_tests/hal_interface.h"
+#include "generated/mem_map.h"
+#include "tile/tile_coro.h"
+#include "log/log.h"
+
+#define GRAPH_LANES     6
+#define GRAPH_BLOCK     64          // one NoC packet; remote DMA is slow in the model
+#define GRAPH_SRC_OFF   0x38000     // in DMEM n
+#define GRAPH_DST_OFF   0x18000     // in tile n DLM1
+#define GRAPH_STAGE_MS  10          // dma + sum of every lane
+#define GRAPH_TIMEOUT   3000
+#define GRAPH_POLL_US   100
+
+static const uint64_t graph_dmem[] = {
+    DMEM1_512_BASE, DMEM2_512_BASE, DMEM3_512_BASE, DMEM4_512_BASE, DMEM5_512_BASE, DMEM6_512_BASE
+};
+static const uint64_t graph_dlm[] = {
+    TILE1_DLM1_512_BASE, TILE2_DLM1_512_BASE, TILE3_DLM1_512_BASE,
+    TILE4_DLM1_512_BASE, TILE5_DLM1_512_BASE, TILE6_DLM1_512_BASE
+};
+
+typedef struct {
+    uint64_t src, dst;
+    int dma_ms, sum_ms;
+    int hold;                   // dma waits for the other lanes' sums
+    uint32_t expected, crc;
+} graph_lane_t;
+
+typedef struct {
+    task_t dma[GRAPH_LANES];
+    task_t sum[GRAPH_LANES];
+    task_t reduce;
+} graph_pipeline_t;
+
+static graph_lane_t lanes[GRAPH_LANES];
+static int g_sums_done;
+
+static int graph_dma_stage(void* arg)
+{
+    graph_lane_t* lane = arg;
+    int rc = g_hal.dma_remote_transfer(lane->src, lane->dst, GRAPH_BLOCK);
+    coro_sleep_us((unsigned)lane->dma_ms * 1000);
+    if (lane->hold) {
+        for (int waited = 0; __atomic_load_n(&g_sums_done, __ATOMIC_ACQUIRE) < GRAPH_LANES - 1; waited++) {
+            if (waited * GRAPH_POLL_US >= GRAPH_TIMEOUT * 1000) {
+                return 0;
+            }
+            coro_sleep_us(GRAPH_POLL_US);
+        }
+    }
+    return rc >= 0;
+}
+
+static int graph_sum_stage(void* arg)
+{
+    graph_lane_t* lane = arg;
+    int rc = g_hal.memory_checksum(lane->dst, GRAPH_BLOCK, &lane->crc);
+    coro_sleep_us((unsigned)lane->sum_ms * 1000);
+    __atomic_fetch_add(&g_sums_done, 1, __ATOMIC_RELEASE);
+    return rc >= 0;
+}
+
+static int graph_reduce_stage(void* arg)
+{
+    (void)arg;
+    int ok = 1;
+    for (int i = 0; i < GRAPH_LANES; i++) {
+        ok &= lanes[i].crc == lanes[i].expected;
+    }
+    return ok;
+}
+
+static int graph_prepare(mesh_platform_t* p, graph_pipeline_t* pl, int hold)
+{
+    __atomic_store_n(&g_sums_done, 0, __ATOMIC_RELAXED);
+    for (int i = 0; i < GRAPH_LANES; i++) {
+        graph_lane_t* lane = &lanes[i];
+        lane->src = graph_dmem[i] + GRAPH_SRC_OFF;
+        lane->dst = graph_dlm[i] + GRAPH_DST_OFF;
+        lane->dma_ms = 2 + (i % 3) * 3;
+        lane->sum_ms = GRAPH_STAGE_MS - lane->dma_ms;
+        lane->hold = hold && i == GRAPH_LANES - 1;
+        lane->crc = 0;
+        if (g_hal.memory_fill(lane->src, (uint8_t)(0x40 + i), GRAPH_BLOCK) < 0 ||
+            g_hal.memory_set(lane->dst, 0, GRAPH_BLOCK) < 0 ||
+            g_hal.memory_checksum(lane->src, GRAPH_BLOCK, &lane->expected) < 0) {
+            return -1;
+        }
+
+        // DMA on the lane's tile, checksum on the next tile over
+        c0_init_callback_task(p, &pl->dma[i], graph_dma_stage, lane, "dma");
+        c0_init_callback_task(p, &pl->sum[i], graph_sum_stage, lane, "sum");
+        pl->dma[i].home_tile = i + 1;
+        pl->sum[i].home_tile = (i + 1) % GRAPH_LANES + 1;
+    }
+    c0_init_callback_task(p, &pl->reduce, graph_reduce_stage, NULL, "reduce");
+    return 0;
+}
+
+static int graph_stages_ok(graph_pipeline_t* pl)
+{
+    for (int i = 0; i < GRAPH_LANES; i++) {
+        if (pl->dma[i].result != 1 || pl->sum[i].result != 1) {
+            return 0;
+        }
+    }
+    return pl->reduce.result == 1;
+}
+
+// Submits one stage as a graph without edges and waits for all of it
+static int graph_run_phase(mesh_platform_t* p, task_t** tasks, int n)
+{
+    task_graph_t g;
+    if (c0_submit_graph(p, &g, tasks, n) != 0) {
+        return -1;
+    }
+    return c0_wait_graph(p, &g, GRAPH_TIMEOUT);
+}
+
+static int graph_run_barriers(mesh_platform_t* p, uint64_t* makespan_ns)
+{
+    graph_pipeline_t pl;
+    if (graph_prepare(p, &pl, 0) != 0) {
+        return 0;
+    }
+    task_t* dma[GRAPH_LANES];
+    task_t* sum[GRAPH_LANES];
+    task_t* reduce = &pl.reduce;
+    for (int i = 0; i < GRAPH_LANES; i++) {
+        dma[i] = &pl.dma[i];
+        sum[i] = &pl.sum[i];
+    }
+
+    uint64_t t0 = get_current_timestamp_ns();
+    if (graph_run_phase(p, dma, GRAPH_LANES) != 0 ||
+        graph_run_phase(p, sum, GRAPH_LANES) != 0 ||
+        graph_run_phase(p, &reduce, 1) != 0) {
+        LOG_INFO("[Graph] Barrier run did not finish\n");
+        return 0;
+    }
+    *makespan_ns = get_current_timestamp_ns() - t0;
+    return graph_stages_ok(&pl);
+}
+
+static int graph_run_dag(mesh_platform_t* p, uint64_t* makespan_ns)
+{
+    graph_pipeline_t pl;
+    if (graph_prepare(p, &pl, 1) != 0) {
+        return 0;
+    }
+    task_t* tasks[2 * GRAPH_LANES + 1];
+    int n = 0;
+    for (int i = 0; i < GRAPH_LANES; i++) {
+        if (task_depends_on(&pl.sum[i], &pl.dma[i]) != 0 ||
+            task_depends_on(&pl.reduce, &pl.sum[i]) != 0) {
+            return 0;
+        }
+        tasks[n++] = &pl.dma[i];
+        tasks[n++] = &pl.sum[i];
+    }
+    tasks[n++] = &pl.reduce;
+
+    task_graph_t g;
+    if (c0_submit_graph(p, &g, tasks, n) != 0 || c0_wait_graph(p, &g, GRAPH_TIMEOUT) != 0) {
+        LOG_INFO("[Graph] Graph run did not finish\n");
+        return 0;
+    }
+
+    task_graph_report_t report;
+    if (task_graph_critical_path(&g, &report) != 0) {
+        return 0;
+    }
+    task_graph_print_report(&g, &report, p->node_count - 1);
+    *makespan_ns = report.makespan_ns;
+
+    int ok = graph_stages_ok(&pl);
+    for (int i = 0; i < GRAPH_LANES; i++) {
+        if (pl.sum[i].start_ns < pl.dma[i].end_ns || pl.reduce.start_ns < pl.sum[i].end_ns) {
+            LOG_INFO("[Graph] Lane %d started before its input completed\n", i);
+            ok = 0;
+        }
+    }
+    // The held dma only returned 1 once the other lanes' sums had run
+    if (pl.dma[GRAPH_LANES - 1].result != 1) {
+        LOG_INFO("[Graph] Sums waited for another lane's dma\n");
+        ok = 0;
+    }
+    // dma -> sum -> reduce, each lane carries GRAPH_STAGE_MS of sleep
+    if (report.path_len != 3 || g.tasks[report.path[2]] != &pl.reduce ||
+        report.critical_ns < GRAPH_STAGE_MS * 1000000ULL || report.critical_ns > report.makespan_ns) {
+        LOG_INFO("[Graph] Unexpected critical path (%d tasks, %.1f ms)\n",
+                 report.path_len, report.critical_ns / 1e6);
+        ok = 0;
+    }
+    return ok;
+}
+
+// Cycles and edges leaving the graph are refused without queueing anything
+static int graph_check_rejects(mesh_platform_t* p)
+{
+    task_t a, b, c;
+    task_graph_t g;
+    c0_init_callback_task(p, &a, graph_reduce_stage, NULL, "a");
+    c0_init_callback_task(p, &b, graph_reduce_stage, NULL, "b");
+    c0_init_callback_task(p, &c, graph_reduce_stage, NULL, "c");
+    task_depends_on(&b, &a);
+    task_depends_on(&a, &b);
+    task_depends_on(&c, &a);
+    task_t* cycle[] = { &a, &b, &c };
+    task_t* partial[] = { &c };
+    return c0_submit_graph(p, &g, cycle, 3) == -1 &&
+           c0_submit_graph(p, &g, partial, 1) == -1 &&
+           !a.graph && !c.graph && task_depends_on(&a, &a) == -1;
+}
+
+int test_c0_task_graph(mesh_platform_t* p)
+{
+    LOG_INFO("[Graph] %d-lane dma -> sum -> reduce pipeline, barriers vs dependency graph\n",
+             GRAPH_LANES);
+
+    uint64_t barrier_ns = 0, dag_ns = 0;
+    int barrier_ok = graph_run_barriers(p, &barrier_ns);
+    int dag_ok = graph_run_dag(p, &dag_ns);
+    int rejects_ok = graph_check_rejects(p);
+
+    LOG_INFO("[Graph] Barriers %.1f ms, graph %.1f ms (%.2fx)\n", barrier_ns / 1e6, dag_ns / 1e6,
+             dag_ns ? (double)barrier_ns / dag_ns : 0.0);
+
+    if (!rejects_ok) {
+        LOG_INFO("[Graph] Invalid graph was accepted\n");
+    }
+
+    int ok = barrier_ok && dag_ok && rejects_ok;
+    LOG_INFO("[Graph] C0 task graph: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
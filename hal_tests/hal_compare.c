@@ -0,0 +1,277 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "hal_tests/hal_compare.h"
+#include "hal_tests/basic_tests.h"
+#include "hal_tests/c0_tests.h"
+#include "hal_tests/dmem_tests.h"
+#include "generated/mem_map.h"
+#include "log/log.h"
+
+#define MAX_SAMPLES     256
+#define SWEEP_BYTES     65536       // bytes per local sample at most
+
+// Tile 3's upper DLM1 and DMEM3's top quarter; no other test uses them
+#define CMP_SRC   (TILE3_DLM1_512_BASE + 0x10000)
+#define CMP_DST   (TILE3_DLM1_512_BASE + 0x14000)
+#define CMP_DMEM  (DMEM3_512_BASE + 0x30000)
+
+typedef enum {
+    OP_CPU_MOVE, OP_DMA_LOCAL, OP_DMA_REMOTE, OP_READ, OP_WRITE, OP_SET, OP_CHECKSUM
+} sweep_op_t;
+
+static const struct {
+    const char* name;
+    sweep_op_t op;
+    size_t sizes[4];        // zero-terminated
+} sweeps[] = {
+    { "cpu_local_move",      OP_CPU_MOVE,   { 64, 1024, 16384 } },
+    { "dma_local_transfer",  OP_DMA_LOCAL,  { 64, 1024, 16384 } },
+    { "dma_remote_transfer", OP_DMA_REMOTE, { 64, 256 } },
+    { "memory_read",         OP_READ,       { 64, 1024, 16384 } },
+    { "memory_write",        OP_WRITE,      { 64, 1024, 16384 } },
+    { "memory_set",          OP_SET,        { 64, 1024, 16384 } },
+    { "memory_checksum",     OP_CHECKSUM,   { 64, 1024, 16384 } },
+};
+
+static const struct {
+    const char* name;
+    int (*run)(mesh_platform_t* p);
+} bodies[] = {
+    { "test:cpu_local_move",      test_cpu_local_move },
+    { "test:dma_local_transfer",  test_dma_local_transfer },
+    { "test:dma_remote_transfer", test_dma_remote_transfer },
+    { "test:dma_fill_engine",     test_dma_fill_engine },
+    { "test:hal_batch",           test_hal_batch },
+    { "test:c0_gather",           test_c0_gather },
+    { "test:c0_distribute",       test_c0_distribute },
+    { "test:dmem_data_integrity", test_dmem_data_integrity },
+};
+
+static uint8_t g_buf[16384];
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// One call; the result is only checked for failure, the data separately
+static int sweep_call(const hal_interface_t* h, sweep_op_t op, size_t size, uint32_t* crc)
+{
+    int r = -1;
+    switch (op) {
+    case OP_CPU_MOVE:   r = h->cpu_local_move(CMP_SRC, CMP_DST, size); break;
+    case OP_DMA_LOCAL:  r = h->dma_local_transfer(3, CMP_SRC, CMP_DST, size); break;
+    case OP_DMA_REMOTE: r = h->dma_remote_transfer(CMP_SRC, CMP_DMEM, size); break;
+    case OP_READ:       r = h->memory_read(CMP_SRC, g_buf, size); break;
+    case OP_WRITE:      r = h->memory_write(CMP_DST, g_buf, size); break;
+    case OP_SET:        r = h->memory_set(CMP_DST, 0x5A, size); break;
+    case OP_CHECKSUM:   r = h->memory_checksum(CMP_SRC, size, crc); break;
+    }
+    return r < 0 ? -1 : 0;
+}
+
+// The candidate must leave the same bytes (or CRC) as the baseline
+static int sweep_agrees(const hal_interface_t* base, const hal_interface_t* cand, sweep_op_t op, size_t size)
+{
+    static uint8_t pattern[16384], want[16384], got[16384];
+    for (size_t i = 0; i < size; i++) pattern[i] = (uint8_t)(i * 13 + size);
+    memcpy(g_buf, pattern, size);
+
+    uint64_t dst = op == OP_DMA_REMOTE ? CMP_DMEM : CMP_DST;
+    uint32_t crc_base = 0, crc_cand = 1;
+    const hal_interface_t* sides[2] = { base, cand };
+    uint8_t* out[2] = { want, got };
+    for (int s = 0; s < 2; s++) {
+        base->memory_write(CMP_SRC, pattern, size);
+        base->memory_set(dst, 0, size);
+        if (sweep_call(sides[s], op, size, s ? &crc_cand : &crc_base) != 0) {
+            return 0;
+        }
+        if (op == OP_READ) {
+            memcpy(out[s], g_buf, size);
+            memcpy(g_buf, pattern, size);
+        } else {
+            base->memory_read(dst, out[s], size);
+        }
+    }
+    if (op == OP_CHECKSUM) {
+        return crc_base == crc_cand;
+    }
+    return memcmp(want, got, size) == 0;
+}
+
+// Two-sided 95% Student t quantile
+static double t95(double df)
+{
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+    if (df < 1.0) return table[0];
+    if (df <= 30.0) return table[(int)df - 1];
+    return 1.960 + 2.4 / df;
+}
+
+static void mean_var(const double* x, int n, double* mean, double* var)
+{
+    double m = 0.0, v = 0.0;
+    for (int i = 0; i < n; i++) m += x[i];
+    m /= n;
+    for (int i = 0; i < n; i++) v += (x[i] - m) * (x[i] - m);
+    *mean = m;
+    *var = n > 1 ? v / (n - 1) : 0.0;
+}
+
+static void finish_row(hal_cmp_row_t* row, const double* a, const double* b, int n, double threshold)
+{
+    double ma, va, mb, vb;
+    mean_var(a, n, &ma, &va);
+    mean_var(b, n, &mb, &vb);
+    row->base_ns = ma;
+    row->cand_ns = mb;
+
+    // Welch interval on the difference of means, as a share of the baseline
+    double sa = va / n, sb = vb / n;
+    double se = sqrt(sa + sb);
+    double df = (sa + sb) * (sa + sb);
+    df = df > 0.0 ? df / (sa * sa / (n - 1) + sb * sb / (n - 1)) : (double)(2 * n - 2);
+    double half = t95(df) * se;
+    row->delta_pct = (mb - ma) / ma * 100.0;
+    row->ci_lo_pct = (mb - ma - half) / ma * 100.0;
+    row->ci_hi_pct = (mb - ma + half) / ma * 100.0;
+
+    if (row->verdict == HAL_CMP_MISMATCH) return;
+    if (row->ci_lo_pct > threshold) {
+        row->verdict = HAL_CMP_REGRESSION;
+    } else if (row->ci_hi_pct < -threshold) {
+        row->verdict = HAL_CMP_FASTER;
+    } else {
+        row->verdict = HAL_CMP_SAME;
+    }
+}
+
+static void run_sweep(const hal_interface_t* base, const hal_interface_t* cand, sweep_op_t op,
+                      size_t size, int samples, double threshold, hal_cmp_row_t* row)
+{
+    double a[MAX_SAMPLES], b[MAX_SAMPLES];
+    // Remote transfers are paced by the NoC model, so one call per sample
+    int reps = op == OP_DMA_REMOTE ? 1 : (int)(SWEEP_BYTES / size);
+    if (reps > 256) reps = 256;
+
+    row->verdict = sweep_agrees(base, cand, op, size) ? HAL_CMP_SAME : HAL_CMP_MISMATCH;
+
+    const hal_interface_t* sides[2] = { base, cand };
+    double* out[2] = { a, b };
+    uint32_t crc;
+    for (int s = -1; s < samples; s++) {
+        for (int k = 0; k < 2; k++) {
+            int side = (s + k) & 1;     // alternate which side goes first
+            double t0 = now_ns();
+            for (int r = 0; r < reps; r++) {
+                if (sweep_call(sides[side], op, size, &crc) != 0) row->verdict = HAL_CMP_MISMATCH;
+            }
+            double t = (now_ns() - t0) / reps;
+            if (s >= 0) out[side][s] = t;   // sample -1 is the warm-up
+        }
+    }
+    finish_row(row, a, b, samples, threshold);
+}
+
+static void run_body(mesh_platform_t* p, const hal_interface_t* base, const hal_interface_t* cand,
+                     int (*body)(mesh_platform_t*), int samples, double threshold, hal_cmp_row_t* row)
+{
+    double a[MAX_SAMPLES], b[MAX_SAMPLES];
+    const hal_interface_t* sides[2] = { base, cand };
+    double* out[2] = { a, b };
+    int result[2] = { -1, -1 };
+
+    // Test bodies narrate every step; keep the report readable
+    log_level_t level = log_get_level();
+    log_set_level(LOG_LEVEL_WARN);
+    row->verdict = HAL_CMP_SAME;
+    for (int s = 0; s < samples; s++) {
+        for (int k = 0; k < 2; k++) {
+            int side = (s + k) & 1;
+            g_hal = *sides[side];
+            double t0 = now_ns();
+            int r = body(p);
+            out[side][s] = now_ns() - t0;
+            if (result[side] == -1) result[side] = r;
+            if (r != result[side]) row->verdict = HAL_CMP_MISMATCH;   // flaky
+        }
+    }
+    log_set_level(level);
+    if (result[0] != result[1]) row->verdict = HAL_CMP_MISMATCH;
+    finish_row(row, a, b, samples, threshold);
+}
+
+int hal_compare_run(mesh_platform_t* p, const hal_interface_t* base, const hal_interface_t* cand,
+                    const hal_cmp_opts_t* opts, hal_cmp_row_t* rows, int max_rows)
+{
+    if (!base || !cand || !opts || !rows || opts->samples < 2 || opts->samples > MAX_SAMPLES ||
+        opts->test_samples < 0 || opts->test_samples == 1 || opts->test_samples > MAX_SAMPLES) {
+        return -1;
+    }
+
+    hal_interface_t saved = g_hal;
+    int n = 0;
+    for (size_t i = 0; i < sizeof(sweeps) / sizeof(sweeps[0]); i++) {
+        for (int j = 0; sweeps[i].sizes[j] && n < max_rows; j++) {
+            hal_cmp_row_t* row = &rows[n++];
+            memset(row, 0, sizeof(*row));
+            snprintf(row->name, sizeof(row->name), "%s", sweeps[i].name);
+            row->size = sweeps[i].sizes[j];
+            run_sweep(base, cand, sweeps[i].op, row->size, opts->samples, opts->threshold_pct, row);
+        }
+    }
+    for (size_t i = 0; opts->test_samples && i < sizeof(bodies) / sizeof(bodies[0]) && n < max_rows; i++) {
+        hal_cmp_row_t* row = &rows[n++];
+        memset(row, 0, sizeof(*row));
+        snprintf(row->name, sizeof(row->name), "%s", bodies[i].name);
+        run_body(p, base, cand, bodies[i].run, opts->test_samples, opts->threshold_pct, row);
+    }
+    g_hal = saved;
+    return n;
+}
+
+const char* hal_compare_verdict_name(hal_cmp_verdict_t verdict)
+{
+    switch (verdict) {
+    case HAL_CMP_SAME:       return "same";
+    case HAL_CMP_FASTER:     return "faster";
+    case HAL_CMP_REGRESSION: return "REGRESSION";
+    case HAL_CMP_MISMATCH:   return "MISMATCH";
+    }
+    return "?";
+}
+
+void hal_compare_print(const char* base_name, const char* cand_name, const hal_cmp_opts_t* opts,
+                       const hal_cmp_row_t* rows, int n)
+{
+    LOG_INFO("[HAL-COMPARE] baseline '%s' vs candidate '%s': %d samples per sweep, %d per test body, threshold %.1f%%\n",
+             base_name, cand_name, opts->samples, opts->test_samples, opts->threshold_pct);
+    LOG_INFO("[HAL-COMPARE] %-26s %6s %11s %11s %9s %9s %8s %19s  %s\n",
+             "operation", "bytes", "base_ns", "cand_ns", "base_MB/s", "cand_MB/s", "delta", "95% CI", "verdict");
+    int regressions = 0, mismatches = 0;
+    for (int i = 0; i < n; i++) {
+        const hal_cmp_row_t* r = &rows[i];
+        char size[24] = "-", bw_a[16] = "-", bw_b[16] = "-", ci[32];
+        if (r->size) {
+            snprintf(size, sizeof(size), "%zu", r->size);
+            snprintf(bw_a, sizeof(bw_a), "%.1f", (double)r->size / r->base_ns * 1e3);
+            snprintf(bw_b, sizeof(bw_b), "%.1f", (double)r->size / r->cand_ns * 1e3);
+        }
+        snprintf(ci, sizeof(ci), "[%+.1f%%, %+.1f%%]", r->ci_lo_pct, r->ci_hi_pct);
+        LOG_INFO("[HAL-COMPARE] %-26s %6s %11.1f %11.1f %9s %9s %+7.1f%% %19s  %s\n",
+                 r->name, size, r->base_ns, r->cand_ns, bw_a, bw_b, r->delta_pct, ci,
+                 hal_compare_verdict_name(r->verdict));
+        regressions += r->verdict == HAL_CMP_REGRESSION;
+        mismatches += r->verdict == HAL_CMP_MISMATCH;
+    }
+    LOG_INFO("[HAL-COMPARE] %d rows: %d regressions, %d mismatches\n", n, regressions, mismatches);
+}
@@ -0,0 +1,49 @@
+#ifndef HAL_COMPARE_H
+#define HAL_COMPARE_H
+#include <stddef.h>
+#include "hal_tests/hal_interface.h"
+
+// Side-by-side performance comparison of two HAL function tables.
+//
+// Every row runs the same workload against the baseline and the candidate,
+// interleaving the samples (ABAB...) so drift hits both sides alike. Rows
+// are synthetic sweeps of the data-path calls over several sizes plus,
+// optionally, whole HAL test bodies run through g_hal. The candidate is
+// checked against the baseline for correctness before it is timed.
+//
+// delta is the change of the candidate's mean time per call; the interval
+// is a Welch 95% confidence interval on that change. A row is a
+// regression only when the whole interval lies above the threshold.
+
+typedef enum {
+    HAL_CMP_SAME,           // interval reaches inside +/- threshold
+    HAL_CMP_FASTER,         // whole interval below -threshold
+    HAL_CMP_REGRESSION,     // whole interval above +threshold
+    HAL_CMP_MISMATCH        // candidate result differs from the baseline
+} hal_cmp_verdict_t;
+
+typedef struct {
+    int samples;            // per side for each sweep row (>= 2)
+    int test_samples;       // per side for each test body (0 skips them)
+    double threshold_pct;
+} hal_cmp_opts_t;
+
+typedef struct {
+    char name[40];
+    size_t size;            // bytes per call; 0 for test bodies
+    double base_ns, cand_ns;        // mean per call
+    double delta_pct, ci_lo_pct, ci_hi_pct;
+    hal_cmp_verdict_t verdict;
+} hal_cmp_row_t;
+
+// Runs every row; returns how many were written to rows (at most
+// max_rows), or -1 on bad arguments. g_hal is restored afterwards.
+int hal_compare_run(mesh_platform_t* p, const hal_interface_t* base, const hal_interface_t* cand,
+                    const hal_cmp_opts_t* opts, hal_cmp_row_t* rows, int max_rows);
+
+void hal_compare_print(const char* base_name, const char* cand_name, const hal_cmp_opts_t* opts,
+                       const hal_cmp_row_t* rows, int n);
+
+const char* hal_compare_verdict_name(hal_cmp_verdict_t verdict);
+
+#endif
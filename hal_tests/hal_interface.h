@@ -2,6 +2,7 @@
 #define HAL_INTERFACE_H
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "tile_memory.h"
 #include "c0_master/c0_controller.h"
 
@@ -11,6 +12,47 @@ typedef enum {
     MEM_DMEM_512
 } mem_type_t;
 
+// Batched submission: one validation/lock/log pass for many operations
+typedef enum {
+    HAL_OP_CPU_MOVE,        // src -> dst by CPU (memmove semantics)
+    HAL_OP_DMA_LOCAL,       // src -> dst inside tile_id via its DMAC512
+    HAL_OP_DMA_REMOTE,      // src -> dst over the NoC
+    HAL_OP_DMEM_COPY,       // DMEM -> DMEM
+    HAL_OP_READ,            // src -> buffer
+    HAL_OP_WRITE,           // buffer -> dst
+    HAL_OP_FILL,            // dst[i] = value + i
+    HAL_OP_SET              // dst[i] = value
+} hal_op_type_t;
+
+typedef struct {
+    hal_op_type_t type;
+    int      tile_id;       // HAL_OP_DMA_LOCAL only
+    uint64_t src_addr;
+    uint64_t dst_addr;
+    size_t   size;
+    uint8_t* buffer;        // HAL_OP_READ destination / HAL_OP_WRITE source
+    uint8_t  value;         // HAL_OP_FILL / HAL_OP_SET
+} hal_op_t;
+
+typedef struct {
+    int status;             // what the single-op HAL call would have returned
+    int wave;               // execution wave, -1 if the op was rejected
+} hal_result_t;
+
+// Zero-copy window onto simulated memory. The range is pinned until
+// memory_unmap: other threads' HAL calls that write it wait, and for a
+// read-write view so do their reads. memory_commit publishes the writes
+// made through wdata and turns the view read-only; unmapping a read-write
+// view without committing it fails. Views belong to the thread that
+// mapped them and should be short-lived.
+typedef struct {
+    const uint8_t* data;    // valid until memory_unmap
+    uint8_t* wdata;         // memory_map_rw until committed, otherwise NULL
+    uint64_t addr;
+    size_t size;
+    int pin;                // HAL private, 0 when unmapped
+} hal_mem_view_t;
+
 typedef struct {
     int (*cpu_local_move)(uint64_t src_addr, uint64_t dst_addr, size_t size);
     int (*dma_local_transfer)(int tile_id, uint64_t src_addr, uint64_t dst_addr, size_t size);
@@ -24,11 +66,71 @@ typedef struct {
     int (*memory_write)(uint64_t addr, const uint8_t* buffer, size_t size);
     int (*memory_fill)(uint64_t addr, uint8_t value, size_t size);
     int (*memory_set)(uint64_t addr, uint8_t value, size_t size);
+    // DMA fill engine (offloads initialization to the owning tile's DMAC512)
+    int (*dma_memory_fill)(uint64_t addr, uint8_t value, size_t size);     // dst[i] = value + i
+    int (*dma_memory_set)(uint64_t addr, uint8_t value, size_t size);      // dst[i] = value
+    int (*dma_memory_fill_pattern)(uint64_t addr, const uint8_t* pattern, size_t size); // 64-byte pattern
+    // Integrity checks: CRC32C of a range, and a local DMA transfer that reports its CRC
+    int (*memory_checksum)(uint64_t addr, size_t size, uint32_t* crc);
+    int (*dma_local_transfer_crc)(int tile_id, uint64_t src_addr, uint64_t dst_addr, size_t size, uint32_t* crc);
+    // Ops in the same wave are independent and may run in parallel; ops that
+    // touch overlapping ranges keep submission order. Returns ops succeeded.
+    int (*submit_batch)(const hal_op_t* ops, size_t n, hal_result_t* results);
+    // Memory views: return size on success like memory_read
+    int (*memory_map_ro)(uint64_t addr, size_t size, hal_mem_view_t* view);
+    int (*memory_map_rw)(uint64_t addr, size_t size, hal_mem_view_t* view);
+    int (*memory_commit)(hal_mem_view_t* view);
+    int (*memory_unmap)(hal_mem_view_t* view);
 } hal_interface_t;
 
 extern hal_interface_t g_hal;
 
+// External HAL libraries (HAL=<shared.so>) export one of these as
+// HAL_EXPORT_SYMBOL. Bump HAL_ABI_VERSION whenever an existing slot changes
+// meaning or signature; appending slots only grows table_size.
+#define HAL_ABI_VERSION   1
+#define HAL_EXPORT_SYMBOL "hal_export"
+
+typedef struct {
+    uint32_t abi_version;               // HAL_ABI_VERSION the library was built against
+    uint32_t table_size;                // sizeof(hal_interface_t) the library was built against
+    const char* name;
+    const hal_interface_t* table;       // NULL slots fall back to the reference HAL
+    int (*init)(mesh_platform_t* p);    // optional, called once after loading
+} hal_export_t;
+
+static inline int hal_submit_batch(const hal_op_t* ops, size_t n, hal_result_t* results)
+{
+    return g_hal.submit_batch(ops, n, results);
+}
+
+// 1 if both ranges hold the same bytes, 0 if not, -1 if either can't be mapped
+static inline int hal_memory_equal(uint64_t a, uint64_t b, size_t size)
+{
+    hal_mem_view_t va, vb;
+    if (g_hal.memory_map_ro(a, size, &va) < 0) {
+        return -1;
+    }
+    if (g_hal.memory_map_ro(b, size, &vb) < 0) {
+        g_hal.memory_unmap(&va);
+        return -1;
+    }
+    int equal = memcmp(va.data, vb.data, size) == 0;
+    g_hal.memory_unmap(&vb);
+    g_hal.memory_unmap(&va);
+    return equal;
+}
+
+typedef struct {
+    uint64_t batches;
+    uint64_t ops;
+    uint64_t transfers;     // after coalescing adjacent ops
+    uint64_t waves;
+} hal_batch_stats_t;
+
 void hal_use_reference_impl(void);
+const hal_interface_t* hal_reference_table(void);
+void hal_batch_get_stats(hal_batch_stats_t* stats);
 
 void hal_set_platform(mesh_platform_t* p);
 #endif
\ No newline at end of file
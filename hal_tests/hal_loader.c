@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dlfcn.h>
+#include "hal_tests/hal_loader.h"
+#include "hal_tests/hal_stats.h"
+#include "log/log.h"
+
+typedef void (*hal_slot_t)(void);
+
+int hal_load_library(const char* path, mesh_platform_t* p, hal_interface_t* table, const char** name)
+{
+    if (!path || !table) {
+        return -1;
+    }
+
+    void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        LOG_ERROR("[HAL-LOADER] dlopen failed: %s\n", dlerror());
+        return -1;
+    }
+
+    const hal_export_t* exp = (const hal_export_t*)dlsym(handle, HAL_EXPORT_SYMBOL);
+    const char* reason = NULL;
+    if (!exp) {
+        reason = "missing " HAL_EXPORT_SYMBOL " symbol";
+    } else if (exp->abi_version != HAL_ABI_VERSION) {
+        reason = "ABI version mismatch";
+    } else if (exp->table_size == 0 || exp->table_size > sizeof(hal_interface_t) ||
+               exp->table_size % sizeof(hal_slot_t) != 0) {
+        reason = "function table size mismatch";
+    } else if (!exp->table) {
+        reason = "no function table";
+    }
+    if (reason) {
+        LOG_ERROR("[HAL-LOADER] %s: %s (library ABI %u/%u bytes, host ABI %u/%zu bytes)\n",
+               path, reason, exp ? exp->abi_version : 0, exp ? exp->table_size : 0,
+               HAL_ABI_VERSION, sizeof(hal_interface_t));
+        dlclose(handle);
+        return -1;
+    }
+
+    // Older libraries export a prefix of the table; unset slots keep the reference
+    hal_interface_t merged = *hal_reference_table();
+    hal_slot_t* dst = (hal_slot_t*)&merged;
+    const hal_slot_t* src = (const hal_slot_t*)exp->table;
+    size_t slots = exp->table_size / sizeof(hal_slot_t);
+    size_t overridden = 0;
+    for (size_t i = 0; i < slots; i++) {
+        if (src[i]) {
+            dst[i] = src[i];
+            overridden++;
+        }
+    }
+
+    if (exp->init && exp->init(p) != 0) {
+        LOG_ERROR("[HAL-LOADER] %s: init failed\n", path);
+        dlclose(handle);
+        return -1;
+    }
+
+    *table = merged;
+    if (name) {
+        *name = exp->name ? exp->name : path;
+    }
+    LOG_INFO("[HAL-LOADER] Loaded '%s' from %s (%zu/%zu slots overridden)\n",
+           exp->name ? exp->name : "unnamed", path, overridden, sizeof(hal_interface_t) / sizeof(hal_slot_t));
+    return 0;
+}
+
+int hal_select_impl(mesh_platform_t* p)
+{
+    hal_use_reference_impl();
+    hal_set_platform(p);
+
+    int external = 0;
+    const char* path = getenv("HAL");
+    if (path && *path) {
+        hal_interface_t table;
+        if (hal_load_library(path, p, &table, NULL) == 0) {
+            g_hal = table;
+            external = 1;
+        } else {
+            LOG_WARN("[HAL-LOADER] Falling back to the reference HAL\n");
+        }
+    }
+
+    // Instrument whichever HAL ended up selected
+    hal_stats_install();
+    const char* stats = getenv("HAL_STATS");
+    hal_stats_set_enabled(stats && *stats && *stats != '0');
+    return external;
+}
@@ -0,0 +1,16 @@
+#ifndef HAL_LOADER_H
+#define HAL_LOADER_H
+#include "hal_tests/hal_interface.h"
+
+// Loads an external HAL library into *table: the reference implementation
+// overlaid with every non-NULL slot the library exports. The library stays
+// loaded for the life of the process. Returns 0, or -1 if the library
+// cannot be opened, lacks HAL_EXPORT_SYMBOL, or fails the ABI/size check.
+int hal_load_library(const char* path, mesh_platform_t* p, hal_interface_t* table, const char** name);
+
+// Installs the reference HAL, then the library named by $HAL if it loads,
+// and wraps the result with the call instrumentation ($HAL_STATS=1 enables
+// it). Returns 1 when an external HAL is active, 0 for the reference HAL.
+int hal_select_impl(mesh_platform_t* p);
+
+#endif
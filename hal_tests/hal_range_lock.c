@@ -0,0 +1,207 @@
+#define _GNU_SOURCE
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include "hal_tests/hal_range_lock.h"
+#include "tile/tile_coro.h"
+
+#define WORDS (HAL_RANGE_LOCK_STRIPES / 64)
+
+static pthread_rwlock_t stripes[HAL_RANGE_LOCK_STRIPES];
+static pthread_once_t stripes_once = PTHREAD_ONCE_INIT;
+static hal_range_lock_stats_t g_stats;
+
+// Pin slots: state 0 free, 1 claimed, 2 live. A live pin that conflicts
+// with a caller was published before the caller got its stripes, so its
+// fields are stable while the caller looks at them.
+typedef struct {
+    uint32_t state;
+    int exclusive;
+    uint64_t lo, hi;
+    const void* owner;
+} pin_slot_t;
+
+static pin_slot_t pin_slots[HAL_RANGE_PIN_SLOTS];
+static uint32_t g_pins_held;
+
+static void stripes_init(void)
+{
+    for (int i = 0; i < HAL_RANGE_LOCK_STRIPES; i++) {
+        pthread_rwlock_init(&stripes[i], NULL);
+    }
+}
+
+// XOR with a per-window constant keeps a window's granules on distinct
+// stripes while spreading equal offsets of different tiles/DMEMs apart
+static unsigned stripe_of(uint64_t granule)
+{
+    uint64_t window = granule / HAL_RANGE_LOCK_STRIPES;
+    return (unsigned)((granule ^ (window * 0x9E37U)) & (HAL_RANGE_LOCK_STRIPES - 1));
+}
+
+void hal_range_lock_init(hal_range_lock_t* l)
+{
+    memset(l, 0, sizeof(*l));
+}
+
+void hal_range_lock_add(hal_range_lock_t* l, uint64_t addr, size_t size, int exclusive)
+{
+    uint64_t* set = exclusive ? l->exclusive : l->shared;
+    if (size == 0) {
+        return;
+    }
+
+    if (l->nspans < HAL_RANGE_LOCK_SPANS) {
+        l->spans[l->nspans++] = (hal_range_span_t){ addr, addr + size, exclusive };
+    } else {
+        hal_range_span_t* last = &l->spans[HAL_RANGE_LOCK_SPANS - 1];
+        last->lo = addr < last->lo ? addr : last->lo;
+        last->hi = addr + size > last->hi ? addr + size : last->hi;
+        last->exclusive |= exclusive;
+    }
+
+    uint64_t first = addr >> HAL_RANGE_LOCK_GRANULE_SHIFT;
+    uint64_t last = (addr + size - 1) >> HAL_RANGE_LOCK_GRANULE_SHIFT;
+    if (last - first >= HAL_RANGE_LOCK_STRIPES) {
+        memset(set, 0xFF, sizeof(l->shared));
+        return;
+    }
+    for (uint64_t g = first; g <= last; g++) {
+        unsigned s = stripe_of(g);
+        set[s / 64] |= 1ULL << (s % 64);
+    }
+}
+
+static int lock_stripes(hal_range_lock_t* l)
+{
+    int waited = 0;
+    for (int w = 0; w < WORDS; w++) {
+        uint64_t excl = l->exclusive[w];
+        uint64_t all = excl | l->shared[w];
+        while (all) {
+            int bit = __builtin_ctzll(all);
+            all &= all - 1;
+            waited |= coro_rwlock_lock(&stripes[w * 64 + bit], (excl & (1ULL << bit)) != 0);
+        }
+    }
+    return waited;
+}
+
+// Another thread pins a range l writes, or pins exclusively a range l reads
+static int pins_conflict(const hal_range_lock_t* l)
+{
+    if (__atomic_load_n(&g_pins_held, __ATOMIC_ACQUIRE) == 0) {
+        return 0;
+    }
+    const void* self = coro_self();
+    for (int i = 0; i < HAL_RANGE_PIN_SLOTS; i++) {
+        pin_slot_t* pin = &pin_slots[i];
+        if (__atomic_load_n(&pin->state, __ATOMIC_ACQUIRE) != 2 ||
+            __atomic_load_n(&pin->owner, __ATOMIC_RELAXED) == self) {
+            continue;
+        }
+        int pin_excl = __atomic_load_n(&pin->exclusive, __ATOMIC_ACQUIRE);
+        uint64_t lo = __atomic_load_n(&pin->lo, __ATOMIC_RELAXED);
+        uint64_t hi = __atomic_load_n(&pin->hi, __ATOMIC_RELAXED);
+        for (int s = 0; s < l->nspans; s++) {
+            const hal_range_span_t* span = &l->spans[s];
+            if ((span->exclusive || pin_excl) && span->lo < hi && lo < span->hi) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+void hal_range_lock_acquire(hal_range_lock_t* l)
+{
+    pthread_once(&stripes_once, stripes_init);
+
+    // Pins are waited out with the stripes dropped, so a pin holder that
+    // needs one of them is never blocked behind us
+    int waited = lock_stripes(l);
+    int pin_waited = 0;
+    while (pins_conflict(l)) {
+        hal_range_lock_release(l);
+        pin_waited = 1;
+        while (pins_conflict(l)) {
+            coro_yield();
+        }
+        waited |= lock_stripes(l);
+    }
+
+    __atomic_fetch_add(&g_stats.acquisitions, 1, __ATOMIC_RELAXED);
+    if (waited) {
+        __atomic_fetch_add(&g_stats.contended, 1, __ATOMIC_RELAXED);
+    }
+    if (pin_waited) {
+        __atomic_fetch_add(&g_stats.pin_waits, 1, __ATOMIC_RELAXED);
+    }
+}
+
+void hal_range_lock_release(hal_range_lock_t* l)
+{
+    for (int w = WORDS - 1; w >= 0; w--) {
+        uint64_t all = l->exclusive[w] | l->shared[w];
+        while (all) {
+            int bit = __builtin_ctzll(all);
+            all &= all - 1;
+            coro_rwlock_unlock(&stripes[w * 64 + bit]);
+        }
+    }
+}
+
+// Publishing the pin under the stripes orders it against in-flight calls;
+// dropping or downgrading it needs no lock
+int hal_range_pin(uint64_t addr, size_t size, int exclusive)
+{
+    int slot = -1;
+    for (int i = 0; i < HAL_RANGE_PIN_SLOTS && slot < 0; i++) {
+        uint32_t free_state = 0;
+        if (__atomic_compare_exchange_n(&pin_slots[i].state, &free_state, 1, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            slot = i;
+        }
+    }
+    if (slot < 0) {
+        return -1;
+    }
+
+    hal_range_lock_t l;
+    hal_range_lock_init(&l);
+    hal_range_lock_add(&l, addr, size, exclusive);
+    hal_range_lock_acquire(&l);
+    pin_slot_t* pin = &pin_slots[slot];
+    __atomic_store_n(&pin->lo, addr, __ATOMIC_RELAXED);
+    __atomic_store_n(&pin->hi, addr + size, __ATOMIC_RELAXED);
+    __atomic_store_n(&pin->owner, coro_self(), __ATOMIC_RELAXED);
+    __atomic_store_n(&pin->exclusive, exclusive, __ATOMIC_RELAXED);
+    __atomic_store_n(&pin->state, 2, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&g_pins_held, 1, __ATOMIC_RELEASE);
+    hal_range_lock_release(&l);
+    return slot;
+}
+
+void hal_range_unpin(int pin)
+{
+    if (pin < 0 || pin >= HAL_RANGE_PIN_SLOTS) {
+        return;
+    }
+    __atomic_fetch_sub(&g_pins_held, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&pin_slots[pin].state, 0, __ATOMIC_RELEASE);
+}
+
+void hal_range_pin_downgrade(int pin)
+{
+    if (pin < 0 || pin >= HAL_RANGE_PIN_SLOTS) {
+        return;
+    }
+    __atomic_store_n(&pin_slots[pin].exclusive, 0, __ATOMIC_RELEASE);
+}
+
+void hal_range_lock_get_stats(hal_range_lock_stats_t* stats)
+{
+    stats->acquisitions = __atomic_load_n(&g_stats.acquisitions, __ATOMIC_RELAXED);
+    stats->contended = __atomic_load_n(&g_stats.contended, __ATOMIC_RELAXED);
+    stats->pin_waits = __atomic_load_n(&g_stats.pin_waits, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,69 @@
+#ifndef HAL_RANGE_LOCK_H
+#define HAL_RANGE_LOCK_H
+#include <stddef.h>
+#include <stdint.h>
+
+// Striped reader-writer locks over the platform address space.
+//
+// Addresses are split into 256-byte granules and each granule hashes to
+// one of HAL_RANGE_LOCK_STRIPES rwlocks; consecutive granules inside a
+// 256 KiB window always land on distinct stripes. A HAL call collects
+// every range it touches into one hal_range_lock_t and acquires the
+// stripes in ascending order, so calls on disjoint ranges run in parallel
+// and multi-range calls cannot deadlock against each other.
+//
+//   hal_range_lock_t l;
+//   hal_range_lock_init(&l);
+//   hal_range_lock_add(&l, src, size, 0);   // shared
+//   hal_range_lock_add(&l, dst, size, 1);   // exclusive
+//   hal_range_lock_acquire(&l);
+//   ...
+//   hal_range_lock_release(&l);
+//
+// Pins hold a range across calls without holding its stripes (zero-copy
+// memory views). A shared pin makes writers of the range wait, an
+// exclusive pin makes readers and writers wait. Pins are checked against
+// the exact byte ranges a call added, and acquire drops its stripes while
+// it waits, so a pin holder may keep making HAL calls. A thread's own pins
+// never block it.
+
+#define HAL_RANGE_LOCK_GRANULE_SHIFT 8
+#define HAL_RANGE_LOCK_STRIPES       1024
+#define HAL_RANGE_LOCK_SPANS         8      // further ranges widen the last span
+#define HAL_RANGE_PIN_SLOTS          64     // pins held at once, all threads
+
+typedef struct {
+    uint64_t lo, hi;        // [lo, hi)
+    int exclusive;
+} hal_range_span_t;
+
+typedef struct {
+    uint64_t shared[HAL_RANGE_LOCK_STRIPES / 64];
+    uint64_t exclusive[HAL_RANGE_LOCK_STRIPES / 64];
+    hal_range_span_t spans[HAL_RANGE_LOCK_SPANS];
+    int nspans;
+} hal_range_lock_t;
+
+typedef struct {
+    uint64_t acquisitions;
+    uint64_t contended;     // acquisitions that had to wait for a stripe
+    uint64_t pin_waits;     // acquisitions that had to wait for another thread's pin
+} hal_range_lock_stats_t;
+
+void hal_range_lock_init(hal_range_lock_t* l);
+// Exclusive wins when a stripe is added in both modes
+void hal_range_lock_add(hal_range_lock_t* l, uint64_t addr, size_t size, int exclusive);
+void hal_range_lock_acquire(hal_range_lock_t* l);
+void hal_range_lock_release(hal_range_lock_t* l);
+
+// Waits out conflicting calls and pins like an acquisition in the same
+// mode; returns a pin handle, or -1 when every pin slot is taken. Pins
+// belong to the calling thread and must be dropped by it.
+int hal_range_pin(uint64_t addr, size_t size, int exclusive);
+void hal_range_unpin(int pin);
+// Turns an exclusive pin into a shared one, publishing the writes made under it
+void hal_range_pin_downgrade(int pin);
+
+void hal_range_lock_get_stats(hal_range_lock_stats_t* stats);
+
+#endif
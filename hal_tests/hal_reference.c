@@ -1,3 +1,4 @@
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include "hal_tests/hal_interface.h"
@@ -7,149 +8,142 @@
 #include "tile_dma.h"
 #include "mesh_noc/mesh_router.h"
 #include "mesh_noc/noc_packet.h"
+#include "mesh_noc/mesh_routing.h"
 #include "dmem/dmem_controller.h"
+#include "mem_ops/mem_ops.h"
+#include "hal_tests/hal_range_lock.h"
+#include "tile/tile_coro.h"
 #include <pthread.h>
 #include <unistd.h>
+#include "log/log.h"
 
 static mesh_platform_t* g_platform = NULL;
 
-// Thread safety for HAL interface
-static pthread_mutex_t hal_mutex = PTHREAD_MUTEX_INITIALIZER;
-
-// HAL Function Call Tracking
-void hal_function_entry(const char* hal_func, const char* caller_test) {
-    printf("[HAL-ENTRY] %s called by test '%s'\n", hal_func, caller_test);
-    fflush(stdout);
+// Thread safety for HAL interface: calls lock only the address ranges they
+// touch (see hal_range_lock.h), tile DMA engines are serialised by the
+// tile DMA driver and the NoC arbitrates per destination.
+static void lock_copy(hal_range_lock_t* l, uint64_t src_addr, uint64_t dst_addr, size_t size)
+{
+    hal_range_lock_init(l);
+    hal_range_lock_add(l, src_addr, size, 0);
+    hal_range_lock_add(l, dst_addr, size, 1);
+    hal_range_lock_acquire(l);
 }
 
-void hal_function_exit(const char* hal_func, int result) {
-    printf("[HAL-EXIT] %s completed with result: %d\n", hal_func, result);
-    fflush(stdout);
+static void lock_range(hal_range_lock_t* l, uint64_t addr, size_t size, int exclusive)
+{
+    hal_range_lock_init(l);
+    hal_range_lock_add(l, addr, size, exclusive);
+    hal_range_lock_acquire(l);
 }
 
 void hal_set_platform(mesh_platform_t* p) { g_platform = p; }
 
 static int ref_cpu_local_move(uint64_t src_addr, uint64_t dst_addr, size_t size)
 {
-    hal_function_entry("hal_cpu_local_move", "CPU Local Move Test");
-    
-    pthread_mutex_lock(&hal_mutex);
-    
     // HAL validates addresses and translates to memory access
     uint8_t* src_ptr = addr_to_ptr(src_addr);
     uint8_t* dst_ptr = addr_to_ptr(dst_addr);
     
     if (!src_ptr || !dst_ptr) {
-        pthread_mutex_unlock(&hal_mutex);
-        hal_function_exit("hal_cpu_local_move", -1);
         return -1;
     }
     if (!validate_address(src_addr, size) || !validate_address(dst_addr, size)) {
-        pthread_mutex_unlock(&hal_mutex);
-        hal_function_exit("hal_cpu_local_move", -1);
         return -1;
     }
     
-    printf("[DRIVER-CALL] CPU Local Move → memory driver (memmove)\n");
-    fflush(stdout);
+    LOG_DEBUG("[DRIVER-CALL] CPU Local Move → memory driver (mem_ops_move)\n");
     
     // HAL could call driver here, or do direct memory access
-    memmove(dst_ptr, src_ptr, size);
+    hal_range_lock_t lock;
+    lock_copy(&lock, src_addr, dst_addr, size);
+    mem_ops_move(dst_ptr, src_ptr, size);
+    hal_range_lock_release(&lock);
     
-    pthread_mutex_unlock(&hal_mutex);
-    hal_function_exit("hal_cpu_local_move", 0);
     return 0;
 }
 
 static int ref_dma_local_transfer(int tile_id, uint64_t src_addr, uint64_t dst_addr, size_t size)
 {
-    hal_function_entry("hal_dma_local_transfer", "DMA Local Transfer Test");
-    
-    pthread_mutex_lock(&hal_mutex);
-    
-    printf("[DRIVER-CALL] DMA Local Transfer → tile DMA driver\n");
-    fflush(stdout);
+    LOG_DEBUG("[DRIVER-CALL] DMA Local Transfer → tile DMA driver\n");
     
     // Call tile DMA driver
+    hal_range_lock_t lock;
+    lock_copy(&lock, src_addr, dst_addr, size);
     int result = dma_local_transfer(tile_id, src_addr, dst_addr, size);
+    hal_range_lock_release(&lock);
     
-    pthread_mutex_unlock(&hal_mutex);
-    hal_function_exit("hal_dma_local_transfer", result);
     return result;
 }
 
-static int ref_dma_remote_transfer(uint64_t src_addr, uint64_t dst_addr, size_t size)
+// Remote DMA rules: tile DLM1_512 <-> DMEM, or a tile DLM1_512/DLM_64 to
+// another tile's DLM1_512/DLM_64 (same-tile copies use the local DMA)
+static int remote_transfer_allowed(uint64_t src_addr, uint64_t dst_addr, size_t size)
 {
-    hal_function_entry("hal_dma_remote_transfer", "DMA Remote Transfer Test");
-    
-    pthread_mutex_lock(&hal_mutex);
-    
     if (!g_platform) {
-        pthread_mutex_unlock(&hal_mutex);
-        hal_function_exit("hal_dma_remote_transfer", -1);
-        return -1;
+        return 0;
     }
     if (!validate_address(src_addr, size) || !validate_address(dst_addr, size)) {
-        pthread_mutex_unlock(&hal_mutex);
-        hal_function_exit("hal_dma_remote_transfer", -1);
-        return -1;
+        return 0;
     }
-
-    
     
-    // Validate this is a valid remote transfer (tile<->dmem)
     addr_region_t src_region = get_address_region(src_addr);
     addr_region_t dst_region = get_address_region(dst_addr);
-    
-    // Allow tile DLM1_512 <-> DMEM transfers
-    if (!((src_region == ADDR_TILE_DLM1_512 && dst_region == ADDR_DMEM_512) ||
-          (src_region == ADDR_DMEM_512 && dst_region == ADDR_TILE_DLM1_512))) {
-        pthread_mutex_unlock(&hal_mutex);
-        hal_function_exit("hal_dma_remote_transfer", -1);
-        return -1;
-    }
-    
-    printf("[DRIVER-CALL] DMA Remote Transfer → NoC packet driver\n");
-    fflush(stdout);
-    
+    int src_is_dlm = (src_region == ADDR_TILE_DLM1_512 || src_region == ADDR_TILE_DLM64);
+    int dst_is_dlm = (dst_region == ADDR_TILE_DLM1_512 || dst_region == ADDR_TILE_DLM64);
+    
+    int tile_dmem = (src_region == ADDR_TILE_DLM1_512 && dst_region == ADDR_DMEM_512) ||
+                    (src_region == ADDR_DMEM_512 && dst_region == ADDR_TILE_DLM1_512);
+    int tile_peer = src_is_dlm && dst_is_dlm &&
+                    get_tile_id_from_address(src_addr) != get_tile_id_from_address(dst_addr);
+    return tile_dmem || tile_peer;
+}
+
+static void remote_transfer_send(uint64_t src_addr, uint64_t dst_addr, size_t size)
+{
     // Create NoC packet with address information
     noc_packet_t pkt = {0};
-    int src_tile = get_tile_id_from_address(src_addr);
-    int dst_tile = get_tile_id_from_address(dst_addr);
+    noc_addr_to_coords(src_addr, &pkt.hdr.src_x, &pkt.hdr.src_y);
+    noc_addr_to_coords(dst_addr, &pkt.hdr.dest_x, &pkt.hdr.dest_y);
     
-    if (src_tile >= 0) {
-        pkt.hdr.src_x = src_tile % 4;
-        pkt.hdr.src_y = src_tile / 4;
-    }
-    if (dst_tile >= 0) {
-        pkt.hdr.dest_x = dst_tile % 4;
-        pkt.hdr.dest_y = dst_tile / 4;
-    }
+    int hops = 0;
+    calc_xy_route(pkt.hdr.src_x, pkt.hdr.src_y, pkt.hdr.dest_x, pkt.hdr.dest_y, &hops);
     
     pkt.hdr.type = PKT_DMA_TRANSFER;
-    pkt.hdr.length = (uint16_t)size;
+    pkt.hdr.length = (uint32_t)size;
+    pkt.hdr.hop_count = (uint8_t)hops;
     pkt.hdr.src_addr = src_addr;  // Add source address
     pkt.hdr.dst_addr = dst_addr;  // Add destination address
     
     // NoC driver now does both routing AND data transfer
     noc_send_packet(&pkt);
+}
+
+static int ref_dma_remote_transfer(uint64_t src_addr, uint64_t dst_addr, size_t size)
+{
+    if (!remote_transfer_allowed(src_addr, dst_addr, size)) {
+        return -1;
+    }
+    
+    LOG_DEBUG("[DRIVER-CALL] DMA Remote Transfer → NoC packet driver\n");
+    
+    // Only accesses overlapping src/dst wait for the packet; the NoC itself
+    // arbitrates between packets to the same destination
+    hal_range_lock_t lock;
+    lock_copy(&lock, src_addr, dst_addr, size);
+    remote_transfer_send(src_addr, dst_addr, size);
+    hal_range_lock_release(&lock);
     
-    pthread_mutex_unlock(&hal_mutex);
-    hal_function_exit("hal_dma_remote_transfer", (int)size);
     return (int)size;
 
 }
 
 static int ref_dmem_to_dmem_transfer(uint64_t src_addr, uint64_t dst_addr, size_t size)
 {
-    pthread_mutex_lock(&hal_mutex);
-    
     if (!g_platform) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     if (!validate_address(src_addr, size) || !validate_address(dst_addr, size)) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
         
@@ -158,169 +152,531 @@ static int ref_dmem_to_dmem_transfer(uint64_t src_addr, uint64_t dst_addr, size_
     addr_region_t dst_region = get_address_region(dst_addr);
     
     if (src_region != ADDR_DMEM_512 || dst_region != ADDR_DMEM_512) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     
     // HAL calls DMEM driver instead of NoC for DMEM-to-DMEM transfers
     // This follows the proper Tests → HAL → Driver flow
+    hal_range_lock_t lock;
+    lock_copy(&lock, src_addr, dst_addr, size);
     int result = dmem_copy(src_addr, dst_addr, size);
+    hal_range_lock_release(&lock);
     
-    pthread_mutex_unlock(&hal_mutex);
     return result;
 }
 
 static int ref_node_sync(int mask) { 
-    pthread_mutex_lock(&hal_mutex);
     (void)mask; 
-    pthread_mutex_unlock(&hal_mutex);
     return 0; 
 }
 
 static int ref_get_dmem_status(uint64_t dmem_base_addr) { 
-    pthread_mutex_lock(&hal_mutex);
-    
     // Validate it's a DMEM address
     if (get_address_region(dmem_base_addr) != ADDR_DMEM_512) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     
     // HAL calls DMEM driver for status
     int dmem_id = get_dmem_id_from_address(dmem_base_addr);
     if (dmem_id < 0) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     
     int result = dmem_get_status(dmem_id);
-    pthread_mutex_unlock(&hal_mutex);
     return result;
 }
 
 static int ref_mesh_route_optimal(uint64_t src_addr, uint64_t dst_addr) { 
-    pthread_mutex_lock(&hal_mutex);
-    
-    // Calculate mesh coordinates from addresses
-    int src_tile = get_tile_id_from_address(src_addr);
-    int dst_tile = get_tile_id_from_address(dst_addr);
-    
-    if (src_tile < 0 || dst_tile < 0) {
-        pthread_mutex_unlock(&hal_mutex);
+    // Calculate mesh coordinates from addresses (tiles and DMEMs)
+    uint8_t src_x, src_y, dst_x, dst_y;
+    if (noc_addr_to_coords(src_addr, &src_x, &src_y) != 0 ||
+        noc_addr_to_coords(dst_addr, &dst_x, &dst_y) != 0) {
         return -1;
     }
     
-    // Simple Manhattan distance calculation
-    int src_x = src_tile % 4, src_y = src_tile / 4;
-    int dst_x = dst_tile % 4, dst_y = dst_tile / 4;
-    
-    int result = abs(dst_x - src_x) + abs(dst_y - src_y);
-    pthread_mutex_unlock(&hal_mutex);
+    // XY routing hop count (Manhattan distance)
+    int result = 0;
+    calc_xy_route(src_x, src_y, dst_x, dst_y, &result);
     return result;
 }
 
 // Memory access functions for test setup/verification - use proper drivers
 static int ref_memory_read(uint64_t addr, uint8_t* buffer, size_t size) {
-    pthread_mutex_lock(&hal_mutex);
-    
     if (!buffer || size == 0) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     if (!validate_address(addr, size)) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     
     // Use address manager (base symbol layer)
     uint8_t* src_ptr = addr_to_ptr(addr);
     if (!src_ptr) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     
-    memcpy(buffer, src_ptr, size);
-    pthread_mutex_unlock(&hal_mutex);
+    hal_range_lock_t lock;
+    lock_range(&lock, addr, size, 0);
+    mem_ops_copy(buffer, src_ptr, size);
+    hal_range_lock_release(&lock);
     return (int)size;
 }
 
 static int ref_memory_write(uint64_t addr, const uint8_t* buffer, size_t size) {
-    pthread_mutex_lock(&hal_mutex);
-    
     if (!buffer || size == 0) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     if (!validate_address(addr, size)) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     
     // Use address manager (base symbol layer)
     uint8_t* dst_ptr = addr_to_ptr(addr);
     if (!dst_ptr) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     
-    memcpy(dst_ptr, buffer, size);
-    pthread_mutex_unlock(&hal_mutex);
+    hal_range_lock_t lock;
+    lock_range(&lock, addr, size, 1);
+    mem_ops_copy(dst_ptr, buffer, size);
+    hal_range_lock_release(&lock);
     return (int)size;
 }
 
 static int ref_memory_fill(uint64_t addr, uint8_t value, size_t size) {
-    pthread_mutex_lock(&hal_mutex);
-    
     if (size == 0) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     if (!validate_address(addr, size)) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     
     // Use address manager (base symbol layer)
     uint8_t* dst_ptr = addr_to_ptr(addr);
     if (!dst_ptr) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     
-    // Create pattern based on value
-    for (size_t i = 0; i < size; i++) {
-        dst_ptr[i] = (uint8_t)(value + i);
-    }
-    pthread_mutex_unlock(&hal_mutex);
+    // Create pattern based on value (dst[i] = value + i)
+    hal_range_lock_t lock;
+    lock_range(&lock, addr, size, 1);
+    mem_ops_fill_ramp(dst_ptr, value, size);
+    hal_range_lock_release(&lock);
     return (int)size;
 }
 
 static int ref_memory_set(uint64_t addr, uint8_t value, size_t size) {
-    pthread_mutex_lock(&hal_mutex);
-    
     if (size == 0) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     if (!validate_address(addr, size)) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     
     // Use address manager (base symbol layer)
     uint8_t* dst_ptr = addr_to_ptr(addr);
     if (!dst_ptr) {
-        pthread_mutex_unlock(&hal_mutex);
         return -1;
     }
     
-    memset(dst_ptr, value, size);
-    pthread_mutex_unlock(&hal_mutex);
+    hal_range_lock_t lock;
+    lock_range(&lock, addr, size, 1);
+    mem_ops_fill(dst_ptr, value, size);
+    hal_range_lock_release(&lock);
+    return (int)size;
+}
+
+static int ref_memory_checksum(uint64_t addr, size_t size, uint32_t* crc) {
+    if (!crc || size == 0) {
+        return -1;
+    }
+    if (!validate_address(addr, size)) {
+        return -1;
+    }
+    
+    uint8_t* src_ptr = addr_to_ptr(addr);
+    if (!src_ptr) {
+        return -1;
+    }
+    
+    hal_range_lock_t lock;
+    lock_range(&lock, addr, size, 0);
+    *crc = mem_ops_crc32c(0, src_ptr, size);
+    hal_range_lock_release(&lock);
     return (int)size;
 }
 
+static int ref_dma_local_transfer_crc(int tile_id, uint64_t src_addr, uint64_t dst_addr,
+                                      size_t size, uint32_t* crc)
+{
+    if (!crc) {
+        return -1;
+    }
+
+    hal_range_lock_t lock;
+    lock_copy(&lock, src_addr, dst_addr, size);
+    int result = dma_local_transfer_crc(tile_id, src_addr, dst_addr, size, crc);
+    hal_range_lock_release(&lock);
+    return result;
+}
+
+static int ref_dma_fill(uint64_t addr, DMAC512_OP_MODE_t mode, uint8_t value,
+                        const uint8_t* pattern, size_t size)
+{
+    int tile_id = dma_fill_owner_tile(addr);
+    if (tile_id < 0) {
+        return -1;
+    }
+
+    hal_range_lock_t lock;
+    lock_range(&lock, addr, size, 1);
+    int result = dma_fill(tile_id, addr, size, mode, value, pattern);
+    hal_range_lock_release(&lock);
+    return result;
+}
+
+static int ref_dma_memory_fill(uint64_t addr, uint8_t value, size_t size) {
+    return ref_dma_fill(addr, DMAC512_FILL_INCR_MODE, value, NULL, size);
+}
+
+static int ref_dma_memory_set(uint64_t addr, uint8_t value, size_t size) {
+    return ref_dma_fill(addr, DMAC512_FILL_CONST_MODE, value, NULL, size);
+}
+
+static int ref_dma_memory_fill_pattern(uint64_t addr, const uint8_t* pattern, size_t size) {
+    if (!pattern) {
+        return -1;
+    }
+    return ref_dma_fill(addr, DMAC512_FILL_PATTERN_MODE, 0, pattern, size);
+}
+
+// ---------------------------------------------------------------------------
+// Memory views
+// ---------------------------------------------------------------------------
+
+static int ref_memory_map(uint64_t addr, size_t size, hal_mem_view_t* view, int writable)
+{
+    if (!view || size == 0) {
+        return -1;
+    }
+    if (!validate_address(addr, size)) {
+        return -1;
+    }
+
+    uint8_t* ptr = addr_to_ptr(addr);
+    if (!ptr) {
+        return -1;
+    }
+
+    int pin = hal_range_pin(addr, size, writable);
+    if (pin < 0) {
+        LOG_WARN("[HAL] memory view 0x%lx+%zu: too many views mapped\n", (unsigned long)addr, size);
+        return -1;
+    }
+    *view = (hal_mem_view_t){
+        .data = ptr,
+        .wdata = writable ? ptr : NULL,
+        .addr = addr,
+        .size = size,
+        .pin = pin + 1,
+    };
+    return (int)size;
+}
+
+static int ref_memory_map_ro(uint64_t addr, size_t size, hal_mem_view_t* view) {
+    return ref_memory_map(addr, size, view, 0);
+}
+
+static int ref_memory_map_rw(uint64_t addr, size_t size, hal_mem_view_t* view) {
+    return ref_memory_map(addr, size, view, 1);
+}
+
+static int ref_memory_commit(hal_mem_view_t* view) {
+    if (!view || !view->pin || !view->wdata) {
+        return -1;
+    }
+
+    // The downgrade's release store publishes the writes to the next
+    // caller that checks this pin
+    hal_range_pin_downgrade(view->pin - 1);
+    view->wdata = NULL;
+    return (int)view->size;
+}
+
+static int ref_memory_unmap(hal_mem_view_t* view) {
+    if (!view || !view->pin) {
+        return -1;
+    }
+
+    int result = (int)view->size;
+    if (view->wdata) {
+        LOG_WARN("[HAL] memory view 0x%lx+%zu unmapped without commit\n",
+                 (unsigned long)view->addr, view->size);
+        result = -1;
+    }
+    hal_range_unpin(view->pin - 1);
+    *view = (hal_mem_view_t){0};
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Batched submission
+// ---------------------------------------------------------------------------
+
+#define BATCH_MAX_THREADS 16
+
+static hal_batch_stats_t g_batch_stats;
+
+typedef struct {
+    uint64_t lo, hi;        // [lo, hi), empty when lo == hi
+} span_t;
+
+// A coalesced run of ops[first..last] executed as one transfer
+typedef struct {
+    hal_op_t op;
+    size_t first, last;
+    int wave;
+    int status;
+} batch_item_t;
+
+static int op_reads_src(hal_op_type_t t) { return t != HAL_OP_WRITE && t != HAL_OP_FILL && t != HAL_OP_SET; }
+static int op_writes_dst(hal_op_type_t t) { return t != HAL_OP_READ; }
+static int op_is_copy(hal_op_type_t t)
+{
+    return t == HAL_OP_CPU_MOVE || t == HAL_OP_DMA_LOCAL || t == HAL_OP_DMA_REMOTE || t == HAL_OP_DMEM_COPY;
+}
+
+static int spans_overlap(span_t a, span_t b) { return a.lo < b.hi && b.lo < a.hi; }
+
+// Simulator ranges read/written and host buffer ranges read/written
+static void op_spans(const hal_op_t* op, span_t* src, span_t* dst, span_t* host_src, span_t* host_dst)
+{
+    *src = *dst = *host_src = *host_dst = (span_t){0, 0};
+    if (op_reads_src(op->type)) *src = (span_t){op->src_addr, op->src_addr + op->size};
+    if (op_writes_dst(op->type)) *dst = (span_t){op->dst_addr, op->dst_addr + op->size};
+    if (op->type == HAL_OP_READ) *host_dst = (span_t){(uintptr_t)op->buffer, (uintptr_t)op->buffer + op->size};
+    if (op->type == HAL_OP_WRITE) *host_src = (span_t){(uintptr_t)op->buffer, (uintptr_t)op->buffer + op->size};
+}
+
+static int op_conflicts(const hal_op_t* a, const hal_op_t* b)
+{
+    span_t as, ad, ahs, ahd, bs, bd, bhs, bhd;
+    op_spans(a, &as, &ad, &ahs, &ahd);
+    op_spans(b, &bs, &bd, &bhs, &bhd);
+    return spans_overlap(ad, bs) || spans_overlap(ad, bd) || spans_overlap(as, bd) ||
+           spans_overlap(ahd, bhs) || spans_overlap(ahd, bhd) || spans_overlap(ahs, bhd);
+}
+
+static int op_valid(const hal_op_t* op)
+{
+    if (op->size == 0) {
+        return 0;
+    }
+    if (op_reads_src(op->type) && op->type != HAL_OP_DMA_REMOTE &&
+        (!validate_address(op->src_addr, op->size) || !addr_to_ptr(op->src_addr))) {
+        return 0;
+    }
+    if (op_writes_dst(op->type) && op->type != HAL_OP_DMA_REMOTE &&
+        (!validate_address(op->dst_addr, op->size) || !addr_to_ptr(op->dst_addr))) {
+        return 0;
+    }
+
+    switch (op->type) {
+    case HAL_OP_CPU_MOVE:
+    case HAL_OP_FILL:
+    case HAL_OP_SET:
+        return 1;
+    case HAL_OP_DMA_LOCAL:
+        return get_tile_id_from_address(op->src_addr) == op->tile_id &&
+               get_tile_id_from_address(op->dst_addr) == op->tile_id;
+    case HAL_OP_DMA_REMOTE:
+        return op->size <= UINT32_MAX && remote_transfer_allowed(op->src_addr, op->dst_addr, op->size);
+    case HAL_OP_DMEM_COPY:
+        return get_address_region(op->src_addr) == ADDR_DMEM_512 &&
+               get_address_region(op->dst_addr) == ADDR_DMEM_512;
+    case HAL_OP_READ:
+    case HAL_OP_WRITE:
+        return op->buffer != NULL;
+    }
+    return 0;
+}
+
+// Extends *run by the next op when both sides continue contiguously
+static int op_try_merge(hal_op_t* run, const hal_op_t* next)
+{
+    if (run->type != next->type || (run->type == HAL_OP_DMA_LOCAL && run->tile_id != next->tile_id)) {
+        return 0;
+    }
+    if (op_reads_src(run->type) && run->src_addr + run->size != next->src_addr) return 0;
+    if (op_writes_dst(run->type) && run->dst_addr + run->size != next->dst_addr) return 0;
+    if ((run->type == HAL_OP_READ || run->type == HAL_OP_WRITE) && run->buffer + run->size != next->buffer) return 0;
+    if (run->type == HAL_OP_FILL && next->value != (uint8_t)(run->value + run->size)) return 0;
+    if (run->type == HAL_OP_SET && next->value != run->value) return 0;
+
+    hal_op_t merged = *run;
+    merged.size += next->size;
+    if (!op_valid(&merged)) {
+        return 0;
+    }
+    // Merging must not change what a copy reads
+    if (op_is_copy(merged.type) &&
+        spans_overlap((span_t){merged.src_addr, merged.src_addr + merged.size},
+                      (span_t){merged.dst_addr, merged.dst_addr + merged.size})) {
+        return 0;
+    }
+    *run = merged;
+    return 1;
+}
+
+static int batch_execute(const hal_op_t* op)
+{
+    switch (op->type) {
+    case HAL_OP_CPU_MOVE:
+        mem_ops_move(addr_to_ptr(op->dst_addr), addr_to_ptr(op->src_addr), op->size);
+        return 0;
+    case HAL_OP_DMA_LOCAL:
+        return dma_local_transfer(op->tile_id, op->src_addr, op->dst_addr, op->size);
+    case HAL_OP_DMA_REMOTE:
+        remote_transfer_send(op->src_addr, op->dst_addr, op->size);
+        return (int)op->size;
+    case HAL_OP_DMEM_COPY:
+        return dmem_copy(op->src_addr, op->dst_addr, op->size);
+    case HAL_OP_READ:
+        mem_ops_copy(op->buffer, addr_to_ptr(op->src_addr), op->size);
+        return (int)op->size;
+    case HAL_OP_WRITE:
+        mem_ops_copy(addr_to_ptr(op->dst_addr), op->buffer, op->size);
+        return (int)op->size;
+    case HAL_OP_FILL:
+        mem_ops_fill_ramp(addr_to_ptr(op->dst_addr), op->value, op->size);
+        return (int)op->size;
+    case HAL_OP_SET:
+        mem_ops_fill(addr_to_ptr(op->dst_addr), op->value, op->size);
+        return (int)op->size;
+    }
+    return -1;
+}
+
+static void* batch_remote_worker(void* arg)
+{
+    batch_item_t* item = (batch_item_t*)arg;
+    item->status = batch_execute(&item->op);
+    return NULL;
+}
+
+static int ref_submit_batch(const hal_op_t* ops, size_t n, hal_result_t* results)
+{
+    if (!ops || !results || n == 0) {
+        return -1;
+    }
+
+    batch_item_t* items = malloc(n * sizeof(*items));
+    if (!items) {
+        return -1;
+    }
+
+    // Validate once and coalesce runs of adjacent ops into single transfers
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        results[i].status = -1;
+        results[i].wave = -1;
+        if (!op_valid(&ops[i])) {
+            continue;
+        }
+        if (count > 0 && items[count - 1].last == i - 1 && op_try_merge(&items[count - 1].op, &ops[i])) {
+            items[count - 1].last = i;
+            continue;
+        }
+        items[count++] = (batch_item_t){ .op = ops[i], .first = i, .last = i, .wave = 0, .status = -1 };
+    }
+
+    // An item runs one wave after the latest earlier item it conflicts with
+    int waves = 0;
+    hal_range_lock_t lock;
+    hal_range_lock_init(&lock);
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < i; j++) {
+            if (items[j].wave >= items[i].wave && op_conflicts(&items[j].op, &items[i].op)) {
+                items[i].wave = items[j].wave + 1;
+            }
+        }
+        if (items[i].wave + 1 > waves) waves = items[i].wave + 1;
+
+        if (op_reads_src(items[i].op.type)) {
+            hal_range_lock_add(&lock, items[i].op.src_addr, items[i].op.size, 0);
+        }
+        if (op_writes_dst(items[i].op.type)) {
+            hal_range_lock_add(&lock, items[i].op.dst_addr, items[i].op.size, 1);
+        }
+    }
+
+    LOG_DEBUG("[DRIVER-CALL] Batch: %zu ops → %zu transfers in %d wave(s)\n", n, count, waves);
+
+    // One lock acquisition covers every range in the batch; NoC transfers in
+    // a wave run on their own threads since they are latency bound. Inside
+    // a tile program coroutine they run inline instead: their NoC waits
+    // then yield the worker and, on simulated time, stay on its clock
+    int spawn = !coro_active();
+    hal_range_lock_acquire(&lock);
+    for (int w = 0; w < waves; w++) {
+        pthread_t threads[BATCH_MAX_THREADS];
+        int nthreads = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (items[i].wave != w) {
+                continue;
+            }
+            if (spawn && items[i].op.type == HAL_OP_DMA_REMOTE && nthreads < BATCH_MAX_THREADS &&
+                pthread_create(&threads[nthreads], NULL, batch_remote_worker, &items[i]) == 0) {
+                nthreads++;
+                continue;
+            }
+            items[i].status = batch_execute(&items[i].op);
+        }
+        for (int t = 0; t < nthreads; t++) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+    hal_range_lock_release(&lock);
+
+    int succeeded = 0;
+    for (size_t i = 0; i < count; i++) {
+        for (size_t k = items[i].first; k <= items[i].last; k++) {
+            results[k].wave = items[i].wave;
+            if (items[i].status < 0) {
+                continue;
+            }
+            // Copies report 0 from the CPU/DMEM drivers, byte counts elsewhere
+            results[k].status = items[i].status == 0 ? 0 : (int)ops[k].size;
+            succeeded++;
+        }
+    }
+
+    __atomic_fetch_add(&g_batch_stats.batches, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&g_batch_stats.ops, n, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&g_batch_stats.transfers, count, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&g_batch_stats.waves, (uint64_t)waves, __ATOMIC_RELAXED);
+
+    free(items);
+    return succeeded;
+}
+
+void hal_batch_get_stats(hal_batch_stats_t* stats)
+{
+    stats->batches = __atomic_load_n(&g_batch_stats.batches, __ATOMIC_RELAXED);
+    stats->ops = __atomic_load_n(&g_batch_stats.ops, __ATOMIC_RELAXED);
+    stats->transfers = __atomic_load_n(&g_batch_stats.transfers, __ATOMIC_RELAXED);
+    stats->waves = __atomic_load_n(&g_batch_stats.waves, __ATOMIC_RELAXED);
+}
+
 hal_interface_t g_hal;
 
+static hal_interface_t g_reference;
+
+const hal_interface_t* hal_reference_table(void)
+{
+    return &g_reference;
+}
+
 void hal_use_reference_impl(void)
 {
     g_hal.cpu_local_move       = ref_cpu_local_move;
@@ -334,4 +690,15 @@ void hal_use_reference_impl(void)
     g_hal.memory_write         = ref_memory_write;
     g_hal.memory_fill          = ref_memory_fill;
     g_hal.memory_set           = ref_memory_set;
+    g_hal.dma_memory_fill      = ref_dma_memory_fill;
+    g_hal.dma_memory_set       = ref_dma_memory_set;
+    g_hal.dma_memory_fill_pattern = ref_dma_memory_fill_pattern;
+    g_hal.memory_checksum      = ref_memory_checksum;
+    g_hal.dma_local_transfer_crc = ref_dma_local_transfer_crc;
+    g_hal.submit_batch         = ref_submit_batch;
+    g_hal.memory_map_ro        = ref_memory_map_ro;
+    g_hal.memory_map_rw        = ref_memory_map_rw;
+    g_hal.memory_commit        = ref_memory_commit;
+    g_hal.memory_unmap         = ref_memory_unmap;
+    g_reference = g_hal;
 }
@@ -0,0 +1,340 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "hal_tests/hal_ring.h"
+#include "generated/mem_map.h"
+#include "tile/tile_coro.h"
+#include "log/log.h"
+
+#define RING_MAX_ENTRIES    4096
+#define BACKEND_BATCH       32      // SQEs per submit_batch call
+#define BACKEND_IDLE_SPINS  64      // empty passes before the backend parks
+#define HAL_RING_CORO_POLL_US 10    // CQ poll interval for a waiting coroutine
+
+// Indices are free-running; producer and consumer sides sit on their own
+// cache lines so the tile and the backend do not false-share
+struct hal_ring {
+    int tile_id;
+    unsigned sq_entries, cq_entries;
+
+    _Alignas(64) unsigned sq_tail;      // published by the tile
+    unsigned sq_local_tail;             // prepared, not yet published
+    _Alignas(64) unsigned sq_head;      // consumed by the backend
+    _Alignas(64) unsigned cq_tail;      // posted by the backend
+    _Alignas(64) unsigned cq_head;      // reaped by the tile
+
+    int cq_waiting;                     // tile sleeps in HAL_RING_WAIT_BLOCK
+    bool inline_backend;                // serviced by its owner, see hal_ring_setup
+    pthread_mutex_t cq_lock;
+    pthread_cond_t cq_posted;
+
+    hal_sqe_t* sqes;
+    hal_cqe_t* cqes;
+    hal_ring_stats_t stats;             // tile-owned counters
+    uint64_t backend_batches;           // backend-owned, read atomically
+};
+
+// Shared backend: services every registered ring. The lock guards only the
+// registry and parking; rings are drained outside it so a slow HAL op on one
+// tile does not stall the others or their submits
+static struct {
+    pthread_mutex_t lock;               // registry + parking
+    pthread_cond_t wake;
+    pthread_cond_t released;            // busy ring handed back to the registry
+    hal_ring_t* rings[NUM_TILES];
+    hal_ring_t* busy;                   // ring being drained without the lock
+    int retiring;                       // teardowns waiting on busy
+    int active;
+    int need_wakeup;
+    bool running;
+    pthread_t thread;
+} g_backend = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+    .released = PTHREAD_COND_INITIALIZER,
+};
+
+static unsigned sq_pending(hal_ring_t* r)
+{
+    return __atomic_load_n(&r->sq_tail, __ATOMIC_ACQUIRE) - r->sq_head;
+}
+
+// Drains up to one batch from a ring; called by the backend thread with the
+// ring marked busy, or by the owner of an inline ring
+static unsigned backend_service(hal_ring_t* r)
+{
+    unsigned pending = sq_pending(r);
+    unsigned cq_room = r->cq_entries - (r->cq_tail - __atomic_load_n(&r->cq_head, __ATOMIC_ACQUIRE));
+    unsigned n = pending < cq_room ? pending : cq_room;
+    if (n > BACKEND_BATCH) n = BACKEND_BATCH;
+    if (n == 0) {
+        return 0;
+    }
+
+    hal_op_t ops[BACKEND_BATCH];
+    hal_result_t results[BACKEND_BATCH];
+    uint64_t tags[BACKEND_BATCH];
+    for (unsigned i = 0; i < n; i++) {
+        const hal_sqe_t* sqe = &r->sqes[(r->sq_head + i) & (r->sq_entries - 1)];
+        ops[i] = sqe->op;
+        tags[i] = sqe->user_data;
+    }
+    __atomic_store_n(&r->sq_head, r->sq_head + n, __ATOMIC_RELEASE);
+
+    g_hal.submit_batch(ops, n, results);
+
+    for (unsigned i = 0; i < n; i++) {
+        hal_cqe_t* cqe = &r->cqes[(r->cq_tail + i) & (r->cq_entries - 1)];
+        cqe->user_data = tags[i];
+        cqe->res = results[i].status;
+    }
+    __atomic_store_n(&r->cq_tail, r->cq_tail + n, __ATOMIC_SEQ_CST);
+    __atomic_fetch_add(&r->backend_batches, 1, __ATOMIC_RELAXED);
+
+    if (__atomic_load_n(&r->cq_waiting, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&r->cq_lock);
+        pthread_cond_broadcast(&r->cq_posted);
+        pthread_mutex_unlock(&r->cq_lock);
+    }
+    return n;
+}
+
+static void* backend_thread(void* arg)
+{
+    (void)arg;
+    int idle = 0;
+
+    pthread_mutex_lock(&g_backend.lock);
+    while (g_backend.running) {
+        unsigned work = 0;
+        for (int t = 0; t < NUM_TILES; t++) {
+            hal_ring_t* r = g_backend.rings[t];
+            if (!r) {
+                continue;
+            }
+            g_backend.busy = r;
+            pthread_mutex_unlock(&g_backend.lock);
+            work += backend_service(r);
+            pthread_mutex_lock(&g_backend.lock);
+            g_backend.busy = NULL;
+            if (g_backend.retiring) {
+                pthread_cond_broadcast(&g_backend.released);
+            }
+        }
+        if (work) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < BACKEND_IDLE_SPINS) {
+            pthread_mutex_unlock(&g_backend.lock);
+            sched_yield();
+            pthread_mutex_lock(&g_backend.lock);
+            continue;
+        }
+
+        // Park; submitters that see need_wakeup signal under the lock, so a
+        // submit between the recheck and the wait cannot be missed
+        __atomic_store_n(&g_backend.need_wakeup, 1, __ATOMIC_SEQ_CST);
+        bool pending = false;
+        for (int t = 0; t < NUM_TILES && !pending; t++) {
+            pending = g_backend.rings[t] && sq_pending(g_backend.rings[t]);
+        }
+        if (!pending && g_backend.running) {
+            pthread_cond_wait(&g_backend.wake, &g_backend.lock);
+        }
+        __atomic_store_n(&g_backend.need_wakeup, 0, __ATOMIC_SEQ_CST);
+        idle = 0;
+    }
+    pthread_mutex_unlock(&g_backend.lock);
+    return NULL;
+}
+
+int hal_ring_setup(int tile_id, unsigned entries, hal_ring_t** ring)
+{
+    if (!ring || tile_id < 0 || tile_id >= NUM_TILES || entries == 0 || entries > RING_MAX_ENTRIES) {
+        return -1;
+    }
+
+    unsigned sq_entries = 1;
+    while (sq_entries < entries) sq_entries <<= 1;
+
+    hal_ring_t* r = aligned_alloc(64, sizeof(*r));
+    if (!r) return -1;
+    *r = (hal_ring_t){ .tile_id = tile_id, .sq_entries = sq_entries, .cq_entries = sq_entries * 2 };
+    r->sqes = calloc(r->sq_entries, sizeof(hal_sqe_t));
+    r->cqes = calloc(r->cq_entries, sizeof(hal_cqe_t));
+    if (!r->sqes || !r->cqes) {
+        free(r->sqes);
+        free(r->cqes);
+        free(r);
+        return -1;
+    }
+    pthread_mutex_init(&r->cq_lock, NULL);
+    pthread_cond_init(&r->cq_posted, NULL);
+
+    // On simulated time a backend thread would complete ops on wall-clock
+    // time; the owning program runs them itself at submit, so each CQE is
+    // posted at the simulated time its op finished
+    if (coro_sim_active()) {
+        r->inline_backend = true;
+        *ring = r;
+        return 0;
+    }
+
+    pthread_mutex_lock(&g_backend.lock);
+    if (g_backend.rings[tile_id]) {
+        pthread_mutex_unlock(&g_backend.lock);
+        pthread_mutex_destroy(&r->cq_lock);
+        pthread_cond_destroy(&r->cq_posted);
+        free(r->sqes);
+        free(r->cqes);
+        free(r);
+        return -1;
+    }
+    g_backend.rings[tile_id] = r;
+    if (g_backend.active++ == 0) {
+        g_backend.running = true;
+        if (pthread_create(&g_backend.thread, NULL, backend_thread, NULL) != 0) {
+            g_backend.running = false;
+            g_backend.active = 0;
+            g_backend.rings[tile_id] = NULL;
+            pthread_mutex_unlock(&g_backend.lock);
+            hal_ring_teardown(r);
+            return -1;
+        }
+    }
+    pthread_mutex_unlock(&g_backend.lock);
+
+    LOG_INFO("[HAL-RING] Tile %d: SQ %u / CQ %u entries\n", tile_id, r->sq_entries, r->cq_entries);
+    *ring = r;
+    return 0;
+}
+
+int hal_ring_teardown(hal_ring_t* r)
+{
+    if (!r) return -1;
+
+    pthread_t join = 0;
+    bool stop = false;
+    pthread_mutex_lock(&g_backend.lock);
+    if (!r->inline_backend && g_backend.rings[r->tile_id] == r) {
+        g_backend.rings[r->tile_id] = NULL;
+        // The backend may still be draining this ring without the lock
+        g_backend.retiring++;
+        while (g_backend.busy == r) {
+            coro_cond_wait(&g_backend.released, &g_backend.lock);
+        }
+        g_backend.retiring--;
+        if (--g_backend.active == 0) {
+            g_backend.running = false;
+            pthread_cond_signal(&g_backend.wake);
+            join = g_backend.thread;
+            stop = true;
+        }
+    }
+    pthread_mutex_unlock(&g_backend.lock);
+    if (stop) {
+        coro_join(join, NULL);
+    }
+
+    pthread_mutex_destroy(&r->cq_lock);
+    pthread_cond_destroy(&r->cq_posted);
+    free(r->sqes);
+    free(r->cqes);
+    free(r);
+    return 0;
+}
+
+hal_sqe_t* hal_ring_get_sqe(hal_ring_t* r)
+{
+    unsigned head = __atomic_load_n(&r->sq_head, __ATOMIC_ACQUIRE);
+    if (r->sq_local_tail - head >= r->sq_entries) {
+        return NULL;
+    }
+    return &r->sqes[r->sq_local_tail++ & (r->sq_entries - 1)];
+}
+
+int hal_ring_submit(hal_ring_t* r)
+{
+    unsigned n = r->sq_local_tail - r->sq_tail;
+    if (n == 0) {
+        return 0;
+    }
+    __atomic_store_n(&r->sq_tail, r->sq_local_tail, __ATOMIC_SEQ_CST);
+    r->stats.submitted += n;
+    if (r->inline_backend) {
+        while (backend_service(r)) {
+        }
+        return (int)n;
+    }
+
+    if (__atomic_load_n(&g_backend.need_wakeup, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&g_backend.lock);
+        pthread_cond_signal(&g_backend.wake);
+        pthread_mutex_unlock(&g_backend.lock);
+        r->stats.backend_wakeups++;
+    }
+    return (int)n;
+}
+
+int hal_ring_peek_cqe(hal_ring_t* r, hal_cqe_t* cqe)
+{
+    unsigned tail = __atomic_load_n(&r->cq_tail, __ATOMIC_ACQUIRE);
+    if (tail == r->cq_head) {
+        return -1;
+    }
+    *cqe = r->cqes[r->cq_head & (r->cq_entries - 1)];
+    __atomic_store_n(&r->cq_head, r->cq_head + 1, __ATOMIC_RELEASE);
+    r->stats.completed++;
+    return 0;
+}
+
+int hal_ring_wait_cqe(hal_ring_t* r, hal_cqe_t* cqe, hal_ring_wait_t mode)
+{
+    if (hal_ring_peek_cqe(r, cqe) == 0) {
+        return 0;
+    }
+    // Nothing in flight means nothing will ever complete
+    if (r->stats.completed == r->stats.submitted) {
+        return -1;
+    }
+    // Only a full CQ leaves inline SQEs behind
+    if (r->inline_backend) {
+        backend_service(r);
+        return hal_ring_peek_cqe(r, cqe);
+    }
+
+    if (mode == HAL_RING_WAIT_POLL) {
+        while (hal_ring_peek_cqe(r, cqe) != 0) {
+            coro_yield();
+        }
+        return 0;
+    }
+    // A tile program coroutine must not sleep on the condvar: that would
+    // stall every other program on its worker
+    if (coro_active()) {
+        while (hal_ring_peek_cqe(r, cqe) != 0) {
+            coro_sleep_us(HAL_RING_CORO_POLL_US);
+        }
+        return 0;
+    }
+
+    pthread_mutex_lock(&r->cq_lock);
+    __atomic_store_n(&r->cq_waiting, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&r->cq_tail, __ATOMIC_SEQ_CST) == r->cq_head) {
+        pthread_cond_wait(&r->cq_posted, &r->cq_lock);
+    }
+    __atomic_store_n(&r->cq_waiting, 0, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&r->cq_lock);
+    return hal_ring_peek_cqe(r, cqe);
+}
+
+void hal_ring_get_stats(const hal_ring_t* r, hal_ring_stats_t* stats)
+{
+    *stats = r->stats;
+    stats->backend_batches = __atomic_load_n(&r->backend_batches, __ATOMIC_RELAXED);
+}
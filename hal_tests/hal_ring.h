@@ -0,0 +1,62 @@
+#ifndef HAL_RING_H
+#define HAL_RING_H
+#include <stddef.h>
+#include <stdint.h>
+#include "hal_tests/hal_interface.h"
+
+// io_uring-style submission/completion rings, one pair per tile.
+//
+// The tile is the only producer of its SQ and the only consumer of its CQ;
+// a shared backend thread is the other side of every ring. Posting and
+// reaping are plain loads/stores on the ring indices, no locks. The
+// backend drains SQEs through g_hal.submit_batch and posts one CQE per SQE
+// carrying the op result and the caller's user_data. When idle it parks
+// and sets a need-wakeup flag that hal_ring_submit checks, like SQPOLL.
+//
+//   hal_ring_setup(tile, 32, &ring);
+//   hal_sqe_t* sqe = hal_ring_get_sqe(ring);
+//   sqe->op = (hal_op_t){ ... }; sqe->user_data = tag;
+//   hal_ring_submit(ring);
+//   hal_ring_wait_cqe(ring, &cqe, HAL_RING_WAIT_BLOCK);
+
+typedef struct hal_ring hal_ring_t;
+
+typedef struct {
+    hal_op_t op;
+    uint64_t user_data;
+} hal_sqe_t;
+
+typedef struct {
+    uint64_t user_data;
+    int32_t  res;           // what the single-op HAL call would return
+} hal_cqe_t;
+
+typedef enum {
+    HAL_RING_WAIT_POLL,     // spin (yielding) until a CQE arrives
+    HAL_RING_WAIT_BLOCK     // sleep until the backend posts a CQE
+} hal_ring_wait_t;
+
+typedef struct {
+    uint64_t submitted;
+    uint64_t completed;
+    uint64_t backend_batches;
+    uint64_t backend_wakeups;   // submits that had to wake a parked backend
+} hal_ring_stats_t;
+
+// entries is rounded up to a power of two; the CQ has twice as many
+int hal_ring_setup(int tile_id, unsigned entries, hal_ring_t** ring);
+int hal_ring_teardown(hal_ring_t* ring);
+
+// Next free SQE, or NULL when the SQ is full. Filled SQEs become visible
+// to the backend only at hal_ring_submit.
+hal_sqe_t* hal_ring_get_sqe(hal_ring_t* ring);
+// Publishes prepared SQEs; returns how many
+int hal_ring_submit(hal_ring_t* ring);
+
+// Copies out and consumes one CQE; peek returns -1 when the CQ is empty
+int hal_ring_peek_cqe(hal_ring_t* ring, hal_cqe_t* cqe);
+int hal_ring_wait_cqe(hal_ring_t* ring, hal_cqe_t* cqe, hal_ring_wait_t mode);
+
+void hal_ring_get_stats(const hal_ring_t* ring, hal_ring_stats_t* stats);
+
+#endif
@@ -0,0 +1,301 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include "hal_tests/hal_stats.h"
+#include "hal_tests/hal_interface.h"
+#include "log/log.h"
+#include "log/log_hist.h"
+
+typedef struct thread_stats {
+    struct thread_stats* next;
+    uint64_t calls[HAL_SLOT_COUNT];
+    uint64_t bytes[HAL_SLOT_COUNT];
+    uint64_t total_ns[HAL_SLOT_COUNT];
+    uint64_t max_ns[HAL_SLOT_COUNT];
+    uint32_t hist[HAL_SLOT_COUNT][LOG_HIST_BUCKETS];
+} thread_stats_t;
+
+static const char* const slot_names[HAL_SLOT_COUNT] = {
+    "cpu_local_move", "dma_local_transfer", "dma_remote_transfer", "dmem_to_dmem_transfer",
+    "node_sync", "get_dmem_status", "mesh_route_optimal", "memory_read", "memory_write",
+    "memory_fill", "memory_set", "dma_memory_fill", "dma_memory_set", "dma_memory_fill_pattern",
+    "memory_checksum", "dma_local_transfer_crc", "submit_batch", "memory_map_ro", "memory_map_rw",
+    "memory_commit", "memory_unmap",
+};
+
+static hal_interface_t g_inner;     // the HAL being measured
+static int g_enabled;
+static int g_installed;
+
+// Threads register their counters once; they stay readable after exit
+static pthread_mutex_t g_registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static thread_stats_t* g_registry;
+static __thread thread_stats_t* t_stats;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Owner-only writes: a relaxed load/store pair avoids a locked RMW
+static inline void bump64(uint64_t* p, uint64_t v)
+{
+    __atomic_store_n(p, __atomic_load_n(p, __ATOMIC_RELAXED) + v, __ATOMIC_RELAXED);
+}
+
+static void record(hal_slot_id_t slot, uint64_t bytes, uint64_t ns)
+{
+    thread_stats_t* s = t_stats;
+    if (!s) {
+        s = calloc(1, sizeof(*s));
+        if (!s) return;
+        pthread_mutex_lock(&g_registry_lock);
+        s->next = g_registry;
+        g_registry = s;
+        pthread_mutex_unlock(&g_registry_lock);
+        t_stats = s;
+    }
+
+    bump64(&s->calls[slot], 1);
+    bump64(&s->bytes[slot], bytes);
+    bump64(&s->total_ns[slot], ns);
+    if (ns > __atomic_load_n(&s->max_ns[slot], __ATOMIC_RELAXED)) {
+        __atomic_store_n(&s->max_ns[slot], ns, __ATOMIC_RELAXED);
+    }
+    uint32_t* h = &s->hist[slot][log_hist_bucket(ns)];
+    __atomic_store_n(h, __atomic_load_n(h, __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED);
+}
+
+#define HAL_STATS_WRAP(slot, nbytes, call)                                      \
+    do {                                                                        \
+        if (__builtin_expect(!__atomic_load_n(&g_enabled, __ATOMIC_RELAXED), 1)) \
+            return g_inner.call;                                                \
+        uint64_t t0_ = now_ns();                                                \
+        int r_ = g_inner.call;                                                  \
+        record(slot, (nbytes), now_ns() - t0_);                                 \
+        return r_;                                                              \
+    } while (0)
+
+static int w_cpu_local_move(uint64_t src, uint64_t dst, size_t size)
+{ HAL_STATS_WRAP(HAL_SLOT_CPU_LOCAL_MOVE, size, cpu_local_move(src, dst, size)); }
+
+static int w_dma_local_transfer(int tile, uint64_t src, uint64_t dst, size_t size)
+{ HAL_STATS_WRAP(HAL_SLOT_DMA_LOCAL_TRANSFER, size, dma_local_transfer(tile, src, dst, size)); }
+
+static int w_dma_remote_transfer(uint64_t src, uint64_t dst, size_t size)
+{ HAL_STATS_WRAP(HAL_SLOT_DMA_REMOTE_TRANSFER, size, dma_remote_transfer(src, dst, size)); }
+
+static int w_dmem_to_dmem_transfer(uint64_t src, uint64_t dst, size_t size)
+{ HAL_STATS_WRAP(HAL_SLOT_DMEM_TO_DMEM_TRANSFER, size, dmem_to_dmem_transfer(src, dst, size)); }
+
+static int w_node_sync(int mask)
+{ HAL_STATS_WRAP(HAL_SLOT_NODE_SYNC, 0, node_sync(mask)); }
+
+static int w_get_dmem_status(uint64_t base)
+{ HAL_STATS_WRAP(HAL_SLOT_GET_DMEM_STATUS, 0, get_dmem_status(base)); }
+
+static int w_mesh_route_optimal(uint64_t src, uint64_t dst)
+{ HAL_STATS_WRAP(HAL_SLOT_MESH_ROUTE_OPTIMAL, 0, mesh_route_optimal(src, dst)); }
+
+static int w_memory_read(uint64_t addr, uint8_t* buffer, size_t size)
+{ HAL_STATS_WRAP(HAL_SLOT_MEMORY_READ, size, memory_read(addr, buffer, size)); }
+
+static int w_memory_write(uint64_t addr, const uint8_t* buffer, size_t size)
+{ HAL_STATS_WRAP(HAL_SLOT_MEMORY_WRITE, size, memory_write(addr, buffer, size)); }
+
+static int w_memory_fill(uint64_t addr, uint8_t value, size_t size)
+{ HAL_STATS_WRAP(HAL_SLOT_MEMORY_FILL, size, memory_fill(addr, value, size)); }
+
+static int w_memory_set(uint64_t addr, uint8_t value, size_t size)
+{ HAL_STATS_WRAP(HAL_SLOT_MEMORY_SET, size, memory_set(addr, value, size)); }
+
+static int w_dma_memory_fill(uint64_t addr, uint8_t value, size_t size)
+{ HAL_STATS_WRAP(HAL_SLOT_DMA_MEMORY_FILL, size, dma_memory_fill(addr, value, size)); }
+
+static int w_dma_memory_set(uint64_t addr, uint8_t value, size_t size)
+{ HAL_STATS_WRAP(HAL_SLOT_DMA_MEMORY_SET, size, dma_memory_set(addr, value, size)); }
+
+static int w_dma_memory_fill_pattern(uint64_t addr, const uint8_t* pattern, size_t size)
+{ HAL_STATS_WRAP(HAL_SLOT_DMA_MEMORY_FILL_PATTERN, size, dma_memory_fill_pattern(addr, pattern, size)); }
+
+static int w_memory_checksum(uint64_t addr, size_t size, uint32_t* crc)
+{ HAL_STATS_WRAP(HAL_SLOT_MEMORY_CHECKSUM, size, memory_checksum(addr, size, crc)); }
+
+static int w_dma_local_transfer_crc(int tile, uint64_t src, uint64_t dst, size_t size, uint32_t* crc)
+{ HAL_STATS_WRAP(HAL_SLOT_DMA_LOCAL_TRANSFER_CRC, size, dma_local_transfer_crc(tile, src, dst, size, crc)); }
+
+static size_t batch_bytes(const hal_op_t* ops, size_t n)
+{
+    size_t total = 0;
+    for (size_t i = 0; ops && i < n; i++) total += ops[i].size;
+    return total;
+}
+
+static int w_submit_batch(const hal_op_t* ops, size_t n, hal_result_t* results)
+{ HAL_STATS_WRAP(HAL_SLOT_SUBMIT_BATCH, batch_bytes(ops, n), submit_batch(ops, n, results)); }
+
+static int w_memory_map_ro(uint64_t addr, size_t size, hal_mem_view_t* view)
+{ HAL_STATS_WRAP(HAL_SLOT_MEMORY_MAP_RO, size, memory_map_ro(addr, size, view)); }
+
+static int w_memory_map_rw(uint64_t addr, size_t size, hal_mem_view_t* view)
+{ HAL_STATS_WRAP(HAL_SLOT_MEMORY_MAP_RW, size, memory_map_rw(addr, size, view)); }
+
+static int w_memory_commit(hal_mem_view_t* view)
+{ HAL_STATS_WRAP(HAL_SLOT_MEMORY_COMMIT, 0, memory_commit(view)); }
+
+static int w_memory_unmap(hal_mem_view_t* view)
+{ HAL_STATS_WRAP(HAL_SLOT_MEMORY_UNMAP, 0, memory_unmap(view)); }
+
+// Points every wrapped g_hal slot at t; a slot is one pointer store, so
+// callers on other threads see either the old or the new function
+static void point_slots(const hal_interface_t* t)
+{
+#define POINT_SLOT(name) if (g_inner.name) __atomic_store_n(&g_hal.name, t->name, __ATOMIC_RELAXED)
+    POINT_SLOT(cpu_local_move);
+    POINT_SLOT(dma_local_transfer);
+    POINT_SLOT(dma_remote_transfer);
+    POINT_SLOT(dmem_to_dmem_transfer);
+    POINT_SLOT(node_sync);
+    POINT_SLOT(get_dmem_status);
+    POINT_SLOT(mesh_route_optimal);
+    POINT_SLOT(memory_read);
+    POINT_SLOT(memory_write);
+    POINT_SLOT(memory_fill);
+    POINT_SLOT(memory_set);
+    POINT_SLOT(dma_memory_fill);
+    POINT_SLOT(dma_memory_set);
+    POINT_SLOT(dma_memory_fill_pattern);
+    POINT_SLOT(memory_checksum);
+    POINT_SLOT(dma_local_transfer_crc);
+    POINT_SLOT(submit_batch);
+    POINT_SLOT(memory_map_ro);
+    POINT_SLOT(memory_map_rw);
+    POINT_SLOT(memory_commit);
+    POINT_SLOT(memory_unmap);
+#undef POINT_SLOT
+}
+
+static const hal_interface_t g_wrappers = {
+    .cpu_local_move = w_cpu_local_move,
+    .dma_local_transfer = w_dma_local_transfer,
+    .dma_remote_transfer = w_dma_remote_transfer,
+    .dmem_to_dmem_transfer = w_dmem_to_dmem_transfer,
+    .node_sync = w_node_sync,
+    .get_dmem_status = w_get_dmem_status,
+    .mesh_route_optimal = w_mesh_route_optimal,
+    .memory_read = w_memory_read,
+    .memory_write = w_memory_write,
+    .memory_fill = w_memory_fill,
+    .memory_set = w_memory_set,
+    .dma_memory_fill = w_dma_memory_fill,
+    .dma_memory_set = w_dma_memory_set,
+    .dma_memory_fill_pattern = w_dma_memory_fill_pattern,
+    .memory_checksum = w_memory_checksum,
+    .dma_local_transfer_crc = w_dma_local_transfer_crc,
+    .submit_batch = w_submit_batch,
+    .memory_map_ro = w_memory_map_ro,
+    .memory_map_rw = w_memory_map_rw,
+    .memory_commit = w_memory_commit,
+    .memory_unmap = w_memory_unmap,
+};
+
+void hal_stats_install(void)
+{
+    if (g_installed) {
+        return;
+    }
+    g_inner = g_hal;
+    g_installed = 1;
+    if (hal_stats_enabled()) {
+        point_slots(&g_wrappers);
+    }
+}
+
+// The wrappers are in g_hal only while enabled; a call that picked one up
+// just before disabling still sees the flag and forwards unrecorded
+void hal_stats_set_enabled(int enabled)
+{
+    __atomic_store_n(&g_enabled, enabled ? 1 : 0, __ATOMIC_RELAXED);
+    if (g_installed) {
+        point_slots(enabled ? &g_wrappers : &g_inner);
+    }
+}
+
+int hal_stats_enabled(void)
+{
+    return __atomic_load_n(&g_enabled, __ATOMIC_RELAXED);
+}
+
+const char* hal_stats_slot_name(hal_slot_id_t slot)
+{
+    return (slot >= 0 && slot < HAL_SLOT_COUNT) ? slot_names[slot] : "?";
+}
+
+int hal_stats_get(hal_slot_id_t slot, hal_slot_stats_t* out)
+{
+    if (slot < 0 || slot >= HAL_SLOT_COUNT || !out) {
+        return -1;
+    }
+
+    static uint64_t hist[LOG_HIST_BUCKETS];
+    static pthread_mutex_t merge_lock = PTHREAD_MUTEX_INITIALIZER;
+    pthread_mutex_lock(&merge_lock);
+    memset(hist, 0, sizeof(hist));
+    memset(out, 0, sizeof(*out));
+
+    pthread_mutex_lock(&g_registry_lock);
+    for (thread_stats_t* s = g_registry; s; s = s->next) {
+        out->calls += __atomic_load_n(&s->calls[slot], __ATOMIC_RELAXED);
+        out->bytes += __atomic_load_n(&s->bytes[slot], __ATOMIC_RELAXED);
+        out->total_ns += __atomic_load_n(&s->total_ns[slot], __ATOMIC_RELAXED);
+        uint64_t max = __atomic_load_n(&s->max_ns[slot], __ATOMIC_RELAXED);
+        if (max > out->max_ns) out->max_ns = max;
+        for (unsigned b = 0; b < LOG_HIST_BUCKETS; b++) {
+            hist[b] += __atomic_load_n(&s->hist[slot][b], __ATOMIC_RELAXED);
+        }
+    }
+    pthread_mutex_unlock(&g_registry_lock);
+
+    // Counts and buckets are read separately, so use the bucket total
+    uint64_t counted = 0;
+    for (unsigned b = 0; b < LOG_HIST_BUCKETS; b++) counted += hist[b];
+    if (counted) {
+        out->p50_ns = log_hist_percentile(hist, counted, 0.50);
+        out->p99_ns = log_hist_percentile(hist, counted, 0.99);
+        out->p999_ns = log_hist_percentile(hist, counted, 0.999);
+    }
+    pthread_mutex_unlock(&merge_lock);
+    return 0;
+}
+
+void hal_stats_reset(void)
+{
+    pthread_mutex_lock(&g_registry_lock);
+    for (thread_stats_t* s = g_registry; s; s = s->next) {
+        thread_stats_t* next = s->next;
+        memset(s, 0, sizeof(*s));
+        s->next = next;
+    }
+    pthread_mutex_unlock(&g_registry_lock);
+}
+
+void hal_stats_print(void)
+{
+    LOG_INFO("[HAL-STATS] %-24s %9s %11s %9s %9s %9s %9s %10s\n",
+           "function", "calls", "bytes", "mean_ns", "p50_ns", "p99_ns", "p999_ns", "max_ns");
+    for (int slot = 0; slot < HAL_SLOT_COUNT; slot++) {
+        hal_slot_stats_t st;
+        hal_stats_get((hal_slot_id_t)slot, &st);
+        if (!st.calls) {
+            continue;
+        }
+        LOG_INFO("[HAL-STATS] %-24s %9lu %11lu %9lu %9lu %9lu %9lu %10lu\n",
+               slot_names[slot], (unsigned long)st.calls, (unsigned long)st.bytes,
+               (unsigned long)(st.total_ns / st.calls), (unsigned long)st.p50_ns,
+               (unsigned long)st.p99_ns, (unsigned long)st.p999_ns, (unsigned long)st.max_ns);
+    }
+}
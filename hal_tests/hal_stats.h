@@ -0,0 +1,59 @@
+#ifndef HAL_STATS_H
+#define HAL_STATS_H
+#include <stddef.h>
+#include <stdint.h>
+
+// HAL call instrumentation.
+//
+// hal_stats_install() remembers the selected HAL. Enabling points every
+// g_hal slot at a wrapper and disabling points them back, so calls cost
+// nothing extra while disabled; while enabled a wrapper records the call
+// count, bytes moved and latency into per-thread log-linear histograms
+// (16 sub-buckets per power of two, so percentiles are within ~6%).
+// Enable with HAL_STATS=1 or at run time.
+
+typedef enum {
+    HAL_SLOT_CPU_LOCAL_MOVE,
+    HAL_SLOT_DMA_LOCAL_TRANSFER,
+    HAL_SLOT_DMA_REMOTE_TRANSFER,
+    HAL_SLOT_DMEM_TO_DMEM_TRANSFER,
+    HAL_SLOT_NODE_SYNC,
+    HAL_SLOT_GET_DMEM_STATUS,
+    HAL_SLOT_MESH_ROUTE_OPTIMAL,
+    HAL_SLOT_MEMORY_READ,
+    HAL_SLOT_MEMORY_WRITE,
+    HAL_SLOT_MEMORY_FILL,
+    HAL_SLOT_MEMORY_SET,
+    HAL_SLOT_DMA_MEMORY_FILL,
+    HAL_SLOT_DMA_MEMORY_SET,
+    HAL_SLOT_DMA_MEMORY_FILL_PATTERN,
+    HAL_SLOT_MEMORY_CHECKSUM,
+    HAL_SLOT_DMA_LOCAL_TRANSFER_CRC,
+    HAL_SLOT_SUBMIT_BATCH,
+    HAL_SLOT_MEMORY_MAP_RO,
+    HAL_SLOT_MEMORY_MAP_RW,
+    HAL_SLOT_MEMORY_COMMIT,
+    HAL_SLOT_MEMORY_UNMAP,
+    HAL_SLOT_COUNT
+} hal_slot_id_t;
+
+typedef struct {
+    uint64_t calls;
+    uint64_t bytes;
+    uint64_t total_ns;
+    uint64_t p50_ns, p99_ns, p999_ns, max_ns;
+} hal_slot_stats_t;
+
+// Takes the current g_hal as the HAL to measure; call once after the HAL
+// has been selected
+void hal_stats_install(void);
+void hal_stats_set_enabled(int enabled);
+int hal_stats_enabled(void);
+
+// Merges every thread's counters; returns 0, or -1 for a bad slot
+int hal_stats_get(hal_slot_id_t slot, hal_slot_stats_t* out);
+const char* hal_stats_slot_name(hal_slot_id_t slot);
+void hal_stats_reset(void);
+void hal_stats_print(void);
+
+#endif
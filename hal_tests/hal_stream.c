@@ -0,0 +1,254 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+#include "hal_tests/hal_stream.h"
+#include "hal_tests/hal_interface.h"
+#include "generated/mem_map.h"
+#include "tile/tile_coro.h"
+#include "log/log.h"
+
+typedef enum {
+    BUF_EMPTY,      // free for the next prefetch
+    BUF_LOADING,    // worker is filling it from src
+    BUF_READY,      // loaded, waiting for acquire()
+    BUF_IN_USE,     // owned by the consumer
+    BUF_RELEASED,   // released, waiting for write-back
+    BUF_WRITING     // worker is writing it to dst
+} buf_state_t;
+
+struct hal_stream {
+    hal_stream_config_t cfg;
+    int nblocks;
+    uint64_t buf_base;
+
+    pthread_t worker;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;         // any buffer state change
+
+    buf_state_t state[HAL_STREAM_MAX_BUFFERS];
+    int block[HAL_STREAM_MAX_BUFFERS];
+    bool load_failed[HAL_STREAM_MAX_BUFFERS];
+    int next_load;
+    int next_acquire;
+    bool failed;                    // a block failed to load; the stream ends there
+    bool stop;
+
+    struct timespec opened;
+    hal_stream_stats_t stats;
+};
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static size_t block_len(const hal_stream_t* s, int blk)
+{
+    size_t offset = (size_t)blk * s->cfg.block_size;
+    size_t remaining = s->cfg.total_size - offset;
+    return remaining < s->cfg.block_size ? remaining : s->cfg.block_size;
+}
+
+static uint64_t buffer_addr(const hal_stream_t* s, int buf)
+{
+    return s->buf_base + (uint64_t)buf * s->cfg.block_size;
+}
+
+// Called without the stream lock, so acquire() and release() never queue
+// behind a DMA; *busy_us gets the time it took
+static int stream_transfer(uint64_t src, uint64_t dst, size_t len, uint64_t* busy_us)
+{
+    uint64_t t0 = now_us();
+    int result = g_hal.dma_remote_transfer(src, dst, len);
+    *busy_us = now_us() - t0;
+    return result == (int)len ? 0 : -1;
+}
+
+// Under the lock again: accounts one finished transfer
+static int stream_account(hal_stream_t* s, int result, uint64_t busy_us)
+{
+    s->stats.dma_busy_us += busy_us;
+    if (result != 0) {
+        s->stats.errors++;
+    }
+    return result;
+}
+
+static void* stream_worker(void* arg)
+{
+    hal_stream_t* s = (hal_stream_t*)arg;
+    int n = s->cfg.num_buffers;
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        // Write-backs first: they free buffers for the next prefetch
+        int wb = -1;
+        for (int b = 0; b < n; b++) {
+            if (s->state[b] == BUF_RELEASED) { wb = b; break; }
+        }
+        if (wb >= 0) {
+            int blk = s->block[wb];
+            uint64_t busy;
+            s->state[wb] = BUF_WRITING;
+            pthread_mutex_unlock(&s->lock);
+            int rc = stream_transfer(buffer_addr(s, wb), s->cfg.dst_addr + (uint64_t)blk * s->cfg.block_size,
+                                     block_len(s, blk), &busy);
+            pthread_mutex_lock(&s->lock);
+            stream_account(s, rc, busy);
+            s->state[wb] = BUF_EMPTY;
+            pthread_cond_broadcast(&s->changed);
+            continue;
+        }
+
+        // Prefetch the next block once its buffer has been recycled
+        int nb = s->next_load % n;
+        if (!s->stop && s->next_load < s->nblocks && s->state[nb] == BUF_EMPTY) {
+            int blk = s->next_load++;
+            uint64_t busy;
+            s->state[nb] = BUF_LOADING;
+            s->block[nb] = blk;
+            pthread_mutex_unlock(&s->lock);
+            int rc = stream_transfer(s->cfg.src_addr + (uint64_t)blk * s->cfg.block_size, buffer_addr(s, nb),
+                                     block_len(s, blk), &busy);
+            pthread_mutex_lock(&s->lock);
+            s->load_failed[nb] = stream_account(s, rc, busy) != 0;
+            if (s->load_failed[nb]) {
+                s->next_load = s->nblocks;      // nothing after it is delivered
+            }
+            s->state[nb] = BUF_READY;
+            pthread_cond_broadcast(&s->changed);
+            continue;
+        }
+
+        if (s->stop) {
+            break;
+        }
+        pthread_cond_wait(&s->changed, &s->lock);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return NULL;
+}
+
+int hal_stream_open(hal_stream_t** stream, const hal_stream_config_t* cfg)
+{
+    if (!stream || !cfg) return -1;
+    if (cfg->tile_id < 0 || cfg->tile_id >= NUM_TILES) return -1;
+    if (cfg->num_buffers < 2 || cfg->num_buffers > HAL_STREAM_MAX_BUFFERS) return -1;
+    if (cfg->block_size == 0 || cfg->total_size == 0) return -1;
+    if (cfg->buffer_offset + cfg->block_size * (size_t)cfg->num_buffers > DLM1_512_SIZE) return -1;
+
+    hal_stream_t* s = calloc(1, sizeof(*s));
+    if (!s) return -1;
+
+    s->cfg = *cfg;
+    s->nblocks = (int)((cfg->total_size + cfg->block_size - 1) / cfg->block_size);
+    s->buf_base = TILE0_DLM1_512_BASE + (uint64_t)cfg->tile_id * TILE_STRIDE + cfg->buffer_offset;
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->changed, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &s->opened);
+
+    if (pthread_create(&s->worker, NULL, stream_worker, s) != 0) {
+        pthread_mutex_destroy(&s->lock);
+        pthread_cond_destroy(&s->changed);
+        free(s);
+        return -1;
+    }
+
+    LOG_INFO("[HAL-STREAM] Tile %d: %d blocks of %zu bytes, %d buffers at 0x%lx\n",
+           cfg->tile_id, s->nblocks, cfg->block_size, cfg->num_buffers, (unsigned long)s->buf_base);
+    *stream = s;
+    return 0;
+}
+
+int hal_stream_acquire(hal_stream_t* s, uint64_t* buf_addr, size_t* len)
+{
+    if (!s || !buf_addr || !len) return -1;
+
+    pthread_mutex_lock(&s->lock);
+    if (s->failed || s->next_acquire >= s->nblocks) {
+        pthread_mutex_unlock(&s->lock);
+        return -1;
+    }
+
+    int blk = s->next_acquire;
+    int b = blk % s->cfg.num_buffers;
+    uint64_t t0 = now_us();
+    while (!(s->state[b] == BUF_READY && s->block[b] == blk)) {
+        coro_cond_wait(&s->changed, &s->lock);       // tile coroutines keep running
+    }
+    s->stats.stall_us += now_us() - t0;
+
+    if (s->load_failed[b]) {
+        // The stream ends at the failed block; close() reports the error
+        s->failed = true;
+        s->state[b] = BUF_EMPTY;
+        pthread_cond_broadcast(&s->changed);
+        pthread_mutex_unlock(&s->lock);
+        return -1;
+    }
+
+    s->state[b] = BUF_IN_USE;
+    s->next_acquire++;
+    *buf_addr = buffer_addr(s, b);
+    *len = block_len(s, blk);
+    pthread_mutex_unlock(&s->lock);
+    return blk;
+}
+
+int hal_stream_release(hal_stream_t* s, int blk)
+{
+    if (!s || blk < 0 || blk >= s->nblocks) return -1;
+
+    int b = blk % s->cfg.num_buffers;
+    pthread_mutex_lock(&s->lock);
+    if (s->state[b] != BUF_IN_USE || s->block[b] != blk) {
+        pthread_mutex_unlock(&s->lock);
+        return -1;
+    }
+
+    s->state[b] = s->cfg.dst_addr ? BUF_RELEASED : BUF_EMPTY;
+    s->stats.blocks++;
+    s->stats.bytes += block_len(s, blk);
+    pthread_cond_broadcast(&s->changed);
+    pthread_mutex_unlock(&s->lock);
+    return 0;
+}
+
+int hal_stream_close(hal_stream_t* s, hal_stream_stats_t* stats)
+{
+    if (!s) return -1;
+
+    // The worker drains pending write-backs before it exits
+    uint64_t t0 = now_us();
+    pthread_mutex_lock(&s->lock);
+    s->stop = true;
+    pthread_cond_broadcast(&s->changed);
+    pthread_mutex_unlock(&s->lock);
+    coro_join(s->worker, NULL);
+    s->stats.stall_us += now_us() - t0;
+
+    struct timespec closed;
+    clock_gettime(CLOCK_MONOTONIC, &closed);
+    s->stats.elapsed_us = (uint64_t)(closed.tv_sec - s->opened.tv_sec) * 1000000ULL +
+                          (uint64_t)((closed.tv_nsec - s->opened.tv_nsec) / 1000);
+
+    uint64_t hidden = s->stats.dma_busy_us > s->stats.stall_us ? s->stats.dma_busy_us - s->stats.stall_us : 0;
+    s->stats.overlap_pct = s->stats.dma_busy_us ? 100.0 * (double)hidden / (double)s->stats.dma_busy_us : 0.0;
+
+    LOG_INFO("[HAL-STREAM] Tile %d: %d blocks, %zu bytes, DMA %lu us, stall %lu us, overlap %.1f%%\n",
+           s->cfg.tile_id, s->stats.blocks, s->stats.bytes, (unsigned long)s->stats.dma_busy_us,
+           (unsigned long)s->stats.stall_us, s->stats.overlap_pct);
+
+    int result = s->stats.errors ? -1 : 0;
+    if (stats) *stats = s->stats;
+
+    pthread_mutex_destroy(&s->lock);
+    pthread_cond_destroy(&s->changed);
+    free(s);
+    return result;
+}
@@ -0,0 +1,52 @@
+#ifndef HAL_STREAM_H
+#define HAL_STREAM_H
+#include <stddef.h>
+#include <stdint.h>
+
+// Multi-buffered streaming DMA on top of the HAL.
+//
+// A stream owns N block buffers in one tile's DLM1_512. A DMA worker
+// prefetches block k+1.. from src while the tile works on block k, and
+// writes released blocks back to dst (if set) in the background.
+//
+//   hal_stream_open(&s, &cfg);
+//   while ((blk = hal_stream_acquire(s, &addr, &len)) >= 0) {
+//       ... work on [addr, addr + len) ...
+//       hal_stream_release(s, blk);
+//   }
+//   hal_stream_close(s, &stats);
+
+#define HAL_STREAM_MAX_BUFFERS 8
+
+typedef struct hal_stream hal_stream_t;
+
+typedef struct {
+    int      tile_id;       // tile whose DLM1_512 holds the buffers
+    uint64_t src_addr;      // input stream (DMEM or another tile's DLM)
+    uint64_t dst_addr;      // write-back destination, 0 for input-only streams
+    size_t   total_size;    // bytes to stream; last block may be short
+    size_t   block_size;
+    int      num_buffers;   // 2 = ping-pong, up to HAL_STREAM_MAX_BUFFERS
+    size_t   buffer_offset; // offset of the first buffer inside DLM1_512
+} hal_stream_config_t;
+
+typedef struct {
+    int      blocks;
+    size_t   bytes;
+    uint64_t dma_busy_us;   // time the worker spent in transfers
+    uint64_t stall_us;      // time the consumer waited in acquire()/close()
+    uint64_t elapsed_us;    // open() to close()
+    double   overlap_pct;   // share of DMA time hidden behind consumer work
+    int      errors;        // failed transfers
+} hal_stream_stats_t;
+
+int hal_stream_open(hal_stream_t** stream, const hal_stream_config_t* cfg);
+// Returns the block index and its DLM1_512 buffer, or -1 at end of stream;
+// a block that failed to load ends the stream there (close() returns -1)
+int hal_stream_acquire(hal_stream_t* stream, uint64_t* buf_addr, size_t* len);
+// Hands the block back; it is written to dst_addr + index * block_size if dst is set
+int hal_stream_release(hal_stream_t* stream, int block);
+// Waits for outstanding write-backs, stops the worker and frees the stream
+int hal_stream_close(hal_stream_t* stream, hal_stream_stats_t* stats);
+
+#endif
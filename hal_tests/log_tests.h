@@ -0,0 +1,7 @@
+#ifndef LOG_TESTS_H
+#define LOG_TESTS_H
+#include "c0_master/c0_controller.h"
+
+int test_async_logging(mesh_platform_t* p);
+
+#endif
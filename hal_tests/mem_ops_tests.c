@@ -0,0 +1,171 @@
+// mem_ops_tests.c – checks every copy/fill/compare kernel variant the host
+// supports against byte-wise reference results, including unaligned heads,
+// short tails and the non-temporal store path.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "mem_ops_tests.h"
+#include "mem_ops/mem_ops.h"
+#include "log/log.h"
+
+#define GUARD      64
+#define GUARD_BYTE 0xEE
+
+static int guards_intact(const uint8_t* buf, size_t offset, size_t size)
+{
+    for (size_t i = 0; i < GUARD + offset; i++) {
+        if (buf[i] != GUARD_BYTE) return 0;
+    }
+    for (size_t i = GUARD + offset + size; i < GUARD + offset + size + GUARD; i++) {
+        if (buf[i] != GUARD_BYTE) return 0;
+    }
+    return 1;
+}
+
+static int sign_of(int v) { return (v > 0) - (v < 0); }
+
+// Runs one size/alignment case against the currently selected variant
+static int check_case(uint8_t* src, uint8_t* dst, size_t offset, size_t size)
+{
+    const size_t span = offset + size + 2 * GUARD;
+    uint8_t* d = dst + GUARD + offset;
+    uint8_t* s = src + GUARD + 3;   // deliberately misaligned against dst
+
+    for (size_t i = 0; i < size; i++) s[i] = (uint8_t)(i * 7 + size);
+
+    // copy
+    memset(dst, GUARD_BYTE, span);
+    mem_ops_copy(d, s, size);
+    if (memcmp(d, s, size) != 0 || !guards_intact(dst, offset, size)) return 0;
+
+    // copy with CRC must match a separate checksum pass
+    memset(dst, GUARD_BYTE, span);
+    uint32_t crc = mem_ops_copy_crc32c(d, s, size, 0);
+    if (memcmp(d, s, size) != 0 || !guards_intact(dst, offset, size)) return 0;
+    if (crc != mem_ops_crc32c(0, s, size)) return 0;
+
+    // compare: equal, then a single differing byte in each direction
+    if (mem_ops_compare(d, s, size) != 0) return 0;
+    if (size > 0) {
+        size_t pos = (size * 5) / 7;
+        d[pos] = (uint8_t)(s[pos] + 1);
+        if (sign_of(mem_ops_compare(d, s, size)) != sign_of(memcmp(d, s, size))) return 0;
+        d[pos] = (uint8_t)(s[pos] - 1);
+        if (sign_of(mem_ops_compare(d, s, size)) != sign_of(memcmp(d, s, size))) return 0;
+    }
+
+    // constant fill
+    memset(dst, GUARD_BYTE, span);
+    mem_ops_fill(d, 0x3C, size);
+    for (size_t i = 0; i < size; i++) {
+        if (d[i] != 0x3C) return 0;
+    }
+    if (!guards_intact(dst, offset, size)) return 0;
+
+    // incrementing fill (memory_fill pattern)
+    memset(dst, GUARD_BYTE, span);
+    mem_ops_fill_ramp(d, (uint8_t)(0xF0 + offset), size);
+    for (size_t i = 0; i < size; i++) {
+        if (d[i] != (uint8_t)(0xF0 + offset + i)) return 0;
+    }
+    if (!guards_intact(dst, offset, size)) return 0;
+
+    // 64-byte repeating pattern (DMAC512 pattern fill mode)
+    uint8_t pattern[MEM_OPS_PATTERN_SIZE];
+    for (size_t i = 0; i < MEM_OPS_PATTERN_SIZE; i++) pattern[i] = (uint8_t)(i * 13 + size);
+    memset(dst, GUARD_BYTE, span);
+    mem_ops_fill_pattern(d, pattern, size);
+    for (size_t i = 0; i < size; i++) {
+        if (d[i] != pattern[i % MEM_OPS_PATTERN_SIZE]) return 0;
+    }
+    if (!guards_intact(dst, offset, size)) return 0;
+
+    // overlapping move in both directions
+    if (size > 8) {
+        for (size_t i = 0; i < size; i++) d[i] = (uint8_t)i;
+        mem_ops_move(d + 3, d, size - 3);
+        for (size_t i = 0; i < size - 3; i++) {
+            if (d[i + 3] != (uint8_t)i) return 0;
+        }
+        for (size_t i = 0; i < size; i++) d[i] = (uint8_t)i;
+        mem_ops_move(d, d + 3, size - 3);
+        for (size_t i = 0; i < size - 3; i++) {
+            if (d[i] != (uint8_t)(i + 3)) return 0;
+        }
+    }
+    return 1;
+}
+
+int test_mem_ops_kernels(mesh_platform_t* p)
+{
+    (void)p;
+    log_banner("1;32", "mem_ops kernel variants");
+
+    const size_t sizes[] = { 0, 1, 15, 16, 17, 63, 64, 65, 255, 256, 257, 1000,
+                             4096 + 7, 65536 + 13, 262144 };
+    const size_t offsets[] = { 0, 1, 7, 33, 63 };
+    const size_t max_size = 262144;
+
+    uint8_t* src = (uint8_t*)malloc(max_size + 2 * GUARD + 64);
+    uint8_t* dst = (uint8_t*)malloc(max_size + 2 * GUARD + 64);
+    if (!src || !dst) {
+        free(src);
+        free(dst);
+        LOG_INFO("[Test] mem_ops kernels: FAIL (allocation)\n");
+        return 0;
+    }
+
+    // CRC32C check value for "123456789" (RFC 3720)
+    static const char crc_vector[] = "123456789";
+    const uint32_t crc_expected = 0xE3069283U;
+
+    mem_ops_variant_t original = mem_ops_get_variant();
+    size_t original_nt = mem_ops_nt_threshold();
+    int ok = 1;
+
+    for (int v = 0; v < MEM_OPS_VARIANT_COUNT; v++) {
+        if (!mem_ops_variant_supported((mem_ops_variant_t)v)) {
+            LOG_INFO("    %-7s: not supported on this host, skipped\n",
+                     mem_ops_variant_name((mem_ops_variant_t)v));
+            continue;
+        }
+        mem_ops_select_variant((mem_ops_variant_t)v);
+
+        int variant_ok = 1;
+        if (mem_ops_crc32c(0, crc_vector, 9) != crc_expected ||
+            mem_ops_crc32c(mem_ops_crc32c(0, crc_vector, 4), crc_vector + 4, 5) != crc_expected) {
+            LOG_INFO("    %-7s: crc32c check value mismatch\n",
+                     mem_ops_variant_name((mem_ops_variant_t)v));
+            variant_ok = 0;
+        }
+        // Second pass forces the streaming-store path for everything above 1 KiB
+        for (int pass = 0; pass < 2 && variant_ok; pass++) {
+            mem_ops_set_nt_threshold(pass == 0 ? original_nt : 1024);
+            for (size_t si = 0; si < sizeof(sizes) / sizeof(sizes[0]) && variant_ok; si++) {
+                for (size_t oi = 0; oi < sizeof(offsets) / sizeof(offsets[0]); oi++) {
+                    if (!check_case(src, dst, offsets[oi], sizes[si])) {
+                        LOG_INFO("    %-7s: mismatch at size %zu offset %zu (nt %s)\n",
+                                 mem_ops_variant_name((mem_ops_variant_t)v),
+                                 sizes[si], offsets[oi], pass ? "on" : "off");
+                        variant_ok = 0;
+                        break;
+                    }
+                }
+            }
+        }
+        LOG_INFO("    %-7s: %s\n", mem_ops_variant_name((mem_ops_variant_t)v),
+                 variant_ok ? "PASS" : "FAIL");
+        ok &= variant_ok;
+    }
+
+    mem_ops_set_nt_threshold(original_nt);
+    mem_ops_select_variant(original);
+    free(src);
+    free(dst);
+
+    LOG_INFO("[Test] mem_ops kernels: %s (active variant: %s)\n",
+             ok ? "PASS" : "FAIL", mem_ops_variant_name(original));
+    return ok;
+}
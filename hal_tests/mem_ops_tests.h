@@ -0,0 +1,7 @@
+#ifndef MEM_OPS_TESTS_H
+#define MEM_OPS_TESTS_H
+#include "c0_master/c0_controller.h"
+
+int test_mem_ops_kernels(mesh_platform_t* p);
+
+#endif
@@ -1,24 +1,17 @@
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <pthread.h>
-#include <stdarg.h>
 #include "performance_tests.h"
 #include "hal_tests/hal_interface.h"
-
-// Thread-safe printing for parallel test execution
-static pthread_mutex_t print_mutex = PTHREAD_MUTEX_INITIALIZER;
-
-static void thread_safe_printf(const char* format, ...)
-{
-    pthread_mutex_lock(&print_mutex);
-    va_list args;
-    va_start(args, format);
-    vprintf(format, args);
-    va_end(args);
-    fflush(stdout);
-    pthread_mutex_unlock(&print_mutex);
-}
+#include "hal_tests/hal_range_lock.h"
+#include "hal_tests/hal_loader.h"
+#include "hal_tests/hal_stats.h"
+#include "hal_tests/hal_compare.h"
+#include "tile/tile_coro.h"
+#include "log/log.h"
 
 int test_noc_bandwidth(mesh_platform_t* p)
 {
@@ -33,7 +26,7 @@ int test_noc_bandwidth(mesh_platform_t* p)
     clock_t t1 = clock();
     double secs = (double)(t1 - t0) / CLOCKS_PER_SEC;
     double bw = bytes / (1024.0*1024.0) / secs;
-    thread_safe_printf("[Perf] CPU local move bandwidth: %.2f MB/s\n", bw);
+    LOG_INFO("[Perf] CPU local move bandwidth: %.2f MB/s\n", bw);
     
     return 1; /* always pass */
 }
@@ -50,7 +43,295 @@ int test_noc_latency(mesh_platform_t* p)
     g_hal.dma_remote_transfer(src_addr, dst_addr, bytes);
     clock_t t1 = clock();
     double ns = (double)(t1 - t0) * 1e9 / CLOCKS_PER_SEC;
-    thread_safe_printf("[Perf] NoC latency (DMA remote): %.0f ns\n", ns);
-    thread_safe_printf("\n");
+    LOG_INFO("[Perf] NoC latency (DMA remote): %.0f ns\n", ns);
+    LOG_INFO("\n");
     return 1;
 }
+
+// HAL scaling: each worker streams its own tile's DLM1 to its paired DMEM,
+// so workers never touch the same range and should not serialise in the HAL
+#define SCALING_OPS      6
+#define SCALING_BYTES    64
+#define SCALING_DLM_OFF  0x6000      // clear of what the other HAL tests use meanwhile
+#define SCALING_DMEM_OFF 0x18000
+
+typedef struct {
+    int tile_id;
+    int ok;
+} scaling_worker_t;
+
+static int scaling_inflight;        // transfers inside the HAL right now
+static int scaling_peak;            // most seen at once in the current round
+
+static void scaling_enter(void)
+{
+    int now = __atomic_add_fetch(&scaling_inflight, 1, __ATOMIC_SEQ_CST);
+    int peak = __atomic_load_n(&scaling_peak, __ATOMIC_RELAXED);
+    while (now > peak &&
+           !__atomic_compare_exchange_n(&scaling_peak, &peak, now, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+static void* scaling_worker(void* arg)
+{
+    scaling_worker_t* w = (scaling_worker_t*)arg;
+    uint64_t src = TILE0_DLM1_512_BASE + (uint64_t)w->tile_id * TILE_STRIDE + SCALING_DLM_OFF;
+    static const uint64_t dmem_bases[] = {
+        DMEM0_512_BASE, DMEM1_512_BASE, DMEM2_512_BASE, DMEM3_512_BASE,
+        DMEM4_512_BASE, DMEM5_512_BASE, DMEM6_512_BASE, DMEM7_512_BASE
+    };
+    uint64_t dst = dmem_bases[w->tile_id] + SCALING_DMEM_OFF;
+
+    w->ok = 1;
+    for (int i = 0; i < SCALING_OPS; i++) {
+        uint32_t src_crc = 0, dst_crc = 1;
+        g_hal.memory_fill(src, (uint8_t)(w->tile_id * 16 + i), SCALING_BYTES);
+        scaling_enter();
+        int moved = g_hal.dma_remote_transfer(src, dst, SCALING_BYTES);
+        __atomic_sub_fetch(&scaling_inflight, 1, __ATOMIC_SEQ_CST);
+        if (moved != SCALING_BYTES ||
+            g_hal.memory_checksum(src, SCALING_BYTES, &src_crc) < 0 ||
+            g_hal.memory_checksum(dst, SCALING_BYTES, &dst_crc) < 0 ||
+            src_crc != dst_crc) {
+            w->ok = 0;
+        }
+    }
+    return NULL;
+}
+
+int test_hal_scaling(mesh_platform_t* p)
+{
+    (void)p;
+    const int counts[] = {1, 2, 4, 7};
+    double base_ops = 0.0, ops_at_4 = 0.0;
+    int peak_at_4 = 0;
+    int ok = 1;
+
+    hal_range_lock_stats_t before, after;
+    hal_range_lock_get_stats(&before);
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        int n = counts[c];
+        pthread_t threads[7];
+        scaling_worker_t workers[7];
+
+        __atomic_store_n(&scaling_peak, 0, __ATOMIC_SEQ_CST);
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int t = 0; t < n; t++) {
+            workers[t].tile_id = t + 1;
+            pthread_create(&threads[t], NULL, scaling_worker, &workers[t]);
+        }
+        for (int t = 0; t < n; t++) {
+            coro_join(threads[t], NULL);
+            ok &= workers[t].ok;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+
+        double secs = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+        double ops = (double)(n * SCALING_OPS) / secs;
+        if (n == 1) base_ops = ops;
+        int peak = __atomic_load_n(&scaling_peak, __ATOMIC_SEQ_CST);
+        if (n == 4) {
+            ops_at_4 = ops;
+            peak_at_4 = peak;
+        }
+        LOG_INFO("[Perf] HAL scaling: %d thread(s) %8.0f transfers/s (x%.2f), up to %d in flight\n",
+                 n, ops, base_ops > 0.0 ? ops / base_ops : 0.0, peak);
+    }
+
+    hal_range_lock_get_stats(&after);
+    LOG_INFO("[Perf] HAL range locks: %lu acquisitions, %lu contended\n",
+             (unsigned long)(after.acquisitions - before.acquisitions),
+             (unsigned long)(after.contended - before.contended));
+
+    // Disjoint transfers on different tiles must be able to overlap in the
+    // HAL. The speed-up depends on the host and what else runs meanwhile,
+    // so it is reported but does not decide the test
+    if (peak_at_4 < 2) {
+        ok = 0;
+    }
+    if (ops_at_4 < 2.0 * base_ops) {
+        LOG_INFO("[Perf] HAL scaling: 4 threads below x2.00 on this host\n");
+    }
+    LOG_INFO("[Test] HAL scaling: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("\n");
+    return ok;
+}
+
+// HAL dispatch: per-call cost of the reference HAL vs. a loaded library
+// ($HAL, or the example plugin built next to soc_top)
+#define DISPATCH_CALLS 20000
+#define DISPATCH_EXAMPLE "hal_plugins/hal_example.so"
+
+typedef enum { CALL_SYNC, CALL_READ, CALL_SET, CALL_CHECKSUM, CALL_KINDS } dispatch_call_t;
+
+static double dispatch_ns(const hal_interface_t* hal, dispatch_call_t kind, uint64_t addr)
+{
+    static const size_t sizes[CALL_KINDS] = {0, 64, 64, 4096};
+    uint8_t buf[64];
+    uint32_t crc;
+    int sink = 0;
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < DISPATCH_CALLS; i++) {
+        switch (kind) {
+        case CALL_SYNC:     sink += hal->node_sync(0); break;
+        case CALL_READ:     sink += hal->memory_read(addr, buf, sizes[kind]); break;
+        case CALL_SET:      sink += hal->memory_set(addr, (uint8_t)i, sizes[kind]); break;
+        case CALL_CHECKSUM: sink += hal->memory_checksum(addr, sizes[kind], &crc); break;
+        default: break;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (sink != DISPATCH_CALLS * (int)sizes[kind]) {
+        return -1.0;
+    }
+    return ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) / DISPATCH_CALLS;
+}
+
+int test_hal_dispatch(mesh_platform_t* p)
+{
+    static const char* names[CALL_KINDS] = {"node_sync", "memory_read 64B", "memory_set 64B", "checksum 4KiB"};
+    const uint64_t addr = TILE1_DLM1_512_BASE + 0x1C000;
+    const hal_interface_t* ref = hal_reference_table();
+    int ok = 1;
+
+    // Broken libraries must be refused, never half-installed
+    hal_interface_t candidate;
+    ok &= hal_load_library("hal_plugins/does_not_exist.so", p, &candidate, NULL) == -1;
+
+    const char* path = getenv("HAL");
+    if (!path || !*path) path = DISPATCH_EXAMPLE;
+    const char* name = NULL;
+    if (hal_load_library(path, p, &candidate, &name) != 0) {
+        LOG_INFO("[Perf] HAL dispatch: no loadable HAL at %s, skipped\n", path);
+        LOG_INFO("[Test] HAL dispatch: %s\n\n", ok ? "PASS" : "FAIL");
+        return ok;
+    }
+
+    // Both tables must agree on the data before their speed is compared
+    uint8_t pattern[64], back[64];
+    for (int i = 0; i < 64; i++) pattern[i] = (uint8_t)(i * 7);
+    uint32_t ref_crc = 0, cand_crc = 1;
+    ref->memory_write(addr, pattern, sizeof(pattern));
+    ok &= candidate.memory_read(addr, back, sizeof(back)) == (int)sizeof(back) &&
+          memcmp(back, pattern, sizeof(back)) == 0;
+    ref->memory_checksum(addr, 4096, &ref_crc);
+    candidate.memory_checksum(addr, 4096, &cand_crc);
+    ok &= ref_crc == cand_crc;
+
+    LOG_INFO("[Perf] HAL dispatch, %d calls each: reference vs '%s'\n", DISPATCH_CALLS, name);
+    for (int k = 0; k < CALL_KINDS; k++) {
+        double r = dispatch_ns(ref, (dispatch_call_t)k, addr);
+        double c = dispatch_ns(&candidate, (dispatch_call_t)k, addr);
+        ok &= r >= 0.0 && c >= 0.0;
+        LOG_INFO("    %-16s %8.1f ns  %8.1f ns  (x%.2f)\n", names[k], r, c, c > 0.0 ? r / c : 0.0);
+    }
+
+    LOG_INFO("[Test] HAL dispatch: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("\n");
+    return ok;
+}
+
+// HAL call stats: counts, bytes and percentiles of the instrumented g_hal,
+// plus the cost of the wrappers while instrumentation is off
+int test_hal_stats(mesh_platform_t* p)
+{
+    (void)p;
+    const uint64_t addr = TILE1_DLM1_512_BASE + 0x1D000;
+    const int calls = 1000;
+    uint8_t buf[64];
+    int ok = 1;
+
+    int was_enabled = hal_stats_enabled();
+    hal_stats_set_enabled(1);
+
+    hal_slot_stats_t before, after;
+    hal_stats_get(HAL_SLOT_MEMORY_READ, &before);
+    for (int i = 0; i < calls; i++) {
+        ok &= g_hal.memory_read(addr, buf, sizeof(buf)) == (int)sizeof(buf);
+    }
+    hal_stats_get(HAL_SLOT_MEMORY_READ, &after);
+
+    ok &= after.calls - before.calls >= (uint64_t)calls;
+    ok &= after.bytes - before.bytes >= (uint64_t)calls * sizeof(buf);
+    ok &= after.p50_ns > 0 && after.p50_ns <= after.p99_ns && after.p99_ns <= after.p999_ns;
+    // Bucket upper bounds may exceed the exact maximum by one sub-bucket
+    ok &= after.p999_ns <= after.max_ns + after.max_ns / 16 + 1;
+    LOG_INFO("[Perf] memory_read 64B: p50 %lu ns, p99 %lu ns, p999 %lu ns, max %lu ns\n",
+             (unsigned long)after.p50_ns, (unsigned long)after.p99_ns,
+             (unsigned long)after.p999_ns, (unsigned long)after.max_ns);
+    hal_stats_print();
+
+    // Disabled: g_hal calls the HAL directly again
+    hal_stats_set_enabled(0);
+    hal_stats_get(HAL_SLOT_NODE_SYNC, &before);
+    struct timespec t0, t1, t2;
+    int sink = 0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < DISPATCH_CALLS; i++) sink += g_hal.node_sync(0);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for (int i = 0; i < DISPATCH_CALLS; i++) sink += hal_reference_table()->node_sync(0);
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    hal_stats_get(HAL_SLOT_NODE_SYNC, &after);
+    ok &= sink == 0 && after.calls == before.calls;
+
+    double wrapped = ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) / DISPATCH_CALLS;
+    double direct = ((double)(t2.tv_sec - t1.tv_sec) * 1e9 + (double)(t2.tv_nsec - t1.tv_nsec)) / DISPATCH_CALLS;
+    LOG_INFO("[Perf] node_sync with stats off: %.1f ns wrapped, %.1f ns direct\n", wrapped, direct);
+
+    hal_stats_set_enabled(was_enabled);
+    LOG_INFO("[Test] HAL call stats: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("\n");
+    return ok;
+}
+
+// HAL compare: a candidate with a slowed read and a wrong set must be
+// flagged on exactly those rows; reference against itself must be clean
+static int slow_memory_read(uint64_t addr, uint8_t* buffer, size_t size)
+{
+    for (int i = 0; i < 3; i++) hal_reference_table()->memory_read(addr, buffer, size);
+    return hal_reference_table()->memory_read(addr, buffer, size);
+}
+
+static int wrong_memory_set(uint64_t addr, uint8_t value, size_t size)
+{
+    return hal_reference_table()->memory_set(addr, (uint8_t)(value + 1), size);
+}
+
+int test_hal_compare(mesh_platform_t* p)
+{
+    hal_cmp_opts_t opts = { .samples = 10, .test_samples = 0, .threshold_pct = 50.0 };
+    hal_cmp_row_t rows[32];
+    const hal_interface_t* ref = hal_reference_table();
+    int ok = 1;
+
+    int n = hal_compare_run(p, ref, ref, &opts, rows, 32);
+    ok &= n > 0;
+    for (int i = 0; i < n; i++) {
+        ok &= rows[i].verdict != HAL_CMP_REGRESSION && rows[i].verdict != HAL_CMP_MISMATCH;
+        ok &= rows[i].ci_lo_pct <= rows[i].delta_pct && rows[i].delta_pct <= rows[i].ci_hi_pct;
+    }
+
+    hal_interface_t cand = *ref;
+    cand.memory_read = slow_memory_read;
+    cand.memory_set = wrong_memory_set;
+    ok &= hal_compare_run(p, ref, &cand, &opts, rows, 32) == n;
+    for (int i = 0; i < n; i++) {
+        // Small reads are dominated by call overhead, so only check sizable ones
+        if (strcmp(rows[i].name, "memory_read") == 0 && rows[i].size >= 1024) {
+            ok &= rows[i].verdict == HAL_CMP_REGRESSION;
+        } else if (strcmp(rows[i].name, "memory_set") == 0) {
+            ok &= rows[i].verdict == HAL_CMP_MISMATCH;
+        } else if (strcmp(rows[i].name, "memory_read") != 0) {
+            ok &= rows[i].verdict != HAL_CMP_MISMATCH;
+        }
+    }
+    hal_compare_print("reference", "slow read + wrong set", &opts, rows, n);
+
+    LOG_INFO("[Test] HAL compare: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("\n");
+    return ok;
+}
@@ -4,5 +4,9 @@
 
 int test_noc_bandwidth(mesh_platform_t* p);
 int test_noc_latency(mesh_platform_t* p);
+int test_hal_scaling(mesh_platform_t* p);
+int test_hal_dispatch(mesh_platform_t* p);
+int test_hal_stats(mesh_platform_t* p);
+int test_hal_compare(mesh_platform_t* p);
 
 #endif
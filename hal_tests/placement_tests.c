@@ -0,0 +1,94 @@
+// placement_tests.c – host placement: simulated memory starts out
+// untouched, a pinned thread runs where it was pinned and can pull memory
+// onto its node without changing it, and with TILE_CPUS set every tile
+// thread sits on its configured CPU with its memory on that CPU's node.
+
+#define _GNU_SOURCE
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include "placement_tests.h"
+#include "platform_init/placement.h"
+#include "log/log.h"
+
+#define PLACE_BYTES (64 * 1024)
+
+typedef struct {
+    int cpu;
+    uint8_t* buf;
+    int ran_on, node, moved;
+} place_worker_t;
+
+static void* place_worker(void* arg)
+{
+    place_worker_t* w = arg;
+    w->ran_on = placement_pin_thread(w->cpu) == 0 ? sched_getcpu() : -1;
+    w->node = placement_current_node();
+    w->moved = placement_move(w->buf, PLACE_BYTES, w->node);
+    return NULL;
+}
+
+// First CPU this thread may run on
+static int first_allowed_cpu(void)
+{
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        return 0;
+    }
+    for (int c = 0; c < CPU_SETSIZE; c++) {
+        if (CPU_ISSET(c, &set)) return c;
+    }
+    return 0;
+}
+
+int test_tile_placement(mesh_platform_t* p)
+{
+    int ok = 1;
+
+    // 1. Fresh memory is zero, page aligned and not resident anywhere yet
+    uint8_t* buf = placement_alloc(PLACE_BYTES);
+    ok &= buf != NULL && ((uintptr_t)buf & 4095) == 0;
+    if (!buf) {
+        LOG_INFO("[Test] Tile placement: FAIL (alloc)\n");
+        return 0;
+    }
+    ok &= placement_page_node(buf) == -1;
+    for (size_t i = 0; i < PLACE_BYTES; i += 4096) {
+        ok &= buf[i] == 0;
+    }
+
+    // 2. A pinned thread pulls written memory onto its node, contents intact
+    for (size_t i = 0; i < PLACE_BYTES; i++) buf[i] = (uint8_t)(i * 31);
+    place_worker_t w = { .cpu = first_allowed_cpu(), .buf = buf };
+    pthread_t tid;
+    pthread_create(&tid, NULL, place_worker, &w);
+    pthread_join(tid, NULL);
+    ok &= w.ran_on == w.cpu && w.node >= 0;
+    int on_node = 0;
+    for (size_t i = 0; i < PLACE_BYTES; i += 4096) {
+        on_node += placement_page_node(buf + i) == w.node;
+    }
+    // Without mbind the pages stay where they were first written
+    ok &= w.moved != 0 || on_node == PLACE_BYTES / 4096;
+    for (size_t i = 0; i < PLACE_BYTES; i++) {
+        if (buf[i] != (uint8_t)(i * 31)) { ok = 0; break; }
+    }
+    LOG_INFO("[Place] pinned to CPU %d (node %d): %d/%d pages moved there%s\n",
+             w.cpu, w.node, on_node, PLACE_BYTES / 4096, w.moved ? " (mbind refused)" : "");
+
+    // 3. Configured tiles run on their CPU and own memory on its node
+    if (placement_enabled()) {
+        for (int t = 1; t < p->node_count; t++) {
+            int node = placement_tile_node(t);
+            ok &= placement_tile_cpu(t) >= 0 && node >= 0;
+            ok &= placement_page_node(p->nodes[t].dlm64_ptr) == node;
+            ok &= placement_node_of_addr(p->nodes[t].dlm1_512_base_addr) == node;
+        }
+        LOG_INFO("[Place] %d tile threads pinned, memory on their nodes: %s\n",
+                 p->node_count - 1, ok ? "yes" : "no");
+    }
+
+    LOG_INFO("[Test] Tile placement: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("\n");
+    return ok;
+}
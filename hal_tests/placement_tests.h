@@ -0,0 +1,7 @@
+#ifndef PLACEMENT_TESTS_H
+#define PLACEMENT_TESTS_H
+#include "c0_master/c0_controller.h"
+
+int test_tile_placement(mesh_platform_t* p);
+
+#endif
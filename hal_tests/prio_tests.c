@@ -0,0 +1,223 @@
+// prio_tests.c – priority classes on the tile processors: a burst of short
+// control tasks queued behind a backlog of long bulk tasks waits for the
+// whole backlog under plain FIFO, but as HIGH over LOW bulk only for the
+// bulk task each tile is already running. Response times are reported;
+// what is checked is the dispatch order on one tile while the others are
+// held busy (HIGH by deadline, then LOW in arrival order) and that
+// deadlines are accounted to their class whether they are missed or met.
+
+#define _GNU_SOURCE
+#include <string.h>
+#include <stdint.h>
+#include "prio_tests.h"
+#include "c0_master/task_prio.h"
+#include "tile/tile_coro.h"
+#include "log/log.h"
+
+#define PRIO_BULK           56
+#define PRIO_BULK_US        2000
+#define PRIO_CONTROL        14
+#define PRIO_CONTROL_US     50
+#define PRIO_DEADLINE_US    5000        // control deadline, from queueing
+#define PRIO_ACCOUNT        8
+#define PRIO_TIMEOUT_MS     5000
+#define PRIO_ORDER_BULK     6
+#define PRIO_ORDER_CONTROL  4
+#define PRIO_HOLD_POLL_US   100
+
+static task_t bulk[PRIO_BULK];
+static task_t control[PRIO_CONTROL];
+static task_t account[2 * PRIO_ACCOUNT];
+
+// Order check: every tile but the home one is held busy, so only the home
+// tile takes the queued tasks and runs them in the order it dequeues them
+typedef struct {
+    int order;
+} prio_job_t;
+
+static task_t hold[NUM_TILES];
+static task_t order_task[PRIO_ORDER_BULK + PRIO_ORDER_CONTROL];
+static prio_job_t order_job[PRIO_ORDER_BULK + PRIO_ORDER_CONTROL];
+static int g_held, g_gate_home, g_gate_rest, g_order;
+
+static int prio_sleep(void* arg)
+{
+    coro_sleep_us((unsigned)(uintptr_t)arg);
+    return 1;
+}
+
+static int prio_hold(void* arg)
+{
+    __atomic_fetch_add(&g_held, 1, __ATOMIC_SEQ_CST);
+    while (!__atomic_load_n((int*)arg, __ATOMIC_ACQUIRE)) {
+        coro_sleep_us(PRIO_HOLD_POLL_US);
+    }
+    return 1;
+}
+
+static int prio_ordered(void* arg)
+{
+    prio_job_t* job = arg;
+    job->order = __atomic_fetch_add(&g_order, 1, __ATOMIC_SEQ_CST);
+    coro_sleep_us(PRIO_CONTROL_US);
+    return 1;
+}
+
+static int prio_queue(mesh_platform_t* p, task_t* t, unsigned us, const char* name,
+                      task_prio_t prio, uint64_t deadline_us)
+{
+    c0_init_callback_task(p, t, prio_sleep, (void*)(uintptr_t)us, name);
+    task_prio_set(t, prio, deadline_us);
+    return queue_task_to_tile(p, t, 0);
+}
+
+static int prio_wait(task_t* tasks, int n)
+{
+    int ok = 1;
+    for (int i = 0; i < n; i++) {
+        ok &= c0_wait_for_task(&tasks[i], PRIO_TIMEOUT_MS) == 0 && tasks[i].result == 1;
+    }
+    return ok;
+}
+
+// Bulk LOW then control HIGH with deadlines closing in, all on the home
+// tile while it is held: it must run control earliest deadline first, then
+// bulk in arrival order
+static int prio_check_order(mesh_platform_t* p)
+{
+    const int home = 1, n = PRIO_ORDER_BULK + PRIO_ORDER_CONTROL;
+    int tiles = p->node_count - 1;
+    int ok = 1;
+    __atomic_store_n(&g_held, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&g_gate_home, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&g_gate_rest, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&g_order, 0, __ATOMIC_SEQ_CST);
+
+    for (int t = 1; t <= tiles; t++) {
+        c0_init_callback_task(p, &hold[t], prio_hold, t == home ? &g_gate_home : &g_gate_rest, "hold");
+        ok &= queue_task_to_tile(p, &hold[t], t) == 0;
+    }
+    for (int waited = 0; __atomic_load_n(&g_held, __ATOMIC_SEQ_CST) < tiles; waited++) {
+        if (waited * PRIO_HOLD_POLL_US >= PRIO_TIMEOUT_MS * 1000) {
+            ok = 0;
+            break;
+        }
+        coro_sleep_us(PRIO_HOLD_POLL_US);
+    }
+
+    for (int i = 0; i < n; i++) {
+        int is_bulk = i < PRIO_ORDER_BULK;
+        int k = i - PRIO_ORDER_BULK;
+        c0_init_callback_task(p, &order_task[i], prio_ordered, &order_job[i], is_bulk ? "bulk" : "control");
+        task_prio_set(&order_task[i], is_bulk ? TASK_PRIO_LOW : TASK_PRIO_HIGH,
+                      is_bulk ? 0 : (uint64_t)PRIO_DEADLINE_US * (PRIO_ORDER_CONTROL - k));
+        ok &= queue_task_to_tile(p, &order_task[i], home) == 0;
+    }
+    __atomic_store_n(&g_gate_home, 1, __ATOMIC_RELEASE);
+    ok &= prio_wait(order_task, n);
+    __atomic_store_n(&g_gate_rest, 1, __ATOMIC_RELEASE);
+    ok &= prio_wait(&hold[1], tiles);
+    if (!ok) {
+        return 0;
+    }
+
+    int in_order = 1;
+    for (int i = 0; i < n; i++) {
+        int k = i - PRIO_ORDER_BULK;
+        int want = i < PRIO_ORDER_BULK ? PRIO_ORDER_CONTROL + i : PRIO_ORDER_CONTROL - 1 - k;
+        in_order &= order_job[i].order == want && order_task[i].assigned_tile == home;
+    }
+    LOG_INFO("[Prio] %d LOW then %d HIGH queued on held tile %d: %s\n",
+             PRIO_ORDER_BULK, PRIO_ORDER_CONTROL, home,
+             in_order ? "HIGH ran first, by deadline, then LOW in order" : "out of order");
+    return in_order;
+}
+
+// Median control response time, read off the tasks themselves
+static uint64_t control_p50_ns(void)
+{
+    uint64_t ns[PRIO_CONTROL];
+    for (int i = 0; i < PRIO_CONTROL; i++) {
+        ns[i] = control[i].end_ns - control[i].ready_ns;
+        for (int j = i; j > 0 && ns[j - 1] > ns[j]; j--) {
+            uint64_t t = ns[j];
+            ns[j] = ns[j - 1];
+            ns[j - 1] = t;
+        }
+    }
+    return ns[PRIO_CONTROL / 2];
+}
+
+// Bulk backlog first, then the control burst
+static int prio_round(mesh_platform_t* p, int classed)
+{
+    int ok = 1;
+    for (int i = 0; i < PRIO_BULK; i++) {
+        ok &= prio_queue(p, &bulk[i], PRIO_BULK_US, "bulk",
+                         classed ? TASK_PRIO_LOW : TASK_PRIO_NORMAL, 0) == 0;
+    }
+    for (int i = 0; i < PRIO_CONTROL; i++) {
+        ok &= prio_queue(p, &control[i], PRIO_CONTROL_US, "control",
+                         classed ? TASK_PRIO_HIGH : TASK_PRIO_NORMAL, classed ? PRIO_DEADLINE_US : 0) == 0;
+    }
+    ok &= prio_wait(bulk, PRIO_BULK);
+    ok &= prio_wait(control, PRIO_CONTROL);
+    return ok;
+}
+
+int test_c0_task_priority(mesh_platform_t* p)
+{
+    int ok = 1;
+    task_prio_stats_t high, low, normal;
+    LOG_INFO("[Prio] %d bulk tasks of %d us, then %d control tasks of %d us\n",
+             PRIO_BULK, PRIO_BULK_US, PRIO_CONTROL, PRIO_CONTROL_US);
+
+    // 1. Everything NORMAL: control waits in line behind the backlog
+    task_prio_reset_stats();
+    ok &= prio_round(p, 0);
+    uint64_t fifo_p50 = control_p50_ns();
+    task_prio_get_stats(TASK_PRIO_NORMAL, &normal);
+    ok &= normal.completed == PRIO_BULK + PRIO_CONTROL && normal.deadlines == 0;
+
+    // 2. Control HIGH with a deadline, bulk LOW: each tile takes control
+    //    work, its own or a busy neighbour's, as soon as its bulk task ends
+    task_prio_reset_stats();
+    ok &= prio_round(p, 1);
+    uint64_t classed_p50 = control_p50_ns();
+    task_prio_get_stats(TASK_PRIO_HIGH, &high);
+    task_prio_get_stats(TASK_PRIO_LOW, &low);
+    ok &= high.completed == PRIO_CONTROL && high.deadlines == PRIO_CONTROL;
+    ok &= low.completed == PRIO_BULK && low.deadlines == 0;
+    task_prio_print();
+
+    // 3. Dispatch order, independent of timing
+    task_prio_reset_stats();
+    ok &= prio_check_order(p);
+
+    // 4. Deadline accounting: already past is always missed, ten seconds
+    //    out always met
+    task_prio_reset_stats();
+    for (int i = 0; i < 2 * PRIO_ACCOUNT; i++) {
+        task_t* t = &account[i];
+        c0_init_callback_task(p, t, prio_sleep, NULL, i < PRIO_ACCOUNT ? "overdue" : "relaxed");
+        if (i < PRIO_ACCOUNT) {
+            t->deadline_ns = 1;
+        } else {
+            task_prio_set(t, TASK_PRIO_LOW, 10 * 1000000ULL);
+        }
+        ok &= queue_task_to_tile(p, t, 0) == 0;
+    }
+    ok &= prio_wait(account, 2 * PRIO_ACCOUNT);
+    task_prio_stats_t overdue, relaxed;
+    task_prio_get_stats(TASK_PRIO_NORMAL, &overdue);
+    task_prio_get_stats(TASK_PRIO_LOW, &relaxed);
+    ok &= overdue.deadlines == PRIO_ACCOUNT && overdue.missed == PRIO_ACCOUNT;
+    ok &= relaxed.deadlines == PRIO_ACCOUNT && relaxed.missed == 0;
+    task_prio_reset_stats();
+
+    LOG_INFO("[Perf] control response p50: %.2f ms FIFO, %.2f ms as HIGH (p99 %.2f ms, %lu/%lu deadlines missed)\n",
+             fifo_p50 / 1e6, classed_p50 / 1e6, high.p99_ns / 1e6,
+             (unsigned long)high.missed, (unsigned long)high.deadlines);
+    LOG_INFO("[Prio] C0 task priority: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
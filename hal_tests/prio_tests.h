@@ -0,0 +1,7 @@
+#ifndef PRIO_TESTS_H
+#define PRIO_TESTS_H
+#include "c0_master/c0_controller.h"
+
+int test_c0_task_priority(mesh_platform_t* p);
+
+#endif
@@ -3,42 +3,14 @@
 #include <stdio.h>
 #include <string.h>
 #include <pthread.h>
-#include <stdarg.h>
 #include "random_dma_tests.h"
 #include "hal_tests/hal_interface.h"
+#include "log/log.h"
 
 // Thread-safe printing for parallel test execution
-static pthread_mutex_t print_mutex = PTHREAD_MUTEX_INITIALIZER;
-
-static void thread_safe_banner(const char *msg)
-{
-    pthread_mutex_lock(&print_mutex);
-    
-    // Build entire banner in memory first
-    char complete_banner[1000];
-    int msg_len = strlen(msg);
-    int total_width = 82; // Inner width of the box
-    int padding = total_width - msg_len;
-    
-    snprintf(complete_banner, sizeof(complete_banner),
-        "\n"
-        "╔═══════════════════════════════════════════════════════════════════════════════════╗\n"
-        "║ \033[1;35m%s\033[0m%*s║\n"
-        "╚═══════════════════════════════════════════════════════════════════════════════════╝\n"
-        "\n",
-        msg, padding, "");
-    
-    // Single atomic write
-    fputs(complete_banner, stdout);
-    fflush(stdout);
-    
-    pthread_mutex_unlock(&print_mutex);
-}
 
 static void thread_safe_operation_banner(const char *msg)
 {
-    pthread_mutex_lock(&print_mutex);
-    
     // Build entire banner in memory first
     char complete_banner[1000];
     int msg_len = strlen(msg);
@@ -53,60 +25,39 @@ static void thread_safe_operation_banner(const char *msg)
         msg, padding, "");
     
     // Single atomic write
-    fputs(complete_banner, stdout);
-    fflush(stdout);
-    
-    pthread_mutex_unlock(&print_mutex);
+    LOG_INFO("%s", complete_banner);
 }
 
 static void thread_safe_dump32(const char *tag, const uint8_t *buf)
 {
-    pthread_mutex_lock(&print_mutex);
-    printf("%s 0x", tag);
-    for (int i = 0; i < 32; ++i) printf("%02X", buf[i]);
-    printf(" ...\n");
-    fflush(stdout);
-    pthread_mutex_unlock(&print_mutex);
-}
-
-static void thread_safe_printf(const char* format, ...)
-{
-    pthread_mutex_lock(&print_mutex);
-    va_list args;
-    va_start(args, format);
-    vprintf(format, args);
-    va_end(args);
-    fflush(stdout);
-    pthread_mutex_unlock(&print_mutex);
+    char hex[65];
+    for (int i = 0; i < 32; ++i) snprintf(hex + 2 * i, 3, "%02X", buf[i]);
+    LOG_INFO("%s 0x%s ...\n", tag, hex);
 }
 
 static void banner(const char *msg)
 {
-    printf("\n");
-    printf("╔═══════════════════════════════════════════════════════════════════════════════════╗\n");
-    printf("║ \033[1;35m%s\033[0m", msg);
+    LOG_INFO("\n");
+    LOG_INFO("╔═══════════════════════════════════════════════════════════════════════════════════╗\n");
     // Calculate padding to center the text
     int msg_len = strlen(msg);
     int total_width = 82; // Inner width of the box
     int padding = total_width - msg_len;
-    for (int i = 0; i < padding; i++) printf(" ");
-    printf("║\n");
-    printf("╚═══════════════════════════════════════════════════════════════════════════════════╝\n");
-    printf("\n");
+    LOG_INFO("║ \033[1;35m%s\033[0m%*s║\n", msg, padding, "");
+    LOG_INFO("╚═══════════════════════════════════════════════════════════════════════════════════╝\n");
+    LOG_INFO("\n");
 }
 
 static void operation_banner(const char *msg)
 {
-    printf("\n");
-    printf("┌─────────────────────────────────────────────────────────────────────────────────────┐\n");
-    printf("│ \033[1;33m%s\033[0m", msg);
+    LOG_INFO("\n");
+    LOG_INFO("┌─────────────────────────────────────────────────────────────────────────────────────┐\n");
     // Calculate padding 
     int msg_len = strlen(msg);
     int total_width = 84; // Inner width of the box
     int padding = total_width - msg_len;
-    for (int i = 0; i < padding; i++) printf(" ");
-    printf("│\n");
-    printf("└─────────────────────────────────────────────────────────────────────────────────────┘\n");
+    LOG_INFO("│ \033[1;33m%s\033[0m%*s│\n", msg, padding, "");
+    LOG_INFO("└─────────────────────────────────────────────────────────────────────────────────────┘\n");
 }
 
 static void fill(uint8_t *buf, size_t len, uint8_t seed)
@@ -120,7 +71,7 @@ int test_random_dma_remote(mesh_platform_t *p)
     const size_t BYTES = 256;
     int pass_cnt = 0;
 
-    thread_safe_banner("random_dma_remote");
+    log_banner("1;35", "random_dma_remote");
 	
 	
     struct {
@@ -173,10 +124,10 @@ int test_random_dma_remote(mesh_platform_t *p)
 
         int ok = (memcmp(src_ptr, dst_ptr, BYTES) == 0);
         pass_cnt += ok;
-        thread_safe_printf("HAL result: %d, Verify: %s\n\n", result, ok ? "PASS" : "FAIL");
+        LOG_INFO("HAL result: %d, Verify: %s\n\n", result, ok ? "PASS" : "FAIL");
     }
 
-    thread_safe_printf("\033[1m[RndDMA] Summary: %d/2 passed\033[0m\n", pass_cnt);
+    LOG_INFO("\033[1m[RndDMA] Summary: %d/2 passed\033[0m\n", pass_cnt);
     return pass_cnt == 2;
 }
 
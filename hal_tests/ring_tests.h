@@ -0,0 +1,7 @@
+#ifndef RING_TESTS_H
+#define RING_TESTS_H
+#include "c0_master/c0_controller.h"
+
+int test_hal_ring(mesh_platform_t* p);
+
+#endif
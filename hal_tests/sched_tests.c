@@ -0,0 +1,343 @@
+// sched_tests.c – work-stealing scheduler: every item runs exactly once
+// under heavy stealing, a backlog queued behind one long task on a single
+// worker is spread over the idle ones, and a parked worker starts a newly
+// submitted item within microseconds, and classed items come out by
+// class, then earliest deadline, then FIFO. The task queue and slab move
+// task pointers between threads without locks, each exactly once.
+
+#define _GNU_SOURCE
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include "sched_tests.h"
+#include "c0_master/task_sched.h"
+#include "c0_master/mpmc_queue.h"
+#include "c0_master/slab.h"
+#include "log/log.h"
+
+#define SCHED_WORKERS    4
+#define STRESS_ITEMS     20000
+#define SHORT_ITEMS      24
+#define SHORT_US         2000
+#define LONG_US          40000
+#define LATENCY_ITEMS    200
+#define QUEUE_ROUNDS     1000000
+#define QUEUE_THREADS    4           // producers, and as many consumers
+#define QUEUE_PER_THREAD 100000
+
+typedef struct {
+    int spin;               // busy iterations, keeps the owner busy so it gets robbed
+    int sleep_us;
+    int runs;
+    int worker;
+    uint64_t submit_ns, start_ns;
+} sched_item_t;
+
+typedef struct {
+    task_sched_t* s;
+    int id;
+    int* remaining;
+} sched_worker_arg_t;
+
+static uint64_t sched_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void* sched_worker(void* arg)
+{
+    sched_worker_arg_t* a = arg;
+    while (__atomic_load_n(a->remaining, __ATOMIC_ACQUIRE) > 0) {
+        uint64_t seen = task_sched_epoch(a->s);
+        sched_item_t* item = task_sched_next(a->s, a->id, NULL);
+        if (!item) {
+            task_sched_wait(a->s, seen);
+            continue;
+        }
+        task_sched_begin(a->s, a->id);
+        uint64_t t0 = sched_now_ns();
+        item->start_ns = t0;
+        __atomic_fetch_add(&item->runs, 1, __ATOMIC_RELAXED);
+        item->worker = a->id;
+        for (volatile int i = 0; i < item->spin; i++) {
+        }
+        if (item->sleep_us) {
+            usleep(item->sleep_us);
+        }
+        task_sched_end(a->s, a->id, sched_now_ns() - t0);
+        if (__atomic_sub_fetch(a->remaining, 1, __ATOMIC_ACQ_REL) == 0) {
+            task_sched_stop(a->s);      // release the parked workers
+        }
+    }
+    return NULL;
+}
+
+// Queues items (all on worker 0 while the others start idle) and runs
+// them to completion; returns the makespan
+static uint64_t run_sched(task_sched_t* s, sched_item_t* items, int n)
+{
+    int remaining = n;
+    pthread_t threads[SCHED_WORKERS];
+    sched_worker_arg_t args[SCHED_WORKERS];
+
+    task_sched_init(s, SCHED_WORKERS);
+    for (int i = 0; i < n; i++) {
+        task_sched_submit(s, 0, &items[i]);
+    }
+    uint64_t t0 = sched_now_ns();
+    for (int w = 0; w < SCHED_WORKERS; w++) {
+        args[w] = (sched_worker_arg_t){ .s = s, .id = w, .remaining = &remaining };
+        pthread_create(&threads[w], NULL, sched_worker, &args[w]);
+    }
+    for (int w = 0; w < SCHED_WORKERS; w++) {
+        pthread_join(threads[w], NULL);
+    }
+    return sched_now_ns() - t0;
+}
+
+int test_work_stealing(mesh_platform_t* p)
+{
+    (void)p;
+    int ok = 1;
+    static task_sched_t s;
+    static sched_item_t items[STRESS_ITEMS];
+    task_sched_stats_t st;
+
+    LOG_INFO("[Test] Work stealing\n");
+
+    // 1. Tiny items, all stolen from one owner: each runs exactly once.
+    //    The submissions outgrow the inbox, so refill it as it drains.
+    memset(items, 0, sizeof(items));
+    for (int i = 0; i < STRESS_ITEMS; i++) {
+        items[i].spin = 500;
+    }
+    items[0].sleep_us = 5000;       // the owner stalls on a full deque at first
+    int remaining = STRESS_ITEMS;
+    pthread_t threads[SCHED_WORKERS];
+    sched_worker_arg_t args[SCHED_WORKERS];
+    task_sched_init(&s, SCHED_WORKERS);
+    int queued = 0;
+    while (queued < TASK_SCHED_CAPACITY) {
+        task_sched_submit(&s, 0, &items[queued++]);
+    }
+    for (int w = 0; w < SCHED_WORKERS; w++) {
+        args[w] = (sched_worker_arg_t){ .s = &s, .id = w, .remaining = &remaining };
+        pthread_create(&threads[w], NULL, sched_worker, &args[w]);
+    }
+    for (int i = queued; i < STRESS_ITEMS; i++) {
+        while (task_sched_submit(&s, 0, &items[i]) != 0) {
+            sched_yield();
+        }
+    }
+    for (int w = 0; w < SCHED_WORKERS; w++) {
+        pthread_join(threads[w], NULL);
+    }
+    uint64_t stress_steals = 0;
+    for (int w = 0; w < SCHED_WORKERS; w++) {
+        task_sched_get_stats(&s, w, &st);
+        stress_steals += st.stolen;
+    }
+    for (int i = 0; i < STRESS_ITEMS; i++) {
+        ok &= items[i].runs == 1;
+    }
+    ok &= task_sched_pending(&s) == 0 && stress_steals > 0;
+    task_sched_destroy(&s);
+
+    // 2. One long task heads a backlog on worker 0: the idle workers
+    //    drain the backlog while it runs, so the makespan approaches the
+    //    long task instead of the sum
+    memset(items, 0, sizeof(items));
+    items[0].sleep_us = LONG_US;
+    for (int i = 1; i <= SHORT_ITEMS; i++) {
+        items[i].sleep_us = SHORT_US;
+    }
+    uint64_t makespan = run_sched(&s, items, SHORT_ITEMS + 1);
+    uint64_t work = 0, steals = 0;
+    for (int w = 0; w < SCHED_WORKERS; w++) {
+        task_sched_get_stats(&s, w, &st);
+        work += st.busy_ns;
+        steals += st.stolen;
+    }
+    for (int i = 0; i <= SHORT_ITEMS; i++) {
+        ok &= items[i].runs == 1;
+    }
+    double serial_ms = (LONG_US + SHORT_ITEMS * SHORT_US) / 1e3;
+    double bound_ms = LONG_US / 1e3;    // the long task alone
+    ok &= steals > 0 && items[0].worker == 0;
+    ok &= makespan / 1e6 < (bound_ms + serial_ms) / 2;
+    task_sched_destroy(&s);
+
+    // 3. Dispatch latency: submit to parked workers one item at a time
+    memset(items, 0, sizeof(items));
+    remaining = LATENCY_ITEMS;
+    task_sched_init(&s, SCHED_WORKERS);
+    for (int w = 0; w < SCHED_WORKERS; w++) {
+        args[w] = (sched_worker_arg_t){ .s = &s, .id = w, .remaining = &remaining };
+        pthread_create(&threads[w], NULL, sched_worker, &args[w]);
+    }
+    static uint64_t latency_ns[LATENCY_ITEMS];
+    for (int i = 0; i < LATENCY_ITEMS; i++) {
+        usleep(200);                    // let every worker park again
+        items[i].submit_ns = sched_now_ns();
+        task_sched_submit(&s, i % SCHED_WORKERS, &items[i]);
+        while (!__atomic_load_n(&items[i].runs, __ATOMIC_ACQUIRE)) {
+            sched_yield();
+        }
+    }
+    for (int w = 0; w < SCHED_WORKERS; w++) {
+        pthread_join(threads[w], NULL);
+    }
+    task_sched_destroy(&s);
+    for (int i = 0; i < LATENCY_ITEMS; i++) {
+        latency_ns[i] = items[i].start_ns - items[i].submit_ns;
+        for (int j = i; j > 0 && latency_ns[j - 1] > latency_ns[j]; j--) {
+            uint64_t t = latency_ns[j];
+            latency_ns[j] = latency_ns[j - 1];
+            latency_ns[j - 1] = t;
+        }
+    }
+    double p50_us = latency_ns[LATENCY_ITEMS / 2] / 1e3;
+    double p99_us = latency_ns[LATENCY_ITEMS * 99 / 100] / 1e3;
+    ok &= p50_us < 250.0;               // a 1 ms poll averages 500 us
+
+    // 4. Dispatch order on one worker, no threads: class 0 by deadline
+    //    (none last), then class 0 stolen from a busy worker, then the
+    //    default class with deadlines before its plain FIFO, then class 2
+    memset(items, 0, sizeof(items));
+    task_sched_init(&s, SCHED_WORKERS);
+    task_sched_submit_class(&s, 0, &items[8], 2, 0);
+    task_sched_submit_class(&s, 0, &items[6], TASK_SCHED_CLASS_DEFAULT, 0);
+    task_sched_submit_class(&s, 0, &items[5], TASK_SCHED_CLASS_DEFAULT, 300);
+    task_sched_submit_class(&s, 0, &items[7], TASK_SCHED_CLASS_DEFAULT, 0);
+    task_sched_submit_class(&s, 0, &items[4], TASK_SCHED_CLASS_DEFAULT, 100);
+    task_sched_submit_class(&s, 0, &items[1], 0, 200);
+    task_sched_submit_class(&s, 0, &items[2], 0, 0);
+    task_sched_submit_class(&s, 0, &items[0], 0, 100);
+    task_sched_submit_class(&s, 1, &items[3], 0, 50);
+    task_sched_begin(&s, 1);            // worker 1 is busy: its work is fair game
+    int in_order = 1, order_stolen = 0;
+    for (int i = 0; i < 9; i++) {
+        int was_stolen = 0;
+        in_order &= task_sched_next(&s, 0, &was_stolen) == &items[i];
+        order_stolen += was_stolen;
+    }
+    in_order &= task_sched_next(&s, 0, NULL) == NULL && order_stolen == 1;
+    ok &= in_order && task_sched_pending(&s) == 0;
+    task_sched_end(&s, 1, 0);
+    ok &= task_sched_submit_class(&s, 0, &items[0], TASK_SCHED_CLASSES, 0) == -1;
+    task_sched_destroy(&s);
+
+    LOG_INFO("[Perf] %d items over %d workers: %lu stolen\n",
+             STRESS_ITEMS, SCHED_WORKERS, (unsigned long)stress_steals);
+    LOG_INFO("[Perf] long-task backlog: makespan %.1f ms (serial %.1f ms, bound %.1f ms, work/workers %.1f ms), %lu steals\n",
+             makespan / 1e6, serial_ms, bound_ms, work / 1e6 / SCHED_WORKERS, (unsigned long)steals);
+    LOG_INFO("[Perf] dispatch to a parked worker: p50 %.1f us, p99 %.1f us\n", p50_us, p99_us);
+    LOG_INFO("[Perf] class/deadline dispatch order: %s\n", in_order ? "as expected" : "WRONG");
+    LOG_INFO("[Test] Work stealing: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("\n");
+    return ok;
+}
+
+typedef struct {
+    mesh_platform_t* p;
+    int id;
+    uint8_t* seen;
+    int* consumed;
+} queue_thread_arg_t;
+
+static void* queue_producer(void* arg)
+{
+    queue_thread_arg_t* a = arg;
+    for (int i = 0; i < QUEUE_PER_THREAD; i++) {
+        task_t* task;
+        while (!(task = c0_create_task(a->p, TASK_TYPE_CALLBACK, 0))) {
+            sched_yield();          // slab empty until the consumers free some
+        }
+        task->result = a->id * QUEUE_PER_THREAD + i;
+        while (task_queue_push(&a->p->task_queue, task) != 0) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void* queue_consumer(void* arg)
+{
+    queue_thread_arg_t* a = arg;
+    while (__atomic_load_n(a->consumed, __ATOMIC_RELAXED) < QUEUE_THREADS * QUEUE_PER_THREAD) {
+        task_t* task = task_queue_pop(&a->p->task_queue);
+        if (!task) {
+            sched_yield();
+            continue;
+        }
+        __atomic_fetch_add(&a->seen[task->result], 1, __ATOMIC_RELAXED);
+        c0_free_task(a->p, task);
+        __atomic_fetch_add(a->consumed, 1, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+int test_task_queue(mesh_platform_t* p)
+{
+    int ok = 1;
+    LOG_INFO("[Test] Lock-free task queue\n");
+
+    // 1. Bounded and FIFO: a full queue refuses, an empty one returns NULL
+    mpmc_queue_t q;
+    int slots[8];
+    ok &= mpmc_queue_init(&q, 8) == 0;
+    for (int i = 0; i < 8; i++) {
+        ok &= mpmc_queue_push(&q, &slots[i]) == 0;
+    }
+    ok &= mpmc_queue_push(&q, &slots[0]) == -1;
+    for (int i = 0; i < 8; i++) {
+        ok &= mpmc_queue_pop(&q) == &slots[i];
+    }
+    ok &= mpmc_queue_pop(&q) == NULL && mpmc_queue_size(&q) == 0;
+    mpmc_queue_destroy(&q);
+
+    // 2. Uncontended create -> queue -> dequeue -> free round trips
+    size_t in_use = slab_in_use(&p->task_slab);
+    uint64_t t0 = sched_now_ns();
+    for (int i = 0; i < QUEUE_ROUNDS; i++) {
+        task_t* task = c0_create_task(p, TASK_TYPE_CALLBACK, 0);
+        if (!task || task_queue_push(&p->task_queue, task) != 0 || task_queue_pop(&p->task_queue) != task) {
+            ok = 0;
+            break;
+        }
+        c0_free_task(p, task);
+    }
+    double single_mops = QUEUE_ROUNDS / ((sched_now_ns() - t0) / 1e3);
+    ok &= single_mops >= 1.0;
+
+    // 3. Producers and consumers hammer the same queue and slab: every
+    //    task arrives exactly once and every slab object comes back
+    static uint8_t seen[QUEUE_THREADS * QUEUE_PER_THREAD];
+    memset(seen, 0, sizeof(seen));
+    int consumed = 0;
+    pthread_t threads[2 * QUEUE_THREADS];
+    queue_thread_arg_t args[2 * QUEUE_THREADS];
+    t0 = sched_now_ns();
+    for (int i = 0; i < 2 * QUEUE_THREADS; i++) {
+        args[i] = (queue_thread_arg_t){ .p = p, .id = i % QUEUE_THREADS, .seen = seen, .consumed = &consumed };
+        pthread_create(&threads[i], NULL, i < QUEUE_THREADS ? queue_producer : queue_consumer, &args[i]);
+    }
+    for (int i = 0; i < 2 * QUEUE_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double mpmc_mops = QUEUE_THREADS * QUEUE_PER_THREAD / ((sched_now_ns() - t0) / 1e3);
+    for (int i = 0; i < QUEUE_THREADS * QUEUE_PER_THREAD; i++) {
+        ok &= seen[i] == 1;
+    }
+    ok &= task_queue_is_empty(&p->task_queue) && slab_in_use(&p->task_slab) == in_use;
+
+    LOG_INFO("[Perf] task create/queue/dequeue/free: %.1f M/s on one thread, %.1f M/s with %d producers + %d consumers\n",
+             single_mops, mpmc_mops, QUEUE_THREADS, QUEUE_THREADS);
+    LOG_INFO("[Test] Lock-free task queue: %s\n", ok ? "PASS" : "FAIL");
+    LOG_INFO("\n");
+    return ok;
+}
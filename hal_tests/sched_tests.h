@@ -0,0 +1,8 @@
+#ifndef SCHED_TESTS_H
+#define SCHED_TESTS_H
+#include "c0_master/c0_controller.h"
+
+int test_work_stealing(mesh_platform_t* p);
+int test_task_queue(mesh_platform_t* p);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef SIM_TESTS_H
+#define SIM_TESTS_H
+#include "c0_master/c0_controller.h"
+
+// Runs on the C0 main thread while the tiles are idle
+int test_c0_sim_determinism(mesh_platform_t* p);
+
+#endif
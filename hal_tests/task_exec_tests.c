@@ -0,0 +1,240 @@
+// task_exec_tests.c – copy, DMA, NoC and computation tasks move real data:
+// a batch of each runs on the tiles, every destination is checked against
+// its source, and the batch reports task-level throughput. A DMA task whose
+// ranges span two tiles and a kernel that fails are rejected as failed
+// tasks, and kernels over swapped ranges on two tiles never deadlock.
+
+#define _GNU_SOURCE
+#include <string.h>
+#include "task_exec_tests.h"
+#include "c0_master/task_exec.h"
+#include "hal_tests/hal_interface.h"
+#include "generated/mem_map.h"
+#include "mem_ops/mem_ops.h"
+#include "log/log.h"
+
+#define EXEC_PER_TILE   4
+#define EXEC_TILES      (NUM_TILES - 1)
+#define EXEC_TASKS      (EXEC_PER_TILE * EXEC_TILES)
+#define EXEC_BLOCK      4096
+#define EXEC_NOC_BLOCK  64          // one NoC packet; remote DMA is slow in the model
+#define EXEC_SRC_OFF    0x10000     // in tile DLM1
+#define EXEC_DST_OFF    0x14000     // in tile DLM1, EXEC_PER_TILE blocks after src
+#define EXEC_DMEM_OFF   0x3A000     // NoC sources, in DMEM n
+#define EXEC_TIMEOUT    5000
+#define EXEC_SWAP_ROUNDS 200
+
+typedef struct {
+    uint64_t src[EXEC_TASKS], dst[EXEC_TASKS];
+    size_t size;
+    task_kernel_fn kernel;
+    void* kernel_arg;
+} exec_batch_t;
+
+static const uint64_t exec_dmem[NUM_DMEMS] = {
+    DMEM0_512_BASE, DMEM1_512_BASE, DMEM2_512_BASE, DMEM3_512_BASE,
+    DMEM4_512_BASE, DMEM5_512_BASE, DMEM6_512_BASE, DMEM7_512_BASE
+};
+
+static uint64_t exec_dlm(int tile, uint64_t off, int k, size_t size)
+{
+    return TILE0_DLM1_512_BASE + (uint64_t)tile * TILE_STRIDE + off + (uint64_t)k * size;
+}
+
+static uint32_t exec_crc(uint64_t addr, size_t size)
+{
+    uint32_t crc = 0;
+    return g_hal.memory_checksum(addr, size, &crc) < 0 ? 0 : crc;
+}
+
+// Queues the batch, waits for it and checks every task moved size bytes
+static int exec_run(mesh_platform_t* p, task_type_t type, const exec_batch_t* b, uint64_t* elapsed_ns)
+{
+    static task_t* tasks[EXEC_TASKS];
+    uint64_t t0 = get_current_timestamp_ns();
+    int queued = 0;
+    for (int i = 0; i < EXEC_TASKS; i++) {
+        task_t* t = c0_create_task(p, type, 0);
+        if (!t) {
+            break;
+        }
+        t->params.memory_op.src_addr = b->src[i];
+        t->params.memory_op.dst_addr = b->dst[i];
+        t->params.memory_op.size = b->size;
+        t->params.memory_op.kernel = b->kernel;
+        t->params.memory_op.kernel_arg = b->kernel_arg;
+        if (queue_task_to_available_tile(p, t) != 0) {
+            c0_free_task(p, t);
+            break;
+        }
+        tasks[queued++] = t;
+    }
+
+    int ok = queued == EXEC_TASKS;
+    for (int i = 0; i < queued; i++) {
+        ok &= c0_wait_for_task(tasks[i], EXEC_TIMEOUT) == 0 && tasks[i]->result == (int)b->size;
+        c0_free_task(p, tasks[i]);
+    }
+    *elapsed_ns = get_current_timestamp_ns() - t0;
+    return ok;
+}
+
+// Fills every source with its own pattern and clears every destination
+static int exec_prepare(const exec_batch_t* b)
+{
+    int ok = 1;
+    for (int i = 0; i < EXEC_TASKS; i++) {
+        ok &= g_hal.memory_fill(b->src[i], (uint8_t)(0x11 * (i + 1)), b->size) >= 0;
+        ok &= g_hal.memory_set(b->dst[i], 0, b->size) >= 0;
+    }
+    return ok;
+}
+
+static int exec_check_copies(const exec_batch_t* b)
+{
+    int ok = 1;
+    for (int i = 0; i < EXEC_TASKS; i++) {
+        ok &= hal_memory_equal(b->src[i], b->dst[i], b->size) == 1;
+    }
+    return ok;
+}
+
+static void exec_report(const char* what, const exec_batch_t* b, uint64_t ns, int ok)
+{
+    double bytes = (double)EXEC_TASKS * (double)b->size;
+    LOG_INFO("[Exec] %-12s %2d x %4zu B  %7.2f ms  %8.1f MB/s  %s\n", what, EXEC_TASKS, b->size,
+             ns / 1e6, ns ? bytes * 1e3 / (double)ns : 0.0, ok ? "verified" : "MISMATCH");
+}
+
+static int exec_fail_kernel(const uint8_t* in, uint8_t* out, size_t size, void* arg)
+{
+    (void)in; (void)out; (void)size; (void)arg;
+    return -1;
+}
+
+// One task, run on whatever tile is free; returns its result
+static int exec_single(mesh_platform_t* p, task_t* t)
+{
+    if (queue_task_to_available_tile(p, t) != 0 || c0_wait_for_task(t, EXEC_TIMEOUT) != 0) {
+        return -2;
+    }
+    return t->result;
+}
+
+static int exec_check_rejects(mesh_platform_t* p)
+{
+    task_t t;
+    int ok = 1;
+
+    // The DMAC512 does not cross tiles
+    c0_init_memory_task(p, &t, TASK_TYPE_DMA_TRANSFER, exec_dlm(1, EXEC_SRC_OFF, 0, EXEC_BLOCK),
+                        exec_dlm(2, EXEC_DST_OFF, 0, EXEC_BLOCK), EXEC_BLOCK);
+    ok &= exec_single(p, &t) == -1;
+
+    // Nor does a NoC transfer go from DMEM to DMEM
+    c0_init_memory_task(p, &t, TASK_TYPE_NOC_TRANSFER, DMEM1_512_BASE + EXEC_DMEM_OFF,
+                        DMEM2_512_BASE + EXEC_DMEM_OFF, EXEC_NOC_BLOCK);
+    ok &= exec_single(p, &t) == -1;
+
+    // A failing kernel fails the task, and its output view is still released
+    c0_init_memory_task(p, &t, TASK_TYPE_COMPUTATION, exec_dlm(3, EXEC_SRC_OFF, 0, EXEC_BLOCK),
+                        exec_dlm(3, EXEC_DST_OFF, 0, EXEC_BLOCK), EXEC_BLOCK);
+    t.params.memory_op.kernel = exec_fail_kernel;
+    ok &= exec_single(p, &t) == -1;
+
+    // No kernel: the CRC32C of src
+    c0_init_memory_task(p, &t, TASK_TYPE_COMPUTATION, exec_dlm(3, EXEC_SRC_OFF, 1, EXEC_BLOCK), 0, EXEC_BLOCK);
+    ok &= exec_single(p, &t) == EXEC_BLOCK &&
+          t.params.memory_op.crc == exec_crc(exec_dlm(3, EXEC_SRC_OFF, 1, EXEC_BLOCK), EXEC_BLOCK);
+
+    LOG_INFO("[Exec] Cross-tile DMA, DMEM->DMEM NoC and a failing kernel rejected, "
+             "default kernel CRC matches: %s\n", ok ? "yes" : "no");
+    return ok;
+}
+
+// X -> Y on one tile while Y -> X runs on another: each maps one range
+// while the other is mapped, over and over
+static int exec_check_swapped(mesh_platform_t* p)
+{
+    uint64_t x = exec_dlm(4, EXEC_SRC_OFF, 0, EXEC_BLOCK), y = exec_dlm(5, EXEC_SRC_OFF, 0, EXEC_BLOCK);
+    uint8_t key = 0x3C;
+    task_t a, b;
+    int ok = 1, r;
+    for (r = 0; ok && r < EXEC_SWAP_ROUNDS; r++) {
+        c0_init_memory_task(p, &a, TASK_TYPE_COMPUTATION, x, y, EXEC_BLOCK);
+        c0_init_memory_task(p, &b, TASK_TYPE_COMPUTATION, y, x, EXEC_BLOCK);
+        a.params.memory_op.kernel = b.params.memory_op.kernel = task_kernel_xor;
+        a.params.memory_op.kernel_arg = b.params.memory_op.kernel_arg = &key;
+        if (queue_task_to_tile(p, &a, 1) != 0) {
+            ok = 0;
+            break;
+        }
+        ok &= queue_task_to_tile(p, &b, 2) == 0 && c0_wait_for_task(&b, EXEC_TIMEOUT) == 0 &&
+              b.result == EXEC_BLOCK;
+        ok &= c0_wait_for_task(&a, EXEC_TIMEOUT) == 0 && a.result == EXEC_BLOCK;
+    }
+    LOG_INFO("[Exec] %d rounds of kernels over swapped ranges on two tiles: %s\n",
+             r, ok ? "no deadlock" : "STUCK");
+    return ok;
+}
+
+int test_c0_task_exec(mesh_platform_t* p)
+{
+    static exec_batch_t b;
+    static uint8_t expect[EXEC_BLOCK];
+    uint64_t ns = 0;
+    int ok = 1, step;
+    LOG_INFO("[Exec] %d tasks per type over %d tiles\n", EXEC_TASKS, EXEC_TILES);
+
+    // CPU copies from each tile's DLM1 to its neighbour's
+    memset(&b, 0, sizeof(b));
+    b.size = EXEC_BLOCK;
+    for (int i = 0; i < EXEC_TASKS; i++) {
+        int tile = 1 + i % EXEC_TILES, k = i / EXEC_TILES;
+        b.src[i] = exec_dlm(tile, EXEC_SRC_OFF, k, EXEC_BLOCK);
+        b.dst[i] = exec_dlm(1 + tile % EXEC_TILES, EXEC_DST_OFF, k, EXEC_BLOCK);
+    }
+    step = exec_prepare(&b) && exec_run(p, TASK_TYPE_MEMORY_COPY, &b, &ns) && exec_check_copies(&b);
+    exec_report("memory copy", &b, ns, step);
+    ok &= step;
+
+    // DMAC512 copies inside each tile
+    for (int i = 0; i < EXEC_TASKS; i++) {
+        int tile = 1 + i % EXEC_TILES, k = i / EXEC_TILES;
+        b.dst[i] = exec_dlm(tile, EXEC_DST_OFF, k, EXEC_BLOCK);
+    }
+    step = exec_prepare(&b) && exec_run(p, TASK_TYPE_DMA_TRANSFER, &b, &ns) && exec_check_copies(&b);
+    exec_report("dma transfer", &b, ns, step);
+    ok &= step;
+
+    // XOR kernel, same ranges; checked against the kernel run here
+    uint8_t key = 0x5A;
+    b.kernel = task_kernel_xor;
+    b.kernel_arg = &key;
+    step = exec_prepare(&b) && exec_run(p, TASK_TYPE_COMPUTATION, &b, &ns);
+    for (int i = 0; step && i < EXEC_TASKS; i++) {
+        step &= g_hal.memory_read(b.src[i], expect, EXEC_BLOCK) >= 0;
+        task_kernel_xor(expect, expect, EXEC_BLOCK, &key);
+        step &= exec_crc(b.dst[i], EXEC_BLOCK) == mem_ops_crc32c(0, expect, EXEC_BLOCK);
+    }
+    exec_report("computation", &b, ns, step);
+    ok &= step;
+
+    // NoC packets from DMEM n to tile n
+    b.size = EXEC_NOC_BLOCK;
+    b.kernel = NULL;
+    b.kernel_arg = NULL;
+    for (int i = 0; i < EXEC_TASKS; i++) {
+        int tile = 1 + i % EXEC_TILES, k = i / EXEC_TILES;
+        b.src[i] = exec_dmem[tile] + EXEC_DMEM_OFF + (uint64_t)k * EXEC_NOC_BLOCK;
+        b.dst[i] = exec_dlm(tile, EXEC_DST_OFF, k, EXEC_NOC_BLOCK);
+    }
+    step = exec_prepare(&b) && exec_run(p, TASK_TYPE_NOC_TRANSFER, &b, &ns) && exec_check_copies(&b);
+    exec_report("noc transfer", &b, ns, step);
+    ok &= step;
+
+    ok &= exec_check_rejects(p);
+    ok &= exec_check_swapped(p);
+    LOG_INFO("[Exec] C0 task executors: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
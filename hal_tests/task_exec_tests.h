@@ -0,0 +1,8 @@
+#ifndef TASK_EXEC_TESTS_H
+#define TASK_EXEC_TESTS_H
+#include "c0_master/c0_controller.h"
+
+// Runs on the C0 main thread while the tiles are idle
+int test_c0_task_exec(mesh_platform_t* p);
+
+#endif
@@ -0,0 +1,158 @@
+// task_place_tests.c – task placement policies on one skewed workload:
+// most tasks move data between the DMEMs and tiles in the left half of the
+// mesh, the rest anywhere. Each task costs a fixed amount plus the NoC
+// time for the hop-bytes its data travels to the tile that runs it, so
+// makespan and hop-bytes show what each policy trades.
+
+#define _GNU_SOURCE
+#include <string.h>
+#include "task_place_tests.h"
+#include "c0_master/task_place.h"
+#include "generated/mem_map.h"
+#include "tile/tile_coro.h"
+#include "log/log.h"
+
+#define PLACE_TASKS         56
+#define PLACE_BYTES         4096
+#define PLACE_HOT_PCT       70
+#define PLACE_BASE_US       300
+#define PLACE_NS_PER_HOP_B  40          // modelled NoC cost per hop-byte
+#define PLACE_TIMEOUT_MS    5000
+
+typedef struct {
+    mesh_platform_t* p;
+    task_t* task;
+    int runs;
+    uint64_t hop_bytes;                 // for the tile that ran it
+} place_item_t;
+
+typedef struct {
+    uint64_t makespan_ns;
+    uint64_t hop_bytes;
+    int max_tasks;                      // on one tile
+    int ok;
+} place_result_t;
+
+static const uint64_t place_dmem[NUM_DMEMS] = {
+    DMEM0_512_BASE, DMEM1_512_BASE, DMEM2_512_BASE, DMEM3_512_BASE,
+    DMEM4_512_BASE, DMEM5_512_BASE, DMEM6_512_BASE, DMEM7_512_BASE
+};
+
+static int place_item_run(void* arg)
+{
+    place_item_t* item = arg;
+    item->hop_bytes = task_place_hop_bytes(item->p, item->task, item->task->assigned_tile, NULL);
+    uint64_t ns = (uint64_t)PLACE_BASE_US * 1000 + item->hop_bytes * PLACE_NS_PER_HOP_B;
+    coro_sleep_us((unsigned)(ns / 1000));
+    __atomic_fetch_add(&item->runs, 1, __ATOMIC_RELAXED);
+    return 1;
+}
+
+// Deterministic workload: same data footprints for every policy
+static void place_workload(uint64_t src[PLACE_TASKS], uint64_t dst[PLACE_TASKS])
+{
+    uint32_t seed = 0x9E3779B9u;
+    for (int i = 0; i < PLACE_TASKS; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int hot = (int)((seed >> 8) % 100) < PLACE_HOT_PCT;
+        seed = seed * 1664525u + 1013904223u;
+        int a = hot ? (int)((seed >> 8) % 2) : (int)((seed >> 8) % NUM_DMEMS);
+        seed = seed * 1664525u + 1013904223u;
+        int b = hot ? (int)((seed >> 8) % 2) : 1 + (int)((seed >> 8) % (NUM_TILES - 1));
+        if (hot) {
+            a += 1;                     // DMEM 1-2 and tiles 1-2
+            b += 1;
+        }
+        src[i] = place_dmem[a];
+        dst[i] = TILE0_DLM1_512_BASE + (uint64_t)b * TILE_STRIDE;
+    }
+}
+
+static place_result_t place_run(mesh_platform_t* p, task_place_policy_t policy)
+{
+    static place_item_t items[PLACE_TASKS];
+    uint64_t src[PLACE_TASKS], dst[PLACE_TASKS];
+    int per_tile[NUM_TILES] = {0};
+    place_result_t r = { .ok = 1 };
+
+    place_workload(src, dst);
+    task_place_set_policy(policy);
+    memset(items, 0, sizeof(items));
+
+    uint64_t t0 = get_current_timestamp_ns();
+    int queued = 0;
+    for (int i = 0; i < PLACE_TASKS; i++) {
+        task_t* t = c0_create_task(p, TASK_TYPE_CALLBACK, 0);
+        if (!t) {
+            break;
+        }
+        items[i].p = p;
+        items[i].task = t;
+        t->params.callback.func = place_item_run;
+        t->params.callback.arg = &items[i];
+        t->params.callback.name = "place";
+        t->data_src = src[i];
+        t->data_dst = dst[i];
+        t->data_bytes = PLACE_BYTES;
+        if (queue_task_to_available_tile(p, t) != 0) {
+            c0_free_task(p, t);
+            items[i].task = NULL;
+            break;
+        }
+        queued++;
+    }
+    r.ok &= queued == PLACE_TASKS;
+
+    uint64_t last_end = t0;
+    for (int i = 0; i < queued; i++) {
+        task_t* t = items[i].task;
+        r.ok &= c0_wait_for_task(t, PLACE_TIMEOUT_MS) == 0 && items[i].runs == 1;
+        if (t->end_ns > last_end) last_end = t->end_ns;
+        if (t->assigned_tile > 0 && t->assigned_tile < NUM_TILES) {
+            per_tile[t->assigned_tile]++;
+        }
+        r.hop_bytes += items[i].hop_bytes;
+        c0_free_task(p, t);
+    }
+    r.makespan_ns = last_end - t0;
+    for (int i = 1; i < NUM_TILES; i++) {
+        if (per_tile[i] > r.max_tasks) r.max_tasks = per_tile[i];
+    }
+    return r;
+}
+
+int test_c0_task_placement(mesh_platform_t* p)
+{
+    int ok = 1;
+    task_place_policy_t saved = task_place_get_policy();
+    LOG_INFO("[Place] %d tasks of %d bytes, %d%% with data in the left half of the mesh\n",
+             PLACE_TASKS, PLACE_BYTES, PLACE_HOT_PCT);
+
+    // Data on tile 5 alone costs nothing there and one hop each way next door
+    task_t probe;
+    memset(&probe, 0, sizeof(probe));
+    probe.type = TASK_TYPE_CALLBACK;
+    probe.data_src = probe.data_dst = TILE5_DLM1_512_BASE;
+    probe.data_bytes = 64;
+    uint64_t bytes = 0;
+    ok &= task_place_hop_bytes(p, &probe, 5, &bytes) == 0 && bytes == 64;
+    ok &= task_place_hop_bytes(p, &probe, 6, NULL) == 2 * 64;
+
+    place_result_t res[TASK_PLACE_POLICIES];
+    LOG_INFO("[Place] policy         makespan(ms)  hop-bytes  busiest tile\n");
+    for (int pol = 0; pol < TASK_PLACE_POLICIES; pol++) {
+        res[pol] = place_run(p, (task_place_policy_t)pol);
+        ok &= res[pol].ok;
+        LOG_INFO("[Place] %-13s  %12.1f  %9lu  %4d tasks\n", task_place_policy_name((task_place_policy_t)pol),
+                 res[pol].makespan_ns / 1e6, (unsigned long)res[pol].hop_bytes, res[pol].max_tasks);
+    }
+    task_place_set_policy(saved);
+
+    // Data-aware policies move less data than the data-blind ones
+    ok &= res[TASK_PLACE_LOCALITY].hop_bytes < res[TASK_PLACE_ROUND_ROBIN].hop_bytes;
+    ok &= res[TASK_PLACE_HYBRID].hop_bytes < res[TASK_PLACE_ROUND_ROBIN].hop_bytes;
+    ok &= res[TASK_PLACE_HYBRID].hop_bytes < res[TASK_PLACE_LEAST_LOADED].hop_bytes;
+
+    LOG_INFO("[Place] C0 task placement: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
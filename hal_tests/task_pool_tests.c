@@ -0,0 +1,116 @@
+// task_pool_tests.c – the task slab grows past its preallocation and reuses
+// what was freed instead of growing again, a tile gets back the task it
+// just freed, and tens of thousands of fine-grained tasks can be in flight
+// on the tiles at once.
+
+#define _GNU_SOURCE
+#include <string.h>
+#include <stdlib.h>
+#include "task_pool_tests.h"
+#include "c0_master/slab.h"
+#include "log/log.h"
+
+#define POOL_OBJS       50000
+#define POOL_OBJ_SIZE   200
+#define FLOOD_TASKS     20000
+
+static int pool_check_slab(void)
+{
+    static slab_t s;
+    static uint32_t* objs[POOL_OBJS];
+    int ok = slab_init(&s, POOL_OBJ_SIZE, 0) == 0;
+
+    // All live at once: distinct, line aligned, each keeps what it was given
+    for (int i = 0; ok && i < POOL_OBJS; i++) {
+        objs[i] = slab_alloc(&s);
+        ok &= objs[i] != NULL && ((uintptr_t)objs[i] & 63) == 0;
+        if (ok) {
+            memset(objs[i], 0, POOL_OBJ_SIZE);
+            objs[i][0] = (uint32_t)i;
+        }
+    }
+    for (int i = 0; ok && i < POOL_OBJS; i++) {
+        ok &= objs[i][0] == (uint32_t)i;
+    }
+    size_t grown = slab_capacity(&s);
+    ok &= grown >= POOL_OBJS && slab_in_use(&s) == POOL_OBJS;
+
+    // Freed objects are reused before the slab grows again
+    for (int i = 0; ok && i < POOL_OBJS; i++) {
+        slab_free(&s, objs[i]);
+    }
+    for (int i = 0; ok && i < POOL_OBJS; i++) {
+        ok &= (objs[i] = slab_alloc(&s)) != NULL;
+    }
+    ok &= slab_capacity(&s) == grown;
+    for (int i = 0; ok && i < POOL_OBJS; i++) {
+        slab_free(&s, objs[i]);
+    }
+    ok &= slab_in_use(&s) == 0;
+
+    // A tile's free list hands back its own most recent free
+    slab_bind_thread(5);
+    void* a = slab_alloc(&s);
+    slab_free(&s, a);
+    ok &= slab_alloc(&s) == a;
+    slab_free(&s, a);
+    slab_bind_thread(0);
+
+    LOG_INFO("[Pool] %d objects live in %zu slots (%zu chunks), reused without growing\n",
+             POOL_OBJS, grown, grown / SLAB_CHUNK_OBJS);
+    slab_destroy(&s);
+    return ok;
+}
+
+static int pool_flood_task(void* arg)
+{
+    __atomic_fetch_add((int*)arg, 1, __ATOMIC_RELAXED);
+    return 1;
+}
+
+static int pool_check_flood(mesh_platform_t* p)
+{
+    static task_t* tasks[FLOOD_TASKS];
+    static int runs[FLOOD_TASKS];
+    memset(runs, 0, sizeof(runs));
+    size_t in_use = slab_in_use(&p->task_slab);
+
+    uint64_t t0 = get_current_timestamp_ns();
+    int queued = 0;
+    for (int i = 0; i < FLOOD_TASKS; i++) {
+        tasks[i] = c0_create_task(p, TASK_TYPE_CALLBACK, 0);
+        if (!tasks[i]) {
+            break;
+        }
+        tasks[i]->params.callback.func = pool_flood_task;
+        tasks[i]->params.callback.arg = &runs[i];
+        tasks[i]->params.callback.name = "flood";
+        if (queue_task_to_available_tile(p, tasks[i]) != 0) {
+            c0_free_task(p, tasks[i]);
+            break;
+        }
+        queued++;
+    }
+    size_t peak = slab_in_use(&p->task_slab) - in_use;
+
+    int ok = queued == FLOOD_TASKS;
+    for (int i = 0; i < queued; i++) {
+        ok &= c0_wait_for_task(tasks[i], 5000) == 0 && runs[i] == 1;
+        c0_free_task(p, tasks[i]);
+    }
+    uint64_t elapsed = get_current_timestamp_ns() - t0;
+    ok &= slab_in_use(&p->task_slab) == in_use;
+
+    LOG_INFO("[Pool] %d/%d tasks queued (up to %zu in flight), each ran once: %s, %.0f k tasks/s end to end\n",
+             queued, FLOOD_TASKS, peak, ok ? "yes" : "no", queued / (elapsed / 1e6));
+    return ok;
+}
+
+int test_c0_task_pool(mesh_platform_t* p)
+{
+    LOG_INFO("[Pool] Growable task slab with per-tile free lists\n");
+    int ok = pool_check_slab();
+    ok &= pool_check_flood(p);
+    LOG_INFO("[Pool] C0 task pool: %s\n", ok ? "PASS" : "FAIL");
+    return ok;
+}
@@ -0,0 +1,8 @@
+#ifndef TASK_POOL_TESTS_H
+#define TASK_POOL_TESTS_H
+#include "c0_master/c0_controller.h"
+
+// Runs on the C0 main thread while the tiles are idle
+int test_c0_task_pool(mesh_platform_t* p);
+
+#endif
@@ -5,6 +5,7 @@
 #include "c0_tests.h"
 #include "stress_tests.h"
 #include "random_dma_tests.h"
+#include "log/log.h"
 
 void run_all_tests(mesh_platform_t* platform)
 {
@@ -17,5 +18,5 @@ void run_all_tests(mesh_platform_t* platform)
     total++; passed += test_noc_bandwidth(platform);
     total++; passed += test_noc_latency(platform);
     total++; passed += test_random_dma_remote(platform);
-printf("\n\033[1mSummary: %d/%d tests passed\033[0m\n", passed, total);
+LOG_INFO("\n\033[1mSummary: %d/%d tests passed\033[0m\n", passed, total);
 }
\ No newline at end of file
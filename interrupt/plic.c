@@ -5,6 +5,7 @@
  
 #include "plic.h"
 #include "platform_init/address_manager.h"
+#include "log/log.h"
  
 #define SIZE 0x800000
  
@@ -258,9 +259,9 @@ void plic_init_for_this_hart(uint32_t hartid)
     
     if (mapped_memory) {
         PLIC_INST[plic_idx] = (volatile PLIC_RegDef*)mapped_memory;
-        printf("[PLIC] Hart %d: Using PLIC_INST[%d] = %p (col=%d)\n", hartid, plic_idx, mapped_memory, col);
+        LOG_DEBUG("[PLIC] Hart %d: Using PLIC_INST[%d] = %p (col=%d)\n", hartid, plic_idx, mapped_memory, col);
     } else {
-        printf("[PLIC] Hart %d: WARNING - No mapped memory for PLIC address 0x%lx\n", 
+        LOG_WARN("[PLIC] Hart %d: WARNING - No mapped memory for PLIC address 0x%lx\n", 
                hartid, plic_base_tbl[0][col]);
         PLIC_INST[plic_idx] = NULL;  // Safe fallback
     }
@@ -293,7 +294,7 @@ void PLIC_enable_interrupt(irq_source_id_t irq_id, uint32_t hart_id){
 
     plic_select(hart_id, &plic, &tgt_local);    
     
-    printf("[PLIC_enable_interrupt] Hart %d: enabling source %d on PLIC %p, target_local %d\n",
+    LOG_DEBUG("[PLIC_enable_interrupt] Hart %d: enabling source %d on PLIC %p, target_local %d\n",
            hart_id, irq_id, plic, tgt_local);
 
     PLIC_M_TAR_enable(plic, tgt_local, irq_id); 
@@ -335,7 +336,7 @@ uint32_t PLIC_calculate_source_id(uint32_t source_hart, uint32_t target_hart, ir
     // Ensure we don't exceed PLIC source limits (1023 max)
     uint32_t source_id = hart_base + type_offset;
     if (source_id > 1023) {
-        printf("[PLIC] WARNING: Source ID %d exceeds PLIC limit\n", source_id);
+        LOG_WARN("[PLIC] WARNING: Source ID %d exceeds PLIC limit\n", source_id);
         return 0; // Invalid source
     }
     
@@ -346,7 +347,7 @@ uint32_t PLIC_calculate_source_id(uint32_t source_hart, uint32_t target_hart, ir
  * Setup bidirectional interrupt capabilities for all harts
  */
 int PLIC_setup_bidirectional_interrupts(void) {
-    printf("[PLIC] Setting up bidirectional interrupt support...\n");
+    LOG_INFO("[PLIC] Setting up bidirectional interrupt support...\n");
     
     // Enhanced interrupt types to support
     irq_source_id_t supported_types[] = {
@@ -363,7 +364,7 @@ int PLIC_setup_bidirectional_interrupts(void) {
     
     // Configure each hart to handle interrupts from all other harts
     for (uint32_t target_hart = 0; target_hart < NR_HARTS; target_hart++) {
-        printf("[PLIC] Configuring hart %d interrupt capabilities...\n", target_hart);
+        LOG_DEBUG("[PLIC] Configuring hart %d interrupt capabilities...\n", target_hart);
         
         // Set threshold (same for all)
         PLIC_set_threshold(target_hart, 1);
@@ -402,14 +403,14 @@ int PLIC_setup_bidirectional_interrupts(void) {
                     
                     PLIC_set_priority((irq_source_id_t)source_id, target_hart, priority);
                     
-                    printf("[PLIC] Hart %d: enabled source %d (hart %d -> type %d) priority %d\n",
+                    LOG_DEBUG("[PLIC] Hart %d: enabled source %d (hart %d -> type %d) priority %d\n",
                            target_hart, source_id, source_hart, (int)irq_type, priority);
                 }
             }
         }
     }
     
-    printf("[PLIC] Bidirectional interrupt setup complete\n");
+    LOG_INFO("[PLIC] Bidirectional interrupt setup complete\n");
     return 1;
 }
 
@@ -418,19 +419,19 @@ int PLIC_setup_bidirectional_interrupts(void) {
  */
 int PLIC_trigger_typed_interrupt(uint32_t source_hart, uint32_t target_hart, irq_source_id_t irq_type) {
     if (source_hart >= NR_HARTS || target_hart >= NR_HARTS) {
-        printf("[PLIC] Invalid hart IDs: source %d, target %d\n", source_hart, target_hart);
+        LOG_ERROR("[PLIC] Invalid hart IDs: source %d, target %d\n", source_hart, target_hart);
         return -1;
     }
     
     if (source_hart == target_hart) {
-        printf("[PLIC] Self-interrupts not supported\n");
+        LOG_ERROR("[PLIC] Self-interrupts not supported\n");
         return -2;
     }
     
     // Calculate the unique source ID for this source->target interrupt type
     uint32_t source_id = PLIC_calculate_source_id(source_hart, target_hart, irq_type);
     if (source_id == 0) {
-        printf("[PLIC] Failed to calculate valid source ID\n");
+        LOG_ERROR("[PLIC] Failed to calculate valid source ID\n");
         return -3;
     }
     
@@ -449,7 +450,7 @@ int PLIC_trigger_typed_interrupt(uint32_t source_hart, uint32_t target_hart, irq
     }
     
     if (plic_index < 0) {
-        printf("[PLIC] No PLIC instance found for target hart %d\n", target_hart);
+        LOG_ERROR("[PLIC] No PLIC instance found for target hart %d\n", target_hart);
         return -4;
     }
     
@@ -459,11 +460,11 @@ int PLIC_trigger_typed_interrupt(uint32_t source_hart, uint32_t target_hart, irq
     plic_select(target_hart, &plic, &tgt_local);
     
     if (!plic) {
-        printf("[PLIC] No valid PLIC instance for target hart %d\n", target_hart);
+        LOG_ERROR("[PLIC] No valid PLIC instance for target hart %d\n", target_hart);
         return -5;
     }
     
-    printf("[PLIC] Triggering: hart %d -> hart %d, type %d, source_id %d\n",
+    LOG_DEBUG("[PLIC] Triggering: hart %d -> hart %d, type %d, source_id %d\n",
            source_hart, target_hart, (int)irq_type, source_id);
     
     return PLIC_N_source_pending_write((PLIC_RegDef*)plic, source_id);
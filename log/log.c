@@ -0,0 +1,576 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "log/log.h"
+
+#define RING_BYTES      (64 * 1024)     // per thread, power of two
+#define RECORD_MAX      2048            // longest message kept
+#define OUT_BYTES       (64 * 1024)     // flusher staging buffer
+#define FLUSH_PERIOD_NS 2000000         // flusher wakes at least this often
+#define PAD_RECORD      0xFFFFFFFFu
+
+typedef struct {
+    uint64_t seq;
+    uint64_t t_ns;
+    uint32_t len;               // PAD_RECORD skips to the end of the ring
+    uint32_t level;
+} record_t;
+
+// Single producer (the owning thread), single consumer (whoever holds
+// g_log.drain_lock). Offsets are free-running byte counts.
+typedef struct {
+    _Alignas(64) uint64_t tail;         // published by the producer
+    _Alignas(64) uint64_t head;         // released by the consumer
+    int id;
+    int retired;                        // owner exited; free once drained
+    _Alignas(64) char data[RING_BYTES];
+} log_ring_t;
+
+int g_log_level = LOG_LEVEL_INFO;
+
+static struct {
+    pthread_once_t once;
+    pthread_key_t key;
+    pthread_mutex_t lock;               // ring registry + flusher parking
+    pthread_cond_t wake;
+    pthread_mutex_t drain_lock;         // one drain pass at a time
+    log_ring_t** rings;
+    int count, capacity, next_id;
+    int running, stopped, sleeping, prefix;
+    pthread_t thread;
+    FILE* out;
+    uint64_t seq;
+    uint64_t t0_ns;
+    log_stats_t stats;
+} g_log = {
+    .once = PTHREAD_ONCE_INIT,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+    .drain_lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static __thread log_ring_t* t_ring;
+
+// Output captured between log_capture_begin() and log_capture_end()
+typedef struct {
+    char* buf;
+    size_t used, cap;
+    int depth;
+    int at_line_start;
+} capture_t;
+
+static __thread capture_t t_capture;
+
+static const char level_chars[] = "EWIDT";
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline void stat_add(uint64_t* p, uint64_t v)
+{
+    __atomic_fetch_add(p, v, __ATOMIC_RELAXED);
+}
+
+static int parse_level(const char* s, int fallback)
+{
+    static const char* const names[] = { "error", "warn", "info", "debug", "trace" };
+    if (!s || !*s) return fallback;
+    if (*s >= '0' && *s <= '4' && s[1] == '\0') return *s - '0';
+    for (int i = 0; i <= LOG_LEVEL_TRACE; i++) {
+        if (strcasecmp(s, names[i]) == 0) return i;
+    }
+    return fallback;
+}
+
+/* ───────────────────────── flusher ───────────────────────── */
+
+typedef struct {
+    char buf[OUT_BYTES];
+    size_t used;
+    int at_line_start;
+} out_buf_t;
+
+static void out_flush(out_buf_t* o)
+{
+    if (o->used) {
+        fwrite(o->buf, 1, o->used, g_log.out);
+        stat_add(&g_log.stats.writes, 1);
+        o->used = 0;
+    }
+}
+
+static void out_put(out_buf_t* o, const char* s, size_t n)
+{
+    while (n) {
+        size_t room = OUT_BYTES - o->used;
+        size_t k = n < room ? n : room;
+        memcpy(o->buf + o->used, s, k);
+        o->used += k;
+        s += k;
+        n -= k;
+        if (o->used == OUT_BYTES) out_flush(o);
+    }
+}
+
+static out_buf_t g_out = { .at_line_start = 1 };   // under drain_lock
+
+typedef void (*put_fn)(void* sink, const char* s, size_t n);
+
+// Writes msg with the LOG_FORMAT=prefix header in front of every line
+static void put_prefixed(put_fn put, void* sink, int* at_line_start, uint64_t t_ns, uint32_t level,
+                         int ring_id, const char* msg, uint32_t len)
+{
+    char pfx[48];
+    int plen = snprintf(pfx, sizeof(pfx), "[%12.6f] %c t%02d ",
+                        (double)(t_ns - g_log.t0_ns) / 1e9, level_chars[level], ring_id);
+    for (uint32_t i = 0; i < len; ) {
+        const char* nl = memchr(msg + i, '\n', len - i);
+        uint32_t end = nl ? (uint32_t)(nl - msg) + 1 : len;
+        if (*at_line_start) put(sink, pfx, (size_t)plen);
+        put(sink, msg + i, end - i);
+        *at_line_start = nl != NULL;
+        i = end;
+    }
+}
+
+static void out_put_fn(void* sink, const char* s, size_t n)
+{
+    out_put(sink, s, n);
+}
+
+static void out_record(out_buf_t* o, const record_t* r, const char* msg, int ring_id)
+{
+    if (!g_log.prefix) {
+        out_put(o, msg, r->len);
+        return;
+    }
+    put_prefixed(out_put_fn, o, &o->at_line_start, r->t_ns, r->level, ring_id, msg, r->len);
+}
+
+// Returns the record at a ring offset, skipping the wrap padding
+static const record_t* ring_peek(log_ring_t* r, uint64_t* pos, uint64_t tail)
+{
+    while (*pos < tail) {
+        uint64_t off = *pos & (RING_BYTES - 1);
+        if (RING_BYTES - off < sizeof(record_t)) {
+            *pos += RING_BYTES - off;
+            continue;
+        }
+        const record_t* rec = (const record_t*)(r->data + off);
+        if (rec->len == PAD_RECORD) {
+            *pos += RING_BYTES - off;
+            continue;
+        }
+        return rec;
+    }
+    return NULL;
+}
+
+static uint64_t record_span(uint32_t len)
+{
+    return (sizeof(record_t) + len + 7) & ~(uint64_t)7;
+}
+
+// Merges every ring's published records in sequence order and writes them
+static void drain(void)
+{
+    out_buf_t* out = &g_out;
+    static log_ring_t** snap;
+    static uint64_t* pos;
+    static uint64_t* tails;
+    static int snap_cap;
+
+    pthread_mutex_lock(&g_log.drain_lock);
+
+    pthread_mutex_lock(&g_log.lock);
+    int n = g_log.count;
+    if (n > snap_cap) {
+        snap = realloc(snap, (size_t)n * sizeof(*snap));
+        pos = realloc(pos, (size_t)n * sizeof(*pos));
+        tails = realloc(tails, (size_t)n * sizeof(*tails));
+        snap_cap = n;
+    }
+    memcpy(snap, g_log.rings, (size_t)n * sizeof(*snap));
+    pthread_mutex_unlock(&g_log.lock);
+
+    for (int i = 0; i < n; i++) {
+        pos[i] = snap[i]->head;
+        tails[i] = __atomic_load_n(&snap[i]->tail, __ATOMIC_ACQUIRE);
+    }
+
+    for (;;) {
+        int best = -1;
+        const record_t* best_rec = NULL;
+        for (int i = 0; i < n; i++) {
+            const record_t* rec = ring_peek(snap[i], &pos[i], tails[i]);
+            if (rec && (!best_rec || rec->seq < best_rec->seq)) {
+                best = i;
+                best_rec = rec;
+            }
+        }
+        if (best < 0) break;
+        out_record(out, best_rec, (const char*)(best_rec + 1), snap[best]->id);
+        pos[best] += record_span(best_rec->len);
+    }
+    out_flush(out);
+    fflush(g_log.out);
+
+    for (int i = 0; i < n; i++) {
+        __atomic_store_n(&snap[i]->head, pos[i], __ATOMIC_RELEASE);
+    }
+
+    // Rings of exited threads go once nothing is left in them
+    pthread_mutex_lock(&g_log.lock);
+    for (int i = 0; i < g_log.count; ) {
+        log_ring_t* r = g_log.rings[i];
+        if (__atomic_load_n(&r->retired, __ATOMIC_ACQUIRE) &&
+            r->head == __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE)) {
+            g_log.rings[i] = g_log.rings[--g_log.count];
+            free(r);
+        } else {
+            i++;
+        }
+    }
+    pthread_mutex_unlock(&g_log.lock);
+
+    pthread_mutex_unlock(&g_log.drain_lock);
+}
+
+static void* flusher_thread(void* arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&g_log.lock);
+    while (g_log.running) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += FLUSH_PERIOD_NS;
+        if (ts.tv_nsec >= 1000000000L) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000L;
+        }
+        __atomic_store_n(&g_log.sleeping, 1, __ATOMIC_SEQ_CST);
+        pthread_cond_timedwait(&g_log.wake, &g_log.lock, &ts);
+        __atomic_store_n(&g_log.sleeping, 0, __ATOMIC_SEQ_CST);
+
+        pthread_mutex_unlock(&g_log.lock);
+        drain();
+        pthread_mutex_lock(&g_log.lock);
+    }
+    pthread_mutex_unlock(&g_log.lock);
+    return NULL;
+}
+
+static void wake_flusher(void)
+{
+    pthread_mutex_lock(&g_log.lock);
+    pthread_cond_signal(&g_log.wake);
+    pthread_mutex_unlock(&g_log.lock);
+}
+
+/* ───────────────────────── producers ───────────────────────── */
+
+// Runs in the exiting thread; a record logged after this gets a new ring
+static void ring_retire(void* arg)
+{
+    t_ring = NULL;
+    free(t_capture.buf);
+    t_capture = (capture_t){0};
+    __atomic_store_n(&((log_ring_t*)arg)->retired, 1, __ATOMIC_RELEASE);
+}
+
+static void init_once(void)
+{
+    g_log.out = stdout;
+    g_log.t0_ns = now_ns();
+    g_log_level = parse_level(getenv("LOG_LEVEL"), LOG_LEVEL_INFO);
+    const char* fmt = getenv("LOG_FORMAT");
+    g_log.prefix = fmt && strcasecmp(fmt, "prefix") == 0;
+    pthread_key_create(&g_log.key, ring_retire);
+
+    g_log.running = 1;
+    if (pthread_create(&g_log.thread, NULL, flusher_thread, NULL) != 0) {
+        g_log.running = 0;
+        g_log.stopped = 1;     // no flusher: records are written inline
+    }
+    atexit(log_shutdown);
+}
+
+void log_init(void)
+{
+    pthread_once(&g_log.once, init_once);
+}
+
+static log_ring_t* ring_get(void)
+{
+    if (t_ring) return t_ring;
+
+    log_ring_t* r = aligned_alloc(64, sizeof(*r));
+    if (!r) return NULL;
+    r->head = r->tail = 0;
+    r->retired = 0;
+
+    pthread_mutex_lock(&g_log.lock);
+    if (g_log.count == g_log.capacity) {
+        int cap = g_log.capacity ? g_log.capacity * 2 : 16;
+        log_ring_t** grown = realloc(g_log.rings, (size_t)cap * sizeof(*grown));
+        if (!grown) {
+            pthread_mutex_unlock(&g_log.lock);
+            free(r);
+            return NULL;
+        }
+        g_log.rings = grown;
+        g_log.capacity = cap;
+    }
+    r->id = g_log.next_id++;
+    g_log.rings[g_log.count++] = r;
+    pthread_mutex_unlock(&g_log.lock);
+
+    pthread_setspecific(g_log.key, r);
+    t_ring = r;
+    return r;
+}
+
+static void write_inline(const char* msg, size_t len)
+{
+    pthread_mutex_lock(&g_log.drain_lock);
+    fwrite(msg, 1, len, g_log.out ? g_log.out : stdout);
+    fflush(g_log.out);
+    pthread_mutex_unlock(&g_log.drain_lock);
+}
+
+static void capture_put(void* sink, const char* s, size_t n)
+{
+    capture_t* c = sink;
+    if (c->used + n > c->cap) {
+        size_t cap = c->cap ? c->cap : 16 * 1024;
+        while (cap < c->used + n) cap *= 2;
+        char* grown = realloc(c->buf, cap);
+        if (!grown) return;
+        c->buf = grown;
+        c->cap = cap;
+    }
+    memcpy(c->buf + c->used, s, n);
+    c->used += n;
+}
+
+void log_vwrite(log_level_t level, const char* format, va_list args)
+{
+    log_init();
+    // Direct callers (printf-style wrappers) skip the macros' level check
+    if ((int)level > __atomic_load_n(&g_log_level, __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    char msg[RECORD_MAX];
+    int n = vsnprintf(msg, sizeof(msg), format, args);
+    if (n < 0) return;
+    uint32_t len = (uint32_t)n;
+    if (len >= sizeof(msg)) {
+        len = sizeof(msg) - 1;
+        stat_add(&g_log.stats.truncated, 1);
+    }
+
+    if (t_capture.depth > 0) {
+        if (g_log.prefix) {
+            log_ring_t* own = ring_get();
+            put_prefixed(capture_put, &t_capture, &t_capture.at_line_start, now_ns(), (uint32_t)level,
+                         own ? own->id : 0, msg, len);
+        } else {
+            capture_put(&t_capture, msg, len);
+        }
+        stat_add(&g_log.stats.records, 1);
+        stat_add(&g_log.stats.bytes, len);
+        return;
+    }
+
+    log_ring_t* r = __atomic_load_n(&g_log.stopped, __ATOMIC_ACQUIRE) ? NULL : ring_get();
+    if (!r) {
+        write_inline(msg, len);
+        return;
+    }
+
+    uint64_t span = record_span(len);
+    uint64_t tail = r->tail;
+    uint64_t off = tail & (RING_BYTES - 1);
+    uint64_t skip = RING_BYTES - off < span ? RING_BYTES - off : 0;
+
+    // Back-pressure: wait for the flusher rather than drop the record
+    if (RING_BYTES - (tail - __atomic_load_n(&r->head, __ATOMIC_ACQUIRE)) < skip + span) {
+        stat_add(&g_log.stats.stalls, 1);
+        while (RING_BYTES - (tail - __atomic_load_n(&r->head, __ATOMIC_ACQUIRE)) < skip + span) {
+            if (__atomic_load_n(&g_log.stopped, __ATOMIC_ACQUIRE)) {
+                write_inline(msg, len);
+                return;
+            }
+            wake_flusher();
+            sched_yield();
+        }
+    }
+
+    if (skip) {
+        if (skip >= sizeof(record_t)) {
+            ((record_t*)(r->data + off))->len = PAD_RECORD;
+        }
+        tail += skip;
+        off = 0;
+    }
+    record_t* rec = (record_t*)(r->data + off);
+    rec->t_ns = now_ns();
+    rec->len = len;
+    rec->level = (uint32_t)level;
+    memcpy(rec + 1, msg, len);
+    rec->seq = __atomic_fetch_add(&g_log.seq, 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->tail, tail + span, __ATOMIC_RELEASE);
+
+    stat_add(&g_log.stats.records, 1);
+    stat_add(&g_log.stats.bytes, len);
+
+    // Nudge a sleeping flusher once the ring is half full
+    if (tail + span - __atomic_load_n(&r->head, __ATOMIC_RELAXED) > RING_BYTES / 2 &&
+        __atomic_load_n(&g_log.sleeping, __ATOMIC_RELAXED)) {
+        wake_flusher();
+    }
+}
+
+void log_write(log_level_t level, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    log_vwrite(level, format, args);
+    va_end(args);
+}
+
+void log_banner(const char* color, const char* msg)
+{
+    int padding = 82 - (int)strlen(msg);   // inner width of the box
+    LOG_INFO("\n"
+             "╔═══════════════════════════════════════════════════════════════════════════════════╗\n"
+             "║ \033[%sm%s\033[0m%*s║\n"
+             "╚═══════════════════════════════════════════════════════════════════════════════════╝\n"
+             "\n",
+             color, msg, padding > 0 ? padding : 0, "");
+}
+
+void log_capture_begin(void)
+{
+    log_init();
+    ring_get();     // retiring the ring at thread exit frees the buffer too
+    if (t_capture.depth++ == 0) {
+        t_capture.used = 0;
+        t_capture.at_line_start = 1;
+    }
+}
+
+void log_capture_end(void)
+{
+    if (t_capture.depth == 0 || --t_capture.depth > 0) {
+        return;
+    }
+    if (t_capture.used == 0) {
+        return;
+    }
+    // Whatever this thread logged before the capture goes out first
+    drain();
+    pthread_mutex_lock(&g_log.drain_lock);
+    out_put(&g_out, t_capture.buf, t_capture.used);
+    out_flush(&g_out);
+    fflush(g_log.out);
+    pthread_mutex_unlock(&g_log.drain_lock);
+
+    t_capture.used = 0;
+    if (t_capture.cap > 1024 * 1024) {
+        free(t_capture.buf);
+        t_capture.buf = NULL;
+        t_capture.cap = 0;
+    }
+}
+
+void log_capture_swap(void** slot)
+{
+    capture_t* saved = *slot;
+    if (!saved) {
+        if (t_capture.depth == 0 && !t_capture.buf) {
+            return;             // both empty
+        }
+        saved = calloc(1, sizeof(*saved));
+        if (!saved) {
+            return;
+        }
+        *slot = saved;
+    }
+    capture_t tmp = t_capture;
+    t_capture = *saved;
+    *saved = tmp;
+}
+
+void log_capture_free(void* slot)
+{
+    capture_t* saved = slot;
+    if (saved) {
+        free(saved->buf);
+        free(saved);
+    }
+}
+
+void log_flush(void)
+{
+    log_init();
+    drain();
+}
+
+void log_shutdown(void)
+{
+    log_init();
+    pthread_mutex_lock(&g_log.lock);
+    int was_running = g_log.running;
+    g_log.running = 0;
+    pthread_cond_signal(&g_log.wake);
+    pthread_mutex_unlock(&g_log.lock);
+    if (was_running) {
+        pthread_join(g_log.thread, NULL);
+    }
+    // Later records bypass the rings
+    __atomic_store_n(&g_log.stopped, 1, __ATOMIC_RELEASE);
+    drain();
+}
+
+void log_set_level(log_level_t level)
+{
+    log_init();
+    __atomic_store_n(&g_log_level, (int)level, __ATOMIC_RELAXED);
+}
+
+log_level_t log_get_level(void)
+{
+    return (log_level_t)__atomic_load_n(&g_log_level, __ATOMIC_RELAXED);
+}
+
+FILE* log_set_output(FILE* out)
+{
+    log_init();
+    drain();
+    pthread_mutex_lock(&g_log.drain_lock);
+    FILE* prev = g_log.out;
+    g_log.out = out ? out : stdout;
+    pthread_mutex_unlock(&g_log.drain_lock);
+    return prev;
+}
+
+void log_get_stats(log_stats_t* stats)
+{
+    stats->records = __atomic_load_n(&g_log.stats.records, __ATOMIC_RELAXED);
+    stats->bytes = __atomic_load_n(&g_log.stats.bytes, __ATOMIC_RELAXED);
+    stats->truncated = __atomic_load_n(&g_log.stats.truncated, __ATOMIC_RELAXED);
+    stats->stalls = __atomic_load_n(&g_log.stats.stalls, __ATOMIC_RELAXED);
+    stats->writes = __atomic_load_n(&g_log.stats.writes, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,91 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Asynchronous logging used by every simulator component.
+//
+// Each thread formats its records into its own lock-free single-producer
+// ring; a background flusher merges the rings in sequence order and writes
+// them with one fwrite per pass, so a logging call never does I/O or takes
+// a lock. Records carry level, timestamp and thread number.
+//
+// Levels are filtered twice: LOG_COMPILE_LEVEL (make LOG_COMPILE_LEVEL=n)
+// removes the calls above it from the build, and LOG_LEVEL=<error|warn|
+// info|debug|trace> filters at run time (default info). LOG_FORMAT=prefix
+// prepends "[seconds] L tNN" to every line.
+
+typedef enum {
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_TRACE
+} log_level_t;
+
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_TRACE
+#endif
+
+extern int g_log_level;
+
+#define LOG_ENABLED(level) \
+    ((level) <= LOG_COMPILE_LEVEL && (level) <= __atomic_load_n(&g_log_level, __ATOMIC_RELAXED))
+
+#define LOG_AT(level, ...) \
+    do { \
+        if (LOG_ENABLED(level)) log_write((level), __VA_ARGS__); \
+    } while (0)
+
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG_WARN(...)  LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_INFO(...)  LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_TRACE(...) LOG_AT(LOG_LEVEL_TRACE, __VA_ARGS__)
+
+typedef struct {
+    uint64_t records;       // accepted into a ring
+    uint64_t bytes;         // message bytes accepted
+    uint64_t truncated;     // records cut to the maximum record length
+    uint64_t stalls;        // producers that waited for ring space
+    uint64_t writes;        // fwrite calls made by the flusher
+} log_stats_t;
+
+// Reads LOG_LEVEL/LOG_FORMAT and starts the flusher; the first record
+// does this implicitly. Safe to call repeatedly.
+void log_init(void);
+// Stops the flusher after writing everything queued (registered atexit)
+void log_shutdown(void);
+
+void log_write(log_level_t level, const char* format, ...)
+    __attribute__((format(printf, 2, 3)));
+void log_vwrite(log_level_t level, const char* format, va_list args);
+// Writes msg boxed as one INFO record; color is an SGR parameter such as
+// "1;32" for bold green
+void log_banner(const char* color, const char* msg);
+
+// Writes every record queued before the call; returns once it is out
+void log_flush(void);
+
+// Between these the calling thread's records go to a private buffer that
+// log_capture_end() writes as one block, so a task's output is never
+// interleaved with other threads' and nothing is locked while it runs.
+// Captures nest; only the outermost end writes.
+void log_capture_begin(void);
+void log_capture_end(void);
+// For coroutines sharing a thread: exchanges the thread's capture with
+// the one kept in *slot (NULL to start with). Call it when a coroutine is
+// switched in and again when it is switched out; free the slot once the
+// coroutine is done.
+void log_capture_swap(void** slot);
+void log_capture_free(void* slot);
+
+void log_set_level(log_level_t level);
+log_level_t log_get_level(void);
+// Redirects the flusher's output (default stdout); returns the previous one
+FILE* log_set_output(FILE* out);
+void log_get_stats(log_stats_t* stats);
+
+#endif
@@ -0,0 +1,30 @@
+#include "log/log_hist.h"
+
+#define SUB_BITS    LOG_HIST_SUB_BITS
+#define SUB_COUNT   LOG_HIST_SUB_COUNT
+#define BUCKETS     LOG_HIST_BUCKETS
+
+uint64_t log_hist_value(unsigned b)
+{
+    if (b < SUB_COUNT) {
+        return b;
+    }
+    unsigned e = (b - SUB_COUNT) / SUB_COUNT + SUB_BITS;
+    uint64_t sub = (b - SUB_COUNT) % SUB_COUNT;
+    uint64_t width = 1ULL << (e - SUB_BITS);
+    return ((SUB_COUNT + sub) << (e - SUB_BITS)) + width - 1;
+}
+
+uint64_t log_hist_percentile(const uint64_t* hist, uint64_t count, double q)
+{
+    uint64_t target = (uint64_t)(q * (double)count + 0.999999);
+    if (target == 0) target = 1;
+    uint64_t seen = 0;
+    for (unsigned b = 0; b < BUCKETS; b++) {
+        seen += hist[b];
+        if (seen >= target) {
+            return log_hist_value(b);
+        }
+    }
+    return log_hist_value(BUCKETS - 1);
+}
@@ -0,0 +1,39 @@
+#ifndef LOG_HIST_H
+#define LOG_HIST_H
+
+#include <stdint.h>
+
+// Log-linear latency histogram shared by the HAL call statistics and the
+// C0 task classes: values below 16 ns get exact buckets, then each power
+// of two up to 2^39 ns is split into 16 sub-buckets, so a percentile read
+// back is within about 6% of the value recorded.
+//
+//   uint64_t hist[LOG_HIST_BUCKETS];
+//   hist[log_hist_bucket(ns)]++;
+//   uint64_t p99 = log_hist_percentile(hist, count, 0.99);
+
+#define LOG_HIST_SUB_BITS   4
+#define LOG_HIST_SUB_COUNT  (1 << LOG_HIST_SUB_BITS)
+#define LOG_HIST_MAX_EXP    39
+#define LOG_HIST_BUCKETS    (LOG_HIST_SUB_COUNT + (LOG_HIST_MAX_EXP - LOG_HIST_SUB_BITS + 1) * LOG_HIST_SUB_COUNT)
+
+// Inline: it runs on every recorded call
+static inline unsigned log_hist_bucket(uint64_t ns)
+{
+    if (ns < LOG_HIST_SUB_COUNT) {
+        return (unsigned)ns;
+    }
+    unsigned e = 63 - (unsigned)__builtin_clzll(ns);
+    if (e > LOG_HIST_MAX_EXP) {
+        return LOG_HIST_BUCKETS - 1;
+    }
+    return LOG_HIST_SUB_COUNT + (e - LOG_HIST_SUB_BITS) * LOG_HIST_SUB_COUNT +
+           (unsigned)((ns >> (e - LOG_HIST_SUB_BITS)) & (LOG_HIST_SUB_COUNT - 1));
+}
+
+// Highest value that lands in a bucket
+uint64_t log_hist_value(unsigned bucket);
+// Value at quantile q of count samples, rounded up to its bucket's top
+uint64_t log_hist_percentile(const uint64_t* hist, uint64_t count, double q);
+
+#endif
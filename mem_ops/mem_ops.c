@@ -0,0 +1,973 @@
+#include "mem_ops.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MEM_OPS_X86 1
+#include <immintrin.h>
+#include <cpuid.h>
+#include "log/log.h"
+#endif
+
+// Sizes below this go straight to libc, which already has tuned small-copy paths
+#define MEM_OPS_SMALL_SIZE      256
+#define MEM_OPS_DEFAULT_NT_SIZE (8UL * 1024 * 1024)
+// Copy+CRC works in L1-sized chunks so the checksum re-reads hot lines
+#define MEM_OPS_CRC_CHUNK       4096
+#define CRC32C_POLY             0x82F63B78U   // Castagnoli, reflected
+
+typedef struct {
+    void (*copy)(void* dst, const void* src, size_t size);
+    void (*fill)(void* dst, uint8_t value, size_t size);
+    void (*fill_ramp)(void* dst, uint8_t start, size_t size);
+    void (*fill_pattern)(void* dst, const uint8_t* pattern, size_t size);
+    int  (*compare)(const void* a, const void* b, size_t size);
+    uint32_t (*crc32c)(uint32_t crc, const uint8_t* data, size_t size);
+} mem_ops_table_t;
+
+static pthread_once_t g_mem_ops_once = PTHREAD_ONCE_INIT;
+static mem_ops_variant_t g_variant = MEM_OPS_LIBC;
+static size_t g_nt_threshold = MEM_OPS_DEFAULT_NT_SIZE;   // atomic: tests retune it while others copy
+
+static inline size_t nt_threshold(void)
+{
+    return __atomic_load_n(&g_nt_threshold, __ATOMIC_RELAXED);
+}
+
+// 0, 1, 2, ... 63 - lane offsets for the incrementing fill kernels
+static const uint8_t k_iota[64] __attribute__((aligned(64))) = {
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63
+};
+
+/* -------------------------------------------------------------------------- */
+/*                              Generic (libc) kernels                        */
+/* -------------------------------------------------------------------------- */
+static void copy_libc(void* dst, const void* src, size_t size)
+{
+    memcpy(dst, src, size);
+}
+
+static void fill_libc(void* dst, uint8_t value, size_t size)
+{
+    memset(dst, value, size);
+}
+
+static void fill_ramp_libc(void* dst, uint8_t start, size_t size)
+{
+    // The ramp repeats every 256 bytes, so build one period and replicate it
+    uint8_t period[256];
+    for (int i = 0; i < 256; i++) {
+        period[i] = (uint8_t)(start + i);
+    }
+
+    uint8_t* d = (uint8_t*)dst;
+    while (size >= sizeof(period)) {
+        memcpy(d, period, sizeof(period));
+        d += sizeof(period);
+        size -= sizeof(period);
+    }
+    memcpy(d, period, size);
+}
+
+static void fill_pattern_libc(void* dst, const uint8_t* pattern, size_t size)
+{
+    uint8_t* d = (uint8_t*)dst;
+    while (size >= MEM_OPS_PATTERN_SIZE) {
+        memcpy(d, pattern, MEM_OPS_PATTERN_SIZE);
+        d += MEM_OPS_PATTERN_SIZE;
+        size -= MEM_OPS_PATTERN_SIZE;
+    }
+    memcpy(d, pattern, size);
+}
+
+static int compare_libc(const void* a, const void* b, size_t size)
+{
+    return memcmp(a, b, size);
+}
+
+// Slice-by-8 tables, built once in mem_ops_init_once()
+static uint32_t g_crc_table[8][256];
+
+static void crc32c_build_tables(void)
+{
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? (c >> 1) ^ CRC32C_POLY : c >> 1;
+        }
+        g_crc_table[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int t = 1; t < 8; t++) {
+            uint32_t prev = g_crc_table[t - 1][i];
+            g_crc_table[t][i] = (prev >> 8) ^ g_crc_table[0][prev & 0xFF];
+        }
+    }
+}
+
+// Operates on the raw (pre-inverted) register value
+static uint32_t crc32c_table(uint32_t crc, const uint8_t* p, size_t size)
+{
+    while (size && ((uintptr_t)p & 7)) {
+        crc = (crc >> 8) ^ g_crc_table[0][(crc ^ *p++) & 0xFF];
+        size--;
+    }
+    for (; size >= 8; size -= 8, p += 8) {
+        uint64_t w;
+        memcpy(&w, p, sizeof(w));
+        w ^= crc;
+        crc = g_crc_table[7][ w        & 0xFF] ^ g_crc_table[6][(w >>  8) & 0xFF] ^
+              g_crc_table[5][(w >> 16) & 0xFF] ^ g_crc_table[4][(w >> 24) & 0xFF] ^
+              g_crc_table[3][(w >> 32) & 0xFF] ^ g_crc_table[2][(w >> 40) & 0xFF] ^
+              g_crc_table[1][(w >> 48) & 0xFF] ^ g_crc_table[0][ w >> 56        ];
+    }
+    while (size--) {
+        crc = (crc >> 8) ^ g_crc_table[0][(crc ^ *p++) & 0xFF];
+    }
+    return crc;
+}
+
+#ifdef MEM_OPS_X86
+// Pattern fills write the head up to the next 64-byte boundary, then rotate
+// the pattern so the vector loop can use aligned (or streaming) stores.
+// Only used for sizes >= MEM_OPS_SMALL_SIZE, so the head always fits.
+static size_t pattern_head(uint8_t* d, const uint8_t* pattern, uint8_t* rotated)
+{
+    size_t head = (MEM_OPS_PATTERN_SIZE - ((uintptr_t)d & (MEM_OPS_PATTERN_SIZE - 1))) & (MEM_OPS_PATTERN_SIZE - 1);
+    memcpy(d, pattern, head);
+    for (size_t i = 0; i < MEM_OPS_PATTERN_SIZE; i++) {
+        rotated[i] = pattern[(head + i) & (MEM_OPS_PATTERN_SIZE - 1)];
+    }
+    return head;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                 SSE2 kernels                               */
+/* -------------------------------------------------------------------------- */
+static void copy_sse2(void* dst, const void* src, size_t size)
+{
+    if (size < MEM_OPS_SMALL_SIZE) {
+        memcpy(dst, src, size);
+        return;
+    }
+
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+
+    // Unaligned head and tail; everything in between uses aligned stores
+    __m128i tail = _mm_loadu_si128((const __m128i*)(s + size - 16));
+    uint8_t* tail_dst = d + size - 16;
+    _mm_storeu_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+    size_t skew = 16 - ((uintptr_t)d & 15);
+    d += skew; s += skew; size -= skew;
+
+    if (size >= nt_threshold()) {
+        for (; size >= 64; size -= 64, s += 64, d += 64) {
+            __m128i v0 = _mm_loadu_si128((const __m128i*)(s +  0));
+            __m128i v1 = _mm_loadu_si128((const __m128i*)(s + 16));
+            __m128i v2 = _mm_loadu_si128((const __m128i*)(s + 32));
+            __m128i v3 = _mm_loadu_si128((const __m128i*)(s + 48));
+            _mm_stream_si128((__m128i*)(d +  0), v0);
+            _mm_stream_si128((__m128i*)(d + 16), v1);
+            _mm_stream_si128((__m128i*)(d + 32), v2);
+            _mm_stream_si128((__m128i*)(d + 48), v3);
+        }
+        _mm_sfence();
+    } else {
+        for (; size >= 64; size -= 64, s += 64, d += 64) {
+            __m128i v0 = _mm_loadu_si128((const __m128i*)(s +  0));
+            __m128i v1 = _mm_loadu_si128((const __m128i*)(s + 16));
+            __m128i v2 = _mm_loadu_si128((const __m128i*)(s + 32));
+            __m128i v3 = _mm_loadu_si128((const __m128i*)(s + 48));
+            _mm_store_si128((__m128i*)(d +  0), v0);
+            _mm_store_si128((__m128i*)(d + 16), v1);
+            _mm_store_si128((__m128i*)(d + 32), v2);
+            _mm_store_si128((__m128i*)(d + 48), v3);
+        }
+    }
+    for (; size >= 16; size -= 16, s += 16, d += 16) {
+        _mm_store_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+    }
+    _mm_storeu_si128((__m128i*)tail_dst, tail);
+}
+
+static void fill_vec_sse2(uint8_t* d, __m128i v, uint8_t step, size_t size)
+{
+    // v holds the bytes for d[0..15]; step is added per 16-byte lane
+    // (zero for a constant fill, 16 for an incrementing one)
+    __m128i vstep = _mm_set1_epi8((char)step);
+    __m128i tail = step ? _mm_add_epi8(v, _mm_set1_epi8((char)(uint8_t)(size - 16))) : v;
+    uint8_t* tail_dst = d + size - 16;
+
+    _mm_storeu_si128((__m128i*)d, v);
+    size_t skew = 16 - ((uintptr_t)d & 15);
+    if (step) {
+        v = _mm_add_epi8(v, _mm_set1_epi8((char)(uint8_t)skew));
+    }
+    d += skew; size -= skew;
+
+    if (size >= nt_threshold()) {
+        for (; size >= 16; size -= 16, d += 16) {
+            _mm_stream_si128((__m128i*)d, v);
+            v = _mm_add_epi8(v, vstep);
+        }
+        _mm_sfence();
+    } else {
+        for (; size >= 16; size -= 16, d += 16) {
+            _mm_store_si128((__m128i*)d, v);
+            v = _mm_add_epi8(v, vstep);
+        }
+    }
+    _mm_storeu_si128((__m128i*)tail_dst, tail);
+}
+
+static void fill_sse2(void* dst, uint8_t value, size_t size)
+{
+    if (size < MEM_OPS_SMALL_SIZE) {
+        memset(dst, value, size);
+        return;
+    }
+    fill_vec_sse2((uint8_t*)dst, _mm_set1_epi8((char)value), 0, size);
+}
+
+static void fill_ramp_sse2(void* dst, uint8_t start, size_t size)
+{
+    if (size < 16) {
+        fill_ramp_libc(dst, start, size);
+        return;
+    }
+    __m128i v = _mm_add_epi8(_mm_set1_epi8((char)start), _mm_load_si128((const __m128i*)k_iota));
+    fill_vec_sse2((uint8_t*)dst, v, 16, size);
+}
+
+static void fill_pattern_sse2(void* dst, const uint8_t* pattern, size_t size)
+{
+    if (size < MEM_OPS_SMALL_SIZE) {
+        fill_pattern_libc(dst, pattern, size);
+        return;
+    }
+
+    uint8_t rotated[MEM_OPS_PATTERN_SIZE] __attribute__((aligned(64)));
+    uint8_t* d = (uint8_t*)dst;
+    size_t head = pattern_head(d, pattern, rotated);
+    d += head; size -= head;
+
+    __m128i v0 = _mm_load_si128((const __m128i*)(rotated +  0));
+    __m128i v1 = _mm_load_si128((const __m128i*)(rotated + 16));
+    __m128i v2 = _mm_load_si128((const __m128i*)(rotated + 32));
+    __m128i v3 = _mm_load_si128((const __m128i*)(rotated + 48));
+    if (size >= nt_threshold()) {
+        for (; size >= 64; size -= 64, d += 64) {
+            _mm_stream_si128((__m128i*)(d +  0), v0);
+            _mm_stream_si128((__m128i*)(d + 16), v1);
+            _mm_stream_si128((__m128i*)(d + 32), v2);
+            _mm_stream_si128((__m128i*)(d + 48), v3);
+        }
+        _mm_sfence();
+    } else {
+        for (; size >= 64; size -= 64, d += 64) {
+            _mm_store_si128((__m128i*)(d +  0), v0);
+            _mm_store_si128((__m128i*)(d + 16), v1);
+            _mm_store_si128((__m128i*)(d + 32), v2);
+            _mm_store_si128((__m128i*)(d + 48), v3);
+        }
+    }
+    memcpy(d, rotated, size);
+}
+
+static int compare_sse2(const void* a, const void* b, size_t size)
+{
+    const uint8_t* pa = (const uint8_t*)a;
+    const uint8_t* pb = (const uint8_t*)b;
+    size_t i = 0;
+
+    for (; i + 16 <= size; i += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(pa + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(pb + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) != 0xFFFF) {
+            return memcmp(pa + i, pb + i, 16);
+        }
+    }
+    return memcmp(pa + i, pb + i, size - i);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                 AVX2 kernels                               */
+/* -------------------------------------------------------------------------- */
+__attribute__((target("avx2")))
+static void copy_avx2(void* dst, const void* src, size_t size)
+{
+    if (size < MEM_OPS_SMALL_SIZE) {
+        memcpy(dst, src, size);
+        return;
+    }
+
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+
+    __m256i tail = _mm256_loadu_si256((const __m256i*)(s + size - 32));
+    uint8_t* tail_dst = d + size - 32;
+    _mm256_storeu_si256((__m256i*)d, _mm256_loadu_si256((const __m256i*)s));
+    size_t skew = 32 - ((uintptr_t)d & 31);
+    d += skew; s += skew; size -= skew;
+
+    if (size >= nt_threshold()) {
+        for (; size >= 128; size -= 128, s += 128, d += 128) {
+            __m256i v0 = _mm256_loadu_si256((const __m256i*)(s +  0));
+            __m256i v1 = _mm256_loadu_si256((const __m256i*)(s + 32));
+            __m256i v2 = _mm256_loadu_si256((const __m256i*)(s + 64));
+            __m256i v3 = _mm256_loadu_si256((const __m256i*)(s + 96));
+            _mm256_stream_si256((__m256i*)(d +  0), v0);
+            _mm256_stream_si256((__m256i*)(d + 32), v1);
+            _mm256_stream_si256((__m256i*)(d + 64), v2);
+            _mm256_stream_si256((__m256i*)(d + 96), v3);
+        }
+        _mm_sfence();
+    } else {
+        for (; size >= 128; size -= 128, s += 128, d += 128) {
+            __m256i v0 = _mm256_loadu_si256((const __m256i*)(s +  0));
+            __m256i v1 = _mm256_loadu_si256((const __m256i*)(s + 32));
+            __m256i v2 = _mm256_loadu_si256((const __m256i*)(s + 64));
+            __m256i v3 = _mm256_loadu_si256((const __m256i*)(s + 96));
+            _mm256_store_si256((__m256i*)(d +  0), v0);
+            _mm256_store_si256((__m256i*)(d + 32), v1);
+            _mm256_store_si256((__m256i*)(d + 64), v2);
+            _mm256_store_si256((__m256i*)(d + 96), v3);
+        }
+    }
+    for (; size >= 32; size -= 32, s += 32, d += 32) {
+        _mm256_store_si256((__m256i*)d, _mm256_loadu_si256((const __m256i*)s));
+    }
+    _mm256_storeu_si256((__m256i*)tail_dst, tail);
+}
+
+__attribute__((target("avx2")))
+static void fill_vec_avx2(uint8_t* d, __m256i v, uint8_t step, size_t size)
+{
+    __m256i vstep = _mm256_set1_epi8((char)step);
+    __m256i tail = step ? _mm256_add_epi8(v, _mm256_set1_epi8((char)(uint8_t)(size - 32))) : v;
+    uint8_t* tail_dst = d + size - 32;
+
+    _mm256_storeu_si256((__m256i*)d, v);
+    size_t skew = 32 - ((uintptr_t)d & 31);
+    if (step) {
+        v = _mm256_add_epi8(v, _mm256_set1_epi8((char)(uint8_t)skew));
+    }
+    d += skew; size -= skew;
+
+    if (size >= nt_threshold()) {
+        for (; size >= 32; size -= 32, d += 32) {
+            _mm256_stream_si256((__m256i*)d, v);
+            v = _mm256_add_epi8(v, vstep);
+        }
+        _mm_sfence();
+    } else {
+        for (; size >= 32; size -= 32, d += 32) {
+            _mm256_store_si256((__m256i*)d, v);
+            v = _mm256_add_epi8(v, vstep);
+        }
+    }
+    _mm256_storeu_si256((__m256i*)tail_dst, tail);
+}
+
+__attribute__((target("avx2")))
+static void fill_avx2(void* dst, uint8_t value, size_t size)
+{
+    if (size < MEM_OPS_SMALL_SIZE) {
+        memset(dst, value, size);
+        return;
+    }
+    fill_vec_avx2((uint8_t*)dst, _mm256_set1_epi8((char)value), 0, size);
+}
+
+__attribute__((target("avx2")))
+static void fill_ramp_avx2(void* dst, uint8_t start, size_t size)
+{
+    if (size < 32) {
+        fill_ramp_sse2(dst, start, size);
+        return;
+    }
+    __m256i v = _mm256_add_epi8(_mm256_set1_epi8((char)start), _mm256_load_si256((const __m256i*)k_iota));
+    fill_vec_avx2((uint8_t*)dst, v, 32, size);
+}
+
+__attribute__((target("avx2")))
+static void fill_pattern_avx2(void* dst, const uint8_t* pattern, size_t size)
+{
+    if (size < MEM_OPS_SMALL_SIZE) {
+        fill_pattern_libc(dst, pattern, size);
+        return;
+    }
+
+    uint8_t rotated[MEM_OPS_PATTERN_SIZE] __attribute__((aligned(64)));
+    uint8_t* d = (uint8_t*)dst;
+    size_t head = pattern_head(d, pattern, rotated);
+    d += head; size -= head;
+
+    __m256i v0 = _mm256_load_si256((const __m256i*)(rotated +  0));
+    __m256i v1 = _mm256_load_si256((const __m256i*)(rotated + 32));
+    if (size >= nt_threshold()) {
+        for (; size >= 64; size -= 64, d += 64) {
+            _mm256_stream_si256((__m256i*)(d +  0), v0);
+            _mm256_stream_si256((__m256i*)(d + 32), v1);
+        }
+        _mm_sfence();
+    } else {
+        for (; size >= 64; size -= 64, d += 64) {
+            _mm256_store_si256((__m256i*)(d +  0), v0);
+            _mm256_store_si256((__m256i*)(d + 32), v1);
+        }
+    }
+    memcpy(d, rotated, size);
+}
+
+__attribute__((target("avx2")))
+static int compare_avx2(const void* a, const void* b, size_t size)
+{
+    const uint8_t* pa = (const uint8_t*)a;
+    const uint8_t* pb = (const uint8_t*)b;
+    size_t i = 0;
+
+    for (; i + 32 <= size; i += 32) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(pa + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(pb + i));
+        if ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)) != 0xFFFFFFFFU) {
+            return memcmp(pa + i, pb + i, 32);
+        }
+    }
+    return memcmp(pa + i, pb + i, size - i);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                               AVX-512 kernels                              */
+/* -------------------------------------------------------------------------- */
+// One zmm register is exactly one 512-bit NoC flit / DLM1_512 beat
+__attribute__((target("avx512f,avx512bw")))
+static void copy_avx512(void* dst, const void* src, size_t size)
+{
+    if (size < MEM_OPS_SMALL_SIZE) {
+        memcpy(dst, src, size);
+        return;
+    }
+
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+
+    __m512i tail = _mm512_loadu_si512((const void*)(s + size - 64));
+    uint8_t* tail_dst = d + size - 64;
+    _mm512_storeu_si512((void*)d, _mm512_loadu_si512((const void*)s));
+    size_t skew = 64 - ((uintptr_t)d & 63);
+    d += skew; s += skew; size -= skew;
+
+    if (size >= nt_threshold()) {
+        for (; size >= 256; size -= 256, s += 256, d += 256) {
+            __m512i v0 = _mm512_loadu_si512((const void*)(s +   0));
+            __m512i v1 = _mm512_loadu_si512((const void*)(s +  64));
+            __m512i v2 = _mm512_loadu_si512((const void*)(s + 128));
+            __m512i v3 = _mm512_loadu_si512((const void*)(s + 192));
+            _mm512_stream_si512((void*)(d +   0), v0);
+            _mm512_stream_si512((void*)(d +  64), v1);
+            _mm512_stream_si512((void*)(d + 128), v2);
+            _mm512_stream_si512((void*)(d + 192), v3);
+        }
+        _mm_sfence();
+    } else {
+        for (; size >= 256; size -= 256, s += 256, d += 256) {
+            __m512i v0 = _mm512_loadu_si512((const void*)(s +   0));
+            __m512i v1 = _mm512_loadu_si512((const void*)(s +  64));
+            __m512i v2 = _mm512_loadu_si512((const void*)(s + 128));
+            __m512i v3 = _mm512_loadu_si512((const void*)(s + 192));
+            _mm512_store_si512((void*)(d +   0), v0);
+            _mm512_store_si512((void*)(d +  64), v1);
+            _mm512_store_si512((void*)(d + 128), v2);
+            _mm512_store_si512((void*)(d + 192), v3);
+        }
+    }
+    for (; size >= 64; size -= 64, s += 64, d += 64) {
+        _mm512_store_si512((void*)d, _mm512_loadu_si512((const void*)s));
+    }
+    _mm512_storeu_si512((void*)tail_dst, tail);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void fill_vec_avx512(uint8_t* d, __m512i v, uint8_t step, size_t size)
+{
+    __m512i vstep = _mm512_set1_epi8((char)step);
+    __m512i tail = step ? _mm512_add_epi8(v, _mm512_set1_epi8((char)(uint8_t)(size - 64))) : v;
+    uint8_t* tail_dst = d + size - 64;
+
+    _mm512_storeu_si512((void*)d, v);
+    size_t skew = 64 - ((uintptr_t)d & 63);
+    if (step) {
+        v = _mm512_add_epi8(v, _mm512_set1_epi8((char)(uint8_t)skew));
+    }
+    d += skew; size -= skew;
+
+    if (size >= nt_threshold()) {
+        for (; size >= 64; size -= 64, d += 64) {
+            _mm512_stream_si512((void*)d, v);
+            v = _mm512_add_epi8(v, vstep);
+        }
+        _mm_sfence();
+    } else {
+        for (; size >= 64; size -= 64, d += 64) {
+            _mm512_store_si512((void*)d, v);
+            v = _mm512_add_epi8(v, vstep);
+        }
+    }
+    _mm512_storeu_si512((void*)tail_dst, tail);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void fill_avx512(void* dst, uint8_t value, size_t size)
+{
+    if (size < MEM_OPS_SMALL_SIZE) {
+        memset(dst, value, size);
+        return;
+    }
+    fill_vec_avx512((uint8_t*)dst, _mm512_set1_epi8((char)value), 0, size);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void fill_ramp_avx512(void* dst, uint8_t start, size_t size)
+{
+    if (size < 64) {
+        fill_ramp_sse2(dst, start, size);
+        return;
+    }
+    __m512i v = _mm512_add_epi8(_mm512_set1_epi8((char)start), _mm512_load_si512((const void*)k_iota));
+    fill_vec_avx512((uint8_t*)dst, v, 64, size);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void fill_pattern_avx512(void* dst, const uint8_t* pattern, size_t size)
+{
+    if (size < MEM_OPS_SMALL_SIZE) {
+        fill_pattern_libc(dst, pattern, size);
+        return;
+    }
+
+    uint8_t rotated[MEM_OPS_PATTERN_SIZE] __attribute__((aligned(64)));
+    uint8_t* d = (uint8_t*)dst;
+    size_t head = pattern_head(d, pattern, rotated);
+    d += head; size -= head;
+
+    // The whole pattern is a single zmm register
+    __m512i v = _mm512_load_si512((const void*)rotated);
+    if (size >= nt_threshold()) {
+        for (; size >= 64; size -= 64, d += 64) {
+            _mm512_stream_si512((void*)d, v);
+        }
+        _mm_sfence();
+    } else {
+        for (; size >= 64; size -= 64, d += 64) {
+            _mm512_store_si512((void*)d, v);
+        }
+    }
+    memcpy(d, rotated, size);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static int compare_avx512(const void* a, const void* b, size_t size)
+{
+    const uint8_t* pa = (const uint8_t*)a;
+    const uint8_t* pb = (const uint8_t*)b;
+    size_t i = 0;
+
+    for (; i + 64 <= size; i += 64) {
+        __m512i va = _mm512_loadu_si512((const void*)(pa + i));
+        __m512i vb = _mm512_loadu_si512((const void*)(pb + i));
+        if (_mm512_cmpneq_epi8_mask(va, vb)) {
+            return memcmp(pa + i, pb + i, 64);
+        }
+    }
+    return memcmp(pa + i, pb + i, size - i);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              SSE4.2 CRC32C kernel                          */
+/* -------------------------------------------------------------------------- */
+// The crc32 instruction uses the Castagnoli polynomial directly
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(uint32_t crc, const uint8_t* p, size_t size)
+{
+    while (size && ((uintptr_t)p & 7)) {
+        crc = _mm_crc32_u8(crc, *p++);
+        size--;
+    }
+    uint64_t c = crc;
+    for (; size >= 32; size -= 32, p += 32) {
+        uint64_t w0, w1, w2, w3;
+        memcpy(&w0, p +  0, 8);
+        memcpy(&w1, p +  8, 8);
+        memcpy(&w2, p + 16, 8);
+        memcpy(&w3, p + 24, 8);
+        c = _mm_crc32_u64(c, w0);
+        c = _mm_crc32_u64(c, w1);
+        c = _mm_crc32_u64(c, w2);
+        c = _mm_crc32_u64(c, w3);
+    }
+    for (; size >= 8; size -= 8, p += 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        c = _mm_crc32_u64(c, w);
+    }
+    crc = (uint32_t)c;
+    while (size--) {
+        crc = _mm_crc32_u8(crc, *p++);
+    }
+    return crc;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                        ERMS (rep movsb / rep stosb) kernels                */
+/* -------------------------------------------------------------------------- */
+static void copy_erms(void* dst, const void* src, size_t size)
+{
+    // rep movsb cannot bypass the cache; large copies use streaming stores
+    if (size >= nt_threshold()) {
+        copy_sse2(dst, src, size);
+        return;
+    }
+    __asm__ volatile("rep movsb"
+                     : "+D"(dst), "+S"(src), "+c"(size)
+                     :
+                     : "memory");
+}
+
+static void fill_erms(void* dst, uint8_t value, size_t size)
+{
+    if (size >= nt_threshold()) {
+        fill_sse2(dst, value, size);
+        return;
+    }
+    __asm__ volatile("rep stosb"
+                     : "+D"(dst), "+c"(size)
+                     : "a"(value)
+                     : "memory");
+}
+
+static int cpu_has_erms(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+    return (ebx >> 9) & 1;
+}
+#endif /* MEM_OPS_X86 */
+
+/* -------------------------------------------------------------------------- */
+/*                                  Dispatch                                  */
+/* -------------------------------------------------------------------------- */
+static void resolve_copy(void* dst, const void* src, size_t size);
+static void resolve_fill(void* dst, uint8_t value, size_t size);
+static void resolve_fill_ramp(void* dst, uint8_t start, size_t size);
+static void resolve_fill_pattern(void* dst, const uint8_t* pattern, size_t size);
+static int  resolve_compare(const void* a, const void* b, size_t size);
+static uint32_t resolve_crc32c(uint32_t crc, const uint8_t* data, size_t size);
+
+// Starts out pointing at resolvers so callers never need an init check
+static mem_ops_table_t g_ops = {
+    resolve_copy, resolve_fill, resolve_fill_ramp, resolve_fill_pattern, resolve_compare,
+    resolve_crc32c
+};
+
+static const char* const g_variant_names[MEM_OPS_VARIANT_COUNT] = {
+    "libc", "sse2", "avx2", "avx512", "erms"
+};
+
+const char* mem_ops_variant_name(mem_ops_variant_t variant)
+{
+    if (variant < 0 || variant >= MEM_OPS_VARIANT_COUNT) {
+        return "unknown";
+    }
+    return g_variant_names[variant];
+}
+
+int mem_ops_variant_supported(mem_ops_variant_t variant)
+{
+    switch (variant) {
+        case MEM_OPS_LIBC:
+            return 1;
+#ifdef MEM_OPS_X86
+        case MEM_OPS_SSE2:
+            return __builtin_cpu_supports("sse2");
+        case MEM_OPS_AVX2:
+            return __builtin_cpu_supports("avx2");
+        case MEM_OPS_AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+        case MEM_OPS_ERMS:
+            return cpu_has_erms();
+#endif
+        default:
+            return 0;
+    }
+}
+
+static void build_table(mem_ops_variant_t variant, mem_ops_table_t* ops)
+{
+    ops->copy = copy_libc;
+    ops->fill = fill_libc;
+    ops->fill_ramp = fill_ramp_libc;
+    ops->fill_pattern = fill_pattern_libc;
+    ops->compare = compare_libc;
+    ops->crc32c = crc32c_table;
+
+#ifdef MEM_OPS_X86
+    // Every SIMD variant uses the crc32 instruction when the CPU has it
+    if (variant != MEM_OPS_LIBC && __builtin_cpu_supports("sse4.2")) {
+        ops->crc32c = crc32c_sse42;
+    }
+
+    switch (variant) {
+        case MEM_OPS_SSE2:
+            ops->copy = copy_sse2;
+            ops->fill = fill_sse2;
+            ops->fill_ramp = fill_ramp_sse2;
+            ops->fill_pattern = fill_pattern_sse2;
+            ops->compare = compare_sse2;
+            break;
+        case MEM_OPS_AVX2:
+            ops->copy = copy_avx2;
+            ops->fill = fill_avx2;
+            ops->fill_ramp = fill_ramp_avx2;
+            ops->fill_pattern = fill_pattern_avx2;
+            ops->compare = compare_avx2;
+            break;
+        case MEM_OPS_AVX512:
+            ops->copy = copy_avx512;
+            ops->fill = fill_avx512;
+            ops->fill_ramp = fill_ramp_avx512;
+            ops->fill_pattern = fill_pattern_avx512;
+            ops->compare = compare_avx512;
+            break;
+        case MEM_OPS_ERMS:
+            // String instructions only cover copy/fill; keep the widest vector kernels for the rest
+            ops->copy = copy_erms;
+            ops->fill = fill_erms;
+            ops->fill_ramp = mem_ops_variant_supported(MEM_OPS_AVX2) ? fill_ramp_avx2 : fill_ramp_sse2;
+            ops->fill_pattern = mem_ops_variant_supported(MEM_OPS_AVX2) ? fill_pattern_avx2 : fill_pattern_sse2;
+            ops->compare = mem_ops_variant_supported(MEM_OPS_AVX2) ? compare_avx2 : compare_sse2;
+            break;
+        default:
+            break;
+    }
+#else
+    (void)variant;
+#endif
+}
+
+int mem_ops_select_variant(mem_ops_variant_t variant)
+{
+    if (!mem_ops_variant_supported(variant)) {
+        return -1;
+    }
+
+    mem_ops_table_t ops;
+    build_table(variant, &ops);
+
+    // Each pointer is swapped atomically and every variant is correct on its own,
+    // so threads racing with a switch only see a mix of valid kernels
+    __atomic_store_n(&g_ops.copy, ops.copy, __ATOMIC_RELEASE);
+    __atomic_store_n(&g_ops.fill, ops.fill, __ATOMIC_RELEASE);
+    __atomic_store_n(&g_ops.fill_ramp, ops.fill_ramp, __ATOMIC_RELEASE);
+    __atomic_store_n(&g_ops.fill_pattern, ops.fill_pattern, __ATOMIC_RELEASE);
+    __atomic_store_n(&g_ops.compare, ops.compare, __ATOMIC_RELEASE);
+    __atomic_store_n(&g_ops.crc32c, ops.crc32c, __ATOMIC_RELEASE);
+    g_variant = variant;
+    return 0;
+}
+
+static size_t detect_nt_threshold(void)
+{
+    const char* env = getenv("MEMOPS_NT_THRESHOLD");
+    if (env && *env) {
+        return (size_t)strtoull(env, NULL, 0);
+    }
+
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    long llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (llc > 0) {
+        return (size_t)llc;
+    }
+#endif
+    return MEM_OPS_DEFAULT_NT_SIZE;
+}
+
+static void mem_ops_init_once(void)
+{
+    __atomic_store_n(&g_nt_threshold, detect_nt_threshold(), __ATOMIC_RELAXED);
+    crc32c_build_tables();
+
+    mem_ops_variant_t chosen = MEM_OPS_LIBC;
+    const mem_ops_variant_t preference[] = {
+        MEM_OPS_AVX512, MEM_OPS_AVX2, MEM_OPS_ERMS, MEM_OPS_SSE2
+    };
+    for (size_t i = 0; i < sizeof(preference) / sizeof(preference[0]); i++) {
+        if (mem_ops_variant_supported(preference[i])) {
+            chosen = preference[i];
+            break;
+        }
+    }
+
+    const char* env = getenv("MEMOPS");
+    if (env && *env) {
+        int matched = 0;
+        for (int v = 0; v < MEM_OPS_VARIANT_COUNT; v++) {
+            if (strcasecmp(env, g_variant_names[v]) == 0) {
+                matched = 1;
+                if (mem_ops_variant_supported((mem_ops_variant_t)v)) {
+                    chosen = (mem_ops_variant_t)v;
+                } else {
+                    LOG_WARN("[MEM-OPS] Requested variant '%s' not supported by this CPU, using '%s'\n",
+                           env, mem_ops_variant_name(chosen));
+                }
+                break;
+            }
+        }
+        if (!matched) {
+            LOG_WARN("[MEM-OPS] Unknown MEMOPS variant '%s', using '%s'\n", env, mem_ops_variant_name(chosen));
+        }
+    }
+
+    mem_ops_select_variant(chosen);
+    LOG_INFO("[MEM-OPS] Using %s kernels (non-temporal stores from %zu bytes)\n",
+           mem_ops_variant_name(chosen), nt_threshold());
+}
+
+void mem_ops_init(void)
+{
+    pthread_once(&g_mem_ops_once, mem_ops_init_once);
+}
+
+mem_ops_variant_t mem_ops_get_variant(void)
+{
+    mem_ops_init();
+    return g_variant;
+}
+
+size_t mem_ops_nt_threshold(void)
+{
+    mem_ops_init();
+    return nt_threshold();
+}
+
+void mem_ops_set_nt_threshold(size_t bytes)
+{
+    mem_ops_init();
+    __atomic_store_n(&g_nt_threshold, bytes, __ATOMIC_RELAXED);
+}
+
+static void resolve_copy(void* dst, const void* src, size_t size)
+{
+    mem_ops_init();
+    g_ops.copy(dst, src, size);
+}
+
+static void resolve_fill(void* dst, uint8_t value, size_t size)
+{
+    mem_ops_init();
+    g_ops.fill(dst, value, size);
+}
+
+static void resolve_fill_ramp(void* dst, uint8_t start, size_t size)
+{
+    mem_ops_init();
+    g_ops.fill_ramp(dst, start, size);
+}
+
+static void resolve_fill_pattern(void* dst, const uint8_t* pattern, size_t size)
+{
+    mem_ops_init();
+    g_ops.fill_pattern(dst, pattern, size);
+}
+
+static int resolve_compare(const void* a, const void* b, size_t size)
+{
+    mem_ops_init();
+    return g_ops.compare(a, b, size);
+}
+
+static uint32_t resolve_crc32c(uint32_t crc, const uint8_t* data, size_t size)
+{
+    mem_ops_init();
+    return g_ops.crc32c(crc, data, size);
+}
+
+/* -------------------------------------------------------------------------- */
+/*                               Public kernels                               */
+/* -------------------------------------------------------------------------- */
+void mem_ops_copy(void* dst, const void* src, size_t size)
+{
+    if (size == 0 || dst == src) return;
+    __atomic_load_n(&g_ops.copy, __ATOMIC_ACQUIRE)(dst, src, size);
+}
+
+void mem_ops_move(void* dst, const void* src, size_t size)
+{
+    if (size == 0 || dst == src) return;
+
+    const uint8_t* d = (const uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+    if (d + size <= s || s + size <= d) {
+        __atomic_load_n(&g_ops.copy, __ATOMIC_ACQUIRE)(dst, src, size);
+    } else {
+        // Overlapping ranges are rare here (scratch shuffles); libc handles direction
+        memmove(dst, src, size);
+    }
+}
+
+void mem_ops_fill(void* dst, uint8_t value, size_t size)
+{
+    if (size == 0) return;
+    __atomic_load_n(&g_ops.fill, __ATOMIC_ACQUIRE)(dst, value, size);
+}
+
+void mem_ops_fill_ramp(void* dst, uint8_t start, size_t size)
+{
+    if (size == 0) return;
+    __atomic_load_n(&g_ops.fill_ramp, __ATOMIC_ACQUIRE)(dst, start, size);
+}
+
+void mem_ops_fill_pattern(void* dst, const uint8_t* pattern, size_t size)
+{
+    if (size == 0) return;
+    __atomic_load_n(&g_ops.fill_pattern, __ATOMIC_ACQUIRE)(dst, pattern, size);
+}
+
+int mem_ops_compare(const void* a, const void* b, size_t size)
+{
+    if (size == 0 || a == b) return 0;
+    return __atomic_load_n(&g_ops.compare, __ATOMIC_ACQUIRE)(a, b, size);
+}
+
+uint32_t mem_ops_crc32c(uint32_t crc, const void* data, size_t size)
+{
+    if (size == 0) return crc;
+    return ~__atomic_load_n(&g_ops.crc32c, __ATOMIC_ACQUIRE)(~crc, (const uint8_t*)data, size);
+}
+
+uint32_t mem_ops_copy_crc32c(void* dst, const void* src, size_t size, uint32_t crc)
+{
+    void (*copy)(void*, const void*, size_t) = __atomic_load_n(&g_ops.copy, __ATOMIC_ACQUIRE);
+    uint32_t (*crc_fn)(uint32_t, const uint8_t*, size_t) = __atomic_load_n(&g_ops.crc32c, __ATOMIC_ACQUIRE);
+
+    uint8_t* d = (uint8_t*)dst;
+    const uint8_t* s = (const uint8_t*)src;
+    uint32_t c = ~crc;
+    while (size) {
+        size_t n = size < MEM_OPS_CRC_CHUNK ? size : MEM_OPS_CRC_CHUNK;
+        if (d != s) copy(d, s, n);
+        c = crc_fn(c, d, n);
+        d += n; s += n; size -= n;
+    }
+    return ~c;
+}
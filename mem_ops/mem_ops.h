@@ -0,0 +1,47 @@
+#ifndef MEM_OPS_H
+#define MEM_OPS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Shared copy/fill/compare kernels used by every simulated data path
+// (DMAC512, NoC, DMEM controller, reference HAL). The implementation is
+// picked once at startup from cpuid; MEMOPS=<libc|sse2|avx2|avx512|erms>
+// forces a specific variant and MEMOPS_NT_THRESHOLD=<bytes> overrides the
+// size above which non-temporal stores are used (default: LLC size).
+
+typedef enum {
+    MEM_OPS_LIBC,
+    MEM_OPS_SSE2,
+    MEM_OPS_AVX2,
+    MEM_OPS_AVX512,
+    MEM_OPS_ERMS,
+    MEM_OPS_VARIANT_COUNT
+} mem_ops_variant_t;
+
+// Repeat length of mem_ops_fill_pattern (one 512-bit beat)
+#define MEM_OPS_PATTERN_SIZE 64
+
+// Dispatch setup (called from platform_setup, safe to call repeatedly)
+void mem_ops_init(void);
+mem_ops_variant_t mem_ops_get_variant(void);
+const char* mem_ops_variant_name(mem_ops_variant_t variant);
+int mem_ops_variant_supported(mem_ops_variant_t variant);
+int mem_ops_select_variant(mem_ops_variant_t variant);
+size_t mem_ops_nt_threshold(void);
+void mem_ops_set_nt_threshold(size_t bytes);
+
+// Data movement kernels
+void mem_ops_copy(void* dst, const void* src, size_t size);          // non-overlapping
+void mem_ops_move(void* dst, const void* src, size_t size);          // overlap-safe
+void mem_ops_fill(void* dst, uint8_t value, size_t size);            // dst[i] = value
+void mem_ops_fill_ramp(void* dst, uint8_t start, size_t size);       // dst[i] = start + i
+void mem_ops_fill_pattern(void* dst, const uint8_t* pattern, size_t size); // dst[i] = pattern[i % 64]
+int  mem_ops_compare(const void* a, const void* b, size_t size);     // memcmp semantics
+
+// CRC32C (Castagnoli). Pass 0 to start; pass a previous result to continue.
+uint32_t mem_ops_crc32c(uint32_t crc, const void* data, size_t size);
+// Copy and checksum the copied bytes in one pass over the data
+uint32_t mem_ops_copy_crc32c(void* dst, const void* src, size_t size, uint32_t crc);
+
+#endif
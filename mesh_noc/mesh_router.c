@@ -1,3 +1,4 @@
+#define _GNU_SOURCE
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
@@ -7,11 +8,16 @@
 #include <time.h>
 #include "generated/mem_map.h"
 #include "mesh_routing.h"
+#include "mesh_router.h"
 #include "noc_packet.h"
 #include "platform_init/address_manager.h"
+#include "mem_ops/mem_ops.h"
+#include "platform_init/placement.h"
+#include "tile/tile_coro.h"
 
 // Include interrupt system headers for NoC interrupt packet handling
 #include "../c0_master/c0_controller.h"
+#include "log/log.h"
 
 // External reference to platform context (defined in c0_controller.c)
 extern mesh_platform_t* g_platform_context;
@@ -28,6 +34,9 @@ static pthread_mutex_t destination_arbitration_locks[MAX_DESTINATIONS];
 static int arbitration_counters[MAX_DESTINATIONS] = {0};  // Track access order
 static bool noc_arbitration_initialized = false;
 
+// Traffic counters, updated with relaxed atomics from every sender thread
+static noc_stats_t g_noc_stats;
+
 // Initialize NOC arbitration simulation (call once at startup)
 void noc_init_arbitration(void) {
     if (!noc_arbitration_initialized) {
@@ -36,7 +45,7 @@ void noc_init_arbitration(void) {
             arbitration_counters[i] = 0;
         }
         noc_arbitration_initialized = true;
-        printf("[NOC-INIT] Hardware arbitration simulation initialized\n");
+        LOG_INFO("[NOC-INIT] Hardware arbitration simulation initialized\n");
     }
 }
 
@@ -57,6 +66,40 @@ int get_destination_lock_index(uint64_t dst_addr) {
     return -1;  // No arbitration needed
 }
 
+int noc_addr_to_coords(uint64_t addr, uint8_t* x, uint8_t* y)
+{
+    addr_region_t region = get_address_region(addr);
+    if (region == ADDR_TILE_DLM64 || region == ADDR_TILE_DLM1_512 || region == ADDR_TILE_DMA_REG) {
+        mesh_tile_coords(get_tile_id_from_address(addr), x, y);
+        return 0;
+    }
+    if (region == ADDR_DMEM_512) {
+        mesh_dmem_coords(get_dmem_id_from_address(addr), x, y);
+        return 0;
+    }
+    return -1;
+}
+
+void noc_get_stats(noc_stats_t* stats)
+{
+    stats->packets      = __atomic_load_n(&g_noc_stats.packets, __ATOMIC_RELAXED);
+    stats->bytes        = __atomic_load_n(&g_noc_stats.bytes, __ATOMIC_RELAXED);
+    stats->hop_bytes    = __atomic_load_n(&g_noc_stats.hop_bytes, __ATOMIC_RELAXED);
+    stats->peer_packets = __atomic_load_n(&g_noc_stats.peer_packets, __ATOMIC_RELAXED);
+    stats->cross_node_packets = __atomic_load_n(&g_noc_stats.cross_node_packets, __ATOMIC_RELAXED);
+    stats->cross_node_bytes = __atomic_load_n(&g_noc_stats.cross_node_bytes, __ATOMIC_RELAXED);
+}
+
+void noc_reset_stats(void)
+{
+    __atomic_store_n(&g_noc_stats.packets, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_noc_stats.bytes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_noc_stats.hop_bytes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_noc_stats.peer_packets, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_noc_stats.cross_node_packets, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&g_noc_stats.cross_node_bytes, 0, __ATOMIC_RELAXED);
+}
+
 int noc_send_packet(const noc_packet_t* pkt)
 {
     // Initialize arbitration if not done yet
@@ -68,8 +111,9 @@ int noc_send_packet(const noc_packet_t* pkt)
     calc_xy_route(pkt->hdr.src_x, pkt->hdr.src_y,
                   pkt->hdr.dest_x, pkt->hdr.dest_y, &hops);
 
-    int src_node = pkt->hdr.src_y * 4 + pkt->hdr.src_x;
-    int dst_node = pkt->hdr.dest_y * 4 + pkt->hdr.dest_x;
+    // Traces name the sending router by its mesh coordinates: tiles and
+    // DMEMs share the grid, so a row-major number would not match an id
+    int src_x = pkt->hdr.src_x, src_y = pkt->hdr.src_y;
     
     // Simulate NOC hardware arbitration for destination access
     int lock_index = get_destination_lock_index(pkt->hdr.dst_addr);
@@ -86,35 +130,52 @@ int noc_send_packet(const noc_packet_t* pkt)
         uint8_t* dst_ptr = addr_to_ptr(pkt->hdr.dst_addr);
         
         if (src_ptr && dst_ptr && pkt->hdr.length > 0) {
+            __atomic_fetch_add(&g_noc_stats.packets, 1, __ATOMIC_RELAXED);
+            __atomic_fetch_add(&g_noc_stats.bytes, pkt->hdr.length, __ATOMIC_RELAXED);
+            __atomic_fetch_add(&g_noc_stats.hop_bytes, (uint64_t)pkt->hdr.length * hops, __ATOMIC_RELAXED);
+            if (get_tile_id_from_address(pkt->hdr.src_addr) >= 0 &&
+                get_tile_id_from_address(pkt->hdr.dst_addr) >= 0) {
+                __atomic_fetch_add(&g_noc_stats.peer_packets, 1, __ATOMIC_RELAXED);
+            }
+            if (placement_enabled()) {
+                int src_host = placement_node_of_addr(pkt->hdr.src_addr);
+                int dst_host = placement_node_of_addr(pkt->hdr.dst_addr);
+                if (src_host >= 0 && dst_host >= 0 && src_host != dst_host) {
+                    __atomic_fetch_add(&g_noc_stats.cross_node_packets, 1, __ATOMIC_RELAXED);
+                    __atomic_fetch_add(&g_noc_stats.cross_node_bytes, pkt->hdr.length, __ATOMIC_RELAXED);
+                }
+            }
+
             if (lock_index >= 0) {
                 // Simulate packet arriving at destination router
-                printf("[NOC-PACKET] Node %d packet arrived at destination (addr 0x%lx)\n", 
-                       src_node, pkt->hdr.dst_addr);
+                LOG_TRACE("[NOC-PACKET] Node (%d,%d) packet arrived at destination (addr 0x%lx)\n", 
+                       src_x, src_y, pkt->hdr.dst_addr);
                 
                 // Hardware arbitration - first to acquire lock wins
-                printf("[NOC-ARBITRATION] Node %d requesting arbitration for destination lock %d...\n", 
-                       src_node, lock_index);
+                LOG_TRACE("[NOC-ARBITRATION] Node (%d,%d) requesting arbitration for destination lock %d...\n", 
+                       src_x, src_y, lock_index);
                 
                 struct timespec start_time, arbitration_time, end_time;
                 clock_gettime(CLOCK_MONOTONIC, &start_time);
                 
-                pthread_mutex_lock(&destination_arbitration_locks[lock_index]);
+                // A tile program coroutine waits without holding up its worker
+                coro_mutex_lock(&destination_arbitration_locks[lock_index]);
                 
                 clock_gettime(CLOCK_MONOTONIC, &arbitration_time);
                 int access_order = ++arbitration_counters[lock_index];
                 
-                printf("[NOC-ARBITRATION-WON] Node %d won arbitration for destination lock %d (access #%d)\n", 
-                       src_node, lock_index, access_order);
+                LOG_TRACE("[NOC-ARBITRATION-WON] Node (%d,%d) won arbitration for destination lock %d (access #%d)\n", 
+                       src_x, src_y, lock_index, access_order);
                 
                 // Simulate hardware transfer time (proportional to data size)
                 int transfer_time_us = (pkt->hdr.length * 10);  // 10us per byte
-                printf("[NOC-TRANSFER] Node %d executing transfer (%u bytes, %d us)...\n",
-                       src_node, pkt->hdr.length, transfer_time_us);
+                LOG_TRACE("[NOC-TRANSFER] Node (%d,%d) executing transfer (%u bytes, %d hops, %d us)...\n",
+                       src_x, src_y, pkt->hdr.length, hops, transfer_time_us);
                 
-                usleep(transfer_time_us);
+                coro_sleep_us((unsigned)transfer_time_us);
                 
                 // Perform the actual data transfer
-                memcpy(dst_ptr, src_ptr, pkt->hdr.length);
+                mem_ops_copy(dst_ptr, src_ptr, pkt->hdr.length);
                 
                 clock_gettime(CLOCK_MONOTONIC, &end_time);
                 
@@ -124,16 +185,16 @@ int noc_send_packet(const noc_packet_t* pkt)
                 long total_time_us = (end_time.tv_sec - start_time.tv_sec) * 1000000 + 
                                     (end_time.tv_nsec - start_time.tv_nsec) / 1000;
                 
-                printf("[NOC-COMPLETE] Node %d completed transfer (waited %ld us, total %ld us)\n",
-                       src_node, wait_time_us, total_time_us);
+                LOG_TRACE("[NOC-COMPLETE] Node (%d,%d) completed transfer (waited %ld us, total %ld us)\n",
+                       src_x, src_y, wait_time_us, total_time_us);
                 
-                pthread_mutex_unlock(&destination_arbitration_locks[lock_index]);
+                coro_mutex_unlock(&destination_arbitration_locks[lock_index]);
                 
-                printf("[NOC-RELEASE] Node %d released destination lock %d\n", 
-                       src_node, lock_index);
+                LOG_TRACE("[NOC-RELEASE] Node (%d,%d) released destination lock %d\n", 
+                       src_x, src_y, lock_index);
             } else {
                 // No contention, direct transfer
-                memcpy(dst_ptr, src_ptr, pkt->hdr.length);
+                mem_ops_copy(dst_ptr, src_ptr, pkt->hdr.length);
             }
         }
     }
@@ -15,6 +15,22 @@ int noc_send_packet(const noc_packet_t* pkt);
 /* Initialize NOC arbitration simulation */
 void noc_init_arbitration(void);
 
+/* Mesh coordinates of the tile or DMEM owning an address; -1 if not routable */
+int noc_addr_to_coords(uint64_t addr, uint8_t* x, uint8_t* y);
+
+/* Traffic counters (hop_bytes = payload bytes x links traversed) */
+typedef struct {
+    uint64_t packets;
+    uint64_t bytes;
+    uint64_t hop_bytes;
+    uint64_t peer_packets;    /* tile-to-tile transfers */
+    uint64_t cross_node_packets;  /* source and destination on different host NUMA nodes */
+    uint64_t cross_node_bytes;
+} noc_stats_t;
+
+void noc_get_stats(noc_stats_t* stats);
+void noc_reset_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,4 +11,17 @@ static inline void calc_xy_route(uint8_t src_x, uint8_t src_y,
     *hops = abs(dst_x - src_x) + abs(dst_y - src_y);
 }
 
+/* Mesh placement: tiles on rows 0 and 2, each DMEM directly below its tile */
+static inline void mesh_tile_coords(int tile_id, uint8_t* x, uint8_t* y)
+{
+    *x = (uint8_t)(tile_id % 4);
+    *y = (uint8_t)((tile_id / 4) * 2);
+}
+
+static inline void mesh_dmem_coords(int dmem_id, uint8_t* x, uint8_t* y)
+{
+    *x = (uint8_t)(dmem_id % 4);
+    *y = (uint8_t)((dmem_id / 4) * 2 + 1);
+}
+
 #endif /* MESH_ROUTING_H */
\ No newline at end of file
@@ -15,8 +15,8 @@ typedef struct {
     uint8_t dest_x, dest_y;
     uint8_t src_x,  src_y;
     pkt_type_t type;
-    uint16_t length;          /* payload bytes (multiple of 64)   */
-    uint8_t  hop_count;
+    uint32_t length;          /* payload bytes (multiple of 64)   */
+    uint8_t  hop_count;       /* XY hops, filled in by the sender */
 
     uint64_t src_addr;
     uint64_t dst_addr;
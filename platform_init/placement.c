@@ -0,0 +1,313 @@
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "platform_init/placement.h"
+#include "platform_init/address_manager.h"
+#include "log/log.h"
+
+// From <numaif.h>
+#define MPOL_PREFERRED   1
+#define MPOL_INTERLEAVE  3
+#define MPOL_MF_MOVE     (1 << 1)
+#define MAX_NODES        64
+
+#define DMEM_PAGES_MAX   (DMEM_512_SIZE / 4096)
+
+// DMEM4-7 sit in a second window, not at DMEM_STRIDE steps
+static const uint64_t dmem_bases[NUM_DMEMS] = {
+    DMEM0_512_BASE, DMEM1_512_BASE, DMEM2_512_BASE, DMEM3_512_BASE,
+    DMEM4_512_BASE, DMEM5_512_BASE, DMEM6_512_BASE, DMEM7_512_BASE
+};
+
+static struct {
+    int cpus[PLACEMENT_MAX_CPUS];
+    int ncpus;                          // 0: tile threads are not pinned
+    dmem_placement_t dmem;
+    size_t page;
+    int tile_cpu[NUM_TILES];            // -1 when not pinned
+    int tile_node[NUM_TILES];           // node of the tile's memory, -1 unknown
+    int8_t dmem_node[NUM_DMEMS][DMEM_PAGES_MAX];    // per page
+    int move_failures;
+} g_place;
+
+// "0-3,8,10-11" -> cpus; -1 on a malformed list
+static int parse_cpu_list(const char* s, int* cpus, int max)
+{
+    int n = 0;
+    while (*s) {
+        char* end;
+        long lo = strtol(s, &end, 10);
+        if (end == s || lo < 0) {
+            return -1;
+        }
+        long hi = lo;
+        s = end;
+        if (*s == '-') {
+            hi = strtol(s + 1, &end, 10);
+            if (end == s + 1 || hi < lo) {
+                return -1;
+            }
+            s = end;
+        }
+        for (long c = lo; c <= hi && n < max; c++) {
+            cpus[n++] = (int)c;
+        }
+        if (*s == ',') {
+            s++;
+        } else if (*s) {
+            return -1;
+        }
+    }
+    return n;
+}
+
+int placement_init(void)
+{
+    memset(&g_place, 0, sizeof(g_place));
+    memset(g_place.dmem_node, -1, sizeof(g_place.dmem_node));
+    for (int i = 0; i < NUM_TILES; i++) {
+        g_place.tile_cpu[i] = -1;
+        g_place.tile_node[i] = -1;
+    }
+    long page = sysconf(_SC_PAGESIZE);
+    g_place.page = page > 0 ? (size_t)page : 4096;
+
+    const char* cpus = getenv("TILE_CPUS");
+    if (cpus && *cpus) {
+        int n = parse_cpu_list(cpus, g_place.cpus, PLACEMENT_MAX_CPUS);
+        if (n <= 0) {
+            LOG_WARN("[Place] Ignoring TILE_CPUS='%s': expected a list like 0-3,8\n", cpus);
+        } else {
+            g_place.ncpus = n;
+        }
+    }
+
+    const char* dmem = getenv("DMEM_PLACEMENT");
+    g_place.dmem = g_place.ncpus > 0 ? DMEM_PLACE_MESH : DMEM_PLACE_NONE;
+    if (dmem && *dmem) {
+        if (strcmp(dmem, "mesh") == 0) {
+            g_place.dmem = DMEM_PLACE_MESH;
+        } else if (strcmp(dmem, "interleave") == 0) {
+            g_place.dmem = DMEM_PLACE_INTERLEAVE;
+        } else if (strcmp(dmem, "none") == 0) {
+            g_place.dmem = DMEM_PLACE_NONE;
+        } else {
+            LOG_WARN("[Place] Ignoring DMEM_PLACEMENT='%s': expected mesh, interleave or none\n", dmem);
+        }
+    }
+    return 0;
+}
+
+int placement_enabled(void)
+{
+    return g_place.ncpus > 0;
+}
+
+void* placement_alloc(size_t size)
+{
+    size_t len = (size + g_place.page - 1) & ~(g_place.page - 1);
+    void* mem = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return mem == MAP_FAILED ? NULL : mem;
+}
+
+int placement_pin_thread(int cpu)
+{
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return -1;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0 ? 0 : -1;
+}
+
+int placement_current_node(void)
+{
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0) {
+        return -1;
+    }
+    return (int)node;
+}
+
+// Faults every page in from the calling thread without changing contents
+static void touch_pages(void* addr, size_t size)
+{
+    for (size_t off = 0; off < size; off += g_place.page) {
+        volatile uint8_t* b = (volatile uint8_t*)addr + off;
+        *b = *b;
+    }
+}
+
+static int set_policy(void* addr, size_t size, int mode, const unsigned long* mask)
+{
+    size_t len = (size + g_place.page - 1) & ~(g_place.page - 1);
+    if (syscall(SYS_mbind, addr, len, mode, mask, MAX_NODES + 1, MPOL_MF_MOVE) != 0) {
+        if (__atomic_fetch_add(&g_place.move_failures, 1, __ATOMIC_RELAXED) == 0) {
+            LOG_WARN("[Place] mbind refused (%s); memory stays where first touch puts it\n", strerror(errno));
+        }
+        return -1;
+    }
+    return 0;
+}
+
+int placement_move(void* addr, size_t size, int node)
+{
+    if (!addr || node < 0 || node >= MAX_NODES) {
+        return -1;
+    }
+    unsigned long mask = 1UL << node;
+    int rc = set_policy(addr, size, MPOL_PREFERRED, &mask);
+    touch_pages(addr, size);
+    return rc;
+}
+
+int placement_page_node(const void* addr)
+{
+    void* page = (void*)((uintptr_t)addr & ~(uintptr_t)(g_place.page - 1));
+    int status = -1;
+    if (syscall(SYS_move_pages, 0, 1UL, &page, NULL, &status, 0) != 0 || status < 0) {
+        return -1;
+    }
+    return status;
+}
+
+// Fraction of a region's pages resident on node, as "on/total"
+static void count_pages(const void* addr, size_t size, int node, int* on, int* total)
+{
+    for (size_t off = 0; off < size; off += g_place.page) {
+        *on += placement_page_node((const uint8_t*)addr + off) == node;
+        (*total)++;
+    }
+}
+
+int placement_bind_tile(mesh_platform_t* p, int tile)
+{
+    if (!p || tile < 0 || tile >= p->node_count || tile >= NUM_TILES) {
+        return -1;
+    }
+    tile_core_t* t = &p->nodes[tile];
+    int rc = 0;
+
+    // C0 is the main thread and stays unpinned; its memory goes to
+    // wherever it runs now
+    if (g_place.ncpus > 0) {
+        if (tile > 0) {
+            int cpu = g_place.cpus[(tile - 1) % g_place.ncpus];
+            if (placement_pin_thread(cpu) == 0) {
+                g_place.tile_cpu[tile] = cpu;
+            } else {
+                LOG_WARN("[Place] Tile %d could not be pinned to CPU %d\n", tile, cpu);
+                rc = -1;
+            }
+        }
+        int node = placement_current_node();
+        placement_move(t->dlm64_ptr, DLM_64_SIZE, node);
+        placement_move(t->dlm1_512_ptr, DLM1_512_SIZE, node);
+        placement_move(t->dma_regs_ptr, 0x1000, node);
+    }
+    __atomic_store_n(&g_place.tile_node[tile], placement_page_node(t->dlm1_512_ptr), __ATOMIC_RELAXED);
+    return rc;
+}
+
+static void record_dmem_nodes(mesh_platform_t* p, int d)
+{
+    size_t pages = p->dmems[d].dmem_size / g_place.page;
+    for (size_t i = 0; i < pages && i < DMEM_PAGES_MAX; i++) {
+        g_place.dmem_node[d][i] = (int8_t)placement_page_node(p->dmems[d].dmem_ptr + i * g_place.page);
+    }
+}
+
+int placement_place_dmems(mesh_platform_t* p)
+{
+    if (!p) {
+        return -1;
+    }
+    unsigned long used = 0;
+    for (int i = 0; i < p->node_count && i < NUM_TILES; i++) {
+        if (g_place.tile_node[i] >= 0 && g_place.tile_node[i] < MAX_NODES) {
+            used |= 1UL << g_place.tile_node[i];
+        }
+    }
+
+    int rc = 0;
+    for (int d = 0; d < p->dmem_count && d < NUM_DMEMS; d++) {
+        dmem_module_t* m = &p->dmems[d];
+        if (g_place.dmem == DMEM_PLACE_MESH && d < p->node_count && g_place.tile_node[d] >= 0) {
+            rc |= placement_move(m->dmem_ptr, m->dmem_size, g_place.tile_node[d]);
+        } else if (g_place.dmem == DMEM_PLACE_INTERLEAVE && used) {
+            rc |= set_policy(m->dmem_ptr, m->dmem_size, MPOL_INTERLEAVE, &used);
+            touch_pages(m->dmem_ptr, m->dmem_size);
+        }
+        record_dmem_nodes(p, d);
+    }
+    return rc;
+}
+
+int placement_node_of_addr(uint64_t addr)
+{
+    switch (get_address_region(addr)) {
+        case ADDR_TILE_DLM64:
+        case ADDR_TILE_DLM1_512:
+        case ADDR_TILE_DMA_REG: {
+            int tile = get_tile_id_from_address(addr);
+            return tile >= 0 && tile < NUM_TILES ? __atomic_load_n(&g_place.tile_node[tile], __ATOMIC_RELAXED) : -1;
+        }
+        case ADDR_DMEM_512: {
+            int d = get_dmem_id_from_address(addr);
+            if (d < 0 || d >= NUM_DMEMS) {
+                return -1;
+            }
+            uint64_t off = addr - dmem_bases[d];
+            size_t page = (size_t)(off / g_place.page);
+            return page < DMEM_PAGES_MAX ? g_place.dmem_node[d][page] : -1;
+        }
+        default:
+            return -1;
+    }
+}
+
+int placement_tile_cpu(int tile)
+{
+    return tile >= 0 && tile < NUM_TILES ? g_place.tile_cpu[tile] : -1;
+}
+
+int placement_tile_node(int tile)
+{
+    return tile >= 0 && tile < NUM_TILES ? g_place.tile_node[tile] : -1;
+}
+
+void placement_report(mesh_platform_t* p)
+{
+    static const char* dmem_modes[] = { "left in place", "mesh (node of the tile above)", "interleaved" };
+    if (!placement_enabled()) {
+        LOG_INFO("[Place] Tile threads not pinned (set TILE_CPUS to pin them and place their memory)\n");
+        return;
+    }
+    LOG_INFO("[Place] Tile  CPU  Node  Pages on node\n");
+    for (int i = 0; i < p->node_count && i < NUM_TILES; i++) {
+        tile_core_t* t = &p->nodes[i];
+        int node = g_place.tile_node[i], on = 0, total = 0;
+        count_pages(t->dlm64_ptr, DLM_64_SIZE, node, &on, &total);
+        count_pages(t->dlm1_512_ptr, DLM1_512_SIZE, node, &on, &total);
+        count_pages(t->dma_regs_ptr, 0x1000, node, &on, &total);
+        if (g_place.tile_cpu[i] >= 0) {
+            LOG_INFO("[Place] %4d  %3d  %4d  %d/%d\n", i, g_place.tile_cpu[i], node, on, total);
+        } else {
+            LOG_INFO("[Place] %4d    -  %4d  %d/%d\n", i, node, on, total);
+        }
+    }
+
+    char nodes[NUM_DMEMS * 8] = "";
+    size_t len = 0;
+    for (int d = 0; d < p->dmem_count && d < NUM_DMEMS; d++) {
+        len += (size_t)snprintf(nodes + len, sizeof(nodes) - len, " %d", g_place.dmem_node[d][0]);
+    }
+    LOG_INFO("[Place] DMEMs %s, first page on node%s\n", dmem_modes[g_place.dmem], nodes);
+}
@@ -0,0 +1,61 @@
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+#include <stddef.h>
+#include <stdint.h>
+#include "c0_master/c0_controller.h"
+
+// Host placement of the simulated tiles. Optionally pins each tile thread
+// to a configured CPU and moves the memory that tile owns (DLM_64,
+// DLM1_512, DMA registers) onto that CPU's NUMA node, then first-touches
+// it from the tile thread. DMEMs follow the tile above them in the mesh or
+// are interleaved over the nodes the tiles use.
+//
+//   TILE_CPUS=0-3,8-11          tile n runs on the n-th listed CPU (wraps);
+//                               unset: threads float, memory is left alone
+//   DMEM_PLACEMENT=mesh|interleave|none   default mesh when TILE_CPUS is set
+//
+// Everything is best effort: on a host without NUMA, or when the kernel
+// refuses the policy, memory stays where first touch put it. The memory
+// syscalls are used directly, so libnuma is not needed.
+
+#define PLACEMENT_MAX_CPUS 256
+
+typedef enum {
+    DMEM_PLACE_NONE,
+    DMEM_PLACE_MESH,            // DMEM n on the node of tile n
+    DMEM_PLACE_INTERLEAVE,      // page-interleaved over the tiles' nodes
+} dmem_placement_t;
+
+// Reads the configuration; call before the simulated memory is allocated
+int placement_init(void);
+// Nonzero when tile threads are pinned
+int placement_enabled(void);
+
+// Zeroed, page-aligned memory none of whose pages have been touched yet
+void* placement_alloc(size_t size);
+
+// Called by tile n's own thread (C0 for tile 0): pins it and places the
+// tile's memory; -1 if pinning failed
+int placement_bind_tile(mesh_platform_t* p, int tile);
+// Once every tile is bound
+int placement_place_dmems(mesh_platform_t* p);
+
+// Building blocks, also used by the tests
+int placement_pin_thread(int cpu);
+int placement_current_node(void);
+// Moves [addr, addr+size) onto node and touches every page; -1 if only
+// the touch could be done
+int placement_move(void* addr, size_t size, int node);
+// Host node holding the page at addr, -1 if it is not resident
+int placement_page_node(const void* addr);
+
+// Host node of a simulated address as placed above, -1 when unknown; used
+// by the NoC to count traffic between host nodes
+int placement_node_of_addr(uint64_t addr);
+
+int placement_tile_cpu(int tile);
+int placement_tile_node(int tile);
+
+void placement_report(mesh_platform_t* p);
+
+#endif
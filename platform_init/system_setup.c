@@ -4,10 +4,14 @@
 // #include "c0_master/c0_controller.h"
 #include "platform_init/system_setup.h"
 #include "platform_init/tile_init.h"
+#include "platform_init/placement.h"
 #include "hal_tests/hal_interface.h"
+#include "hal_tests/hal_loader.h"
 #include "address_manager.h"
 #include "interrupt/plic.h"
 #include "tile/tile_dma.h"
+#include "mem_ops/mem_ops.h"
+#include "log/log.h"
 
 // void platform_setup(mesh_platform_t* p)
 // {
@@ -31,6 +35,13 @@ void platform_setup(mesh_platform_t* p)
     p->dmem_count = NUM_DMEMS;
     p->dmems = calloc(NUM_DMEMS, sizeof(dmem_module_t));
 
+    // Select copy/fill kernels for all simulated data paths
+    mem_ops_init();
+
+    // Simulated memory is mapped untouched so the owning tile thread can
+    // place it (TILE_CPUS, DMEM_PLACEMENT)
+    placement_init();
+
     // Initialize address manager for HAL/driver use
     address_manager_init(p);
     
@@ -38,21 +49,21 @@ void platform_setup(mesh_platform_t* p)
     for (int i = 0; i < NUM_TILES; i++) {
         // 1. DLM_64 (32 KiB scratchpad memory)
         p->nodes[i].dlm64_base_addr = TILE0_BASE + i * TILE_STRIDE + DLM_64_OFFSET;
-        p->nodes[i].dlm64_ptr = calloc(DLM_64_SIZE, 1);
+        p->nodes[i].dlm64_ptr = placement_alloc(DLM_64_SIZE);
         register_memory_region(p->nodes[i].dlm64_base_addr, 
                              p->nodes[i].dlm64_ptr, 
                              DLM_64_SIZE);
         
         // 2. DLM1_512 (128 KiB buffer memory)
         p->nodes[i].dlm1_512_base_addr = TILE0_BASE + i * TILE_STRIDE + DLM1_512_OFFSET;
-        p->nodes[i].dlm1_512_ptr = calloc(DLM1_512_SIZE, 1);
+        p->nodes[i].dlm1_512_ptr = placement_alloc(DLM1_512_SIZE);
         register_memory_region(p->nodes[i].dlm1_512_base_addr, 
                              p->nodes[i].dlm1_512_ptr, 
                              DLM1_512_SIZE);
         
         // 3. DMA Registers (4 KiB control block)
         p->nodes[i].dma_reg_base_addr = TILE0_BASE + i * TILE_STRIDE + DMA_REG_OFFSET;
-        p->nodes[i].dma_regs_ptr = calloc(0x1000, 1);  // 4 KiB for DMA registers
+        p->nodes[i].dma_regs_ptr = placement_alloc(0x1000);  // 4 KiB for DMA registers
         register_memory_region(p->nodes[i].dma_reg_base_addr, 
                              p->nodes[i].dma_regs_ptr, 
                              0x1000);
@@ -79,7 +90,7 @@ void platform_setup(mesh_platform_t* p)
             p->nodes[i].dmac512_initialized = true;
         } else {
             p->nodes[i].dmac512_initialized = false;
-            printf("Warning: Failed to initialize DMAC512 for tile %d\n", i);
+            LOG_WARN("Warning: Failed to initialize DMAC512 for tile %d\n", i);
         }
     }
 
@@ -91,11 +102,13 @@ void platform_setup(mesh_platform_t* p)
 
     for (int i = 0; i < NUM_DMEMS; i++) {
         p->dmems[i].id = i;
+        p->dmems[i].x = (i % 4);
+        p->dmems[i].y = (i / 4) * 2 + 1; /* DMEMs on rows 1 and 3 */
         p->dmems[i].dmem_base_addr = dmem_bases[i];
         p->dmems[i].dmem_size = DMEM_512_SIZE;
         
         // Allocate simulated memory for DMEM
-        p->dmems[i].dmem_ptr = calloc(DMEM_512_SIZE, 1);
+        p->dmems[i].dmem_ptr = placement_alloc(DMEM_512_SIZE);
         
         // Register memory with address manager
         register_memory_region(p->dmems[i].dmem_base_addr, 
@@ -113,8 +126,7 @@ void platform_setup(mesh_platform_t* p)
 
     // platform_init_tiles(p->nodes, p->node_count);
 
-    hal_use_reference_impl();
-    hal_set_platform(p);
+    hal_select_impl(p);
     
 
     // Initialize PLIC memory regions
@@ -138,9 +150,9 @@ void platform_setup(mesh_platform_t* p)
     // Setup bidirectional interrupt capabilities (replaces hardcoded setup)
     PLIC_setup_bidirectional_interrupts();
     
-    printf("[Platform Setup] Enhanced PLIC integration complete with bidirectional support\n");
+    LOG_INFO("[Platform Setup] Enhanced PLIC integration complete with bidirectional support\n");
     
-    printf("[Platform Setup] (Step 2)\n");
+    LOG_INFO("[Platform Setup] (Step 2)\n");
 
 }
 
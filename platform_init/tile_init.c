@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include "c0_master/c0_controller.h"
+#include "log/log.h"
 
 void platform_init_tiles(tile_core_t* tiles, int count)
 {
@@ -7,6 +8,6 @@ void platform_init_tiles(tile_core_t* tiles, int count)
         tiles[i].id = i;
         tiles[i].x  = (i % 4);
         tiles[i].y  = (i / 4) * 2; /* nodes on rows 0 and 2 */
-        printf("Init Node%d at (%d,%d)\n", i, tiles[i].x, tiles[i].y);
+        LOG_DEBUG("Init Node%d at (%d,%d)\n", i, tiles[i].x, tiles[i].y);
     }
 }
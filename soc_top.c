@@ -4,13 +4,18 @@
 #include "c0_master/c0_controller.h"
 #include "platform_init/system_setup.h"
 #include "mesh_noc/mesh_router.h" /* include implementation */
+#include "log/log.h"
 
 
 void test_plic_functionality(mesh_platform_t* platform);
 
 int main(int argc, char** argv)
 {
-    if (getenv("TRACE")) noc_trace_enabled = 1;
+    log_init();
+    if (getenv("TRACE")) {
+        noc_trace_enabled = 1;
+        log_set_level(LOG_LEVEL_TRACE);
+    }
     mesh_platform_t platform = {0};
     platform_setup(&platform);
     
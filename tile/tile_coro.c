@@ -0,0 +1,959 @@
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+#include "tile/tile_coro.h"
+#include "log/log.h"
+
+#define CORO_LOCK_SPINS     16      // yields before coro_mutex_lock backs off
+#define CORO_LOCK_BACKOFF   20      // us between later attempts
+#define CORO_WAIT_POLL_US   50      // condition and join polls inside a coroutine
+
+typedef enum {
+    CORO_READY,
+    CORO_SLEEPING,
+    CORO_LOCKING,               // simulated time: waits for the coordinator's grant
+    CORO_DONE
+} coro_state_t;
+
+typedef struct coro {
+    ucontext_t ctx;
+    coro_fn fn;
+    void* arg;
+    uint8_t* map;               // stack mapping, guard page first
+    size_t map_size;
+    coro_state_t state;
+    void* log_capture;          // its log capture while switched out
+    uint64_t wake_ns;           // simulated: when it next runs
+    struct coro* next;
+    // Simulated time
+    int id;
+    int worker;
+    uint64_t key;               // orders coroutines due at the same time
+    uint32_t events;
+    void* lock;                 // CORO_LOCKING
+    int lock_excl;
+    int lock_waited;
+} coro_t;
+
+typedef struct {
+    const void* addr;
+    uint32_t id;                // first-use order, the same every run
+    int writer, readers;
+    int dirty;                  // released during the current step
+    coro_t* head;               // waiters, first come first served
+    coro_t* tail;
+} sim_lock_t;
+
+typedef struct coro_sim {
+    uint64_t seed;
+    uint64_t now;
+    pthread_mutex_t lock;       // pending, lock table, dirty list
+    pthread_cond_t idle;
+    int pending;                // workers still running the current step
+    coro_t** all;               // by id; NULL once finished
+    coro_t** heap;              // due coroutines by (wake_ns, key, id)
+    coro_t** step;
+    int count, cap, heap_n;
+    sim_lock_t locks[CORO_SIM_LOCKS];
+    uint32_t nlocks;
+    uint32_t dirty[CORO_SIM_LOCKS];
+    int ndirty;
+    int table_full;
+    coro_trace_fn trace;
+    void* trace_arg;
+    uint64_t steps, parallel_steps, lock_waits, hash;
+} coro_sim_t;
+
+typedef struct coro_worker {
+    coro_pool_t* pool;
+    pthread_t thread;
+    pthread_mutex_t lock;       // run and sleep lists, stopping
+    pthread_cond_t work;
+    coro_t* run_head;
+    coro_t* run_tail;
+    coro_t* sleepers;           // by wake time
+    int stopping;
+    ucontext_t sched;
+    coro_t* current;
+    uint64_t spawned, finished, resumes, yields, sleeps;
+} coro_worker_t;
+
+static __thread coro_worker_t* tl_worker;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void run_append(coro_worker_t* w, coro_t* c)
+{
+    c->next = NULL;
+    if (w->run_tail) {
+        w->run_tail->next = c;
+    } else {
+        w->run_head = c;
+    }
+    w->run_tail = c;
+}
+
+static void sleep_insert(coro_worker_t* w, coro_t* c)
+{
+    coro_t** at = &w->sleepers;
+    while (*at && (*at)->wake_ns <= c->wake_ns) {
+        at = &(*at)->next;
+    }
+    c->next = *at;
+    *at = c;
+}
+
+static void wake_due(coro_worker_t* w, uint64_t now)
+{
+    while (w->sleepers && w->sleepers->wake_ns <= now) {
+        coro_t* c = w->sleepers;
+        w->sleepers = c->next;
+        run_append(w, c);
+    }
+}
+
+static void coro_free(coro_t* c)
+{
+    log_capture_free(c->log_capture);
+    munmap(c->map, c->map_size);
+    free(c);
+}
+
+// Back on the worker's own stack after c switched out
+static void park(coro_worker_t* w, coro_t* c)
+{
+    switch (c->state) {
+        case CORO_READY:
+            run_append(w, c);
+            break;
+        case CORO_SLEEPING:
+            sleep_insert(w, c);
+            break;
+        case CORO_LOCKING:      // simulated time only
+            break;
+        case CORO_DONE: {
+            coro_pool_t* pool = w->pool;
+            w->finished++;
+            coro_free(c);
+            pthread_mutex_lock(&pool->lock);
+            if (--pool->live == 0) {
+                pthread_cond_broadcast(&pool->done);
+            }
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+    }
+}
+
+// Simulated time: the worker tells the coordinator once its share of the
+// step has switched out
+static void sim_ran(coro_worker_t* w)
+{
+    if (w->run_head) {
+        return;
+    }
+    coro_sim_t* s = w->pool->sim;
+    pthread_mutex_lock(&s->lock);
+    if (--s->pending == 0) {
+        pthread_cond_signal(&s->idle);
+    }
+    pthread_mutex_unlock(&s->lock);
+}
+
+static void* worker_main(void* arg)
+{
+    coro_worker_t* w = arg;
+    tl_worker = w;
+
+    pthread_mutex_lock(&w->lock);
+    while (true) {
+        if (!w->pool->sim) {
+            wake_due(w, now_ns());
+        }
+        coro_t* c = w->run_head;
+        if (c) {
+            w->run_head = c->next;
+            if (!w->run_head) {
+                w->run_tail = NULL;
+            }
+            w->resumes++;
+            pthread_mutex_unlock(&w->lock);
+
+            // The log capture follows the coroutine, not the worker
+            w->current = c;
+            log_capture_swap(&c->log_capture);
+            swapcontext(&w->sched, &c->ctx);
+            log_capture_swap(&c->log_capture);
+            w->current = NULL;
+
+            pthread_mutex_lock(&w->lock);
+            if (w->pool->sim) {
+                sim_ran(w);
+            } else {
+                park(w, c);
+            }
+            continue;
+        }
+        if (w->stopping && !w->sleepers) {
+            break;
+        }
+        if (w->sleepers) {
+            uint64_t at = w->sleepers->wake_ns;
+            struct timespec ts = { (time_t)(at / 1000000000ULL), (long)(at % 1000000000ULL) };
+            pthread_cond_timedwait(&w->work, &w->lock, &ts);
+        } else {
+            pthread_cond_wait(&w->work, &w->lock);
+        }
+    }
+    pthread_mutex_unlock(&w->lock);
+    return NULL;
+}
+
+// Switches back to the worker, which files c according to state
+static void switch_out(coro_worker_t* w, coro_state_t state)
+{
+    coro_t* c = w->current;
+    c->state = state;
+    swapcontext(&c->ctx, &w->sched);
+}
+
+static void coro_entry(void)
+{
+    coro_worker_t* w = tl_worker;
+    coro_t* c = w->current;
+    c->fn(c->arg);
+    switch_out(w, CORO_DONE);   // never resumed
+}
+
+// ---- Simulated time -------------------------------------------------------
+
+static uint64_t mix64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static int due_before(const coro_t* a, const coro_t* b)
+{
+    if (a->wake_ns != b->wake_ns) {
+        return a->wake_ns < b->wake_ns;
+    }
+    if (a->key != b->key) {
+        return a->key < b->key;
+    }
+    return a->id < b->id;
+}
+
+// Schedules c at simulated time at with a fresh seeded tie key
+static void sim_push(coro_sim_t* s, coro_t* c, uint64_t at)
+{
+    c->wake_ns = at;
+    c->key = mix64(s->seed ^ mix64(((uint64_t)(uint32_t)c->id << 32) | c->events++));
+    int i = s->heap_n++;
+    while (i > 0 && due_before(c, s->heap[(i - 1) / 2])) {
+        s->heap[i] = s->heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    s->heap[i] = c;
+}
+
+static coro_t* sim_pop(coro_sim_t* s)
+{
+    coro_t* top = s->heap[0];
+    coro_t* last = s->heap[--s->heap_n];
+    int i = 0;
+    while (true) {
+        int child = 2 * i + 1;
+        if (child >= s->heap_n) {
+            break;
+        }
+        if (child + 1 < s->heap_n && due_before(s->heap[child + 1], s->heap[child])) {
+            child++;
+        }
+        if (!due_before(s->heap[child], last)) {
+            break;
+        }
+        s->heap[i] = s->heap[child];
+        i = child;
+    }
+    if (s->heap_n > 0) {
+        s->heap[i] = last;
+    }
+    return top;
+}
+
+static void sim_trace(coro_sim_t* s, const coro_t* c, coro_event_t kind, uint64_t arg)
+{
+    coro_trace_t ev = { s->now, c->id, kind, arg };
+    uint64_t words[4] = { ev.ns, (uint64_t)ev.coro, (uint64_t)ev.kind, ev.arg };
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 8; b++) {
+            s->hash = (s->hash ^ ((words[i] >> (8 * b)) & 0xFF)) * 0x100000001B3ULL;
+        }
+    }
+    LOG_TRACE("[Coro-Sim] %llu ns: coro %d event %d arg %llu\n",
+              (unsigned long long)ev.ns, ev.coro, (int)ev.kind, (unsigned long long)ev.arg);
+    if (s->trace) {
+        s->trace(&ev, s->trace_arg);
+    }
+}
+
+// Lock state by address; NULL when the table is full
+static sim_lock_t* sim_lock_get(coro_sim_t* s, const void* addr, int create)
+{
+    uint32_t i = (uint32_t)mix64((uint64_t)(uintptr_t)addr) & (CORO_SIM_LOCKS - 1);
+    for (uint32_t n = 0; n < CORO_SIM_LOCKS; n++, i = (i + 1) & (CORO_SIM_LOCKS - 1)) {
+        sim_lock_t* l = &s->locks[i];
+        if (l->addr == addr) {
+            return l;
+        }
+        if (!l->addr) {
+            if (!create || s->nlocks >= CORO_SIM_LOCKS * 3 / 4) {
+                return NULL;
+            }
+            l->addr = addr;
+            l->id = s->nlocks++;
+            return l;
+        }
+    }
+    return NULL;
+}
+
+static int sim_lock_free(const sim_lock_t* l, int exclusive)
+{
+    return exclusive ? !l->writer && !l->readers : !l->writer;
+}
+
+static void sim_grant(coro_sim_t* s, sim_lock_t* l, coro_t* c)
+{
+    if (c->lock_excl) {
+        l->writer = 1;
+    } else {
+        l->readers++;
+    }
+    sim_trace(s, c, CORO_EV_LOCK_GRANT, l->id);
+    sim_push(s, c, s->now);
+}
+
+static void sim_lock_request(coro_sim_t* s, coro_t* c)
+{
+    sim_lock_t* l = sim_lock_get(s, c->lock, 1);
+    if (!l) {
+        // Untracked: the coroutine takes the lock itself, outside the order
+        if (!s->table_full) {
+            LOG_WARN("[Coro] More than %d locks in one simulation; lock order no longer deterministic\n",
+                     CORO_SIM_LOCKS * 3 / 4);
+            s->table_full = 1;
+        }
+        sim_push(s, c, s->now);
+        return;
+    }
+    if (!l->head && sim_lock_free(l, c->lock_excl)) {
+        sim_grant(s, l, c);
+        return;
+    }
+    c->lock_waited = 1;
+    c->next = NULL;
+    if (l->tail) {
+        l->tail->next = c;
+    } else {
+        l->head = c;
+    }
+    l->tail = c;
+    s->lock_waits++;
+    sim_trace(s, c, CORO_EV_LOCK_WAIT, l->id);
+}
+
+static int by_lock_id(const void* a, const void* b)
+{
+    uint32_t x = (*(sim_lock_t* const*)a)->id, y = (*(sim_lock_t* const*)b)->id;
+    return (x > y) - (x < y);
+}
+
+// Hands locks released during the step to their waiters, in lock-id order
+// so the trace does not depend on which worker released first
+static void sim_settle_releases(coro_sim_t* s)
+{
+    sim_lock_t* released[CORO_SIM_LOCKS];
+    int n = s->ndirty;
+    for (int i = 0; i < n; i++) {
+        released[i] = &s->locks[s->dirty[i]];
+    }
+    qsort(released, (size_t)n, sizeof(released[0]), by_lock_id);
+    for (int i = 0; i < n; i++) {
+        sim_lock_t* l = released[i];
+        l->dirty = 0;
+        while (l->head && sim_lock_free(l, l->head->lock_excl)) {
+            coro_t* c = l->head;
+            l->head = c->next;
+            if (!l->head) {
+                l->tail = NULL;
+            }
+            sim_grant(s, l, c);
+        }
+    }
+    s->ndirty = 0;
+}
+
+// Called from a coroutine on simulated time; the grant happens next step
+static void sim_release(coro_sim_t* s, const void* addr)
+{
+    pthread_mutex_lock(&s->lock);
+    sim_lock_t* l = sim_lock_get(s, addr, 0);
+    if (l) {
+        if (l->writer) {
+            l->writer = 0;
+        } else if (l->readers > 0) {
+            l->readers--;
+        }
+        if (!l->dirty) {
+            l->dirty = 1;
+            s->dirty[s->ndirty++] = (uint32_t)(l - s->locks);
+        }
+    }
+    pthread_mutex_unlock(&s->lock);
+}
+
+static void sim_finish(coro_pool_t* pool, coro_t* c)
+{
+    coro_sim_t* s = pool->sim;
+    coro_worker_t* w = &pool->w[c->worker];
+    sim_trace(s, c, CORO_EV_DONE, 0);
+    s->all[c->id] = NULL;
+    coro_free(c);
+    pthread_mutex_lock(&w->lock);
+    w->finished++;
+    pthread_mutex_unlock(&w->lock);
+    pthread_mutex_lock(&pool->lock);
+    pool->live--;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// The coordinator: one step per distinct simulated time (and again at the
+// same time while coroutines yield or are granted locks)
+static int sim_run(coro_pool_t* pool, int timeout_ms)
+{
+    coro_sim_t* s = pool->sim;
+    uint64_t deadline = now_ns() + (uint64_t)timeout_ms * 1000000ULL;
+    while (true) {
+        pthread_mutex_lock(&pool->lock);
+        int live = pool->live;
+        pthread_mutex_unlock(&pool->lock);
+        if (live == 0) {
+            return 0;
+        }
+        if (s->heap_n == 0) {
+            LOG_ERROR("[Coro] Simulation stuck at %llu ns: %d programs wait on locks held by none of them\n",
+                      (unsigned long long)s->now, live);
+            return -1;
+        }
+        if (now_ns() > deadline) {
+            return -1;
+        }
+
+        s->now = s->heap[0]->wake_ns;
+        int n = 0;
+        while (s->heap_n > 0 && s->heap[0]->wake_ns == s->now) {
+            s->step[n++] = sim_pop(s);
+        }
+
+        // Each worker runs its share of the step in key order; it gets the
+        // whole share at once so it cannot report back half way
+        int busy[CORO_MAX_WORKERS] = { 0 };
+        int workers = 0;
+        for (int i = 0; i < n; i++) {
+            workers += busy[s->step[i]->worker]++ == 0;
+        }
+        s->pending = workers;
+        s->steps++;
+        s->parallel_steps += workers > 1;
+        for (int k = 0; k < pool->workers; k++) {
+            if (!busy[k]) {
+                continue;
+            }
+            coro_worker_t* w = &pool->w[k];
+            pthread_mutex_lock(&w->lock);
+            for (int i = 0; i < n; i++) {
+                if (s->step[i]->worker == k) {
+                    run_append(w, s->step[i]);
+                }
+            }
+            pthread_cond_signal(&w->work);
+            pthread_mutex_unlock(&w->lock);
+        }
+        pthread_mutex_lock(&s->lock);
+        while (s->pending > 0) {
+            pthread_cond_wait(&s->idle, &s->lock);
+        }
+        pthread_mutex_unlock(&s->lock);
+
+        // Settle in key order; releases first, so queued waiters keep
+        // their place ahead of this step's new requests
+        sim_settle_releases(s);
+        for (int i = 0; i < n; i++) {
+            coro_t* c = s->step[i];
+            switch (c->state) {
+                case CORO_READY:
+                    sim_trace(s, c, CORO_EV_YIELD, 0);
+                    sim_push(s, c, s->now);
+                    break;
+                case CORO_SLEEPING:
+                    sim_trace(s, c, CORO_EV_SLEEP, c->wake_ns - s->now);
+                    sim_push(s, c, c->wake_ns);
+                    break;
+                case CORO_LOCKING:
+                    sim_lock_request(s, c);
+                    break;
+                case CORO_DONE:
+                    sim_finish(pool, c);
+                    break;
+            }
+        }
+    }
+}
+
+// ---- Pool -----------------------------------------------------------------
+
+static int pool_init(coro_pool_t* pool, int workers, size_t stack_size, int sim, uint64_t seed)
+{
+    if (!pool || workers <= 0 || workers > CORO_MAX_WORKERS) {
+        return -1;
+    }
+    memset(pool, 0, sizeof(*pool));
+    long page = sysconf(_SC_PAGESIZE);
+    size_t pg = page > 0 ? (size_t)page : 4096;
+    stack_size = stack_size ? stack_size : CORO_STACK_SIZE;
+    pool->stack_size = (stack_size + pg - 1) & ~(pg - 1);
+    pool->w = calloc((size_t)workers, sizeof(coro_worker_t));
+    if (!pool->w) {
+        return -1;
+    }
+    if (sim) {
+        pool->sim = calloc(1, sizeof(coro_sim_t));
+        if (!pool->sim) {
+            free(pool->w);
+            pool->w = NULL;
+            return -1;
+        }
+        pool->sim->seed = seed;
+        pool->sim->hash = 0xCBF29CE484222325ULL;
+        pthread_mutex_init(&pool->sim->lock, NULL);
+        pthread_cond_init(&pool->sim->idle, NULL);
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    for (int i = 0; i < workers; i++) {
+        coro_worker_t* w = &pool->w[i];
+        w->pool = pool;
+        pthread_mutex_init(&w->lock, NULL);
+        pthread_cond_init(&w->work, &attr);
+        if (pthread_create(&w->thread, NULL, worker_main, w) != 0) {
+            LOG_ERROR("[Coro] Failed to start worker %d\n", i);
+            pool->workers = i;
+            coro_pool_destroy(pool);
+            pthread_condattr_destroy(&attr);
+            return -1;
+        }
+    }
+    pthread_condattr_destroy(&attr);
+    pool->workers = workers;
+    return 0;
+}
+
+int coro_pool_init(coro_pool_t* pool, int workers, size_t stack_size)
+{
+    const char* env = getenv("SIM_SEED");
+    if (env && *env) {
+        char* end;
+        unsigned long long seed = strtoull(env, &end, 0);
+        if (*end == '\0') {
+            return pool_init(pool, workers, stack_size, 1, seed);
+        }
+        LOG_WARN("[Coro] Ignoring SIM_SEED='%s': expected a number\n", env);
+    }
+    return pool_init(pool, workers, stack_size, 0, 0);
+}
+
+int coro_pool_init_wall(coro_pool_t* pool, int workers, size_t stack_size)
+{
+    return pool_init(pool, workers, stack_size, 0, 0);
+}
+
+int coro_pool_init_sim(coro_pool_t* pool, int workers, size_t stack_size, uint64_t seed)
+{
+    return pool_init(pool, workers, stack_size, 1, seed);
+}
+
+// Simulated time: gives c an id and makes it due now
+static int sim_add(coro_pool_t* pool, coro_t* c)
+{
+    coro_sim_t* s = pool->sim;
+    if (s->count == s->cap) {
+        int cap = s->cap ? s->cap * 2 : 64;
+        coro_t** all = realloc(s->all, (size_t)cap * sizeof(coro_t*));
+        if (!all) {
+            return -1;
+        }
+        s->all = all;
+        coro_t** heap = realloc(s->heap, (size_t)cap * sizeof(coro_t*));
+        if (!heap) {
+            return -1;
+        }
+        s->heap = heap;
+        coro_t** step = realloc(s->step, (size_t)cap * sizeof(coro_t*));
+        if (!step) {
+            return -1;
+        }
+        s->step = step;
+        s->cap = cap;
+    }
+    c->id = s->count;
+    c->worker = c->id % pool->workers;
+    s->all[s->count++] = c;
+    sim_push(s, c, s->now);
+    return 0;
+}
+
+int coro_spawn(coro_pool_t* pool, coro_fn fn, void* arg)
+{
+    if (!pool || !pool->w || !fn) {
+        return -1;
+    }
+    // The coordinator owns the schedule while it runs
+    if (pool->sim && coro_active()) {
+        return -1;
+    }
+    coro_t* c = calloc(1, sizeof(coro_t));
+    if (!c) {
+        return -1;
+    }
+    long page = sysconf(_SC_PAGESIZE);
+    size_t guard = page > 0 ? (size_t)page : 4096;
+    c->map_size = pool->stack_size + guard;
+    c->map = mmap(NULL, c->map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (c->map == MAP_FAILED) {
+        free(c);
+        return -1;
+    }
+    mprotect(c->map, guard, PROT_NONE);
+
+    c->fn = fn;
+    c->arg = arg;
+    c->state = CORO_READY;
+    getcontext(&c->ctx);
+    c->ctx.uc_stack.ss_sp = c->map + guard;
+    c->ctx.uc_stack.ss_size = pool->stack_size;
+    c->ctx.uc_link = NULL;
+    makecontext(&c->ctx, coro_entry, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->sim) {
+        int rc = sim_add(pool, c);
+        if (rc == 0) {
+            pool->live++;
+            pool->w[c->worker].spawned++;
+        }
+        pthread_mutex_unlock(&pool->lock);
+        if (rc != 0) {
+            coro_free(c);
+        }
+        return rc;
+    }
+    pool->live++;
+    coro_worker_t* w = &pool->w[pool->next];
+    pool->next = (pool->next + 1) % pool->workers;
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_mutex_lock(&w->lock);
+    w->spawned++;
+    run_append(w, c);
+    pthread_cond_signal(&w->work);
+    pthread_mutex_unlock(&w->lock);
+    return 0;
+}
+
+int coro_pool_wait(coro_pool_t* pool, int timeout_ms)
+{
+    if (!pool) {
+        return -1;
+    }
+    if (pool->sim) {
+        return sim_run(pool, timeout_ms);
+    }
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    int rc = 0;
+    pthread_mutex_lock(&pool->lock);
+    while (pool->live > 0 && rc == 0) {
+        rc = pthread_cond_timedwait(&pool->done, &pool->lock, &deadline);
+    }
+    int live = pool->live;
+    pthread_mutex_unlock(&pool->lock);
+    return live == 0 ? 0 : -1;
+}
+
+void coro_pool_destroy(coro_pool_t* pool)
+{
+    if (!pool || !pool->w) {
+        return;
+    }
+    for (int i = 0; i < pool->workers; i++) {
+        coro_worker_t* w = &pool->w[i];
+        pthread_mutex_lock(&w->lock);
+        w->stopping = 1;
+        pthread_cond_signal(&w->work);
+        pthread_mutex_unlock(&w->lock);
+    }
+    for (int i = 0; i < pool->workers; i++) {
+        coro_worker_t* w = &pool->w[i];
+        pthread_join(w->thread, NULL);
+        pthread_mutex_destroy(&w->lock);
+        pthread_cond_destroy(&w->work);
+    }
+    if (pool->sim) {
+        // Programs a failed run left suspended
+        coro_sim_t* s = pool->sim;
+        for (int i = 0; i < s->count; i++) {
+            if (s->all[i]) {
+                coro_free(s->all[i]);
+            }
+        }
+        free(s->all);
+        free(s->heap);
+        free(s->step);
+        pthread_mutex_destroy(&s->lock);
+        pthread_cond_destroy(&s->idle);
+        free(s);
+        pool->sim = NULL;
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->done);
+    free(pool->w);
+    pool->w = NULL;
+}
+
+void coro_pool_get_stats(coro_pool_t* pool, coro_stats_t* stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    for (int i = 0; pool && pool->w && i < pool->workers; i++) {
+        coro_worker_t* w = &pool->w[i];
+        pthread_mutex_lock(&w->lock);
+        stats->spawned += w->spawned;
+        stats->finished += w->finished;
+        stats->resumes += w->resumes;
+        stats->yields += w->yields;
+        stats->sleeps += w->sleeps;
+        stats->workers_used += w->resumes > 0;
+        pthread_mutex_unlock(&w->lock);
+    }
+    if (pool && pool->sim) {
+        coro_sim_t* s = pool->sim;
+        stats->sim_ns = s->now;
+        stats->steps = s->steps;
+        stats->parallel_steps = s->parallel_steps;
+        stats->lock_waits = s->lock_waits;
+        stats->trace_hash = s->hash;
+    }
+}
+
+void coro_pool_set_trace(coro_pool_t* pool, coro_trace_fn fn, void* arg)
+{
+    if (pool && pool->sim) {
+        pool->sim->trace = fn;
+        pool->sim->trace_arg = arg;
+    }
+}
+
+// ---- Wait points ----------------------------------------------------------
+
+int coro_active(void)
+{
+    return tl_worker && tl_worker->current;
+}
+
+const void* coro_self(void)
+{
+    static __thread char self;
+    return coro_active() ? (const void*)tl_worker->current : (const void*)&self;
+}
+
+int coro_sim_active(void)
+{
+    return coro_active() && tl_worker->pool->sim;
+}
+
+uint64_t coro_now_ns(void)
+{
+    return coro_sim_active() ? tl_worker->pool->sim->now : now_ns();
+}
+
+void coro_yield(void)
+{
+    coro_worker_t* w = tl_worker;
+    if (!w || !w->current) {
+        sched_yield();
+        return;
+    }
+    w->yields++;
+    switch_out(w, CORO_READY);
+}
+
+void coro_sleep_us(unsigned us)
+{
+    coro_worker_t* w = tl_worker;
+    if (!w || !w->current) {
+        struct timespec ts = { (time_t)(us / 1000000u), (long)(us % 1000000u) * 1000L };
+        while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+        }
+        return;
+    }
+    w->sleeps++;
+    uint64_t base = w->pool->sim ? w->pool->sim->now : now_ns();
+    w->current->wake_ns = base + (uint64_t)us * 1000ULL;
+    switch_out(w, CORO_SLEEPING);
+}
+
+// The holder may be a coroutine on this very worker: never block it
+static void lock_backoff(int attempt)
+{
+    if (attempt < CORO_LOCK_SPINS) {
+        coro_yield();
+    } else {
+        coro_sleep_us(CORO_LOCK_BACKOFF);
+    }
+}
+
+static int try_lock(void* l, int rw, int exclusive)
+{
+    if (!rw) {
+        return pthread_mutex_trylock(l);
+    }
+    return exclusive ? pthread_rwlock_trywrlock(l) : pthread_rwlock_tryrdlock(l);
+}
+
+// Simulated time: the coordinator decides who gets the lock; a thread
+// outside the simulation can still hold it for a moment
+static int sim_lock(void* l, int rw, int exclusive)
+{
+    coro_worker_t* w = tl_worker;
+    coro_t* c = w->current;
+    c->lock = l;
+    c->lock_excl = exclusive;
+    c->lock_waited = 0;
+    switch_out(w, CORO_LOCKING);
+    while (try_lock(l, rw, exclusive) != 0) {
+        sched_yield();
+    }
+    return c->lock_waited;
+}
+
+int coro_mutex_lock(pthread_mutex_t* m)
+{
+    if (!coro_active()) {
+        if (pthread_mutex_trylock(m) == 0) {
+            return 0;
+        }
+        pthread_mutex_lock(m);
+        return 1;
+    }
+    if (tl_worker->pool->sim) {
+        return sim_lock(m, 0, 1);
+    }
+    int i = 0;
+    for (; pthread_mutex_trylock(m) != 0; i++) {
+        lock_backoff(i);
+    }
+    return i > 0;
+}
+
+int coro_rwlock_lock(pthread_rwlock_t* l, int exclusive)
+{
+    if (!coro_active()) {
+        if (try_lock(l, 1, exclusive) == 0) {
+            return 0;
+        }
+        if (exclusive) {
+            pthread_rwlock_wrlock(l);
+        } else {
+            pthread_rwlock_rdlock(l);
+        }
+        return 1;
+    }
+    if (tl_worker->pool->sim) {
+        return sim_lock(l, 1, exclusive);
+    }
+    int i = 0;
+    for (; try_lock(l, 1, exclusive) != 0; i++) {
+        lock_backoff(i);
+    }
+    return i > 0;
+}
+
+void coro_mutex_unlock(pthread_mutex_t* m)
+{
+    pthread_mutex_unlock(m);
+    if (coro_sim_active()) {
+        sim_release(tl_worker->pool->sim, m);
+    }
+}
+
+void coro_rwlock_unlock(pthread_rwlock_t* l)
+{
+    pthread_rwlock_unlock(l);
+    if (coro_sim_active()) {
+        sim_release(tl_worker->pool->sim, l);
+    }
+}
+
+// A coroutine polls instead of parking its worker; the condition may
+// have been signalled and missed meanwhile, which callers' loops absorb
+void coro_cond_wait(pthread_cond_t* cond, pthread_mutex_t* m)
+{
+    if (!coro_active()) {
+        pthread_cond_wait(cond, m);
+        return;
+    }
+    pthread_mutex_unlock(m);
+    coro_sleep_us(CORO_WAIT_POLL_US);
+    for (int i = 0; pthread_mutex_trylock(m) != 0; i++) {
+        lock_backoff(i);
+    }
+}
+
+int coro_join(pthread_t thread, void** ret)
+{
+    if (!coro_active()) {
+        return pthread_join(thread, ret);
+    }
+    int rc;
+    while ((rc = pthread_tryjoin_np(thread, ret)) == EBUSY) {
+        coro_sleep_us(CORO_WAIT_POLL_US);
+    }
+    return rc;
+}
@@ -0,0 +1,130 @@
+#ifndef TILE_CORO_H
+#define TILE_CORO_H
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// Stackful coroutines for tile programs. A mesh larger than the host has
+// threads for (16x16 and up) runs each tile program as a coroutine on a
+// small pool of worker threads:
+//
+//   coro_pool_init(&pool, 2, 0);
+//   for (int i = 0; i < 256; i++) coro_spawn(&pool, tile_program, &tiles[i]);
+//   coro_pool_wait(&pool, 5000);
+//   coro_pool_destroy(&pool);
+//
+// A program gives up its worker at the simulator's wait points: the NoC
+// transfer delay and destination arbitration, HAL range locks, HAL ring
+// completion waits (DMA), HAL stream acquires, c0_wait_for_task, and
+// coro_cond_wait / coro_join for tests that wait on helper threads. The
+// same calls outside a coroutine behave as before, sleeping or blocking
+// the calling thread.
+//
+// A coroutine stays on the worker it was spawned on, so a lock it takes is
+// released by the thread that took it. Blocking on anything other than the
+// wait points above stalls every coroutine on that worker. Memory view
+// pins and log captures belong to the coroutine (coro_self), not to the
+// worker thread it shares with others.
+//
+// Simulated time (coro_pool_init_sim, or SIM_SEED=<n> for every pool):
+// coro_pool_wait becomes a coordinator that advances a simulated clock
+// instead of sleeping. Each step it takes every coroutine due at the
+// earliest simulated time, orders them by a key hashed from the seed, and
+// runs them up to their next wait point, in parallel on their workers.
+// It then settles what they asked for in that order: sleeps become
+// wakeups at now + delay, and locks are granted first-come first-served
+// from the coordinator, so arbitration (NoC destinations, HAL range
+// stripes) never depends on which host thread got there first. A run is a
+// function of the seed and the programs; the worker count only changes
+// how much of it overlaps on the host. This holds as long as programs do
+// not race on memory between wait points and do not wait on the physical
+// tile threads, which stay on wall-clock time. Spawn every program
+// before coro_pool_wait.
+
+#define CORO_MAX_WORKERS    16
+#define CORO_STACK_SIZE     (64 * 1024)     // default; a guard page sits below
+
+#define CORO_SIM_LOCKS      4096        // distinct locks one simulation can arbitrate
+
+typedef void (*coro_fn)(void* arg);
+
+struct coro_worker;
+struct coro_sim;
+
+typedef struct {
+    uint64_t spawned, finished;
+    uint64_t resumes;           // switches into a coroutine
+    uint64_t yields, sleeps;
+    int workers_used;           // workers that ran at least one coroutine
+    // Simulated time only
+    uint64_t sim_ns;            // simulated clock at the last step
+    uint64_t steps;             // coordinator steps
+    uint64_t parallel_steps;    // steps that ran on more than one worker
+    uint64_t lock_waits;        // lock requests that had to queue
+    uint64_t trace_hash;        // FNV-1a over every coro_trace_t
+} coro_stats_t;
+
+typedef enum {
+    CORO_EV_SLEEP,              // arg: ns asked for
+    CORO_EV_YIELD,
+    CORO_EV_LOCK_WAIT,          // arg: lock id (first-use order)
+    CORO_EV_LOCK_GRANT,
+    CORO_EV_DONE
+} coro_event_t;
+
+// One settled request, in the order the coordinator settled it
+typedef struct {
+    uint64_t ns;                // simulated time
+    int coro;                   // spawn order
+    coro_event_t kind;
+    uint64_t arg;
+} coro_trace_t;
+
+typedef void (*coro_trace_fn)(const coro_trace_t* ev, void* arg);
+
+typedef struct coro_pool {
+    struct coro_worker* w;
+    int workers;
+    size_t stack_size;
+    int next;                   // spawn round-robin
+    pthread_mutex_t lock;       // live
+    pthread_cond_t done;
+    int live;
+    struct coro_sim* sim;       // NULL on wall-clock time
+} coro_pool_t;
+
+// stack_size 0 uses CORO_STACK_SIZE
+int coro_pool_init(coro_pool_t* pool, int workers, size_t stack_size);
+int coro_pool_init_sim(coro_pool_t* pool, int workers, size_t stack_size, uint64_t seed);
+// Wall-clock time whatever SIM_SEED says, for programs that wait on threads
+int coro_pool_init_wall(coro_pool_t* pool, int workers, size_t stack_size);
+int coro_spawn(coro_pool_t* pool, coro_fn fn, void* arg);
+// Waits until every spawned coroutine has returned (on simulated time:
+// runs them); -1 on timeout or, simulated, when every program is stuck
+// on a lock
+int coro_pool_wait(coro_pool_t* pool, int timeout_ms);
+// Stops the workers; call once coro_pool_wait has succeeded
+void coro_pool_destroy(coro_pool_t* pool);
+void coro_pool_get_stats(coro_pool_t* pool, coro_stats_t* stats);
+// Called by the coordinator for every settled request; set before waiting
+void coro_pool_set_trace(coro_pool_t* pool, coro_trace_fn fn, void* arg);
+
+// Wait points, usable from any thread
+int coro_active(void);                  // nonzero inside a coroutine
+int coro_sim_active(void);              // ... on simulated time
+const void* coro_self(void);            // the coroutine, else the thread: same value until it ends
+uint64_t coro_now_ns(void);             // simulated clock there, else CLOCK_MONOTONIC
+void coro_yield(void);                  // sched_yield() outside
+void coro_sleep_us(unsigned us);        // nanosleep() outside
+// Return nonzero when the caller had to wait
+int coro_mutex_lock(pthread_mutex_t* m);
+int coro_rwlock_lock(pthread_rwlock_t* l, int exclusive);
+// Locks taken with the calls above must be dropped with these
+void coro_mutex_unlock(pthread_mutex_t* m);
+void coro_rwlock_unlock(pthread_rwlock_t* l);
+// pthread_cond_wait and pthread_join that keep the worker running others;
+// the wait may end without a signal, so check the condition in a loop
+void coro_cond_wait(pthread_cond_t* cond, pthread_mutex_t* m);
+int coro_join(pthread_t thread, void** ret);
+
+#endif
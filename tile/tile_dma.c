@@ -1,12 +1,22 @@
 #include <string.h>
+#include <pthread.h>
 #include "tile_dma.h"
 #include "platform_init/address_manager.h"
 #include "c0_master/c0_controller.h"
+#include "mem_ops/mem_ops.h"
 
 // Global handles for each tile's DMAC512 instance
 static DMAC512_HandleTypeDef g_dmac512_handles[8];
 static bool g_dmac512_initialized[8] = {false};
 
+// One DMAC512 per tile: its register block serialises transfers and fills
+static pthread_mutex_t g_dmac512_locks[8] = {
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+};
+
 // External access to platform for getting tile handles
 extern mesh_platform_t* g_platform;
 
@@ -56,6 +66,15 @@ int dma_tile_get_handle(int tile_id, DMAC512_HandleTypeDef** handle)
  * @brief Updated DMA local transfer using DMAC512
  */
 int dma_local_transfer(int tile_id, uint64_t src_addr, uint64_t dst_addr, size_t size)
+{
+    return dma_local_transfer_crc(tile_id, src_addr, dst_addr, size, NULL);
+}
+
+/**
+ * @brief DMA local transfer; when crc is non-NULL the DMAC512 CRC unit is
+ *        enabled and the CRC32C of the transferred data is returned in *crc
+ */
+int dma_local_transfer_crc(int tile_id, uint64_t src_addr, uint64_t dst_addr, size_t size, uint32_t* crc)
 {
     // Driver validates addresses are within the same tile
     if(get_tile_id_from_address(src_addr) != tile_id || 
@@ -74,14 +93,69 @@ int dma_local_transfer(int tile_id, uint64_t src_addr, uint64_t dst_addr, size_t
     }
     
     // Use DMAC512 for transfer
-    return HAL_DMAC512Transfer(dmac_handle, src_addr, dst_addr, size);
+    pthread_mutex_lock(&g_dmac512_locks[tile_id]);
+    dmac_handle->Init.CrcEnable = (crc != NULL);
+    int result = HAL_DMAC512Transfer(dmac_handle, src_addr, dst_addr, size);
+    if (crc && result >= 0) {
+        *crc = HAL_DMAC512GetCrc(dmac_handle);
+    }
+    dmac_handle->Init.CrcEnable = false;
+    pthread_mutex_unlock(&g_dmac512_locks[tile_id]);
+    return result;
+}
+
+/**
+ * @brief Fill a memory range with the tile's DMAC512 fill engine
+ */
+int dma_fill(int tile_id, uint64_t dst_addr, size_t size, DMAC512_OP_MODE_t mode,
+             uint8_t value, const uint8_t* pattern)
+{
+    // Tile DMA may initialize its own DLM or any DMEM over the NoC
+    addr_region_t region = get_address_region(dst_addr);
+    if (region != ADDR_DMEM_512 && get_tile_id_from_address(dst_addr) != tile_id) {
+        return -1;
+    }
+    if (region != ADDR_DMEM_512 && region != ADDR_TILE_DLM64 && region != ADDR_TILE_DLM1_512) {
+        return -1;
+    }
+
+    if (!validate_address(dst_addr, size)) {
+        return -1;
+    }
+
+    DMAC512_HandleTypeDef* dmac_handle;
+    if (dma_tile_get_handle(tile_id, &dmac_handle) != 0) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&g_dmac512_locks[tile_id]);
+    int result = HAL_DMAC512Fill(dmac_handle, dst_addr, size, mode, value, pattern);
+    pthread_mutex_unlock(&g_dmac512_locks[tile_id]);
+    return result;
+}
+
+/**
+ * @brief Pick the tile whose DMA engine should fill an address
+ *        (the owning tile for DLM, the tile paired with a DMEM module)
+ */
+int dma_fill_owner_tile(uint64_t dst_addr)
+{
+    int tile_id = get_tile_id_from_address(dst_addr);
+    if (tile_id >= 0) {
+        return tile_id;
+    }
+    int dmem_id = get_dmem_id_from_address(dst_addr);
+    if (dmem_id >= 0) {
+        return dmem_id % NUM_TILES;
+    }
+    return -1;
 }
 
 // Legacy functions for backward compatibility
 void dma_memcpy(void* dst, const void* src, size_t size)
 {
     /* blocking copy for simulation */
-    memcpy(dst, src, size);
+    mem_ops_copy(dst, src, size);
 }
 
 void dma_memcpy_addr(uint64_t dst_addr, uint64_t src_addr, size_t size)
@@ -90,7 +164,7 @@ void dma_memcpy_addr(uint64_t dst_addr, uint64_t src_addr, size_t size)
     uint8_t* src_ptr = addr_to_ptr(src_addr);
     
     if (dst_ptr && src_ptr && validate_address(src_addr, size) && validate_address(dst_addr, size)) {
-        memcpy(dst_ptr, src_ptr, size);
+        mem_ops_copy(dst_ptr, src_ptr, size);
     }
 }
 
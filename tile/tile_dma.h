@@ -14,6 +14,12 @@ int dma_tile_get_handle(int tile_id, DMAC512_HandleTypeDef** handle);
 
 // Updated DMA functions using DMAC512
 int dma_local_transfer(int tile_id, uint64_t src_addr, uint64_t dst_addr, size_t size);
+int dma_local_transfer_crc(int tile_id, uint64_t src_addr, uint64_t dst_addr, size_t size, uint32_t* crc);
+
+// DMAC512 fill engine: destination may be the tile's own DLM or any DMEM
+int dma_fill(int tile_id, uint64_t dst_addr, size_t size, DMAC512_OP_MODE_t mode,
+             uint8_t value, const uint8_t* pattern);
+int dma_fill_owner_tile(uint64_t dst_addr);
 
 // Legacy functions for backward compatibility
 void dma_memcpy(void* dst, const void* src, size_t size);
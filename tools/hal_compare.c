@@ -0,0 +1,91 @@
+// hal_compare – time a candidate HAL against a baseline on the same
+// workload and flag regressions (make compare CANDIDATE=<lib.so>).
+//
+//   hal_compare [--baseline <lib.so>] [--candidate <lib.so>] [--samples N]
+//               [--test-samples N] [--threshold PCT]
+//
+// Either side defaults to the reference HAL ($HAL_CANDIDATE also names the
+// candidate). Exits 1 if any row regressed or disagreed with the baseline.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "c0_master/c0_controller.h"
+#include "platform_init/system_setup.h"
+#include "hal_tests/hal_loader.h"
+#include "hal_tests/hal_compare.h"
+#include "log/log.h"
+
+#define MAX_ROWS 64
+
+static int load_side(const char* path, mesh_platform_t* p, hal_interface_t* table, const char** name)
+{
+    if (!path || !*path) {
+        *table = *hal_reference_table();
+        *name = "reference";
+        return 0;
+    }
+    return hal_load_library(path, p, table, name);
+}
+
+static void usage(const char* argv0)
+{
+    LOG_ERROR("usage: %s [--baseline <lib.so>] [--candidate <lib.so>] [--samples N] "
+              "[--test-samples N] [--threshold PCT]\n", argv0);
+}
+
+int main(int argc, char** argv)
+{
+    const char* base_path = NULL;
+    const char* cand_path = getenv("HAL_CANDIDATE");
+    hal_cmp_opts_t opts = { .samples = 30, .test_samples = 5, .threshold_pct = 5.0 };
+
+    log_init();
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* val = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!val) {
+            usage(argv[0]);
+            return 2;
+        }
+        if (strcmp(arg, "--baseline") == 0) {
+            base_path = val;
+        } else if (strcmp(arg, "--candidate") == 0) {
+            cand_path = val;
+        } else if (strcmp(arg, "--samples") == 0) {
+            opts.samples = atoi(val);
+        } else if (strcmp(arg, "--test-samples") == 0) {
+            opts.test_samples = atoi(val);
+        } else if (strcmp(arg, "--threshold") == 0) {
+            opts.threshold_pct = atof(val);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+    }
+
+    mesh_platform_t platform = {0};
+    platform_setup(&platform);
+
+    hal_interface_t base, cand;
+    const char *base_name, *cand_name;
+    if (load_side(base_path, &platform, &base, &base_name) != 0 ||
+        load_side(cand_path, &platform, &cand, &cand_name) != 0) {
+        return 2;
+    }
+
+    hal_cmp_row_t rows[MAX_ROWS];
+    int n = hal_compare_run(&platform, &base, &cand, &opts, rows, MAX_ROWS);
+    if (n < 0) {
+        usage(argv[0]);
+        return 2;
+    }
+    hal_compare_print(base_name, cand_name, &opts, rows, n);
+
+    int failed = 0;
+    for (int i = 0; i < n; i++) {
+        failed |= rows[i].verdict == HAL_CMP_REGRESSION || rows[i].verdict == HAL_CMP_MISMATCH;
+    }
+    return failed ? 1 : 0;
+}